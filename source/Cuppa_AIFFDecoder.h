@@ -0,0 +1,100 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AIFFDecoder
+           - Reads the samples of an AIFF or AIFF-C sound, a piece at a time or all at once.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AIFFDECODER_H
+#define _CUPPA_AIFFDECODER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioBuffer.h"
+
+// Constants
+
+enum
+{
+    CUPPA_AIFF_INT_BIG = 0, // big-endian integer samples (AIFF, and AIFF-C "NONE" or "twos")
+    CUPPA_AIFF_INT_LITTLE, // little-endian integer samples (AIFF-C "sowt")
+    CUPPA_AIFF_FLOAT, // big-endian 32-bit float samples (AIFF-C "fl32")
+    CUPPA_AIFF_IMA4 // IMA ADPCM packets of 64 frames, 4 bits a sample (AIFF-C "ima4")
+};
+
+// Class Interface
+
+// Only plain Foundation is used, so sounds decode the same way wherever they are read. Every
+// chunk is bounds checked; a sound that is truncated reads as far as its data goes. Reading a
+// piece at a time only ever holds one packet of decoded samples, so a long compressed sound can be
+// streamed from a mapped file without decoding it all.
+@interface Cuppa_AIFFDecoder : NSObject
+{
+    NSData *mData; // the whole file
+    const uint8_t *mSound; // first sample byte
+    NSUInteger mFrameCount; // number of frames in the sound
+    NSUInteger mChannelCount; // number of channels
+    NSUInteger mBytesPerSample; // bytes in each sample
+    double mSampleRate; // frames per second
+    int mEncoding; // how samples are stored, one of the CUPPA_AIFF_* constants
+    NSUInteger mPosition; // next frame to read
+    float *mPacket; // decoded samples of the current IMA4 packet (all channels, interleaved)
+    NSUInteger mPacketIndex; // which packet mPacket holds, or NSNotFound
+}
+
+// ------ Class Methods ------
+
+// Decode a whole sound, or return nil if it is not a sound we can read.
++ (Cuppa_AudioBuffer *)bufferWithData:(NSData *)data;
+
+// Decode a whole sound file, or return nil if it can't be read or is not a sound we can read.
++ (Cuppa_AudioBuffer *)bufferWithContentsOfFile:(NSString *)path;
+
+// ------ Life Cycle ------
+
+// Initialize a decoder for a sound. Returns nil if it is not a sound we can read.
+- (id)initWithData:(NSData *)data;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Read up to count frames from the current position into samples (interleaved, -1.0 to 1.0).
+// Returns the number of frames read, which is 0 at the end of the sound.
+- (NSUInteger)readFrames:(NSUInteger)count into:(float *)samples;
+
+// Go back to the start of the sound.
+- (void)rewind;
+
+// ------ Accessors ------
+
+// Returns the number of frames in the sound.
+- (NSUInteger)frameCount;
+
+// Returns the number of channels.
+- (NSUInteger)channelCount;
+
+// Returns the number of frames per second.
+- (double)sampleRate;
+
+@end // @interface Cuppa_AIFFDecoder
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AIFFDECODER_H
+
+// end Cuppa_AIFFDecoder.h
@@ -0,0 +1,433 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AIFFDecoder
+           - Reads the samples of an AIFF or AIFF-C sound, a piece at a time or all at once.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AIFFDecoder.h"
+#import "Cuppa_AudioBuffer.h"
+
+// Internal Constants
+
+// Sizes of the fixed parts of the file
+enum
+{
+    sChunkHeaderSize = 8, // chunk ID and length
+    sFormHeaderSize = 12, // "FORM", length, form type
+    sCommSize = 18, // channels, frames, sample size, sample rate
+    sSoundHeaderSize = 8, // offset and block size, before the sound data
+    sIMAPacketFrames = 64, // frames in an IMA4 packet
+    sIMAPacketSize = 34, // bytes in one channel of an IMA4 packet (2 header bytes, 64 nibbles)
+    sIMAStepCount = 89 // entries in the IMA step table
+};
+
+// IMA ADPCM step sizes
+static const int sIMASteps[sIMAStepCount] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,
+    25,    28,    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,
+    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,   230,   253,   279,
+    307,   337,   371,   408,   449,   494,   544,   598,   658,   724,   796,   876,   963,
+    1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,
+    3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+// IMA ADPCM step index changes, by nibble
+static const int sIMAIndexChanges[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+// Code!
+
+// Read a big-endian 16-bit word.
+static inline uint16_t CuppaAIFFWord16(const uint8_t *bytes)
+{
+    return (uint16_t)((bytes[0] << 8) | bytes[1]);
+}
+
+// Read a big-endian 32-bit word.
+static inline uint32_t CuppaAIFFWord32(const uint8_t *bytes)
+{
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) |
+           (uint32_t)bytes[3];
+}
+
+// Read an 80-bit extended precision number (used for the sample rate).
+static double CuppaAIFFExtended(const uint8_t *bytes)
+{
+    int exponent; // power of two, unbiased
+    uint64_t mantissa; // integer part first
+    int i; // loop counter
+
+    exponent = (int)(CuppaAIFFWord16(bytes) & 0x7FFF) - 16383 - 63;
+    mantissa = 0;
+    for (i = 0; i < 8; i++)
+    {
+        mantissa = (mantissa << 8) | bytes[2 + i];
+    }
+    return ((bytes[0] & 0x80) ? -1.0 : 1.0) * ldexp((double)mantissa, exponent);
+}
+
+// Decode one channel of an IMA4 packet into every stride'th element of samples.
+static void CuppaAIFFDecodeIMA4(const uint8_t *packet, float *samples, NSUInteger stride)
+{
+    int predictor; // current sample
+    int index; // current step index
+    int nibble; // current code
+    int step; // current step size
+    int diff; // change in the sample
+    int i; // loop counter
+
+    // the header holds the top 9 bits of the first predictor and the step index
+    predictor = (int16_t)(CuppaAIFFWord16(packet) & 0xFF80);
+    index = MIN(packet[1] & 0x7F, sIMAStepCount - 1);
+    for (i = 0; i < sIMAPacketFrames; i++)
+    {
+        // low nibble first
+        nibble = (packet[2 + (i / 2)] >> ((i & 1) * 4)) & 0x0F;
+        step = sIMASteps[index];
+        diff = step >> 3;
+        if (nibble & 1)
+            diff += step >> 2;
+        if (nibble & 2)
+            diff += step >> 1;
+        if (nibble & 4)
+            diff += step;
+        predictor += (nibble & 8) ? -diff : diff;
+        predictor = MAX(-32768, MIN(predictor, 32767));
+        index = MAX(0, MIN(index + sIMAIndexChanges[nibble], sIMAStepCount - 1));
+        samples[i * stride] = (float)predictor / 32768.0f;
+    }
+}
+
+@implementation Cuppa_AIFFDecoder
+;
+
+// *************************************************************************************************
+
+// Decode a whole sound, or return nil if it is not a sound we can read.
++ (Cuppa_AudioBuffer *)bufferWithData:(NSData *)data
+{
+    Cuppa_AIFFDecoder *decoder; // reads the sound
+    float *samples; // decoded samples
+    NSUInteger frameCount; // frames actually read
+
+    decoder = [[[Cuppa_AIFFDecoder alloc] initWithData:data] autorelease];
+    if (!decoder)
+        return nil;
+
+    samples = malloc([decoder frameCount] * [decoder channelCount] * sizeof(float) + 1);
+    NSAssert(samples != NULL, @"Out of memory for audio samples.\n");
+    frameCount = [decoder readFrames:[decoder frameCount] into:samples];
+
+    return [[[Cuppa_AudioBuffer alloc] initWithMallocedSamples:samples
+                                                    frameCount:frameCount
+                                                  channelCount:[decoder channelCount]
+                                                    sampleRate:[decoder sampleRate]] autorelease];
+
+} // end +bufferWithData:
+
+// *************************************************************************************************
+
+// Decode a whole sound file, or return nil if it can't be read or is not a sound we can read.
++ (Cuppa_AudioBuffer *)bufferWithContentsOfFile:(NSString *)path
+{
+    NSData *data; // file contents
+
+    if (!path)
+        return nil;
+    data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:NULL];
+    if (!data)
+        return nil;
+
+    return [self bufferWithData:data];
+
+} // end +bufferWithContentsOfFile:
+
+// *************************************************************************************************
+
+// Initialize a decoder for a sound. Returns nil if it is not a sound we can read.
+- (id)initWithData:(NSData *)data
+{
+    const uint8_t *bytes; // start of the file
+    NSUInteger length; // length of the file, as far as the FORM chunk says
+    NSUInteger offset; // current chunk
+    NSUInteger chunkLength; // length of the current chunk
+    bool isCompressed; // flag: AIFF-C file?
+    bool haveComm; // flag: seen the COMM chunk?
+    const uint8_t *sound; // sound data, once seen
+    NSUInteger soundLength; // length of the sound data
+    NSUInteger bitsPerSample; // sample size from the COMM chunk
+
+    // parameter checks
+    NSAssert(data != nil, @"Bad data parameter.\n");
+
+    self = [super init];
+    mData = [data retain];
+    mPacket = NULL;
+    mPacketIndex = NSNotFound;
+    bytes = [data bytes];
+    length = [data length];
+
+    // a FORM of AIFF or AIFF-C
+    if (length < sFormHeaderSize || memcmp(bytes, "FORM", 4) != 0 ||
+        (memcmp(bytes + 8, "AIFF", 4) != 0 && memcmp(bytes + 8, "AIFC", 4) != 0))
+    {
+        [self release];
+        return nil;
+    }
+    isCompressed = (memcmp(bytes + 8, "AIFC", 4) == 0);
+    length = MIN(length, (NSUInteger)CuppaAIFFWord32(bytes + 4) + sChunkHeaderSize);
+
+    // find the COMM and SSND chunks
+    haveComm = false;
+    sound = NULL;
+    soundLength = 0;
+    bitsPerSample = 0;
+    mEncoding = CUPPA_AIFF_INT_BIG;
+    for (offset = sFormHeaderSize; offset + sChunkHeaderSize <= length;
+         offset += sChunkHeaderSize + chunkLength + (chunkLength & 1))
+    {
+        chunkLength = CuppaAIFFWord32(bytes + offset + 4);
+        if (chunkLength > length - offset - sChunkHeaderSize)
+            chunkLength = length - offset - sChunkHeaderSize;
+
+        if (memcmp(bytes + offset, "COMM", 4) == 0 && chunkLength >= sCommSize)
+        {
+            haveComm = true;
+            mChannelCount = CuppaAIFFWord16(bytes + offset + 8);
+            mFrameCount = CuppaAIFFWord32(bytes + offset + 10);
+            bitsPerSample = CuppaAIFFWord16(bytes + offset + 14);
+            mSampleRate = CuppaAIFFExtended(bytes + offset + 16);
+
+            // AIFF-C says how the samples are stored
+            if (isCompressed)
+            {
+                if (chunkLength < sCommSize + 4)
+                    break;
+                if (memcmp(bytes + offset + 26, "sowt", 4) == 0)
+                    mEncoding = CUPPA_AIFF_INT_LITTLE;
+                else if (memcmp(bytes + offset + 26, "fl32", 4) == 0 ||
+                         memcmp(bytes + offset + 26, "FL32", 4) == 0)
+                    mEncoding = CUPPA_AIFF_FLOAT;
+                else if (memcmp(bytes + offset + 26, "ima4", 4) == 0)
+                    mEncoding = CUPPA_AIFF_IMA4;
+                else if (memcmp(bytes + offset + 26, "NONE", 4) != 0 &&
+                         memcmp(bytes + offset + 26, "twos", 4) != 0)
+                    break;
+            }
+        }
+        else if (memcmp(bytes + offset, "SSND", 4) == 0 && chunkLength >= sSoundHeaderSize)
+        {
+            // sound data starts after the header, plus any offset it gives
+            soundLength = chunkLength - sSoundHeaderSize;
+            sound = bytes + offset + sChunkHeaderSize + sSoundHeaderSize;
+            chunkLength = MIN(CuppaAIFFWord32(bytes + offset + 8), soundLength);
+            sound += chunkLength;
+            soundLength -= chunkLength;
+            chunkLength = CuppaAIFFWord32(bytes + offset + 4);
+            if (chunkLength > length - offset - sChunkHeaderSize)
+                chunkLength = length - offset - sChunkHeaderSize;
+        }
+    }
+
+    // check we can read the samples (IMA4 decodes to 16 bits, whatever the COMM chunk says)
+    mBytesPerSample = (mEncoding == CUPPA_AIFF_IMA4) ? 2 : ((bitsPerSample + 7) / 8);
+    if (!haveComm || !sound || mChannelCount == 0 || mSampleRate <= 0.0 ||
+        mBytesPerSample < 1 || mBytesPerSample > 4 ||
+        (mEncoding == CUPPA_AIFF_FLOAT && mBytesPerSample != 4))
+    {
+        [self release];
+        return nil;
+    }
+
+    // a truncated sound plays as far as it goes (for IMA4, the COMM chunk counts packets)
+    mSound = sound;
+    if (mEncoding == CUPPA_AIFF_IMA4)
+    {
+        mFrameCount = MIN(mFrameCount, soundLength / (sIMAPacketSize * mChannelCount)) *
+                      sIMAPacketFrames;
+        mPacket = malloc(sIMAPacketFrames * mChannelCount * sizeof(float));
+        NSAssert(mPacket != NULL, @"Out of memory for audio samples.\n");
+    }
+    else
+    {
+        mFrameCount = MIN(mFrameCount, soundLength / (mBytesPerSample * mChannelCount));
+    }
+    mPosition = 0;
+
+    return self;
+
+} // end -initWithData:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the file
+    [mData release];
+    free(mPacket);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Read count frames (which must all be there) of an IMA4 sound from the current position into
+// samples, decoding a packet at a time.
+- (NSUInteger)readPacketFrames:(NSUInteger)count into:(float *)samples
+{
+    NSUInteger done; // frames read so far
+    NSUInteger packet; // packet holding the current position
+    NSUInteger offset; // current position within its packet
+    NSUInteger frames; // frames to take from the current packet
+    NSUInteger channel; // loop counter
+
+    for (done = 0; done < count; done += frames)
+    {
+        // packets for each channel follow one another
+        packet = mPosition / sIMAPacketFrames;
+        if (packet != mPacketIndex)
+        {
+            for (channel = 0; channel < mChannelCount; channel++)
+            {
+                CuppaAIFFDecodeIMA4(mSound + ((packet * mChannelCount + channel) * sIMAPacketSize),
+                                    mPacket + channel, mChannelCount);
+            }
+            mPacketIndex = packet;
+        }
+
+        offset = mPosition % sIMAPacketFrames;
+        frames = MIN(sIMAPacketFrames - offset, count - done);
+        memcpy(samples + (done * mChannelCount), mPacket + (offset * mChannelCount),
+               frames * mChannelCount * sizeof(float));
+        mPosition += frames;
+    }
+
+    return count;
+
+} // end -readPacketFrames:into:
+
+// *************************************************************************************************
+
+// Read up to count frames from the current position into samples (interleaved, -1.0 to 1.0).
+// Returns the number of frames read, which is 0 at the end of the sound.
+- (NSUInteger)readFrames:(NSUInteger)count into:(float *)samples
+{
+    const uint8_t *in; // next sample byte
+    NSUInteger sampleCount; // number of samples to read
+    NSUInteger i; // loop counter
+    uint32_t word; // current sample's bits, most significant first
+    int32_t value; // current sample, left aligned
+    union
+    {
+        uint32_t word;
+        float value;
+    } bits; // float sample's bits
+
+    // parameter checks
+    NSAssert(samples != NULL || count == 0, @"Bad samples parameter.\n");
+
+    count = MIN(count, mFrameCount - mPosition);
+    if (mEncoding == CUPPA_AIFF_IMA4)
+        return [self readPacketFrames:count into:samples];
+    sampleCount = count * mChannelCount;
+    in = mSound + (mPosition * mChannelCount * mBytesPerSample);
+    for (i = 0; i < sampleCount; i++, in += mBytesPerSample)
+    {
+        if (mEncoding == CUPPA_AIFF_FLOAT)
+        {
+            bits.word = CuppaAIFFWord32(in);
+            samples[i] = bits.value;
+            continue;
+        }
+
+        // gather the sample's bytes most significant first, then scale it from a left aligned
+        // 32-bit sample
+        switch (mBytesPerSample)
+        {
+            case 1:
+                word = (uint32_t)in[0] << 24;
+                break;
+            case 2:
+                word = (mEncoding == CUPPA_AIFF_INT_LITTLE)
+                           ? (((uint32_t)in[1] << 24) | ((uint32_t)in[0] << 16))
+                           : (((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16));
+                break;
+            case 3:
+                word = (mEncoding == CUPPA_AIFF_INT_LITTLE)
+                           ? (((uint32_t)in[2] << 24) | ((uint32_t)in[1] << 16) |
+                              ((uint32_t)in[0] << 8))
+                           : (((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) |
+                              ((uint32_t)in[2] << 8));
+                break;
+            default:
+                word = (mEncoding == CUPPA_AIFF_INT_LITTLE)
+                           ? (((uint32_t)in[3] << 24) | ((uint32_t)in[2] << 16) |
+                              ((uint32_t)in[1] << 8) | (uint32_t)in[0])
+                           : CuppaAIFFWord32(in);
+                break;
+        }
+        value = (int32_t)word;
+        samples[i] = (float)((double)value / 2147483648.0);
+    }
+    mPosition += count;
+
+    return count;
+
+} // end -readFrames:into:
+
+// *************************************************************************************************
+
+// Go back to the start of the sound.
+- (void)rewind
+{
+    mPosition = 0;
+
+} // end -rewind
+
+// *************************************************************************************************
+
+// Returns the number of frames in the sound.
+- (NSUInteger)frameCount
+{
+    // return requested info
+    return mFrameCount;
+
+} // end -frameCount
+
+// *************************************************************************************************
+
+// Returns the number of channels.
+- (NSUInteger)channelCount
+{
+    // return requested info
+    return mChannelCount;
+
+} // end -channelCount
+
+// *************************************************************************************************
+
+// Returns the number of frames per second.
+- (double)sampleRate
+{
+    // return requested info
+    return mSampleRate;
+
+} // end -sampleRate
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AIFFDecoder
+
+// end Cuppa_AIFFDecoder.m
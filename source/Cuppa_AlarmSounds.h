@@ -0,0 +1,125 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AlarmSounds
+           - Imports the sounds chosen as beverage alarms, keeping the ones in use ready to
+             play.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_ALARMSOUNDS_H
+#define _CUPPA_ALARMSOUNDS_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioCues.h"
+
+// Constants
+
+enum
+{
+    CUPPA_ALARMSOUNDS_MAX_SECONDS = 30, // longest sound accepted as an alarm
+    CUPPA_ALARMSOUNDS_KEPT = 8 // most sounds kept ready to play
+};
+
+// Class Interface
+
+// A sound is read once, when it is imported: it is checked, hashed and (if it is short enough to
+// be decoded whole, see CUPPA_AUDIOCUES_PRELOAD_SECONDS) converted to the output's format on a
+// background queue, then loaded as a cue named for the hash of the file's contents. Longer sounds
+// are loaded as their mapped file and streamed as they play. The same sound imported from two
+// places is only kept once, and the sounds played least recently are forgotten once more than
+// CUPPA_ALARMSOUNDS_KEPT are ready (to be imported again if they are needed).
+// A sound chosen as an alarm is also copied to a folder of our own, named for its content hash, so
+// it can still be read after the original has moved (or from inside the sandbox) on later launches.
+@interface Cuppa_AlarmSounds : NSObject
+{
+    Cuppa_AudioCues *mAudio; // plays the sounds
+    NSString *mFolder; // folder chosen sounds are copied to
+    double mSampleRate; // frames per second sounds are converted to
+    NSUInteger mChannelCount; // number of channels sounds are converted to
+    NSMutableArray *mReady; // content hashes of the sounds loaded as cues, least recent first
+    NSMutableDictionary *mHashes; // content hash of each file imported, by path
+    NSMutableDictionary *mPending; // handlers waiting for each file being imported, by path
+    dispatch_queue_t mQueue; // queue sounds are read and converted on
+}
+
+// ------ Class Methods ------
+
+// Returns the standard folder for copies of chosen sounds, in the application support folder.
++ (NSString *)defaultFolder;
+
+// Returns the content hash of a sound file's contents (SHA-256, as lower case hex).
++ (NSString *)hashForData:(NSData *)data;
+
+// Returns a sound file's contents ready to be loaded as a cue: a Cuppa_AudioBuffer converted to
+// sampleRate and channelCount, or data itself if the sound is long enough to be streamed. Returns
+// nil if the sound can't be used as an alarm: it must be an AIFF or AIFF-C sound of some length,
+// but no longer than CUPPA_ALARMSOUNDS_MAX_SECONDS. Safe to call on any thread.
++ (id)soundWithData:(NSData *)data
+        sampleRate:(double)sampleRate
+      channelCount:(NSUInteger)channelCount;
+
+// ------ Life Cycle ------
+
+// Initialize an empty set of sounds, played by audio (and converted to its mixer's format),
+// copying chosen sounds to folder.
+- (id)initWithAudio:(Cuppa_AudioCues *)audio folder:(NSString *)folder;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Import the sound at path in the background, unless it is ready already, then call handler on
+// the main thread with the name of its cue, or nil if the file can't be read or the sound can't
+// be used as an alarm. The handler is called straight away if the sound is ready.
+- (void)prepareSoundAtPath:(NSString *)path completion:(void (^)(NSString *cue))handler;
+
+// Import the sound at path in the background and copy it to our folder, unless a copy is there
+// already, then call handler on the main thread with the path of the copy, or nil if the sound
+// can't be used as an alarm or can't be copied.
+- (void)keepSoundAtPath:(NSString *)path completion:(void (^)(NSString *copy))handler;
+
+// ------ Accessors ------
+
+// Returns the name of the cue of the sound imported from path, or nil if it isn't ready.
+- (NSString *)cueForPath:(NSString *)path;
+
+// Returns the content hash of the sound imported from path, or nil if it hasn't been.
+- (NSString *)hashForPath:(NSString *)path;
+
+// Returns the number of distinct sounds ready to play.
+- (NSUInteger)count;
+
+// Returns the number of files being imported.
+- (NSUInteger)pendingCount;
+
+// Returns the frames per second sounds are converted to.
+- (double)sampleRate;
+
+// Returns the number of channels sounds are converted to.
+- (NSUInteger)channelCount;
+
+// Returns the folder chosen sounds are copied to.
+- (NSString *)folder;
+
+@end // @interface Cuppa_AlarmSounds
+
+// *************************************************************************************************
+
+#endif // _CUPPA_ALARMSOUNDS_H
+
+// end Cuppa_AlarmSounds.h
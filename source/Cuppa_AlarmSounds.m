@@ -0,0 +1,441 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AlarmSounds
+           - Imports the sounds chosen as beverage alarms, keeping the ones in use ready to
+             play.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <CommonCrypto/CommonDigest.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AIFFDecoder.h"
+#import "Cuppa_AlarmSounds.h"
+#import "Cuppa_AudioBuffer.h"
+
+// Internal Constants
+
+// Copies of chosen sounds are named for their content hash, with this extension
+static NSString *const sCopyExtension = @"aiff";
+
+// Code!
+
+@implementation Cuppa_AlarmSounds
+;
+
+// *************************************************************************************************
+
+// Returns the standard folder for copies of chosen sounds, in the application support folder.
++ (NSString *)defaultFolder
+{
+    NSArray *folders; // application support folders
+    NSString *folder; // our folder within them
+    NSString *bundleID; // our bundle identifier
+
+    folders = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask,
+                                                  YES);
+    NSAssert([folders count] > 0, @"No application support folder.\n");
+    bundleID = [[NSBundle mainBundle] bundleIdentifier];
+    folder = [[folders objectAtIndex:0] stringByAppendingPathComponent:(bundleID ? bundleID
+                                                                                 : @"Cuppa")];
+    return [folder stringByAppendingPathComponent:@"Alarm Sounds"];
+
+} // end +defaultFolder
+
+// *************************************************************************************************
+
+// Returns the content hash of a sound file's contents (SHA-256, as lower case hex).
++ (NSString *)hashForData:(NSData *)data
+{
+    unsigned char digest[CC_SHA256_DIGEST_LENGTH]; // hash of the contents
+    NSMutableString *hash; // hash as hex
+    NSUInteger i; // loop counter
+
+    // parameter checks
+    NSAssert(data != nil, @"Bad data parameter.\n");
+
+    CC_SHA256([data bytes], (CC_LONG)[data length], digest);
+    hash = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (i = 0; i < CC_SHA256_DIGEST_LENGTH; i++)
+    {
+        [hash appendFormat:@"%02x", digest[i]];
+    }
+
+    return hash;
+
+} // end +hashForData:
+
+// *************************************************************************************************
+
+// Returns a sound file's contents ready to be loaded as a cue: a Cuppa_AudioBuffer converted to
+// sampleRate and channelCount, or data itself if the sound is long enough to be streamed. Returns
+// nil if the sound can't be used as an alarm: it must be an AIFF or AIFF-C sound of some length,
+// but no longer than CUPPA_ALARMSOUNDS_MAX_SECONDS. Safe to call on any thread.
++ (id)soundWithData:(NSData *)data
+        sampleRate:(double)sampleRate
+      channelCount:(NSUInteger)channelCount
+{
+    Cuppa_AIFFDecoder *decoder; // checks the sound
+    Cuppa_AudioBuffer *buffer; // decoded sound
+    double seconds; // length of the sound
+
+    // parameter checks
+    NSAssert(data != nil, @"Bad data parameter.\n");
+    NSAssert(sampleRate > 0.0, @"Bad sampleRate parameter.\n");
+    NSAssert(channelCount > 0, @"Bad channelCount parameter.\n");
+
+    // check the sound before decoding any of it
+    decoder = [[[Cuppa_AIFFDecoder alloc] initWithData:data] autorelease];
+    if (!decoder || [decoder frameCount] == 0)
+        return nil;
+    seconds = (double)[decoder frameCount] / [decoder sampleRate];
+    if (seconds > CUPPA_ALARMSOUNDS_MAX_SECONDS)
+        return nil;
+
+    // a long sound is streamed from its file as it plays, rather than kept decoded
+    if (seconds > CUPPA_AUDIOCUES_PRELOAD_SECONDS)
+        return data;
+
+    // otherwise convert it to the output format now, so it plays as is
+    buffer = [Cuppa_AIFFDecoder bufferWithData:data];
+    return [buffer bufferWithSampleRate:sampleRate channelCount:channelCount];
+
+} // end +soundWithData:sampleRate:channelCount:
+
+// *************************************************************************************************
+
+// Initialize an empty set of sounds, played by audio (and converted to its mixer's format),
+// copying chosen sounds to folder.
+- (id)initWithAudio:(Cuppa_AudioCues *)audio folder:(NSString *)folder
+{
+    // parameter checks
+    NSAssert(audio != nil, @"Bad audio parameter.\n");
+    NSAssert(folder != nil, @"Bad folder parameter.\n");
+
+    self = [super init];
+    mAudio = [audio retain];
+    mFolder = [folder copy];
+    mSampleRate = [[audio mixer] sampleRate];
+    mChannelCount = [[audio mixer] channelCount];
+    mReady = [[NSMutableArray alloc] init];
+    mHashes = [[NSMutableDictionary alloc] init];
+    mPending = [[NSMutableDictionary alloc] init];
+    mQueue = dispatch_queue_create("com.nathancosgray.cuppa.alarmsounds", DISPATCH_QUEUE_SERIAL);
+
+    return self;
+
+} // end -initWithAudio:folder:
+
+// *************************************************************************************************
+
+// Returns the name of the cue a sound is loaded as.
+- (NSString *)cueForHash:(NSString *)hash
+{
+    // return requested info
+    return [@"alarm-" stringByAppendingString:hash];
+
+} // end -cueForHash:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    NSUInteger i; // loop counter
+
+    // (imports under way hold on to us, so the queue is idle by now)
+    for (i = 0; i < [mReady count]; i++)
+    {
+        [mAudio removeCue:[self cueForHash:[mReady objectAtIndex:i]]];
+    }
+    dispatch_release(mQueue);
+    [mAudio release];
+    [mFolder release];
+    [mReady release];
+    [mHashes release];
+    [mPending release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Make a sound the most recently used, loading it as a cue if it isn't loaded already, and forget
+// the least recently used sounds if there are now too many.
+- (void)useSound:(id)sound hash:(NSString *)hash
+{
+    if ([mReady containsObject:hash])
+    {
+        // record new info (this sound is now the most recently used)
+        [hash retain];
+        [mReady removeObject:hash];
+        [mReady addObject:hash];
+        [hash release];
+        return;
+    }
+
+    // a sound being kept is converted, and one being streamed is its file
+    if ([sound isKindOfClass:[Cuppa_AudioBuffer class]])
+        [mAudio addCue:[self cueForHash:hash] buffer:sound];
+    else
+        [mAudio addCue:[self cueForHash:hash] streamData:sound];
+
+    // record new info
+    [mReady addObject:hash];
+    while ([mReady count] > CUPPA_ALARMSOUNDS_KEPT)
+    {
+        [mAudio removeCue:[self cueForHash:[mReady objectAtIndex:0]]];
+        [mReady removeObjectAtIndex:0];
+    }
+
+} // end -useSound:hash:
+
+// *************************************************************************************************
+
+// Record the outcome of importing the file at path, and call the handlers waiting for it.
+- (void)finishPath:(NSString *)path sound:(id)sound hash:(NSString *)hash
+{
+    NSArray *handlers; // called now the import is done
+    void (^handler)(NSString *cue); // current handler
+    NSString *cue = nil; // cue of the sound
+    NSUInteger i; // loop counter
+
+    if (sound)
+    {
+        [self useSound:sound hash:hash];
+        [mHashes setObject:hash forKey:path];
+        cue = [self cueForHash:hash];
+    }
+
+#if !defined(NDEBUG)
+    printf("Alarm sound %s: %s\n", (sound ? "ready" : "failed"), [path UTF8String]);
+#endif
+
+    // the handlers may import the file again, so the waiting list is gone before they are called
+    handlers = [[mPending objectForKey:path] retain];
+    [mPending removeObjectForKey:path];
+    for (i = 0; i < [handlers count]; i++)
+    {
+        handler = [handlers objectAtIndex:i];
+        handler(cue);
+    }
+    [handlers release];
+
+} // end -finishPath:sound:hash:
+
+// *************************************************************************************************
+
+// Import the sound at path in the background, unless it is ready already, then call handler on
+// the main thread with the name of its cue, or nil if the file can't be read or the sound can't
+// be used as an alarm. The handler is called straight away if the sound is ready.
+- (void)prepareSoundAtPath:(NSString *)path completion:(void (^)(NSString *cue))handler
+{
+    NSMutableArray *handlers; // handlers waiting for the file
+    NSString *cue; // cue of the sound, if it is ready
+    double sampleRate = mSampleRate; // format to convert to (read here, not on the queue)
+    NSUInteger channelCount = mChannelCount;
+
+    // parameter checks
+    NSAssert(path != nil, @"Bad path parameter.\n");
+    NSAssert(handler != nil, @"Bad handler parameter.\n");
+
+    // a file already imported isn't read again
+    cue = [self cueForPath:path];
+    if (cue)
+    {
+        handler(cue);
+        return;
+    }
+
+    // a file already being imported is only read once
+    handlers = [mPending objectForKey:path];
+    if (handlers)
+    {
+        [handlers addObject:[[handler copy] autorelease]];
+        return;
+    }
+
+    // record new info
+    [mPending setObject:[NSMutableArray arrayWithObject:[[handler copy] autorelease]] forKey:path];
+
+    // reading, hashing and converting the sound can take a while, so none of it is done here
+    dispatch_async(mQueue, ^{
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSData *data = [NSData dataWithContentsOfFile:path
+                                              options:NSDataReadingMappedIfSafe
+                                                error:NULL];
+        id sound = data ? [Cuppa_AlarmSounds soundWithData:data
+                                                sampleRate:sampleRate
+                                              channelCount:channelCount] : nil;
+        NSString *hash = sound ? [Cuppa_AlarmSounds hashForData:data] : nil;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            [self finishPath:path sound:sound hash:hash];
+        });
+        [pool release];
+    });
+
+} // end -prepareSoundAtPath:completion:
+
+// *************************************************************************************************
+
+// Import the sound at path in the background and copy it to our folder, unless a copy is there
+// already, then call handler on the main thread with the path of the copy, or nil if the sound
+// can't be used as an alarm or can't be copied.
+- (void)keepSoundAtPath:(NSString *)path completion:(void (^)(NSString *copy))handler
+{
+    NSString *folder = mFolder; // folder to copy to (read here, not on the queue)
+    double sampleRate = mSampleRate; // format to convert to
+    NSUInteger channelCount = mChannelCount;
+
+    // parameter checks
+    NSAssert(path != nil, @"Bad path parameter.\n");
+    NSAssert(handler != nil, @"Bad handler parameter.\n");
+
+    // the original is always read afresh, as it may have changed since it was last chosen
+    handler = [[handler copy] autorelease];
+    dispatch_async(mQueue, ^{
+        NSAutoreleasePool *pool = [[NSAutoreleasePool alloc] init];
+        NSFileManager *manager = [NSFileManager defaultManager];
+        NSData *data = [NSData dataWithContentsOfFile:path
+                                              options:NSDataReadingMappedIfSafe
+                                                error:NULL];
+        id sound = data ? [Cuppa_AlarmSounds soundWithData:data
+                                                sampleRate:sampleRate
+                                              channelCount:channelCount] : nil;
+        NSString *hash = sound ? [Cuppa_AlarmSounds hashForData:data] : nil;
+        NSString *copy = nil;
+
+        // a copy never changes, as its name says what is in it
+        if (hash)
+        {
+            copy = [folder stringByAppendingPathComponent:
+                    [hash stringByAppendingPathExtension:sCopyExtension]];
+            if (![manager fileExistsAtPath:copy] &&
+                (![manager createDirectoryAtPath:folder
+                     withIntermediateDirectories:YES
+                                      attributes:nil
+                                           error:NULL] ||
+                 ![data writeToFile:copy atomically:YES]))
+                copy = nil;
+        }
+
+        // a streamed sound plays from the copy, which outlives the original
+        if (copy && ![sound isKindOfClass:[Cuppa_AudioBuffer class]])
+        {
+            sound = [NSData dataWithContentsOfFile:copy
+                                           options:NSDataReadingMappedIfSafe
+                                             error:NULL];
+        }
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if (!copy || !sound)
+            {
+                handler(nil);
+                return;
+            }
+
+            // record new info
+            [self useSound:sound hash:hash];
+            [mHashes setObject:hash forKey:copy];
+            handler(copy);
+        });
+        [pool release];
+    });
+
+} // end -keepSoundAtPath:completion:
+
+// *************************************************************************************************
+
+// Returns the name of the cue of the sound imported from path, or nil if it isn't ready.
+- (NSString *)cueForPath:(NSString *)path
+{
+    NSString *hash; // content hash of the sound
+
+    // parameter checks
+    NSAssert(path != nil, @"Bad path parameter.\n");
+
+    hash = [mHashes objectForKey:path];
+    if (!hash || ![mReady containsObject:hash])
+        return nil;
+
+    // return requested info
+    return [self cueForHash:hash];
+
+} // end -cueForPath:
+
+// *************************************************************************************************
+
+// Returns the content hash of the sound imported from path, or nil if it hasn't been.
+- (NSString *)hashForPath:(NSString *)path
+{
+    // parameter checks
+    NSAssert(path != nil, @"Bad path parameter.\n");
+
+    // return requested info
+    return [mHashes objectForKey:path];
+
+} // end -hashForPath:
+
+// *************************************************************************************************
+
+// Returns the number of distinct sounds ready to play.
+- (NSUInteger)count
+{
+    // return requested info
+    return [mReady count];
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the number of files being imported.
+- (NSUInteger)pendingCount
+{
+    // return requested info
+    return [mPending count];
+
+} // end -pendingCount
+
+// *************************************************************************************************
+
+// Returns the frames per second sounds are converted to.
+- (double)sampleRate
+{
+    // return requested info
+    return mSampleRate;
+
+} // end -sampleRate
+
+// *************************************************************************************************
+
+// Returns the number of channels sounds are converted to.
+- (NSUInteger)channelCount
+{
+    // return requested info
+    return mChannelCount;
+
+} // end -channelCount
+
+// *************************************************************************************************
+
+// Returns the folder chosen sounds are copied to.
+- (NSString *)folder
+{
+    // return requested info
+    return mFolder;
+
+} // end -folder
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AlarmSounds
+
+// end Cuppa_AlarmSounds.m
@@ -0,0 +1,81 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioBuffer
+           - A sound decoded into memory, as interleaved floating point samples.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AUDIOBUFFER_H
+#define _CUPPA_AUDIOBUFFER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Class Interface
+
+// Buffers never change once made, so one buffer can be played by any number of voices at once,
+// from any thread.
+@interface Cuppa_AudioBuffer : NSObject
+{
+    float *mSamples; // interleaved samples, -1.0 to 1.0
+    NSUInteger mFrameCount; // number of frames (one sample per channel)
+    NSUInteger mChannelCount; // number of channels
+    double mSampleRate; // frames per second
+}
+
+// ------ Life Cycle ------
+
+// Initialize a buffer with a copy of frameCount frames of interleaved samples.
+- (id)initWithSamples:(const float *)samples
+           frameCount:(NSUInteger)frameCount
+         channelCount:(NSUInteger)channelCount
+           sampleRate:(double)sampleRate;
+
+// Initialize a buffer that takes over samples, which must have come from malloc().
+- (id)initWithMallocedSamples:(float *)samples
+                   frameCount:(NSUInteger)frameCount
+                 channelCount:(NSUInteger)channelCount
+                   sampleRate:(double)sampleRate;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Accessors ------
+
+// Returns the interleaved samples.
+- (const float *)samples;
+
+// Returns the number of frames.
+- (NSUInteger)frameCount;
+
+// Returns the number of channels.
+- (NSUInteger)channelCount;
+
+// Returns the number of frames per second.
+- (double)sampleRate;
+
+// Returns the length of the sound in seconds.
+- (NSTimeInterval)duration;
+
+// Returns this sound at another sample rate and channel count (resampled linearly, and mixed
+// down or copied across channels as needed), or this buffer if it already matches.
+- (Cuppa_AudioBuffer *)bufferWithSampleRate:(double)sampleRate
+                               channelCount:(NSUInteger)channelCount;
+
+@end // @interface Cuppa_AudioBuffer
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AUDIOBUFFER_H
+
+// end Cuppa_AudioBuffer.h
@@ -0,0 +1,204 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioBuffer
+           - A sound decoded into memory, as interleaved floating point samples.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioBuffer.h"
+
+// Code!
+
+@implementation Cuppa_AudioBuffer
+;
+
+// *************************************************************************************************
+
+// Initialize a buffer with a copy of frameCount frames of interleaved samples.
+- (id)initWithSamples:(const float *)samples
+           frameCount:(NSUInteger)frameCount
+         channelCount:(NSUInteger)channelCount
+           sampleRate:(double)sampleRate
+{
+    float *copy; // our own copy of the samples
+
+    // parameter checks
+    NSAssert(samples != NULL || frameCount == 0, @"Bad samples parameter.\n");
+    NSAssert(channelCount > 0, @"Bad channelCount parameter.\n");
+
+    copy = malloc(frameCount * channelCount * sizeof(float) + 1);
+    NSAssert(copy != NULL, @"Out of memory for audio samples.\n");
+    if (frameCount > 0)
+        memcpy(copy, samples, frameCount * channelCount * sizeof(float));
+
+    return [self initWithMallocedSamples:copy
+                              frameCount:frameCount
+                            channelCount:channelCount
+                              sampleRate:sampleRate];
+
+} // end -initWithSamples:frameCount:channelCount:sampleRate:
+
+// *************************************************************************************************
+
+// Initialize a buffer that takes over samples, which must have come from malloc().
+- (id)initWithMallocedSamples:(float *)samples
+                   frameCount:(NSUInteger)frameCount
+                 channelCount:(NSUInteger)channelCount
+                   sampleRate:(double)sampleRate
+{
+    // parameter checks
+    NSAssert(samples != NULL, @"Bad samples parameter.\n");
+    NSAssert(channelCount > 0, @"Bad channelCount parameter.\n");
+    NSAssert(sampleRate > 0.0, @"Bad sampleRate parameter.\n");
+
+    self = [super init];
+    mSamples = samples;
+    mFrameCount = frameCount;
+    mChannelCount = channelCount;
+    mSampleRate = sampleRate;
+    return self;
+
+} // end -initWithMallocedSamples:frameCount:channelCount:sampleRate:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release the samples
+    free(mSamples);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Returns the interleaved samples.
+- (const float *)samples
+{
+    // return requested info
+    return mSamples;
+
+} // end -samples
+
+// *************************************************************************************************
+
+// Returns the number of frames.
+- (NSUInteger)frameCount
+{
+    // return requested info
+    return mFrameCount;
+
+} // end -frameCount
+
+// *************************************************************************************************
+
+// Returns the number of channels.
+- (NSUInteger)channelCount
+{
+    // return requested info
+    return mChannelCount;
+
+} // end -channelCount
+
+// *************************************************************************************************
+
+// Returns the number of frames per second.
+- (double)sampleRate
+{
+    // return requested info
+    return mSampleRate;
+
+} // end -sampleRate
+
+// *************************************************************************************************
+
+// Returns the length of the sound in seconds.
+- (NSTimeInterval)duration
+{
+    // return requested info
+    return (NSTimeInterval)mFrameCount / mSampleRate;
+
+} // end -duration
+
+// *************************************************************************************************
+
+// Returns this sound at another sample rate and channel count (resampled linearly, and mixed
+// down or copied across channels as needed), or this buffer if it already matches.
+- (Cuppa_AudioBuffer *)bufferWithSampleRate:(double)sampleRate
+                               channelCount:(NSUInteger)channelCount
+{
+    float *samples; // converted samples
+    NSUInteger frameCount; // number of converted frames
+    NSUInteger frame, channel, i; // loop counters
+    double position; // where a converted frame falls in our frames
+    NSUInteger before, after; // our frames either side of position
+    float fraction; // how far position is past the frame before it
+    float a, b; // samples either side of position
+
+    // parameter checks
+    NSAssert(sampleRate > 0.0, @"Bad sampleRate parameter.\n");
+    NSAssert(channelCount > 0, @"Bad channelCount parameter.\n");
+
+    if (sampleRate == mSampleRate && channelCount == mChannelCount)
+        return [[self retain] autorelease];
+
+    frameCount = (NSUInteger)floor((double)mFrameCount * sampleRate / mSampleRate);
+    samples = malloc(frameCount * channelCount * sizeof(float) + 1);
+    NSAssert(samples != NULL, @"Out of memory for audio samples.\n");
+
+    for (frame = 0; frame < frameCount; frame++)
+    {
+        position = (double)frame * mSampleRate / sampleRate;
+        before = MIN((NSUInteger)position, mFrameCount - 1);
+        after = MIN(before + 1, mFrameCount - 1);
+        fraction = (float)(position - (double)before);
+        for (channel = 0; channel < channelCount; channel++)
+        {
+            if (channelCount != mChannelCount && (mChannelCount == 1 || channelCount == 1))
+            {
+                // mono in or out: spread mono to every channel, or mix every channel to mono
+                a = 0.0f;
+                b = 0.0f;
+                for (i = 0; i < mChannelCount; i++)
+                {
+                    a += mSamples[before * mChannelCount + i];
+                    b += mSamples[after * mChannelCount + i];
+                }
+                a /= (float)mChannelCount;
+                b /= (float)mChannelCount;
+            }
+            else
+            {
+                // otherwise match channels up in order, repeating the last one if we run out
+                i = MIN(channel, mChannelCount - 1);
+                a = mSamples[before * mChannelCount + i];
+                b = mSamples[after * mChannelCount + i];
+            }
+            samples[frame * channelCount + channel] = a + ((b - a) * fraction);
+        }
+    }
+
+    return [[[Cuppa_AudioBuffer alloc] initWithMallocedSamples:samples
+                                                    frameCount:frameCount
+                                                  channelCount:channelCount
+                                                    sampleRate:sampleRate] autorelease];
+
+} // end -bufferWithSampleRate:channelCount:
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioBuffer
+
+// end Cuppa_AudioBuffer.m
@@ -0,0 +1,135 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioCues
+           - Plays short named sounds (cues) with little delay, decoding each one only once.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AUDIOCUES_H
+#define _CUPPA_AUDIOCUES_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioBuffer.h"
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioOutput.h"
+#import "Cuppa_Clock.h"
+
+// Constants
+
+enum
+{
+    CUPPA_AUDIOCUES_PRELOAD_SECONDS = 5 // longest cue decoded whole; longer ones are streamed
+};
+
+// Class Interface
+
+// Short cues are decoded and converted to the output's format when they are loaded, so playing
+// one only takes a free mixer voice; long ones are streamed through a small ring as they play.
+// Cues overlap freely, such as when several brews finish at once. The output is started for the
+// first cue and stopped again once nothing has played for a while.
+// Cues can also be scheduled for a time on the clock. Shortly before that time they are handed to
+// the mixer at the matching sample time, so they land on the exact frame however late the main
+// thread runs. While the output runs, clock times map to sample times through one anchor taken
+// when it started, so cues a second apart on the clock are exactly a second of samples apart.
+@interface Cuppa_AudioCues : NSObject
+{
+    id<Cuppa_AudioOutput> mOutput; // plays the mixer
+    Cuppa_AudioMixer *mMixer; // mixes the cues that are playing
+    NSMutableDictionary *mCues; // sounds (Cuppa_AudioBuffer) or files to stream (NSData), by name
+    Cuppa_Clock *mClock; // time source for scheduled cues
+    NSMutableData *mSchedule; // scheduled cues, in the order they were scheduled
+    NSTimeInterval mAnchorTime; // clock time at mAnchorSample
+    uint64_t mAnchorSample; // mixer sample time when the output was started
+    NSUInteger mNextVoiceTag; // mixer tag for the next scheduled cue handed over
+}
+
+// ------ Life Cycle ------
+
+// Initialize a cue player that plays through output, scheduling cues by clock.
+- (id)initWithOutput:(id<Cuppa_AudioOutput>)output clock:(Cuppa_Clock *)clock;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Load the AIFF or AIFF-C sound at path as a cue. Returns NO if the sound can't be read.
+- (BOOL)loadCue:(NSString *)name fromFile:(NSString *)path;
+
+// Add a sound already converted to the output's format (see -mixer) as a cue.
+- (void)addCue:(NSString *)name buffer:(Cuppa_AudioBuffer *)buffer;
+
+// Add the contents of an AIFF or AIFF-C file (best mapped) as a cue that is streamed as it plays.
+- (void)addCue:(NSString *)name streamData:(NSData *)data;
+
+// Forget a cue, along with any scheduled plays of it. Plays the mixer has started carry on.
+- (void)removeCue:(NSString *)name;
+
+// Start playing a cue, alongside any already playing. Returns NO if the cue isn't loaded or
+// can't be played.
+- (BOOL)playCue:(NSString *)name;
+
+// Schedule a cue to play at time on the clock, tagged with tag. Returns NO if the cue isn't
+// loaded.
+- (BOOL)scheduleCue:(NSString *)name atTime:(NSTimeInterval)time tag:(NSUInteger)tag;
+
+// Cancel the scheduled cues tagged with tag that have not started yet.
+- (void)cancelTag:(NSUInteger)tag;
+
+// Forget a scheduled cue once its time has come. Returns YES if it was handed to the mixer to play
+// on time, or NO if it was never scheduled or was dropped for being too late.
+- (BOOL)retireCue:(NSString *)name tag:(NSUInteger)tag;
+
+// Hand the scheduled cues that are nearly due to the mixer, and wait for the next ones.
+- (void)armDueCues;
+
+// Hand all scheduled cues to the mixer again, after the output has been interrupted (such as by
+// system sleep). Cues that are now well past their time are dropped.
+- (void)resynchronize;
+
+// Stop playing all cues.
+- (void)stopAll;
+
+// Stop the output if no cues are playing, or check again later if some are.
+- (void)stopIfIdle;
+
+// Run a cue player whose output is a recorder forward to time on its virtual clock, handing over
+// scheduled cues and recording as it goes, so a timeline of cues can be rendered offline.
+// Returns the number of frames recorded.
+- (NSUInteger)runUntil:(NSTimeInterval)time;
+
+// ------ Accessors ------
+
+// Returns the decoded sound for a cue, or nil if it isn't loaded or is streamed.
+- (Cuppa_AudioBuffer *)bufferForCue:(NSString *)name;
+
+// Returns the mixer.
+- (Cuppa_AudioMixer *)mixer;
+
+// Returns the output.
+- (id<Cuppa_AudioOutput>)output;
+
+// Returns the number of scheduled cues not yet retired or cancelled.
+- (NSUInteger)scheduledCount;
+
+@end // @interface Cuppa_AudioCues
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AUDIOCUES_H
+
+// end Cuppa_AudioCues.h
@@ -0,0 +1,592 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioCues
+           - Plays short named sounds (cues) with little delay, decoding each one only once.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AIFFDecoder.h"
+#import "Cuppa_AudioBuffer.h"
+#import "Cuppa_AudioCues.h"
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioRecorder.h"
+#import "Cuppa_AudioStream.h"
+#import "Cuppa_Clock.h"
+
+// Internal Constants
+
+// Keep the output running this long after the last cue, so the countdown beeps don't restart it
+static const NSTimeInterval sIdleDelay = 2.0;
+
+// Output channels (the mixer always renders stereo)
+static const NSUInteger sChannelCount = 2;
+
+// Hand scheduled cues to the mixer this long before they are due, which is plenty of time for a
+// late main thread and still short enough for the output not to run long before the cue
+static const NSTimeInterval sScheduleAhead = 2.0;
+
+// Drop a scheduled cue that can't be handed to the mixer until this long after its time
+static const NSTimeInterval sLateLimit = 0.5;
+
+// Forget a scheduled cue that has not been retired this long after its time
+static const NSTimeInterval sRetainTime = 10.0;
+
+// Longest step when rendering offline, about the size of a render by the audio device
+static const NSTimeInterval sRenderStep = 0.01;
+
+// Code!
+
+// A cue scheduled for a time on the clock
+typedef struct
+{
+    id source; // sound or file to stream (held by mCues)
+    NSTimeInterval time; // clock time the cue plays at
+    NSUInteger tag; // caller's tag
+    NSUInteger voiceTag; // mixer's tag for the cue, once handed over
+    bool armed; // flag: handed to the mixer?
+} CuppaScheduledCue;
+
+@implementation Cuppa_AudioCues
+;
+
+// *************************************************************************************************
+
+// Initialize a cue player that plays through output, scheduling cues by clock.
+- (id)initWithOutput:(id<Cuppa_AudioOutput>)output clock:(Cuppa_Clock *)clock
+{
+    // parameter checks
+    NSAssert(output != nil, @"Bad output parameter.\n");
+    NSAssert(clock != nil, @"Bad clock parameter.\n");
+
+    self = [super init];
+    mOutput = [output retain];
+    mMixer = [[Cuppa_AudioMixer alloc] initWithSampleRate:[output sampleRate]
+                                             channelCount:sChannelCount];
+    mCues = [[NSMutableDictionary alloc] init];
+    mClock = [clock retain];
+    mSchedule = [[NSMutableData alloc] init];
+    mAnchorTime = 0.0;
+    mAnchorSample = 0;
+    mNextVoiceTag = 1; // (cues played straight away have tag 0)
+
+    return self;
+
+} // end -initWithOutput:clock:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // stop playing before letting go of the mixer
+    [mOutput stop];
+    [mOutput release];
+    [mMixer release];
+    [mCues release];
+    [mClock release];
+    [mSchedule release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Load the AIFF or AIFF-C sound at path as a cue. Returns NO if the sound can't be read.
+- (BOOL)loadCue:(NSString *)name fromFile:(NSString *)path
+{
+    NSData *data; // the file, mapped
+    Cuppa_AIFFDecoder *decoder; // checks the sound
+    Cuppa_AudioBuffer *buffer; // decoded sound
+
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+
+    if (!path)
+        return NO;
+    data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:NULL];
+    decoder = data ? [[[Cuppa_AIFFDecoder alloc] initWithData:data] autorelease] : nil;
+    if (!decoder)
+        return NO;
+
+    // a long sound is kept as its (mapped) file, to be streamed, so it only ever takes a ring's
+    // worth of memory
+    if ((double)[decoder frameCount] / [decoder sampleRate] > CUPPA_AUDIOCUES_PRELOAD_SECONDS)
+    {
+        [mCues setObject:data forKey:name];
+        return YES;
+    }
+
+    // otherwise convert it to the output format now, so it plays as is
+    buffer = [Cuppa_AIFFDecoder bufferWithData:data];
+    buffer = [buffer bufferWithSampleRate:[mMixer sampleRate] channelCount:sChannelCount];
+    if (!buffer)
+        return NO;
+
+    // record new info
+    [mCues setObject:buffer forKey:name];
+
+    return YES;
+
+} // end -loadCue:fromFile:
+
+// *************************************************************************************************
+
+// Add a sound already converted to the output's format (see -mixer) as a cue.
+- (void)addCue:(NSString *)name buffer:(Cuppa_AudioBuffer *)buffer
+{
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+    NSAssert(buffer != nil, @"Bad buffer parameter.\n");
+    NSAssert([buffer sampleRate] == [mMixer sampleRate] && [buffer channelCount] == sChannelCount,
+             @"Bad buffer parameter.\n");
+
+    // record new info
+    [mCues setObject:buffer forKey:name];
+
+} // end -addCue:buffer:
+
+// *************************************************************************************************
+
+// Add the contents of an AIFF or AIFF-C file (best mapped) as a cue that is streamed as it plays.
+- (void)addCue:(NSString *)name streamData:(NSData *)data
+{
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+    NSAssert(data != nil, @"Bad data parameter.\n");
+
+    // record new info
+    [mCues setObject:data forKey:name];
+
+} // end -addCue:streamData:
+
+// *************************************************************************************************
+
+// Forget a cue, along with any scheduled plays of it. Plays the mixer has started carry on.
+- (void)removeCue:(NSString *)name
+{
+    id source; // sound or file of the cue
+    CuppaScheduledCue *cues; // scheduled cues
+    NSUInteger count; // number of scheduled cues
+    NSUInteger i; // loop counter
+
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+
+    source = [mCues objectForKey:name];
+    if (!source)
+        return;
+
+    // scheduled plays only hold the source through mCues, so they go first (taking back any the
+    // mixer has not started)
+    cues = [mSchedule mutableBytes];
+    count = [mSchedule length] / sizeof(CuppaScheduledCue);
+    for (i = count; i > 0; i--)
+    {
+        if (cues[i - 1].source == source)
+        {
+            if (cues[i - 1].armed)
+                [mMixer cancelVoiceTag:cues[i - 1].voiceTag];
+            [mSchedule replaceBytesInRange:NSMakeRange((i - 1) * sizeof(CuppaScheduledCue),
+                                                       sizeof(CuppaScheduledCue))
+                                 withBytes:NULL
+                                    length:0];
+        }
+    }
+
+    // record new info
+    [mCues removeObjectForKey:name];
+
+} // end -removeCue:
+
+// *************************************************************************************************
+
+// Start the output if it is not running, anchoring clock times to the mixer's sample time.
+// Returns NO if the output could not be started.
+- (BOOL)startOutput
+{
+    if ([mOutput isRunning])
+        return YES;
+    if (![mOutput startWithMixer:mMixer])
+        return NO;
+
+    // record new info
+    mAnchorTime = [mClock now];
+    mAnchorSample = [mMixer sampleTime];
+
+    return YES;
+
+} // end -startOutput
+
+// *************************************************************************************************
+
+// Hand a cue's source (a sound, or a file to stream) to the mixer to play from sampleTime,
+// starting the output if it has been idle. Returns NO if it can't be played.
+- (BOOL)playSource:(id)source atSampleTime:(uint64_t)sampleTime tag:(NSUInteger)tag
+{
+    Cuppa_AudioStream *stream; // stream of a file
+
+    if (![self startOutput])
+        return NO;
+    if ([source isKindOfClass:[Cuppa_AudioBuffer class]])
+        return [mMixer playBuffer:source atSampleTime:sampleTime tag:tag];
+
+    // a stream is filled before it is handed over, so it is ready to play
+    stream = [[[Cuppa_AudioStream alloc] initWithData:source
+                                           sampleRate:[mMixer sampleRate]
+                                         channelCount:sChannelCount] autorelease];
+    if (!stream)
+        return NO;
+    [stream start];
+
+    return [mMixer playStream:stream atSampleTime:sampleTime tag:tag];
+
+} // end -playSource:atSampleTime:tag:
+
+// *************************************************************************************************
+
+// Start playing a cue, alongside any already playing. Returns NO if the cue isn't loaded or
+// can't be played.
+- (BOOL)playCue:(NSString *)name
+{
+    id source; // sound or file to play
+
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+
+    source = [mCues objectForKey:name];
+    if (!source || ![self playSource:source atSampleTime:0 tag:0])
+        return NO;
+
+    // check for idle once this cue is over (and again until nothing is playing)
+    [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                             selector:@selector(stopIfIdle)
+                                               object:nil];
+    [self performSelector:@selector(stopIfIdle)
+               withObject:nil
+               afterDelay:sIdleDelay
+                  inModes:@[ NSRunLoopCommonModes ]];
+
+    return YES;
+
+} // end -playCue:
+
+// *************************************************************************************************
+
+// Schedule a cue to play at time on the clock, tagged with tag. Returns NO if the cue isn't
+// loaded.
+- (BOOL)scheduleCue:(NSString *)name atTime:(NSTimeInterval)time tag:(NSUInteger)tag
+{
+    CuppaScheduledCue cue; // the new cue
+
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+
+    cue.source = [mCues objectForKey:name];
+    if (!cue.source)
+        return NO;
+    cue.time = time;
+    cue.tag = tag;
+    cue.voiceTag = 0;
+    cue.armed = false;
+
+    // record new info
+    [mSchedule appendBytes:&cue length:sizeof(cue)];
+
+    // it may already be nearly due
+    [self armDueCues];
+
+    return YES;
+
+} // end -scheduleCue:atTime:tag:
+
+// *************************************************************************************************
+
+// Cancel the scheduled cues tagged with tag that have not started yet.
+- (void)cancelTag:(NSUInteger)tag
+{
+    CuppaScheduledCue *cues; // scheduled cues
+    NSUInteger count; // number of scheduled cues
+    NSUInteger i; // loop counter
+
+    // forget them, and take back any the mixer has not started
+    cues = [mSchedule mutableBytes];
+    count = [mSchedule length] / sizeof(CuppaScheduledCue);
+    for (i = count; i > 0; i--)
+    {
+        if (cues[i - 1].tag == tag)
+        {
+            if (cues[i - 1].armed)
+                [mMixer cancelVoiceTag:cues[i - 1].voiceTag];
+            [mSchedule replaceBytesInRange:NSMakeRange((i - 1) * sizeof(CuppaScheduledCue),
+                                                       sizeof(CuppaScheduledCue))
+                                 withBytes:NULL
+                                    length:0];
+        }
+    }
+
+} // end -cancelTag:
+
+// *************************************************************************************************
+
+// Forget a scheduled cue once its time has come. Returns YES if it was handed to the mixer to play
+// on time, or NO if it was never scheduled or was dropped for being too late.
+- (BOOL)retireCue:(NSString *)name tag:(NSUInteger)tag
+{
+    id source; // sound or file of the cue
+    CuppaScheduledCue *cues; // scheduled cues
+    NSUInteger count; // number of scheduled cues
+    NSUInteger i; // loop counter
+    bool armed; // flag: cue was handed to the mixer?
+
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+
+    // cues that are due now are handed over before we look
+    [self armDueCues];
+
+    source = [mCues objectForKey:name];
+    cues = [mSchedule mutableBytes];
+    count = [mSchedule length] / sizeof(CuppaScheduledCue);
+    for (i = 0; i < count; i++)
+    {
+        if (cues[i].source == source && cues[i].tag == tag)
+        {
+            armed = cues[i].armed;
+            [mSchedule replaceBytesInRange:NSMakeRange(i * sizeof(CuppaScheduledCue),
+                                                       sizeof(CuppaScheduledCue))
+                                 withBytes:NULL
+                                    length:0];
+            return armed;
+        }
+    }
+
+    return NO;
+
+} // end -retireCue:tag:
+
+// *************************************************************************************************
+
+// Hand the scheduled cues that are nearly due to the mixer, and wait for the next ones.
+- (void)armDueCues
+{
+    NSTimeInterval now; // current time
+    NSTimeInterval next; // time of the next cue still to hand over
+    CuppaScheduledCue *cues; // scheduled cues
+    NSUInteger count; // number of scheduled cues
+    NSUInteger i; // loop counter
+    uint64_t sampleTime; // sample time a cue plays at
+    double offset; // frames from the anchor to a cue
+
+    [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                             selector:@selector(armDueCues)
+                                               object:nil];
+
+    now = [mClock now];
+    next = INFINITY;
+    count = [mSchedule length] / sizeof(CuppaScheduledCue);
+    for (i = count; i > 0; i--)
+    {
+        cues = [mSchedule mutableBytes];
+
+        // cues that are too late to play, or long over, are dropped
+        if ((!cues[i - 1].armed && cues[i - 1].time < now - sLateLimit) ||
+            cues[i - 1].time < now - sRetainTime)
+        {
+            [mSchedule replaceBytesInRange:NSMakeRange((i - 1) * sizeof(CuppaScheduledCue),
+                                                       sizeof(CuppaScheduledCue))
+                                 withBytes:NULL
+                                    length:0];
+            continue;
+        }
+        if (cues[i - 1].armed)
+            continue;
+        if (cues[i - 1].time > now + sScheduleAhead)
+        {
+            next = MIN(next, cues[i - 1].time);
+            continue;
+        }
+
+        // a cue a second from the anchor is a second of samples from it
+        if (![self startOutput])
+            break;
+        offset = round((cues[i - 1].time - mAnchorTime) * [mMixer sampleRate]);
+        sampleTime = (offset > 0.0) ? mAnchorSample + (uint64_t)offset : 0;
+        if (![self playSource:cues[i - 1].source atSampleTime:sampleTime tag:mNextVoiceTag])
+            continue;
+        cues[i - 1].voiceTag = mNextVoiceTag++;
+        cues[i - 1].armed = true;
+
+        // check for idle once the cue is over
+        [NSObject cancelPreviousPerformRequestsWithTarget:self
+                                                 selector:@selector(stopIfIdle)
+                                                   object:nil];
+        [self performSelector:@selector(stopIfIdle)
+                   withObject:nil
+                   afterDelay:(cues[i - 1].time - now) + sIdleDelay
+                      inModes:@[ NSRunLoopCommonModes ]];
+    }
+
+    // wake again in time to hand over the next cue (even while a menu is open)
+    if (!isinf(next))
+    {
+        [self performSelector:@selector(armDueCues)
+                   withObject:nil
+                   afterDelay:MAX(next - sScheduleAhead - now, 0.0)
+                      inModes:@[ NSRunLoopCommonModes ]];
+    }
+
+} // end -armDueCues
+
+// *************************************************************************************************
+
+// Hand all scheduled cues to the mixer again, after the output has been interrupted (such as by
+// system sleep). Cues that are now well past their time are dropped.
+- (void)resynchronize
+{
+    CuppaScheduledCue *cues; // scheduled cues
+    NSUInteger count; // number of scheduled cues
+    NSUInteger i; // loop counter
+
+    // take back every cue the mixer has not started; the ones it has started have played
+    cues = [mSchedule mutableBytes];
+    count = [mSchedule length] / sizeof(CuppaScheduledCue);
+    for (i = 0; i < count; i++)
+    {
+        if (cues[i].armed && [mMixer cancelVoiceTag:cues[i].voiceTag])
+            cues[i].armed = false;
+    }
+
+    // restart the output, so it gets a fresh anchor
+    [mOutput stop];
+    [self armDueCues];
+
+} // end -resynchronize
+
+// *************************************************************************************************
+
+// Stop playing all cues.
+- (void)stopAll
+{
+    [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    [mSchedule setLength:0];
+    [mOutput stop];
+    [mMixer stopAll];
+
+} // end -stopAll
+
+// *************************************************************************************************
+
+// Stop the output if no cues are playing, or check again later if some are.
+- (void)stopIfIdle
+{
+    [mMixer reap];
+    if ([mMixer activeVoiceCount] > 0)
+    {
+        [self performSelector:@selector(stopIfIdle)
+                   withObject:nil
+                   afterDelay:sIdleDelay
+                      inModes:@[ NSRunLoopCommonModes ]];
+        return;
+    }
+
+    [mOutput stop];
+
+} // end -stopIfIdle
+
+// *************************************************************************************************
+
+// Run a cue player whose output is a recorder forward to time on its virtual clock, handing over
+// scheduled cues and recording as it goes, so a timeline of cues can be rendered offline.
+// Returns the number of frames recorded.
+- (NSUInteger)runUntil:(NSTimeInterval)time
+{
+    Cuppa_AudioRecorder *recorder; // output that records the mixer
+    NSUInteger count; // frames in the current step
+    NSUInteger frameCount; // frames recorded
+
+    // parameter checks
+    NSAssert([mClock policy] == CUPPA_CLOCK_VIRTUAL, @"Clock is not virtual.\n");
+    NSAssert([(id)mOutput isKindOfClass:[Cuppa_AudioRecorder class]],
+             @"Output is not a recorder.\n");
+
+    // step the clock by whole frames, so it keeps exactly in step with the samples
+    recorder = (Cuppa_AudioRecorder *)mOutput;
+    frameCount = 0;
+    while ([mClock now] < time)
+    {
+        [self armDueCues];
+
+        // offline, the mixer gets through a stream far faster than it fills itself
+        [mMixer topUpStreams];
+        count = (NSUInteger)ceil(MIN(time - [mClock now], sRenderStep) * [mMixer sampleRate]);
+        count = MAX(count, (NSUInteger)1);
+        frameCount += [recorder renderFrames:count];
+        [mClock advanceBy:(count / [mMixer sampleRate])];
+    }
+
+    return frameCount;
+
+} // end -runUntil:
+
+// *************************************************************************************************
+
+// Returns the decoded sound for a cue, or nil if it isn't loaded or is streamed.
+- (Cuppa_AudioBuffer *)bufferForCue:(NSString *)name
+{
+    id source; // sound or file of the cue
+
+    source = [mCues objectForKey:name];
+    if (![source isKindOfClass:[Cuppa_AudioBuffer class]])
+        return nil;
+
+    // return requested info
+    return source;
+
+} // end -bufferForCue:
+
+// *************************************************************************************************
+
+// Returns the mixer.
+- (Cuppa_AudioMixer *)mixer
+{
+    // return requested info
+    return mMixer;
+
+} // end -mixer
+
+// *************************************************************************************************
+
+// Returns the output.
+- (id<Cuppa_AudioOutput>)output
+{
+    // return requested info
+    return mOutput;
+
+} // end -output
+
+// *************************************************************************************************
+
+// Returns the number of scheduled cues not yet retired or cancelled.
+- (NSUInteger)scheduledCount
+{
+    // return requested info
+    return [mSchedule length] / sizeof(CuppaScheduledCue);
+
+} // end -scheduledCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioCues
+
+// end Cuppa_AudioCues.m
@@ -0,0 +1,159 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioMixer
+           - Mixes any number of overlapping sounds (up to a fixed limit) into one output stream.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AUDIOMIXER_H
+#define _CUPPA_AUDIOMIXER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#include <stdatomic.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioBuffer.h"
+#import "Cuppa_AudioRing.h"
+#import "Cuppa_AudioStream.h"
+
+// Constants
+
+enum
+{
+    CUPPA_AUDIOMIXER_VOICES = 32 // most sounds that can be playing or waiting to play at once
+};
+
+// The states a voice goes through, each owned by one thread
+enum
+{
+    CUPPA_AUDIOMIXER_VOICE_FREE = 0, // not in use (main thread)
+    CUPPA_AUDIOMIXER_VOICE_WAITING, // handed over, none of it mixed yet (either thread may claim)
+    CUPPA_AUDIOMIXER_VOICE_PLAYING, // being mixed (audio thread)
+    CUPPA_AUDIOMIXER_VOICE_DONE // finished, cancelled or stopped, waiting to be freed (main thread)
+};
+
+// Types
+
+// A voice, as the audio thread sees it
+typedef struct
+{
+    atomic_int state; // CUPPA_AUDIOMIXER_VOICE_ state
+    atomic_bool stop; // flag: the main thread wants a playing voice stopped?
+    const float *samples; // samples of the voice's sound, or NULL for a stream
+    size_t frameCount; // frames in the voice's sound
+    CuppaAudioRingState *ring; // ring of the voice's stream, or NULL for a sound
+    size_t position; // next frame to mix
+    uint64_t start; // sample time the voice starts at
+} CuppaAudioMixerVoice;
+
+// Everything the audio thread renders from, so it needs no message sends
+typedef struct
+{
+    size_t channelCount; // output channels
+    atomic_uint_least64_t sampleTime; // frames rendered so far
+    CuppaAudioMixerVoice voices[CUPPA_AUDIOMIXER_VOICES]; // the voices
+} CuppaAudioMixerState;
+
+// Mix the next count frames of all playing sounds in mixer into samples (interleaved). This is
+// what the audio thread calls: it takes no locks, allocates nothing and sends no messages.
+void CuppaAudioMixerRender(CuppaAudioMixerState *mixer, size_t count, float *samples);
+
+// Class Interface
+
+// Sounds are started and reaped on the main thread, and rendered on the audio thread, with no lock
+// between them: each voice is handed from one thread to the other by atomically changing its
+// state. The main thread fills a free voice in before marking it waiting; the audio thread claims
+// a waiting voice when it is due, and marks it done once it has played to the end. A waiting voice
+// can be cancelled by claiming it first; a playing one is asked to stop, and the audio thread
+// marks it done on its next render. Only then does the main thread let go of its sound.
+// A sound can be started at a given sample time, so its first frame lands on that exact frame
+// however late the main thread gets to it.
+@interface Cuppa_AudioMixer : NSObject
+{
+    double mSampleRate; // output frames per second
+    NSUInteger mChannelCount; // output channels
+    CuppaAudioMixerState mState; // voices, as rendered
+    id mVoiceSources[CUPPA_AUDIOMIXER_VOICES]; // sound or stream of each voice, or nil if free
+    NSUInteger mVoiceTags[CUPPA_AUDIOMIXER_VOICES]; // caller's tag for each voice
+}
+
+// ------ Life Cycle ------
+
+// Initialize a mixer producing interleaved output at sampleRate with channelCount channels.
+- (id)initWithSampleRate:(double)sampleRate channelCount:(NSUInteger)channelCount;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Start playing a sound, which must already be at the mixer's sample rate and channel count.
+// Returns NO if all voices are busy.
+- (BOOL)playBuffer:(Cuppa_AudioBuffer *)buffer;
+
+// Play a sound from sampleTime (or straight away, if that has passed), tagged with tag so it can
+// be cancelled (see -cancelVoiceTag:). Returns NO if all voices are busy.
+- (BOOL)playBuffer:(Cuppa_AudioBuffer *)buffer
+      atSampleTime:(uint64_t)sampleTime
+               tag:(NSUInteger)tag;
+
+// Play a stream (already started) from sampleTime, or straight away if that has passed, tagged
+// with tag. The stream must already be at the mixer's sample rate and channel count. Returns NO
+// if all voices are busy.
+- (BOOL)playStream:(Cuppa_AudioStream *)stream
+      atSampleTime:(uint64_t)sampleTime
+               tag:(NSUInteger)tag;
+
+// Cancel the sounds tagged with tag that have not started yet. Returns YES if any were cancelled.
+- (BOOL)cancelVoiceTag:(NSUInteger)tag;
+
+// Stop playing all sounds.
+- (void)stopAll;
+
+// Let go of the sounds that have finished playing.
+- (void)reap;
+
+// Top up the rings of the streams playing or waiting to play, for rendering offline faster than
+// the streams fill themselves.
+- (void)topUpStreams;
+
+// Mix the next count frames of all playing sounds into samples (interleaved), as
+// CuppaAudioMixerRender() does (for rendering offline).
+- (void)renderFrames:(NSUInteger)count into:(float *)samples;
+
+// ------ Accessors ------
+
+// Returns the state the audio thread renders from, to pass to CuppaAudioMixerRender().
+- (CuppaAudioMixerState *)state;
+
+// Returns the number of sounds still playing or waiting to start.
+- (NSUInteger)activeVoiceCount;
+
+// Returns the number of frames rendered so far.
+- (uint64_t)sampleTime;
+
+// Returns the output frames per second.
+- (double)sampleRate;
+
+// Returns the number of output channels.
+- (NSUInteger)channelCount;
+
+@end // @interface Cuppa_AudioMixer
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AUDIOMIXER_H
+
+// end Cuppa_AudioMixer.h
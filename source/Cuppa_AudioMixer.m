@@ -0,0 +1,435 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioMixer
+           - Mixes any number of overlapping sounds (up to a fixed limit) into one output stream.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#include <stdatomic.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioBuffer.h"
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioRing.h"
+#import "Cuppa_AudioStream.h"
+
+// Code!
+
+// *************************************************************************************************
+
+// Mix the next count frames of all playing sounds in mixer into samples (interleaved). This is
+// what the audio thread calls: it takes no locks, allocates nothing and sends no messages.
+void CuppaAudioMixerRender(CuppaAudioMixerState *mixer, size_t count, float *samples)
+{
+    uint64_t sampleTime; // sample time of the first frame of this render
+    size_t sampleCount; // number of output samples
+    size_t frames; // frames to mix from the current voice
+    size_t offset; // frame of this render the current voice starts at
+    CuppaAudioMixerVoice *voice; // current voice
+    int state; // state of the current voice
+    const float *in; // current voice's next sample
+    float *out; // where the current voice's next sample is mixed
+    size_t i, j; // loop counters
+
+    // only this thread moves the sample time on
+    sampleTime = atomic_load_explicit(&mixer->sampleTime, memory_order_relaxed);
+    sampleCount = count * mixer->channelCount;
+    memset(samples, 0, sampleCount * sizeof(float));
+
+    // sum the voices that are playing, or are due to start
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        voice = &mixer->voices[i];
+        state = atomic_load_explicit(&voice->state, memory_order_acquire);
+        offset = 0;
+        if (state == CUPPA_AUDIOMIXER_VOICE_WAITING)
+        {
+            if (voice->start >= sampleTime + count)
+                continue;
+
+            // claim the voice, unless the main thread has just cancelled it
+            if (!atomic_compare_exchange_strong_explicit(&voice->state, &state,
+                                                         CUPPA_AUDIOMIXER_VOICE_PLAYING,
+                                                         memory_order_acq_rel,
+                                                         memory_order_acquire))
+                continue;
+
+            // a voice starting part way through this render is mixed in from its start frame
+            if (voice->start > sampleTime)
+                offset = (size_t)(voice->start - sampleTime);
+        }
+        else if (state != CUPPA_AUDIOMIXER_VOICE_PLAYING)
+        {
+            continue;
+        }
+        else if (atomic_load_explicit(&voice->stop, memory_order_acquire))
+        {
+            // the main thread may let go of the sound now we are done with it
+            atomic_store_explicit(&voice->state, CUPPA_AUDIOMIXER_VOICE_DONE,
+                                  memory_order_release);
+            continue;
+        }
+        out = samples + (offset * mixer->channelCount);
+
+        // a stream plays until its ring has drained (if the ring runs dry, it picks up again
+        // where it left off)
+        if (voice->ring)
+        {
+            voice->position += CuppaAudioRingMix(voice->ring, count - offset, out);
+            if (CuppaAudioRingIsDrained(voice->ring))
+                atomic_store_explicit(&voice->state, CUPPA_AUDIOMIXER_VOICE_DONE,
+                                      memory_order_release);
+            continue;
+        }
+
+        frames = MIN(count - offset, voice->frameCount - voice->position);
+        in = voice->samples + (voice->position * mixer->channelCount);
+        for (j = 0; j < frames * mixer->channelCount; j++)
+        {
+            out[j] += in[j];
+        }
+        voice->position += frames;
+        if (voice->position >= voice->frameCount)
+            atomic_store_explicit(&voice->state, CUPPA_AUDIOMIXER_VOICE_DONE,
+                                  memory_order_release);
+    }
+    atomic_store_explicit(&mixer->sampleTime, sampleTime + count, memory_order_release);
+
+    // overlapping sounds can go out of range
+    for (j = 0; j < sampleCount; j++)
+    {
+        if (samples[j] > 1.0f)
+            samples[j] = 1.0f;
+        else if (samples[j] < -1.0f)
+            samples[j] = -1.0f;
+    }
+
+} // end CuppaAudioMixerRender()
+
+// *************************************************************************************************
+
+@implementation Cuppa_AudioMixer
+;
+
+// *************************************************************************************************
+
+// Initialize a mixer producing interleaved output at sampleRate with channelCount channels.
+- (id)initWithSampleRate:(double)sampleRate channelCount:(NSUInteger)channelCount
+{
+    int i; // loop counter
+
+    // parameter checks
+    NSAssert(sampleRate > 0.0, @"Bad sampleRate parameter.\n");
+    NSAssert(channelCount > 0, @"Bad channelCount parameter.\n");
+
+    self = [super init];
+    mSampleRate = sampleRate;
+    mChannelCount = channelCount;
+    mState.channelCount = channelCount;
+    atomic_init(&mState.sampleTime, 0);
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        atomic_init(&mState.voices[i].state, CUPPA_AUDIOMIXER_VOICE_FREE);
+        atomic_init(&mState.voices[i].stop, false);
+    }
+
+    return self;
+
+} // end -initWithSampleRate:channelCount:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    int i; // loop counter
+
+    // release the voices' sounds (nothing renders from a mixer that is going away)
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        [mVoiceSources[i] release];
+    }
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Start playing a sound, which must already be at the mixer's sample rate and channel count.
+// Returns NO if all voices are busy.
+- (BOOL)playBuffer:(Cuppa_AudioBuffer *)buffer
+{
+    // a start time of 0 has always passed
+    return [self playBuffer:buffer atSampleTime:0 tag:0];
+
+} // end -playBuffer:
+
+// *************************************************************************************************
+
+// Start a voice playing source, which is either samples (of frameCount frames) or ring, from
+// sampleTime. Returns NO if all voices are busy.
+- (BOOL)playSource:(id)source
+           samples:(const float *)samples
+        frameCount:(NSUInteger)frameCount
+              ring:(CuppaAudioRingState *)ring
+      atSampleTime:(uint64_t)sampleTime
+               tag:(NSUInteger)tag
+{
+    CuppaAudioMixerVoice *voice; // the voice taken
+    int i; // loop counter
+
+    // finished voices can be reused
+    [self reap];
+
+    // take the first free voice
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        if (mVoiceSources[i] == nil)
+            break;
+    }
+    if (i == CUPPA_AUDIOMIXER_VOICES)
+        return NO;
+
+    // a free voice is ours alone, so it is filled in before the audio thread is told about it
+    mVoiceSources[i] = [source retain];
+    mVoiceTags[i] = tag;
+    voice = &mState.voices[i];
+    voice->samples = samples;
+    voice->frameCount = frameCount;
+    voice->ring = ring;
+    voice->position = 0;
+    voice->start = sampleTime;
+    atomic_store_explicit(&voice->stop, false, memory_order_relaxed);
+    atomic_store_explicit(&voice->state, CUPPA_AUDIOMIXER_VOICE_WAITING, memory_order_release);
+
+    return YES;
+
+} // end -playSource:samples:frameCount:ring:atSampleTime:tag:
+
+// *************************************************************************************************
+
+// Play a sound from sampleTime (or straight away, if that has passed), tagged with tag so it can
+// be cancelled (see -cancelVoiceTag:). Returns NO if all voices are busy.
+- (BOOL)playBuffer:(Cuppa_AudioBuffer *)buffer
+      atSampleTime:(uint64_t)sampleTime
+               tag:(NSUInteger)tag
+{
+    // parameter checks
+    NSAssert(buffer != nil, @"Bad buffer parameter.\n");
+    NSAssert([buffer channelCount] == mChannelCount && [buffer sampleRate] == mSampleRate,
+             @"Bad buffer parameter.\n");
+
+    return [self playSource:buffer
+                    samples:[buffer samples]
+                 frameCount:[buffer frameCount]
+                       ring:NULL
+               atSampleTime:sampleTime
+                        tag:tag];
+
+} // end -playBuffer:atSampleTime:tag:
+
+// *************************************************************************************************
+
+// Play a stream (already started) from sampleTime, or straight away if that has passed, tagged
+// with tag. The stream must already be at the mixer's sample rate and channel count. Returns NO
+// if all voices are busy.
+- (BOOL)playStream:(Cuppa_AudioStream *)stream
+      atSampleTime:(uint64_t)sampleTime
+               tag:(NSUInteger)tag
+{
+    // parameter checks
+    NSAssert(stream != nil, @"Bad stream parameter.\n");
+    NSAssert([[stream ring] channelCount] == mChannelCount, @"Bad stream parameter.\n");
+
+    return [self playSource:stream
+                    samples:NULL
+                 frameCount:0
+                       ring:[[stream ring] state]
+               atSampleTime:sampleTime
+                        tag:tag];
+
+} // end -playStream:atSampleTime:tag:
+
+// *************************************************************************************************
+
+// Cancel the sounds tagged with tag that have not started yet. Returns YES if any were cancelled.
+- (BOOL)cancelVoiceTag:(NSUInteger)tag
+{
+    BOOL cancelled; // flag: a voice was cancelled?
+    int state; // state a voice is expected to be in
+    int i; // loop counter
+
+    // a voice has started once the audio thread has claimed it, so only waiting ones can go
+    cancelled = NO;
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        state = CUPPA_AUDIOMIXER_VOICE_WAITING;
+        if (mVoiceSources[i] != nil && mVoiceTags[i] == tag &&
+            atomic_compare_exchange_strong_explicit(&mState.voices[i].state, &state,
+                                                    CUPPA_AUDIOMIXER_VOICE_DONE,
+                                                    memory_order_acq_rel,
+                                                    memory_order_acquire))
+            cancelled = YES;
+    }
+    [self reap];
+
+    return cancelled;
+
+} // end -cancelVoiceTag:
+
+// *************************************************************************************************
+
+// Stop playing all sounds.
+- (void)stopAll
+{
+    int state; // state a voice is expected to be in
+    int i; // loop counter
+
+    // waiting voices are simply taken back; playing ones are stopped by the audio thread, which
+    // may be mixing them right now
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        state = CUPPA_AUDIOMIXER_VOICE_WAITING;
+        if (mVoiceSources[i] != nil &&
+            !atomic_compare_exchange_strong_explicit(&mState.voices[i].state, &state,
+                                                     CUPPA_AUDIOMIXER_VOICE_DONE,
+                                                     memory_order_acq_rel,
+                                                     memory_order_acquire) &&
+            state == CUPPA_AUDIOMIXER_VOICE_PLAYING)
+            atomic_store_explicit(&mState.voices[i].stop, true, memory_order_release);
+    }
+    [self reap];
+
+} // end -stopAll
+
+// *************************************************************************************************
+
+// Let go of the sounds that have finished playing.
+- (void)reap
+{
+    int i; // loop counter
+
+    // the audio thread is done with a voice once it is marked done
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        if (mVoiceSources[i] != nil &&
+            atomic_load_explicit(&mState.voices[i].state, memory_order_acquire) ==
+                CUPPA_AUDIOMIXER_VOICE_DONE)
+        {
+            [mVoiceSources[i] release];
+            mVoiceSources[i] = nil;
+            atomic_store_explicit(&mState.voices[i].state, CUPPA_AUDIOMIXER_VOICE_FREE,
+                                  memory_order_relaxed);
+        }
+    }
+
+} // end -reap
+
+// *************************************************************************************************
+
+// Top up the rings of the streams playing or waiting to play, for rendering offline faster than
+// the streams fill themselves.
+- (void)topUpStreams
+{
+    int i; // loop counter
+
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        if ([mVoiceSources[i] isKindOfClass:[Cuppa_AudioStream class]])
+            [(Cuppa_AudioStream *)mVoiceSources[i] topUp];
+    }
+
+} // end -topUpStreams
+
+// *************************************************************************************************
+
+// Mix the next count frames of all playing sounds into samples (interleaved), as
+// CuppaAudioMixerRender() does (for rendering offline).
+- (void)renderFrames:(NSUInteger)count into:(float *)samples
+{
+    // parameter checks
+    NSAssert(samples != NULL || count == 0, @"Bad samples parameter.\n");
+
+    CuppaAudioMixerRender(&mState, count, samples);
+
+} // end -renderFrames:into:
+
+// *************************************************************************************************
+
+// Returns the state the audio thread renders from, to pass to CuppaAudioMixerRender().
+- (CuppaAudioMixerState *)state
+{
+    // return requested info
+    return &mState;
+
+} // end -state
+
+// *************************************************************************************************
+
+// Returns the number of sounds still playing or waiting to start.
+- (NSUInteger)activeVoiceCount
+{
+    NSUInteger count; // number of voices playing
+    int state; // state of a voice
+    int i; // loop counter
+
+    // (a voice that has been asked to stop no longer counts)
+    count = 0;
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        state = atomic_load_explicit(&mState.voices[i].state, memory_order_acquire);
+        if (state == CUPPA_AUDIOMIXER_VOICE_WAITING ||
+            (state == CUPPA_AUDIOMIXER_VOICE_PLAYING &&
+             !atomic_load_explicit(&mState.voices[i].stop, memory_order_acquire)))
+            count++;
+    }
+
+    // return requested info
+    return count;
+
+} // end -activeVoiceCount
+
+// *************************************************************************************************
+
+// Returns the number of frames rendered so far.
+- (uint64_t)sampleTime
+{
+    // return requested info
+    return atomic_load_explicit(&mState.sampleTime, memory_order_acquire);
+
+} // end -sampleTime
+
+// *************************************************************************************************
+
+// Returns the output frames per second.
+- (double)sampleRate
+{
+    // return requested info
+    return mSampleRate;
+
+} // end -sampleRate
+
+// *************************************************************************************************
+
+// Returns the number of output channels.
+- (NSUInteger)channelCount
+{
+    // return requested info
+    return mChannelCount;
+
+} // end -channelCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioMixer
+
+// end Cuppa_AudioMixer.m
@@ -0,0 +1,55 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Protocol: Cuppa_AudioOutput
+           - The interface shared by the outputs that play what an audio mixer renders.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AUDIOOUTPUT_H
+#define _CUPPA_AUDIOOUTPUT_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioMixer.h"
+
+// Protocol Interface
+
+@protocol Cuppa_AudioOutput <NSObject>
+
+// ------ Manipulators ------
+
+// Start pulling interleaved stereo from mixer. Returns NO if the output could not be started.
+// Starting an output that is already running does nothing.
+- (BOOL)startWithMixer:(Cuppa_AudioMixer *)mixer;
+
+// Stop pulling from the mixer. The output stays open, so it can be started again quickly.
+- (void)stop;
+
+// ------ Accessors ------
+
+// Returns the frames per second the output plays at.
+- (double)sampleRate;
+
+// Returns YES if the output is running.
+- (BOOL)isRunning;
+
+@end // @protocol Cuppa_AudioOutput
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AUDIOOUTPUT_H
+
+// end Cuppa_AudioOutput.h
@@ -0,0 +1,85 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioRecorder
+           - Stands in for the audio device when sounds are simulated, recording what the mixer
+             renders instead of playing it.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AUDIORECORDER_H
+#define _CUPPA_AUDIORECORDER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioOutput.h"
+
+// Class Interface
+
+// Nothing is rendered until -renderFrames: is called, so time only moves when the caller says.
+@interface Cuppa_AudioRecorder : NSObject <Cuppa_AudioOutput>
+{
+    double mSampleRate; // frames per second to record at
+    Cuppa_AudioMixer *mMixer; // mixer being recorded, while running
+    NSMutableData *mSamples; // everything rendered so far (interleaved stereo floats)
+    NSUInteger mStartCount; // number of times the output has been started
+}
+
+// ------ Life Cycle ------
+
+// Initialize a recorder that records at sampleRate.
+- (id)initWithSampleRate:(double)sampleRate;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Start recording interleaved stereo from mixer. Starting a recorder that is already running
+// does nothing.
+- (BOOL)startWithMixer:(Cuppa_AudioMixer *)mixer;
+
+// Stop recording from the mixer.
+- (void)stop;
+
+// Render and record the next count frames from the mixer, if running. Returns the number of
+// frames recorded.
+- (NSUInteger)renderFrames:(NSUInteger)count;
+
+// ------ Accessors ------
+
+// Returns the frames per second the recorder records at.
+- (double)sampleRate;
+
+// Returns YES if the recorder is running.
+- (BOOL)isRunning;
+
+// Returns everything recorded so far (interleaved stereo floats).
+- (NSData *)samples;
+
+// Returns the number of frames recorded so far.
+- (NSUInteger)frameCount;
+
+// Returns the number of times the recorder has been started.
+- (NSUInteger)startCount;
+
+@end // @interface Cuppa_AudioRecorder
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AUDIORECORDER_H
+
+// end Cuppa_AudioRecorder.h
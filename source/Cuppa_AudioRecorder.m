@@ -0,0 +1,164 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioRecorder
+           - Stands in for the audio device when sounds are simulated, recording what the mixer
+             renders instead of playing it.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioRecorder.h"
+
+// Code!
+
+@implementation Cuppa_AudioRecorder
+;
+
+// *************************************************************************************************
+
+// Initialize a recorder that records at sampleRate.
+- (id)initWithSampleRate:(double)sampleRate
+{
+    // parameter checks
+    NSAssert(sampleRate > 0.0, @"Bad sampleRate parameter.\n");
+
+    self = [super init];
+    mSampleRate = sampleRate;
+    mMixer = nil;
+    mSamples = [[NSMutableData alloc] init];
+    mStartCount = 0;
+
+    return self;
+
+} // end -initWithSampleRate:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release the recording
+    [mMixer release];
+    [mSamples release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Start recording interleaved stereo from mixer. Starting a recorder that is already running
+// does nothing.
+- (BOOL)startWithMixer:(Cuppa_AudioMixer *)mixer
+{
+    // parameter checks
+    NSAssert(mixer != nil, @"Bad mixer parameter.\n");
+    NSAssert([mixer channelCount] == 2 && [mixer sampleRate] == mSampleRate,
+             @"Bad mixer parameter.\n");
+
+    if (mMixer)
+        return YES;
+
+    // record new info
+    mMixer = [mixer retain];
+    mStartCount++;
+
+    return YES;
+
+} // end -startWithMixer:
+
+// *************************************************************************************************
+
+// Stop recording from the mixer.
+- (void)stop
+{
+    [mMixer release];
+    mMixer = nil;
+
+} // end -stop
+
+// *************************************************************************************************
+
+// Render and record the next count frames from the mixer, if running. Returns the number of
+// frames recorded.
+- (NSUInteger)renderFrames:(NSUInteger)count
+{
+    NSUInteger length; // bytes recorded before this render
+
+    if (!mMixer)
+        return 0;
+
+    // render straight onto the end of the recording
+    length = [mSamples length];
+    [mSamples increaseLengthBy:count * 2 * sizeof(float)];
+    [mMixer renderFrames:count into:(float *)((uint8_t *)[mSamples mutableBytes] + length)];
+
+    return count;
+
+} // end -renderFrames:
+
+// *************************************************************************************************
+
+// Returns the frames per second the recorder records at.
+- (double)sampleRate
+{
+    // return requested info
+    return mSampleRate;
+
+} // end -sampleRate
+
+// *************************************************************************************************
+
+// Returns YES if the recorder is running.
+- (BOOL)isRunning
+{
+    // return requested info
+    return (mMixer != nil);
+
+} // end -isRunning
+
+// *************************************************************************************************
+
+// Returns everything recorded so far (interleaved stereo floats).
+- (NSData *)samples
+{
+    // return requested info
+    return mSamples;
+
+} // end -samples
+
+// *************************************************************************************************
+
+// Returns the number of frames recorded so far.
+- (NSUInteger)frameCount
+{
+    // return requested info
+    return [mSamples length] / (2 * sizeof(float));
+
+} // end -frameCount
+
+// *************************************************************************************************
+
+// Returns the number of times the recorder has been started.
+- (NSUInteger)startCount
+{
+    // return requested info
+    return mStartCount;
+
+} // end -startCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioRecorder
+
+// end Cuppa_AudioRecorder.m
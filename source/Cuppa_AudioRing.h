@@ -0,0 +1,103 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioRing
+           - A fixed size ring of audio frames, filled by one thread and drained by another.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AUDIORING_H
+#define _CUPPA_AUDIORING_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#include <stdatomic.h>
+
+// Types
+
+// The ring's state, which the reading side drains through the C functions below, so the audio
+// thread never has to send a message
+typedef struct
+{
+    float *samples; // interleaved samples
+    size_t capacity; // number of frames the ring holds
+    size_t channelCount; // number of channels
+    atomic_size_t writeCount; // frames written so far
+    atomic_size_t readCount; // frames read so far
+    atomic_bool finished; // flag: the writer has written everything it will?
+} CuppaAudioRingState;
+
+// Add up to count frames to samples (interleaved), taking them from ring. Returns the number
+// mixed, which is less than count if the ring runs dry. Only the reading thread may call this.
+size_t CuppaAudioRingMix(CuppaAudioRingState *ring, size_t count, float *samples);
+
+// Returns true once the stream in ring has ended and every frame has been read.
+bool CuppaAudioRingIsDrained(CuppaAudioRingState *ring);
+
+// Class Interface
+
+// One thread writes and one thread reads, without locks: each side only moves its own count, and
+// the other side sees the frames before it sees the count move. The ring never grows, so a stream
+// of any length uses the same memory.
+@interface Cuppa_AudioRing : NSObject
+{
+    CuppaAudioRingState mState; // samples and counts
+}
+
+// ------ Life Cycle ------
+
+// Initialize a ring holding capacity frames of channelCount channels.
+- (id)initWithCapacity:(NSUInteger)capacity channelCount:(NSUInteger)channelCount;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Write up to count frames from samples (interleaved). Returns the number written, which is less
+// than count if the ring fills. Only the writing thread may call this.
+- (NSUInteger)writeFrames:(const float *)samples count:(NSUInteger)count;
+
+// Mark the end of the stream; nothing more will be written. Only the writing thread may call this.
+- (void)finish;
+
+// Add up to count frames to samples (interleaved), taking them from the ring. Returns the number
+// mixed, which is less than count if the ring runs dry. Only the reading thread may call this.
+- (NSUInteger)mixFrames:(NSUInteger)count into:(float *)samples;
+
+// ------ Accessors ------
+
+// Returns the ring's state, for the reading thread to drain it with CuppaAudioRingMix().
+- (CuppaAudioRingState *)state;
+
+// Returns the number of frames the ring holds.
+- (NSUInteger)capacity;
+
+// Returns the number of channels.
+- (NSUInteger)channelCount;
+
+// Returns the number of frames waiting to be read.
+- (NSUInteger)availableFrameCount;
+
+// Returns the number of frames that can be written before the ring is full.
+- (NSUInteger)freeFrameCount;
+
+// Returns YES once the stream has ended and every frame has been read.
+- (BOOL)isDrained;
+
+@end // @interface Cuppa_AudioRing
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AUDIORING_H
+
+// end Cuppa_AudioRing.h
@@ -0,0 +1,230 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioRing
+           - A fixed size ring of audio frames, filled by one thread and drained by another.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#include <stdatomic.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioRing.h"
+
+// Code!
+
+// *************************************************************************************************
+
+// Add up to count frames to samples (interleaved), taking them from ring. Returns the number
+// mixed, which is less than count if the ring runs dry. Only the reading thread may call this.
+size_t CuppaAudioRingMix(CuppaAudioRingState *ring, size_t count, float *samples)
+{
+    size_t read; // frames read so far
+    size_t start; // ring frame the read starts at
+    size_t first; // frames read before wrapping round
+    const float *in; // next sample to mix
+    size_t i; // loop counter
+
+    read = atomic_load_explicit(&ring->readCount, memory_order_relaxed);
+    count = MIN(count, atomic_load_explicit(&ring->writeCount, memory_order_acquire) - read);
+
+    // mix out, in two parts if it wraps round the end
+    start = read % ring->capacity;
+    first = MIN(count, ring->capacity - start);
+    in = ring->samples + (start * ring->channelCount);
+    for (i = 0; i < first * ring->channelCount; i++)
+    {
+        samples[i] += in[i];
+    }
+    for (i = first * ring->channelCount; i < count * ring->channelCount; i++)
+    {
+        samples[i] += ring->samples[i - (first * ring->channelCount)];
+    }
+
+    // hand the space back to the writer
+    atomic_store_explicit(&ring->readCount, read + count, memory_order_release);
+
+    return count;
+
+} // end CuppaAudioRingMix()
+
+// *************************************************************************************************
+
+// Returns true once the stream in ring has ended and every frame has been read.
+bool CuppaAudioRingIsDrained(CuppaAudioRingState *ring)
+{
+    // the count is checked after the flag, so a final write is not missed
+    if (!atomic_load_explicit(&ring->finished, memory_order_acquire))
+        return false;
+
+    return (atomic_load_explicit(&ring->writeCount, memory_order_acquire) ==
+            atomic_load_explicit(&ring->readCount, memory_order_acquire));
+
+} // end CuppaAudioRingIsDrained()
+
+// *************************************************************************************************
+
+@implementation Cuppa_AudioRing
+;
+
+// *************************************************************************************************
+
+// Initialize a ring holding capacity frames of channelCount channels.
+- (id)initWithCapacity:(NSUInteger)capacity channelCount:(NSUInteger)channelCount
+{
+    // parameter checks
+    NSAssert(capacity > 0, @"Bad capacity parameter.\n");
+    NSAssert(channelCount > 0, @"Bad channelCount parameter.\n");
+
+    self = [super init];
+    mState.capacity = capacity;
+    mState.channelCount = channelCount;
+    mState.samples = malloc(capacity * channelCount * sizeof(float));
+    NSAssert(mState.samples != NULL, @"Out of memory for audio samples.\n");
+    atomic_init(&mState.writeCount, 0);
+    atomic_init(&mState.readCount, 0);
+    atomic_init(&mState.finished, false);
+
+    return self;
+
+} // end -initWithCapacity:channelCount:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // free the samples
+    free(mState.samples);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Write up to count frames from samples (interleaved). Returns the number written, which is less
+// than count if the ring fills. Only the writing thread may call this.
+- (NSUInteger)writeFrames:(const float *)samples count:(NSUInteger)count
+{
+    size_t written; // frames written so far
+    NSUInteger start; // ring frame the write starts at
+    NSUInteger first; // frames written before wrapping round
+    NSUInteger channelCount = mState.channelCount; // samples per frame
+
+    // parameter checks
+    NSAssert(samples != NULL || count == 0, @"Bad samples parameter.\n");
+
+    written = atomic_load_explicit(&mState.writeCount, memory_order_relaxed);
+    count = MIN(count, mState.capacity -
+                       (written - atomic_load_explicit(&mState.readCount, memory_order_acquire)));
+
+    // copy in, in two parts if it wraps round the end
+    start = written % mState.capacity;
+    first = MIN(count, mState.capacity - start);
+    memcpy(mState.samples + (start * channelCount), samples, first * channelCount * sizeof(float));
+    memcpy(mState.samples, samples + (first * channelCount),
+           (count - first) * channelCount * sizeof(float));
+
+    // publish the frames
+    atomic_store_explicit(&mState.writeCount, written + count, memory_order_release);
+
+    return count;
+
+} // end -writeFrames:count:
+
+// *************************************************************************************************
+
+// Mark the end of the stream; nothing more will be written. Only the writing thread may call this.
+- (void)finish
+{
+    atomic_store_explicit(&mState.finished, true, memory_order_release);
+
+} // end -finish
+
+// *************************************************************************************************
+
+// Add up to count frames to samples (interleaved), taking them from the ring. Returns the number
+// mixed, which is less than count if the ring runs dry. Only the reading thread may call this.
+- (NSUInteger)mixFrames:(NSUInteger)count into:(float *)samples
+{
+    // parameter checks
+    NSAssert(samples != NULL || count == 0, @"Bad samples parameter.\n");
+
+    return CuppaAudioRingMix(&mState, count, samples);
+
+} // end -mixFrames:into:
+
+// *************************************************************************************************
+
+// Returns the ring's state, for the reading thread to drain it with CuppaAudioRingMix().
+- (CuppaAudioRingState *)state
+{
+    // return requested info
+    return &mState;
+
+} // end -state
+
+// *************************************************************************************************
+
+// Returns the number of frames the ring holds.
+- (NSUInteger)capacity
+{
+    // return requested info
+    return mState.capacity;
+
+} // end -capacity
+
+// *************************************************************************************************
+
+// Returns the number of channels.
+- (NSUInteger)channelCount
+{
+    // return requested info
+    return mState.channelCount;
+
+} // end -channelCount
+
+// *************************************************************************************************
+
+// Returns the number of frames waiting to be read.
+- (NSUInteger)availableFrameCount
+{
+    // return requested info
+    return atomic_load_explicit(&mState.writeCount, memory_order_acquire) -
+           atomic_load_explicit(&mState.readCount, memory_order_acquire);
+
+} // end -availableFrameCount
+
+// *************************************************************************************************
+
+// Returns the number of frames that can be written before the ring is full.
+- (NSUInteger)freeFrameCount
+{
+    // return requested info
+    return mState.capacity - [self availableFrameCount];
+
+} // end -freeFrameCount
+
+// *************************************************************************************************
+
+// Returns YES once the stream has ended and every frame has been read.
+- (BOOL)isDrained
+{
+    // return requested info
+    return CuppaAudioRingIsDrained(&mState);
+
+} // end -isDrained
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioRing
+
+// end Cuppa_AudioRing.m
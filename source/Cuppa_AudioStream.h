@@ -0,0 +1,91 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioStream
+           - Decodes a sound a little at a time into a ring, converting it to the output format,
+             so a long sound can play without ever being decoded whole.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AUDIOSTREAM_H
+#define _CUPPA_AUDIOSTREAM_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AIFFDecoder.h"
+#import "Cuppa_AudioRing.h"
+
+// Class Interface
+
+// The ring is topped up on a background queue, well ahead of the mixer draining it. Resampling is
+// linear and channels are matched up as Cuppa_AudioBuffer does, so a sound streams exactly as it
+// would play if it had been decoded whole.
+@interface Cuppa_AudioStream : NSObject
+{
+    Cuppa_AIFFDecoder *mDecoder; // reads the sound
+    Cuppa_AudioRing *mRing; // converted frames waiting to be mixed
+    double mSampleRate; // output frames per second
+    NSUInteger mChannelCount; // output channels
+    double mStep; // sound frames per output frame
+    double mFraction; // how far the next output frame is past mBefore
+    NSUInteger mRemain; // output frames still to convert
+    float *mBefore; // sound frame before the next output frame (in output channels)
+    float *mAfter; // sound frame after the next output frame (in output channels)
+    float *mChunk; // decoded sound frames not yet converted
+    NSUInteger mChunkCount; // number of frames in mChunk
+    NSUInteger mChunkPosition; // next frame of mChunk to convert
+    float *mOut; // converted frames on their way to the ring
+    dispatch_queue_t mQueue; // queue the ring is filled on
+    dispatch_source_t mTimer; // tops the ring up while the stream plays
+}
+
+// ------ Life Cycle ------
+
+// Initialize a stream of the sound in data, converted to sampleRate and channelCount. Returns nil
+// if it is not a sound we can read.
+- (id)initWithData:(NSData *)data
+        sampleRate:(double)sampleRate
+      channelCount:(NSUInteger)channelCount;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Fill the ring, then keep it topped up in the background until the whole sound is through.
+- (void)start;
+
+// Convert as much of the sound as fits in the ring (called on the stream's queue).
+- (void)fill;
+
+// Top the ring up now, waiting for the stream's queue, for a reader that runs faster than the
+// stream fills itself (such as an offline render).
+- (void)topUp;
+
+// ------ Accessors ------
+
+// Returns the ring the converted frames go into.
+- (Cuppa_AudioRing *)ring;
+
+// Returns the length of the converted sound in seconds.
+- (NSTimeInterval)duration;
+
+@end // @interface Cuppa_AudioStream
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AUDIOSTREAM_H
+
+// end Cuppa_AudioStream.h
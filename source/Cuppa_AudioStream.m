@@ -0,0 +1,289 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioStream
+           - Decodes a sound a little at a time into a ring, converting it to the output format,
+             so a long sound can play without ever being decoded whole.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AIFFDecoder.h"
+#import "Cuppa_AudioRing.h"
+#import "Cuppa_AudioStream.h"
+
+// Internal Constants
+
+// Length of the ring, which is all the stream buffers ahead of the mixer
+static const NSTimeInterval sRingSeconds = 0.5;
+
+// How often the ring is topped up (a fraction of its length, so it never runs dry)
+static const NSTimeInterval sFillInterval = 0.1;
+
+// Buffer sizes, in frames
+enum
+{
+    sChunkFrames = 1024, // sound frames decoded at a time
+    sOutFrames = 512 // output frames converted at a time
+};
+
+// Code!
+
+// Copy a frame of inCount channels to a frame of outCount channels, matching up channels the way
+// Cuppa_AudioBuffer does.
+static void CuppaStreamMapFrame(const float *in, NSUInteger inCount, float *out,
+                                NSUInteger outCount)
+{
+    float mix; // every channel mixed to mono
+    NSUInteger channel; // loop counter
+
+    if (inCount != outCount && (inCount == 1 || outCount == 1))
+    {
+        // mono in or out: spread mono to every channel, or mix every channel to mono
+        mix = 0.0f;
+        for (channel = 0; channel < inCount; channel++)
+        {
+            mix += in[channel];
+        }
+        mix /= (float)inCount;
+        for (channel = 0; channel < outCount; channel++)
+        {
+            out[channel] = mix;
+        }
+    }
+    else
+    {
+        // otherwise match channels up in order, repeating the last one if we run out
+        for (channel = 0; channel < outCount; channel++)
+        {
+            out[channel] = in[MIN(channel, inCount - 1)];
+        }
+    }
+}
+
+@implementation Cuppa_AudioStream
+;
+
+// *************************************************************************************************
+
+// Take the next frame of the sound, in output channels. Returns NO at the end of the sound.
+- (BOOL)readFrame:(float *)frame
+{
+    // decode another chunk once this one is used up
+    if (mChunkPosition == mChunkCount)
+    {
+        mChunkCount = [mDecoder readFrames:sChunkFrames into:mChunk];
+        mChunkPosition = 0;
+        if (mChunkCount == 0)
+            return NO;
+    }
+
+    CuppaStreamMapFrame(mChunk + (mChunkPosition * [mDecoder channelCount]),
+                        [mDecoder channelCount], frame, mChannelCount);
+    mChunkPosition++;
+
+    return YES;
+
+} // end -readFrame:
+
+// *************************************************************************************************
+
+// Initialize a stream of the sound in data, converted to sampleRate and channelCount. Returns nil
+// if it is not a sound we can read.
+- (id)initWithData:(NSData *)data
+        sampleRate:(double)sampleRate
+      channelCount:(NSUInteger)channelCount
+{
+    // parameter checks
+    NSAssert(data != nil, @"Bad data parameter.\n");
+    NSAssert(sampleRate > 0.0, @"Bad sampleRate parameter.\n");
+    NSAssert(channelCount > 0, @"Bad channelCount parameter.\n");
+
+    self = [super init];
+    mDecoder = [[Cuppa_AIFFDecoder alloc] initWithData:data];
+    if (!mDecoder)
+    {
+        [self release];
+        return nil;
+    }
+    mSampleRate = sampleRate;
+    mChannelCount = channelCount;
+    mRing = [[Cuppa_AudioRing alloc] initWithCapacity:(NSUInteger)ceil(sRingSeconds * sampleRate)
+                                         channelCount:channelCount];
+
+    // as many output frames as a whole buffer would convert to
+    mStep = [mDecoder sampleRate] / sampleRate;
+    mFraction = 0.0;
+    mRemain = (NSUInteger)floor((double)[mDecoder frameCount] / mStep);
+
+    mChunk = malloc(sChunkFrames * [mDecoder channelCount] * sizeof(float));
+    mOut = malloc(sOutFrames * channelCount * sizeof(float));
+    mBefore = malloc(channelCount * sizeof(float));
+    mAfter = malloc(channelCount * sizeof(float));
+    NSAssert(mChunk && mOut && mBefore && mAfter, @"Out of memory for audio samples.\n");
+    mChunkCount = 0;
+    mChunkPosition = 0;
+
+    // the first two frames (the last frame repeats at the end of the sound)
+    if (![self readFrame:mBefore])
+        mRemain = 0;
+    else if (![self readFrame:mAfter])
+        memcpy(mAfter, mBefore, channelCount * sizeof(float));
+
+    mQueue = dispatch_queue_create("com.nathancosgray.cuppa.audiostream", DISPATCH_QUEUE_SERIAL);
+    mTimer = NULL;
+
+    return self;
+
+} // end -initWithData:sampleRate:channelCount:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // stop filling, and wait for any fill under way to finish
+    if (mTimer)
+    {
+        dispatch_source_cancel(mTimer);
+        dispatch_release(mTimer);
+    }
+    if (mQueue)
+    {
+        dispatch_sync(mQueue, ^{
+            // nothing to do: this only waits for the queue to empty
+        });
+        dispatch_release(mQueue);
+    }
+
+    [mDecoder release];
+    [mRing release];
+    free(mChunk);
+    free(mOut);
+    free(mBefore);
+    free(mAfter);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Fill the ring, then keep it topped up in the background until the whole sound is through.
+- (void)start
+{
+    __block Cuppa_AudioStream *stream = self; // (not retained, so the timer doesn't keep us)
+    uint64_t interval; // nanoseconds between fills
+
+    if (mTimer)
+        return;
+
+    // the first fill is done before returning, so the stream can play straight away
+    dispatch_sync(mQueue, ^{
+        [stream fill];
+    });
+
+    interval = (uint64_t)(sFillInterval * NSEC_PER_SEC);
+    mTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, mQueue);
+    dispatch_source_set_timer(mTimer, dispatch_time(DISPATCH_TIME_NOW, interval), interval,
+                              interval / 10);
+    dispatch_source_set_event_handler(mTimer, ^{
+        [stream fill];
+    });
+    dispatch_resume(mTimer);
+
+} // end -start
+
+// *************************************************************************************************
+
+// Convert as much of the sound as fits in the ring (called on the stream's queue).
+- (void)fill
+{
+    NSUInteger count; // frames to convert this time round
+    NSUInteger frame, channel; // loop counters
+    float *swap; // frame being moved along
+
+    for (count = MIN(MIN([mRing freeFrameCount], mRemain), (NSUInteger)sOutFrames); count > 0;
+         count = MIN(MIN([mRing freeFrameCount], mRemain), (NSUInteger)sOutFrames))
+    {
+        for (frame = 0; frame < count; frame++)
+        {
+            // move along the sound until the output frame falls between mBefore and mAfter
+            while (mFraction >= 1.0)
+            {
+                swap = mBefore;
+                mBefore = mAfter;
+                mAfter = swap;
+                if (![self readFrame:mAfter])
+                    memcpy(mAfter, mBefore, mChannelCount * sizeof(float));
+                mFraction -= 1.0;
+            }
+
+            for (channel = 0; channel < mChannelCount; channel++)
+            {
+                mOut[frame * mChannelCount + channel] =
+                    mBefore[channel] + ((mAfter[channel] - mBefore[channel]) * (float)mFraction);
+            }
+            mFraction += mStep;
+        }
+        [mRing writeFrames:mOut count:count];
+        mRemain -= count;
+    }
+
+    // once everything is through, the mixer can tell the stream has ended
+    if (mRemain == 0)
+    {
+        [mRing finish];
+        if (mTimer)
+            dispatch_source_cancel(mTimer);
+    }
+
+} // end -fill
+
+// *************************************************************************************************
+
+// Top the ring up now, waiting for the stream's queue, for a reader that runs faster than the
+// stream fills itself (such as an offline render).
+- (void)topUp
+{
+    __block Cuppa_AudioStream *stream = self; // (the block is done with before we return)
+
+    dispatch_sync(mQueue, ^{
+        [stream fill];
+    });
+
+} // end -topUp
+
+// *************************************************************************************************
+
+// Returns the ring the converted frames go into.
+- (Cuppa_AudioRing *)ring
+{
+    // return requested info
+    return mRing;
+
+} // end -ring
+
+// *************************************************************************************************
+
+// Returns the length of the converted sound in seconds.
+- (NSTimeInterval)duration
+{
+    // return requested info
+    return floor((double)[mDecoder frameCount] / mStep) / mSampleRate;
+
+} // end -duration
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioStream
+
+// end Cuppa_AudioStream.m
@@ -0,0 +1,73 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioUnitOutput
+           - Plays an audio mixer through the system's default output device.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_AUDIOUNITOUTPUT_H
+#define _CUPPA_AUDIOUNITOUTPUT_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <AudioToolbox/AudioToolbox.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioOutput.h"
+
+// Class Interface
+
+// The output unit is opened and initialized up front, so starting it for a sound is quick. It is
+// only running while there is something to play, so it does not keep the system awake.
+@interface Cuppa_AudioUnitOutput : NSObject <Cuppa_AudioOutput>
+{
+    AudioComponentInstance mUnit; // default output unit
+    double mSampleRate; // frames per second of the output device
+    Cuppa_AudioMixer *mMixer; // mixer being played, while running
+    CuppaAudioMixerState *mMixerState; // what the render callback mixes from, while running
+}
+
+// ------ Life Cycle ------
+
+// Initialize an output for the default output device. Returns nil if it can't be opened.
+- (id)init;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Start pulling interleaved stereo from mixer. Returns NO if the output could not be started.
+// Starting an output that is already running does nothing.
+- (BOOL)startWithMixer:(Cuppa_AudioMixer *)mixer;
+
+// Stop pulling from the mixer. The output stays open, so it can be started again quickly.
+- (void)stop;
+
+// ------ Accessors ------
+
+// Returns the frames per second the output plays at.
+- (double)sampleRate;
+
+// Returns YES if the output is running.
+- (BOOL)isRunning;
+
+@end // @interface Cuppa_AudioUnitOutput
+
+// *************************************************************************************************
+
+#endif // _CUPPA_AUDIOUNITOUTPUT_H
+
+// end Cuppa_AudioUnitOutput.h
@@ -0,0 +1,205 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_AudioUnitOutput
+           - Plays an audio mixer through the system's default output device.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <AudioToolbox/AudioToolbox.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioUnitOutput.h"
+
+// Internal Constants
+
+// Output rate to use if the device doesn't say
+static const double sDefaultSampleRate = 44100.0;
+
+// Code!
+
+@implementation Cuppa_AudioUnitOutput
+;
+
+// *************************************************************************************************
+
+// Fill the output unit's buffer from the mixer (called on the audio thread).
+static OSStatus CuppaAudioUnitRender(void *refCon,
+                                     AudioUnitRenderActionFlags *flags,
+                                     const AudioTimeStamp *timeStamp,
+                                     UInt32 bus,
+                                     UInt32 frameCount,
+                                     AudioBufferList *buffers)
+{
+    Cuppa_AudioUnitOutput *output = (Cuppa_AudioUnitOutput *)refCon; // the output being played
+
+    // no messages are sent here, as they may block the audio thread
+    CuppaAudioMixerRender(output->mMixerState, frameCount, (float *)buffers->mBuffers[0].mData);
+
+    return noErr;
+
+} // end CuppaAudioUnitRender
+
+// *************************************************************************************************
+
+// Initialize an output for the default output device. Returns nil if it can't be opened.
+- (id)init
+{
+    AudioComponentDescription description; // which unit to open
+    AudioComponent component; // the default output unit
+    AudioStreamBasicDescription format; // device and input formats
+    AURenderCallbackStruct callback; // where the unit gets its samples
+    UInt32 size; // size of the device format
+
+    self = [super init];
+    mUnit = NULL;
+    mMixer = nil;
+    mMixerState = NULL;
+
+    // open the default output unit
+    memset(&description, 0, sizeof(description));
+    description.componentType = kAudioUnitType_Output;
+    description.componentSubType = kAudioUnitSubType_DefaultOutput;
+    description.componentManufacturer = kAudioUnitManufacturer_Apple;
+    component = AudioComponentFindNext(NULL, &description);
+    if (!component || AudioComponentInstanceNew(component, &mUnit) != noErr)
+    {
+        mUnit = NULL;
+        [self release];
+        return nil;
+    }
+
+    // play at the device's own rate, so the unit doesn't have to convert
+    size = sizeof(format);
+    if (AudioUnitGetProperty(mUnit, kAudioUnitProperty_StreamFormat, kAudioUnitScope_Output, 0,
+                             &format, &size) == noErr &&
+        format.mSampleRate > 0.0)
+        mSampleRate = format.mSampleRate;
+    else
+        mSampleRate = sDefaultSampleRate;
+
+    // feed it interleaved float stereo from the mixer
+    memset(&format, 0, sizeof(format));
+    format.mSampleRate = mSampleRate;
+    format.mFormatID = kAudioFormatLinearPCM;
+    format.mFormatFlags = kAudioFormatFlagIsFloat | kAudioFormatFlagIsPacked;
+    format.mBytesPerPacket = 2 * sizeof(float);
+    format.mFramesPerPacket = 1;
+    format.mBytesPerFrame = 2 * sizeof(float);
+    format.mChannelsPerFrame = 2;
+    format.mBitsPerChannel = 8 * sizeof(float);
+    callback.inputProc = CuppaAudioUnitRender;
+    callback.inputProcRefCon = self;
+    if (AudioUnitSetProperty(mUnit, kAudioUnitProperty_StreamFormat, kAudioUnitScope_Input, 0,
+                             &format, sizeof(format)) != noErr ||
+        AudioUnitSetProperty(mUnit, kAudioUnitProperty_SetRenderCallback, kAudioUnitScope_Input,
+                             0, &callback, sizeof(callback)) != noErr ||
+        AudioUnitInitialize(mUnit) != noErr)
+    {
+        [self release];
+        return nil;
+    }
+
+#if !defined(NDEBUG)
+    printf("Audio output opened at %g Hz.\n", mSampleRate);
+#endif
+
+    return self;
+
+} // end -init
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // close the output unit
+    [self stop];
+    if (mUnit)
+    {
+        AudioUnitUninitialize(mUnit);
+        AudioComponentInstanceDispose(mUnit);
+    }
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Start pulling interleaved stereo from mixer. Returns NO if the output could not be started.
+// Starting an output that is already running does nothing.
+- (BOOL)startWithMixer:(Cuppa_AudioMixer *)mixer
+{
+    // parameter checks
+    NSAssert(mixer != nil, @"Bad mixer parameter.\n");
+    NSAssert([mixer channelCount] == 2 && [mixer sampleRate] == mSampleRate,
+             @"Bad mixer parameter.\n");
+
+    if (mMixer)
+        return YES;
+
+    // the render callback only reads the mixer while the unit is running
+    mMixer = [mixer retain];
+    mMixerState = [mixer state];
+    if (AudioOutputUnitStart(mUnit) != noErr)
+    {
+        [mMixer release];
+        mMixer = nil;
+        mMixerState = NULL;
+        return NO;
+    }
+
+    return YES;
+
+} // end -startWithMixer:
+
+// *************************************************************************************************
+
+// Stop pulling from the mixer. The output stays open, so it can be started again quickly.
+- (void)stop
+{
+    if (!mMixer)
+        return;
+
+    // the unit has finished rendering once it has stopped
+    AudioOutputUnitStop(mUnit);
+    [mMixer release];
+    mMixer = nil;
+    mMixerState = NULL;
+
+} // end -stop
+
+// *************************************************************************************************
+
+// Returns the frames per second the output plays at.
+- (double)sampleRate
+{
+    // return requested info
+    return mSampleRate;
+
+} // end -sampleRate
+
+// *************************************************************************************************
+
+// Returns YES if the output is running.
+- (BOOL)isRunning
+{
+    // return requested info
+    return (mMixer != nil);
+
+} // end -isRunning
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioUnitOutput
+
+// end Cuppa_AudioUnitOutput.m
@@ -37,9 +37,12 @@ enum
 
 @interface Cuppa_Bevy : NSObject
 {
-    NSString *mName; // name of the beverage
+    NSString *mName; // name of the beverage (shared with others of the same name)
+    NSUInteger mNameHandle; // handle of the name in the shared Cuppa_NameArena
     int mBrewTime; // brew time of the bevy in seconds
-    int mCupShape; // cup shape of bevy, one of the CUPPA_SHAPE_* constants in Cuppa_Shape.h
+    int mCupShape; // cup shape of bevy, a shape code from Cuppa_Shape.h
+    NSString *mIdentifier; // stable identifier of the bevy, kept across launches
+    NSString *mAlarmSound; // path of the bevy's own alarm sound, or nil for the usual one
 }
 
 // ------ Classs Methods ------
@@ -53,6 +56,10 @@ enum
 // Convert an array of beverages from an array of dictionaries, to allow user defaults retrieval.
 + (NSMutableArray *)fromDictionary:(NSArray *)dictArray;
 
+// Convert a single beverage from a dictionary. A beverage stored without an identifier (by an
+// older version) is given a new one.
++ (Cuppa_Bevy *)bevyFromDictionary:(NSDictionary *)dict;
+
 // ------ Life Cycle ------
 
 // Default initializer.
@@ -72,17 +79,40 @@ enum
 // Sets the name of this bevy.
 - (void)setCupShape:(int)cupShape;
 
+// Sets the stable identifier of this bevy.
+- (void)setIdentifier:(NSString *)identifier;
+
+// Sets the path of this bevy's own alarm sound, or nil to use the usual one.
+- (void)setAlarmSound:(NSString *)alarmSound;
+
+// Copies the name, brew time, cup shape and alarm sound (but not the identifier) from a
+// dictionary.
+- (void)updateFromDictionary:(NSDictionary *)dict;
+
 // ------ Accessors ------
 
 // Returns the name of this bevy.
 - (NSString *)name;
 
+// Returns the handle of this bevy's name in the shared Cuppa_NameArena, held until the bevy is
+// renamed or deallocated.
+- (NSUInteger)nameHandle;
+
 // Returns the brew time of this bevy.
 - (int)brewTime;
 
 // Returns the cup shape of this bevy.
 - (int)cupShape;
 
+// Returns the stable identifier of this bevy.
+- (NSString *)identifier;
+
+// Returns the path of this bevy's own alarm sound, or nil to use the usual one.
+- (NSString *)alarmSound;
+
+// Convert this beverage to a dictionary, to allow user defaults storage.
+- (NSMutableDictionary *)dictionary;
+
 @end // @interface Cuppa_Bevy
 
 // *************************************************************************************************
@@ -17,7 +17,8 @@
 // Cuppa Includes
 
 #import "Cuppa_Bevy.h"
-#import "Cuppa_Shape.h"
+#import "Cuppa_NameArena.h"
+#import "Cuppa_ShapeTable.h"
 
 // Code!
 
@@ -109,18 +110,11 @@
     
     int i; // loop counter
     NSMutableArray *dictArray; // array of dictionarys
-    NSMutableDictionary *dict; // dictionary object
-    Cuppa_Bevy *bevy; // beverage object
     
     dictArray = [NSMutableArray array];
     for (i = 0; i < [bevyArray count]; i++)
     {
-        bevy = [bevyArray objectAtIndex:i];
-        dict = [NSMutableDictionary dictionary];
-        [dict setObject:[bevy name] forKey:@"name"];
-        [dict setObject:[NSNumber numberWithInt:[bevy brewTime]] forKey:@"brewTime"];
-        [dict setObject:[Cuppa_Shape labelForShape:[bevy cupShape]] forKey:@"cupShape"];
-        [dictArray addObject:dict];
+        [dictArray addObject:[[bevyArray objectAtIndex:i] dictionary]];
     }
     
     return dictArray;
@@ -134,18 +128,11 @@
 {
     int i; // loop counter
     NSMutableArray *bevyArray; // array of Cuppa_Bevys
-    NSDictionary *dict; // dictionary object
-    Cuppa_Bevy *bevy; // beverage object
     
     bevyArray = [NSMutableArray array];
     for (i = 0; i < [dictArray count]; i++)
     {
-        dict = [dictArray objectAtIndex:i];
-        bevy = [[[Cuppa_Bevy alloc] init] autorelease];
-        [bevy setName:[dict objectForKey:@"name"]];
-        [bevy setBrewTime:[[dict objectForKey:@"brewTime"] intValue]];
-        [bevy setCupShape:[Cuppa_Shape shapeForLabel:[dict objectForKey:@"cupShape"]]];
-        [bevyArray addObject:bevy];
+        [bevyArray addObject:[Cuppa_Bevy bevyFromDictionary:[dictArray objectAtIndex:i]]];
     }
     
     return bevyArray;
@@ -154,13 +141,38 @@
 
 // *************************************************************************************************
 
+// Convert a single beverage from a dictionary. A beverage stored without an identifier (by an
+// older version) is given a new one.
++ (Cuppa_Bevy *)bevyFromDictionary:(NSDictionary *)dict
+{
+    Cuppa_Bevy *bevy; // beverage object
+    NSString *identifier; // stored identifier, if any
+    
+    // parameter checks
+    NSAssert(dict != nil, @"Bad dictionary parameter.\n");
+    
+    bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+    [bevy updateFromDictionary:dict];
+    identifier = [dict objectForKey:@"identifier"];
+    if (identifier)
+        [bevy setIdentifier:identifier];
+    
+    return bevy;
+    
+} // end +bevyFromDictionary:
+
+// *************************************************************************************************
+
 // Default initializer.
 - (id)init
 {
     self = [super init];
-    mName = [[NSString alloc] init];
+    mNameHandle = [[Cuppa_NameArena sharedArena] handleForName:@""];
+    mName = [[[Cuppa_NameArena sharedArena] nameForHandle:mNameHandle] retain];
     mBrewTime = CUPPA_BEVY_BREW_TIME_MIN;
     mCupShape = 0;
+    mIdentifier = [[[NSUUID UUID] UUIDString] copy];
+    mAlarmSound = nil;
     return self;
     
 } // end -init
@@ -170,8 +182,11 @@
 // Deallocate.
 - (void)dealloc
 {
-    // release our hold on the name string
+    // release our hold on the name, identifier and alarm sound strings
+    [[Cuppa_NameArena sharedArena] releaseHandle:mNameHandle];
     [mName release];
+    [mIdentifier release];
+    [mAlarmSound release];
     [super dealloc];
     
 } // end -dealloc
@@ -191,18 +206,33 @@
 // Sets the name of this bevy.
 - (void)setName:(NSString *)name
 {
+    NSUInteger handle; // handle of the new name
+    
     // parameter checks
     NSAssert(name != nil, @"Bad name parameter.\n");
     
-    // record new info
+    // record new info, sharing the arena's copy of the name, and let go of the old one
+    handle = [[Cuppa_NameArena sharedArena] handleForName:name];
+    [[Cuppa_NameArena sharedArena] releaseHandle:mNameHandle];
+    mNameHandle = handle;
     [mName release];
-    mName = name;
-    [mName retain];
+    mName = [[[Cuppa_NameArena sharedArena] nameForHandle:mNameHandle] retain];
     
 } // end -setName:
 
 // *************************************************************************************************
 
+// Returns the handle of this bevy's name in the shared Cuppa_NameArena, held until the bevy is
+// renamed or deallocated.
+- (NSUInteger)nameHandle
+{
+    // return requested info
+    return mNameHandle;
+    
+} // end -nameHandle
+
+// *************************************************************************************************
+
 // Returns the brew time of this bevy.
 - (int)brewTime
 {
@@ -242,7 +272,8 @@
 {
     // parameter checks
     NSAssert(cupShape >= 0, @"Cup shape index < 0.\n");
-    NSAssert(cupShape < CUPPA_SHAPE_MAX, @"Cup shape index >= MAX.\n");
+    NSAssert((NSUInteger)cupShape < [[Cuppa_ShapeTable sharedTable] count],
+             @"Cup shape index >= count.\n");
     
     // record new info
     mCupShape = cupShape;
@@ -251,6 +282,95 @@
 
 // *************************************************************************************************
 
+// Returns the stable identifier of this bevy.
+- (NSString *)identifier
+{
+    // return requested info
+    return mIdentifier;
+    
+} // end -identifier
+
+// *************************************************************************************************
+
+// Sets the stable identifier of this bevy.
+- (void)setIdentifier:(NSString *)identifier
+{
+    // parameter checks
+    NSAssert(identifier != nil, @"Bad identifier parameter.\n");
+    
+    // record new info
+    [mIdentifier release];
+    mIdentifier = [identifier copy];
+    
+} // end -setIdentifier:
+
+// *************************************************************************************************
+
+// Returns the path of this bevy's own alarm sound, or nil to use the usual one.
+- (NSString *)alarmSound
+{
+    // return requested info
+    return mAlarmSound;
+    
+} // end -alarmSound
+
+// *************************************************************************************************
+
+// Sets the path of this bevy's own alarm sound, or nil to use the usual one.
+- (void)setAlarmSound:(NSString *)alarmSound
+{
+    // record new info
+    [mAlarmSound release];
+    mAlarmSound = [alarmSound copy];
+    
+} // end -setAlarmSound:
+
+// *************************************************************************************************
+
+// Convert this beverage to a dictionary, to allow user defaults storage.
+- (NSMutableDictionary *)dictionary
+{
+    NSMutableDictionary *dict; // dictionary object
+    
+    dict = [NSMutableDictionary dictionary];
+    [dict setObject:mName forKey:@"name"];
+    [dict setObject:[NSNumber numberWithInt:mBrewTime] forKey:@"brewTime"];
+    [dict setObject:[[Cuppa_ShapeTable sharedTable] labelForShape:mCupShape] forKey:@"cupShape"];
+    [dict setObject:mIdentifier forKey:@"identifier"];
+    if (mAlarmSound)
+        [dict setObject:mAlarmSound forKey:@"alarmSound"];
+    
+    return dict;
+    
+} // end -dictionary
+
+// *************************************************************************************************
+
+// Copies the name, brew time, cup shape and alarm sound (but not the identifier) from a
+// dictionary.
+- (void)updateFromDictionary:(NSDictionary *)dict
+{
+    id alarmSound; // stored alarm sound, if any
+    
+    // parameter checks
+    NSAssert(dict != nil, @"Bad dictionary parameter.\n");
+    
+    // record new info
+    [self setName:[dict objectForKey:@"name"]];
+    [self setBrewTime:[[dict objectForKey:@"brewTime"] intValue]];
+    [self setCupShape:[[Cuppa_ShapeTable sharedTable]
+                          shapeForLabel:[dict objectForKey:@"cupShape"]]];
+    
+    // a beverage stored by an older version (or with the usual sound) has no alarm sound
+    alarmSound = [dict objectForKey:@"alarmSound"];
+    if (![alarmSound isKindOfClass:[NSString class]] || [alarmSound length] == 0)
+        alarmSound = nil;
+    [self setAlarmSound:alarmSound];
+    
+} // end -updateFromDictionary:
+
+// *************************************************************************************************
+
 @end // @implementation Cuppa_Bevy
 
 // end Cuppa_Bevy.m
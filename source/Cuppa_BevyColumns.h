@@ -0,0 +1,100 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_BevyColumns
+           - A snapshot of a beverage list stored a column at a time, for sorting and scanning
+             without going through each beverage object.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_BEVYCOLUMNS_H
+#define _CUPPA_BEVYCOLUMNS_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_BevySortKeys.h"
+
+// Constants
+
+enum
+{
+    CUPPA_COLUMN_NONE = -1, // not a column we can sort on
+    CUPPA_COLUMN_NAME = 0, // beverage name, compared case-insensitively
+    CUPPA_COLUMN_BREW_TIME, // brew time in seconds
+    CUPPA_COLUMN_CUP_SHAPE, // cup shape constant
+    CUPPA_COLUMN_MAX
+};
+
+// Class Interface
+
+// Names are kept case-folded (and decomposed) in one character arena, so comparing two of them
+// is a plain comparison of UTF-16 units rather than a message to each string.
+@interface Cuppa_BevyColumns : NSObject
+{
+    NSUInteger mCount; // number of rows
+    int *mBrewTimes; // brew time of each row
+    int *mCupShapes; // cup shape of each row
+    NSUInteger *mNameStarts; // start of each row's name in the arena, plus the end of the last
+    unichar *mNames; // arena of folded names
+}
+
+// ------ Class Methods ------
+
+// Returns the column with a sort key ("name", "brewTime" or "cupShape"), or CUPPA_COLUMN_NONE.
++ (int)columnForKey:(NSString *)key;
+
+// Sort a beverage list in place by sort descriptors, stably, taking name keys from keys (if set).
+// Returns NO (leaving the list as it was) if a descriptor uses a key or selector that a typed
+// comparator cannot stand in for.
++ (BOOL)sortBevys:(NSMutableArray *)bevys
+    usingDescriptors:(NSArray *)descriptors
+            sortKeys:(Cuppa_BevySortKeys *)keys;
+
+// ------ Life Cycle ------
+
+// Initialize a snapshot of a beverage list, taking name keys from keys (if set). Rows are read
+// with the bevy* accessors, so a lazy list is not turned into beverage objects.
+- (id)initWithBevys:(NSArray *)bevys sortKeys:(Cuppa_BevySortKeys *)keys;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Put rows (count row numbers) in order by sort descriptors, stably. Returns NO (leaving rows as
+// they were) if a descriptor uses a key or selector that a typed comparator cannot stand in for.
+- (BOOL)sortRows:(NSUInteger *)rows count:(NSUInteger)count byDescriptors:(NSArray *)descriptors;
+
+// ------ Accessors ------
+
+// Returns the number of rows.
+- (NSUInteger)count;
+
+// Returns the brew time of a row.
+- (int)brewTimeAtIndex:(NSUInteger)index;
+
+// Returns the cup shape of a row.
+- (int)cupShapeAtIndex:(NSUInteger)index;
+
+// Compare two rows by a column, ascending.
+- (NSComparisonResult)compareRow:(NSUInteger)a toRow:(NSUInteger)b column:(int)column;
+
+@end // @interface Cuppa_BevyColumns
+
+// *************************************************************************************************
+
+#endif // _CUPPA_BEVYCOLUMNS_H
+
+// end Cuppa_BevyColumns.h
@@ -0,0 +1,387 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_BevyColumns
+           - A snapshot of a beverage list stored a column at a time, for sorting and scanning
+             without going through each beverage object.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_BevyColumns.h"
+#import "Cuppa_BevySortKeys.h"
+#import "Cuppa_LazyBevys.h"
+
+// Types
+
+// Everything a comparison needs, as plain pointers
+typedef struct
+{
+    const int *brewTimes; // brew time column
+    const int *cupShapes; // cup shape column
+    const NSUInteger *nameStarts; // name starts in the arena
+    const unichar *names; // folded name arena
+    const int *columns; // columns to compare by, most significant first
+    const bool *ascending; // flag for each column: ascending order?
+    NSUInteger keyCount; // number of columns to compare by
+} CuppaColumnsSort;
+
+// Code!
+
+// Compare two ints.
+static inline NSComparisonResult CuppaColumnsCompareInts(int a, int b)
+{
+    return (a < b) ? NSOrderedAscending : ((a > b) ? NSOrderedDescending : NSOrderedSame);
+}
+
+// Compare two folded names from the arena, a UTF-16 unit at a time.
+static NSComparisonResult CuppaColumnsCompareNames(const CuppaColumnsSort *sort, NSUInteger a,
+                                                   NSUInteger b)
+{
+    const unichar *nameA = sort->names + sort->nameStarts[a]; // first name
+    const unichar *nameB = sort->names + sort->nameStarts[b]; // second name
+    NSUInteger lengthA = sort->nameStarts[a + 1] - sort->nameStarts[a]; // length of first name
+    NSUInteger lengthB = sort->nameStarts[b + 1] - sort->nameStarts[b]; // length of second name
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < lengthA && i < lengthB; i++)
+    {
+        if (nameA[i] != nameB[i])
+            return (nameA[i] < nameB[i]) ? NSOrderedAscending : NSOrderedDescending;
+    }
+    return (lengthA < lengthB) ? NSOrderedAscending
+                               : ((lengthA > lengthB) ? NSOrderedDescending : NSOrderedSame);
+}
+
+// Compare two rows by one column, ascending.
+static NSComparisonResult CuppaColumnsCompareColumn(const CuppaColumnsSort *sort, int column,
+                                                    NSUInteger a, NSUInteger b)
+{
+    switch (column)
+    {
+        case CUPPA_COLUMN_NAME:
+            return CuppaColumnsCompareNames(sort, a, b);
+        case CUPPA_COLUMN_BREW_TIME:
+            return CuppaColumnsCompareInts(sort->brewTimes[a], sort->brewTimes[b]);
+        case CUPPA_COLUMN_CUP_SHAPE:
+            return CuppaColumnsCompareInts(sort->cupShapes[a], sort->cupShapes[b]);
+        default:
+            return NSOrderedSame;
+    }
+}
+
+// Compare two rows by every sort column in turn.
+static NSComparisonResult CuppaColumnsCompareRows(const CuppaColumnsSort *sort, NSUInteger a,
+                                                  NSUInteger b)
+{
+    NSComparisonResult result; // result for the current column
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < sort->keyCount; i++)
+    {
+        result = CuppaColumnsCompareColumn(sort, sort->columns[i], a, b);
+        if (result != NSOrderedSame)
+            return sort->ascending[i] ? result : -result;
+    }
+    return NSOrderedSame;
+}
+
+// Merge sort rows, bottom up. Equal rows keep their order, since a row is only taken from the
+// right-hand run when it is strictly less.
+static void CuppaColumnsMergeSort(const CuppaColumnsSort *sort, NSUInteger *rows,
+                                  NSUInteger *scratch, NSUInteger count)
+{
+    NSUInteger *from = rows; // runs being merged
+    NSUInteger *to = scratch; // merged runs
+    NSUInteger *swap; // for swapping the two
+    NSUInteger width; // length of the runs being merged
+    NSUInteger left, middle, right; // bounds of the pair of runs being merged
+    NSUInteger i, j, k; // merge positions
+
+    for (width = 1; width < count; width *= 2)
+    {
+        for (left = 0; left < count; left += 2 * width)
+        {
+            middle = MIN(left + width, count);
+            right = MIN(left + 2 * width, count);
+            for (i = left, j = middle, k = left; i < middle && j < right; k++)
+            {
+                if (CuppaColumnsCompareRows(sort, from[j], from[i]) == NSOrderedAscending)
+                    to[k] = from[j++];
+                else
+                    to[k] = from[i++];
+            }
+            while (i < middle)
+                to[k++] = from[i++];
+            while (j < right)
+                to[k++] = from[j++];
+        }
+        swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from != rows)
+        memcpy(rows, from, count * sizeof(NSUInteger));
+}
+
+@implementation Cuppa_BevyColumns
+;
+
+// *************************************************************************************************
+
+// Returns the column with a sort key ("name", "brewTime" or "cupShape"), or CUPPA_COLUMN_NONE.
++ (int)columnForKey:(NSString *)key
+{
+    if ([key isEqualToString:@"name"])
+        return CUPPA_COLUMN_NAME;
+    if ([key isEqualToString:@"brewTime"])
+        return CUPPA_COLUMN_BREW_TIME;
+    if ([key isEqualToString:@"cupShape"])
+        return CUPPA_COLUMN_CUP_SHAPE;
+    return CUPPA_COLUMN_NONE;
+
+} // end +columnForKey:
+
+// *************************************************************************************************
+
+// Returns whether every sort descriptor can be handled by a typed comparator: names compared
+// case-insensitively, and numbers compared.
++ (BOOL)canSortByDescriptors:(NSArray *)descriptors
+{
+    NSSortDescriptor *descriptor; // current sort descriptor
+    int column; // its column
+
+    for (descriptor in descriptors)
+    {
+        column = [self columnForKey:[descriptor key]];
+        if (column == CUPPA_COLUMN_NAME && [descriptor selector] == @selector(caseInsensitiveCompare:))
+            continue;
+        if (column != CUPPA_COLUMN_NONE && column != CUPPA_COLUMN_NAME &&
+            [descriptor selector] == @selector(compare:))
+            continue;
+        return NO;
+    }
+    return YES;
+
+} // end +canSortByDescriptors:
+
+// *************************************************************************************************
+
+// Sort a beverage list in place by sort descriptors, stably, taking name keys from keys (if set).
+// Returns NO (leaving the list as it was) if a descriptor uses a key or selector that a typed
+// comparator cannot stand in for.
++ (BOOL)sortBevys:(NSMutableArray *)bevys
+    usingDescriptors:(NSArray *)descriptors
+            sortKeys:(Cuppa_BevySortKeys *)keys
+{
+    Cuppa_BevyColumns *columns; // snapshot of the list
+    NSUInteger *rows; // rows in sorted order
+    NSUInteger i; // loop counter
+
+    // parameter checks
+    NSAssert(bevys != nil, @"Bad bevys parameter.\n");
+    NSAssert(descriptors != nil, @"Bad descriptors parameter.\n");
+
+    if (![self canSortByDescriptors:descriptors])
+        return NO;
+
+    // sort the row numbers, then move the rows into that order in one go
+    columns = [[self alloc] initWithBevys:bevys sortKeys:keys];
+    rows = malloc(([bevys count] + 1) * sizeof(NSUInteger));
+    NSAssert(rows != NULL, @"Out of memory for sort.\n");
+    for (i = 0; i < [bevys count]; i++)
+    {
+        rows[i] = i;
+    }
+    [columns sortRows:rows count:[bevys count] byDescriptors:descriptors];
+    [bevys reorderBevysByRows:rows];
+    free(rows);
+    [columns release];
+
+    return YES;
+
+} // end +sortBevys:usingDescriptors:sortKeys:
+
+// *************************************************************************************************
+
+// Initialize a snapshot of a beverage list, taking name keys from keys (if set). Rows are read
+// with the bevy* accessors, so a lazy list is not turned into beverage objects.
+- (id)initWithBevys:(NSArray *)bevys sortKeys:(Cuppa_BevySortKeys *)keys
+{
+    NSUInteger i; // loop counter
+    NSUInteger capacity; // characters the arena has room for
+    NSString *identifier; // identifier of the current row
+    NSString *name; // sort key for the name of the current row
+
+    // parameter checks
+    NSAssert(bevys != nil, @"Bad bevys parameter.\n");
+
+    self = [super init];
+    mCount = [bevys count];
+    mBrewTimes = malloc((mCount + 1) * sizeof(int));
+    mCupShapes = malloc((mCount + 1) * sizeof(int));
+    mNameStarts = malloc((mCount + 1) * sizeof(NSUInteger));
+    capacity = 16 * (mCount + 1);
+    mNames = malloc(capacity * sizeof(unichar));
+    NSAssert(mBrewTimes && mCupShapes && mNameStarts && mNames,
+             @"Out of memory for beverage columns.\n");
+
+    mNameStarts[0] = 0;
+    for (i = 0; i < mCount; i++)
+    {
+        mBrewTimes[i] = [bevys bevyBrewTimeAtIndex:i];
+        mCupShapes[i] = [bevys bevyCupShapeAtIndex:i];
+
+        // use the known key for the name if there is one (so the name need not be read), and
+        // add it to the arena
+        identifier = [bevys bevyIdentifierAtIndex:i];
+        name = [keys keyForIdentifier:identifier];
+        if (!name && keys)
+            name = [keys keyForName:[bevys bevyNameAtIndex:i] identifier:identifier];
+        else if (!name)
+            name = [Cuppa_BevySortKeys keyForName:[bevys bevyNameAtIndex:i]];
+        while (mNameStarts[i] + [name length] > capacity)
+        {
+            capacity *= 2;
+            mNames = realloc(mNames, capacity * sizeof(unichar));
+            NSAssert(mNames != NULL, @"Out of memory for beverage names.\n");
+        }
+        [name getCharacters:(mNames + mNameStarts[i]) range:NSMakeRange(0, [name length])];
+        mNameStarts[i + 1] = mNameStarts[i] + [name length];
+    }
+
+    return self;
+
+} // end -initWithBevys:sortKeys:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release the columns
+    free(mBrewTimes);
+    free(mCupShapes);
+    free(mNameStarts);
+    free(mNames);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Put rows (count row numbers) in order by sort descriptors, stably. Returns NO (leaving rows as
+// they were) if a descriptor uses a key or selector that a typed comparator cannot stand in for.
+- (BOOL)sortRows:(NSUInteger *)rows count:(NSUInteger)count byDescriptors:(NSArray *)descriptors
+{
+    CuppaColumnsSort sort; // what the comparisons need
+    int *columns; // column of each descriptor
+    bool *ascending; // order of each descriptor
+    NSUInteger *scratch; // merge space
+    NSUInteger i; // loop counter
+
+    // parameter checks
+    NSAssert(rows != NULL || count == 0, @"Bad rows parameter.\n");
+    NSAssert(descriptors != nil, @"Bad descriptors parameter.\n");
+
+    if (![Cuppa_BevyColumns canSortByDescriptors:descriptors])
+        return NO;
+
+    // gather the columns to compare by
+    columns = malloc(([descriptors count] + 1) * sizeof(int));
+    ascending = malloc(([descriptors count] + 1) * sizeof(bool));
+    scratch = malloc((count + 1) * sizeof(NSUInteger));
+    NSAssert(columns && ascending && scratch, @"Out of memory for sort.\n");
+    for (i = 0; i < [descriptors count]; i++)
+    {
+        columns[i] = [Cuppa_BevyColumns columnForKey:[[descriptors objectAtIndex:i] key]];
+        ascending[i] = [[descriptors objectAtIndex:i] ascending];
+    }
+    sort.brewTimes = mBrewTimes;
+    sort.cupShapes = mCupShapes;
+    sort.nameStarts = mNameStarts;
+    sort.names = mNames;
+    sort.columns = columns;
+    sort.ascending = ascending;
+    sort.keyCount = [descriptors count];
+
+    CuppaColumnsMergeSort(&sort, rows, scratch, count);
+
+    free(columns);
+    free(ascending);
+    free(scratch);
+    return YES;
+
+} // end -sortRows:count:byDescriptors:
+
+// *************************************************************************************************
+
+// Returns the number of rows.
+- (NSUInteger)count
+{
+    // return requested info
+    return mCount;
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the brew time of a row.
+- (int)brewTimeAtIndex:(NSUInteger)index
+{
+    // parameter checks
+    NSAssert(index < mCount, @"Bad index parameter.\n");
+
+    // return requested info
+    return mBrewTimes[index];
+
+} // end -brewTimeAtIndex:
+
+// *************************************************************************************************
+
+// Returns the cup shape of a row.
+- (int)cupShapeAtIndex:(NSUInteger)index
+{
+    // parameter checks
+    NSAssert(index < mCount, @"Bad index parameter.\n");
+
+    // return requested info
+    return mCupShapes[index];
+
+} // end -cupShapeAtIndex:
+
+// *************************************************************************************************
+
+// Compare two rows by a column, ascending.
+- (NSComparisonResult)compareRow:(NSUInteger)a toRow:(NSUInteger)b column:(int)column
+{
+    CuppaColumnsSort sort; // what the comparison needs
+
+    // parameter checks
+    NSAssert(a < mCount && b < mCount, @"Bad row parameter.\n");
+
+    sort.brewTimes = mBrewTimes;
+    sort.cupShapes = mCupShapes;
+    sort.nameStarts = mNameStarts;
+    sort.names = mNames;
+    sort.columns = NULL;
+    sort.ascending = NULL;
+    sort.keyCount = 0;
+    return CuppaColumnsCompareColumn(&sort, column, a, b);
+
+} // end -compareRow:toRow:column:
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_BevyColumns
+
+// end Cuppa_BevyColumns.m
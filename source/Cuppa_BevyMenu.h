@@ -0,0 +1,62 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_BevyMenu
+           - Keeps the beverage items at the top of a menu in step with the beverage list.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_BEVYMENU_H
+#define _CUPPA_BEVYMENU_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <AppKit/AppKit.h>
+#import <Foundation/Foundation.h>
+
+// Class Interface
+
+// The dock and application menus each start with an item per beverage. Each item is told apart by
+// the beverage's identifier (its represented object), and starts brewing through the action
+// -startBrewing: sent to the menu's target.
+@interface Cuppa_BevyMenu : NSObject
+{
+    // no instance vars
+}
+
+// ------ Class Methods ------
+
+// Update the beverage items at the top of a menu, which show the beverages with oldIdentifiers, to
+// show bevys (whose identifiers are identifiers) instead. Items for beverages still in the list
+// are kept (and only touched if they have changed), so a rename or reorder does not rebuild the
+// whole menu. Steep times are shown if steep is set, and number keys assigned if keys is set.
++ (void)updateMenu:(NSMenu *)menu
+              from:(NSArray *)oldIdentifiers
+                to:(NSArray *)identifiers
+             bevys:(NSArray *)bevys
+         showSteep:(BOOL)steep
+    keyEquivalents:(BOOL)keys
+            target:(id)target;
+
+// Create a menu item that sends -startBrewing: to target for the beverage with identifier; its
+// title and image are set by +updateMenu:.
++ (NSMenuItem *)menuItemForIdentifier:(NSString *)identifier target:(id)target;
+
+// Returns the class of the menu items made (NSMenuItem).
++ (Class)menuItemClass;
+
+@end // @interface Cuppa_BevyMenu
+
+// *************************************************************************************************
+
+#endif // _CUPPA_BEVYMENU_H
+
+// end Cuppa_BevyMenu.h
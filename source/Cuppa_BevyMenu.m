@@ -0,0 +1,186 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_BevyMenu
+           - Keeps the beverage items at the top of a menu in step with the beverage list.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <AppKit/AppKit.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_BevyMenu.h"
+#import "Cuppa_LazyBevys.h"
+#import "Cuppa_ListDiff.h"
+#import "Cuppa_Shape.h"
+#import "Cuppa_TimeFormat.h"
+
+// Code!
+
+@implementation Cuppa_BevyMenu
+;
+
+// *************************************************************************************************
+
+// Update the beverage items at the top of a menu, which show the beverages with oldIdentifiers, to
+// show bevys (whose identifiers are identifiers) instead. Items for beverages still in the list
+// are kept (and only touched if they have changed), so a rename or reorder does not rebuild the
+// whole menu. Steep times are shown if steep is set, and number keys assigned if keys is set.
++ (void)updateMenu:(NSMenu *)menu
+              from:(NSArray *)oldIdentifiers
+                to:(NSArray *)identifiers
+             bevys:(NSArray *)bevys
+         showSteep:(BOOL)steep
+    keyEquivalents:(BOOL)keys
+            target:(id)target
+{
+    NSUInteger i; // loop counter
+    NSUInteger from; // index of a moved item before the update
+    char countString[CUPPA_TIME_STRING_MAX]; // formatted steep time
+    Cuppa_ListDiff *diff; // removals and insertions needed to update the menu
+    NSMutableDictionary *moved; // items being moved, by their index before the update
+    NSMenuItem *item; // current menu item
+    NSString *title; // title for the current menu item
+    NSImage *bevyImage; // image for the current menu item
+    NSString *key; // key equivalent for the current menu item
+    NSEventModifierFlags modifiers; // key equivalent modifiers for the current menu item
+
+    // parameter checks
+    NSAssert(menu != nil, @"Bad menu parameter.\n");
+    NSAssert(identifiers != nil, @"Bad identifiers parameter.\n");
+    NSAssert([identifiers count] == [bevys count], @"Identifiers do not match bevys.\n");
+
+    // a menu we have not filled yet has no beverage items
+    if (!oldIdentifiers)
+        oldIdentifiers = [NSArray array];
+    diff = [[[Cuppa_ListDiff alloc] initFromList:oldIdentifiers toList:identifiers] autorelease];
+
+    // take out the old items, bottom up so the remaining indexes stay put
+    moved = [NSMutableDictionary dictionary];
+    for (i = [[diff removed] lastIndex]; i != NSNotFound; i = [[diff removed] indexLessThanIndex:i])
+    {
+        // hang on to items that are only moving
+        if ([diff newIndexForOldIndex:i] != NSNotFound)
+            [moved setObject:[menu itemAtIndex:i] forKey:[NSNumber numberWithUnsignedInteger:i]];
+        [menu removeItemAtIndex:i];
+    }
+
+    // put in the new and moved items, top down so each lands at its final index
+    for (i = [[diff inserted] firstIndex]; i != NSNotFound;
+         i = [[diff inserted] indexGreaterThanIndex:i])
+    {
+        from = [diff oldIndexForNewIndex:i];
+        if (from != NSNotFound)
+            item = [moved objectForKey:[NSNumber numberWithUnsignedInteger:from]];
+        else
+            item = [self menuItemForIdentifier:[identifiers objectAtIndex:i] target:target];
+        [menu insertItem:item atIndex:i];
+    }
+
+    // refresh anything about each item that has changed, such as a new name or position; the
+    // beverage is read through its row, so a lazy list does not make an object of it
+    for (i = 0; i < [identifiers count]; i++)
+    {
+        item = [menu itemAtIndex:i];
+
+        // title, with steep times if requested
+        if (steep)
+        {
+            [Cuppa_TimeFormat formatSeconds:[bevys bevyBrewTimeAtIndex:i]
+                                     buffer:countString
+                                       size:sizeof(countString)];
+            title = [NSString stringWithFormat:@"%@ (%s)", [bevys bevyNameAtIndex:i],
+                                               countString];
+        }
+        else
+        {
+            // the name is the shared arena copy, so it can be the title as it is
+            title = [bevys bevyNameAtIndex:i];
+        }
+        if (![[item title] isEqualToString:title])
+            [item setTitle:title];
+
+        // image for the beverage (shape images are shared, so compare them directly)
+        bevyImage = [Cuppa_Shape imageForShape:[bevys bevyCupShapeAtIndex:i]];
+        if ([item image] != bevyImage)
+            [item setImage:bevyImage];
+
+        // number key for the first 40 items
+        key = @"";
+        modifiers = NSEventModifierFlagCommand;
+        if (keys && i < 40)
+        {
+            key = [NSString stringWithFormat:@"%d", (int)(i % 10)];
+            if (i < 10)
+            {
+                modifiers = NSEventModifierFlagCommand;
+            }
+            else if (i < 20)
+            {
+                modifiers = NSEventModifierFlagCommand + NSEventModifierFlagOption;
+            }
+            else if (i < 30)
+            {
+                modifiers = NSEventModifierFlagCommand + NSEventModifierFlagControl;
+            }
+            else
+            {
+                modifiers = NSEventModifierFlagCommand + NSEventModifierFlagShift;
+            }
+        }
+        if (![[item keyEquivalent] isEqualToString:key])
+            [item setKeyEquivalent:key];
+        if ([item keyEquivalentModifierMask] != modifiers)
+            [item setKeyEquivalentModifierMask:modifiers];
+    }
+
+} // end +updateMenu:from:to:bevys:showSteep:keyEquivalents:target:
+
+// *************************************************************************************************
+
+// Create a menu item that sends -startBrewing: to target for the beverage with identifier; its
+// title and image are set by +updateMenu:.
++ (NSMenuItem *)menuItemForIdentifier:(NSString *)identifier target:(id)target
+{
+    NSMenuItem *item; // new menu item
+
+    // parameter checks
+    NSAssert(identifier != nil, @"Bad identifier parameter.\n");
+
+    // build a menu item for the beverage
+    // every beverage item shares one target; -startBrewing: finds the beverage from the item's
+    // represented object, which survives the dock copying its menu items
+    item = [[[[self menuItemClass] alloc] initWithTitle:@""
+                                                 action:@selector(startBrewing:)
+                                          keyEquivalent:@""] autorelease];
+    [item setRepresentedObject:identifier];
+    [item setTarget:target];
+    [item setEnabled:YES];
+
+    return item;
+
+} // end +menuItemForIdentifier:target:
+
+// *************************************************************************************************
+
+// Returns the class of the menu items made (NSMenuItem).
++ (Class)menuItemClass
+{
+    // return requested info
+    return [NSMenuItem class];
+
+} // end +menuItemClass
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_BevyMenu
+
+// end Cuppa_BevyMenu.m
@@ -0,0 +1,78 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_BevySortKeys
+           - Remembers the sort key of each beverage name, so that names are only folded when they
+             are first sorted or have been renamed.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_BEVYSORTKEYS_H
+#define _CUPPA_BEVYSORTKEYS_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Class Interface
+
+// A sort key is a name case-folded and decomposed, so that an ordinal comparison of two keys
+// orders names the way caseInsensitiveCompare: does. Keys are kept by beverage identifier; the
+// owner must forget a beverage's key when it is renamed.
+@interface Cuppa_BevySortKeys : NSObject
+{
+    NSMutableDictionary *mKeys; // sort key of each beverage name, by beverage identifier
+    NSUInteger mFoldCount; // number of names folded into keys
+}
+
+// ------ Class Methods ------
+
+// Returns the sort key for a name.
++ (NSString *)keyForName:(NSString *)name;
+
+// ------ Life Cycle ------
+
+// Initialize with no keys.
+- (id)init;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Forget the key for a beverage, because it has been renamed or removed.
+- (void)forgetIdentifier:(NSString *)identifier;
+
+// Forget every key, because the whole beverage list has been replaced.
+- (void)forgetAll;
+
+// ------ Accessors ------
+
+// Returns the known sort key for a beverage, or nil if its name has not been folded yet.
+- (NSString *)keyForIdentifier:(NSString *)identifier;
+
+// Returns the sort key for a beverage's name, folding the name only if the key is not known.
+// A beverage without an identifier always has its name folded.
+- (NSString *)keyForName:(NSString *)name identifier:(NSString *)identifier;
+
+// Returns the number of keys known.
+- (NSUInteger)count;
+
+// Returns the number of names folded into keys.
+- (NSUInteger)foldCount;
+
+@end // @interface Cuppa_BevySortKeys
+
+// *************************************************************************************************
+
+#endif // _CUPPA_BEVYSORTKEYS_H
+
+// end Cuppa_BevySortKeys.h
@@ -0,0 +1,143 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_BevySortKeys
+           - Remembers the sort key of each beverage name, so that names are only folded when they
+             are first sorted or have been renamed.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_BevySortKeys.h"
+
+// Code!
+
+@implementation Cuppa_BevySortKeys
+;
+
+// *************************************************************************************************
+
+// Returns the sort key for a name.
++ (NSString *)keyForName:(NSString *)name
+{
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+
+    // fold the name the way caseInsensitiveCompare: sees it: that compares accented letters by
+    // their decomposed characters, so "e\u0301" and "\u00e9" are equal, and both come before "f"
+    return [[name stringByFoldingWithOptions:NSCaseInsensitiveSearch locale:nil]
+        decomposedStringWithCanonicalMapping];
+
+} // end +keyForName:
+
+// *************************************************************************************************
+
+// Initialize with no keys.
+- (id)init
+{
+    self = [super init];
+    mKeys = [[NSMutableDictionary alloc] init];
+    mFoldCount = 0;
+    return self;
+
+} // end -init
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the keys
+    [mKeys release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Forget the key for a beverage, because it has been renamed or removed.
+- (void)forgetIdentifier:(NSString *)identifier
+{
+    if ([identifier length] > 0)
+        [mKeys removeObjectForKey:identifier];
+
+} // end -forgetIdentifier:
+
+// *************************************************************************************************
+
+// Forget every key, because the whole beverage list has been replaced.
+- (void)forgetAll
+{
+    [mKeys removeAllObjects];
+
+} // end -forgetAll
+
+// *************************************************************************************************
+
+// Returns the known sort key for a beverage, or nil if its name has not been folded yet.
+- (NSString *)keyForIdentifier:(NSString *)identifier
+{
+    if ([identifier length] == 0)
+        return nil;
+
+    // return requested info
+    return [mKeys objectForKey:identifier];
+
+} // end -keyForIdentifier:
+
+// *************************************************************************************************
+
+// Returns the sort key for a beverage's name, folding the name only if the key is not known.
+// A beverage without an identifier always has its name folded.
+- (NSString *)keyForName:(NSString *)name identifier:(NSString *)identifier
+{
+    NSString *key; // sort key for the name
+
+    key = [self keyForIdentifier:identifier];
+    if (key)
+        return key;
+
+    // not known yet, so fold the name and remember it
+    key = [Cuppa_BevySortKeys keyForName:name];
+    mFoldCount++;
+    if ([identifier length] > 0)
+        [mKeys setObject:key forKey:identifier];
+
+    return key;
+
+} // end -keyForName:identifier:
+
+// *************************************************************************************************
+
+// Returns the number of keys known.
+- (NSUInteger)count
+{
+    // return requested info
+    return [mKeys count];
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the number of names folded into keys.
+- (NSUInteger)foldCount
+{
+    // return requested info
+    return mFoldCount;
+
+} // end -foldCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_BevySortKeys
+
+// end Cuppa_BevySortKeys.m
@@ -0,0 +1,127 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_BevyStore
+           - Saves the beverage list as a log of the changes made to it, so that an edit writes
+             only the beverage that changed rather than the whole list.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_BEVYSTORE_H
+#define _CUPPA_BEVYSTORE_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_PrefsWriter.h"
+
+// Constants
+
+enum
+{
+    CUPPA_BEVYSTORE_COMPACT_CHANGES = 200, // log length at which the whole list is written out
+    CUPPA_BEVYSTORE_CATALOG_ROWS = 1000 // list length at which a catalog is saved instead
+};
+
+// Class Interface
+
+// The whole list is kept in the preferences under "bevys", as it always has been, along with a
+// generation number. Changes since then are appended to a log file that starts with the same
+// generation; a log from any other generation is stale and is ignored. Compacting writes the
+// whole list out again and starts a new, empty log. The log is written on the preferences
+// writer's queue, so it stays in step with the list saved there.
+//
+// A long list is saved instead as a binary catalog named for its generation, alongside the log,
+// and the preferences only hold its name. The catalog is written on the queue too, copying rows
+// that have not been edited straight from the old one, and it is loaded lazily, as a
+// Cuppa_LazyBevys.
+//
+// The caller owns the editing: it changes the list returned by -load and then tells the store
+// what it did, which the store records.
+@interface Cuppa_BevyStore : NSObject
+{
+    Cuppa_PrefsWriter *mPrefs; // holds the compacted beverage list
+    NSString *mLogPath; // path of the change log
+    NSFileHandle *mLog; // change log open for appending, or nil (only used on the prefs queue)
+    NSMutableArray *mBevys; // live beverage list being stored
+    NSMutableDictionary *mPositions; // index of each beverage by identifier, while replaying
+    NSInteger mGeneration; // generation of the compacted list
+    NSUInteger mLogCount; // number of changes in the log
+    BOOL mCompactPending; // flag: a change found no log, so a compaction is on its way (queue)
+    unsigned long long mBytesWritten; // bytes written to the log and catalogs (queue)
+}
+
+// ------ Class Methods ------
+
+// Returns the standard location of the change log, in the application support folder.
++ (NSString *)defaultLogPath;
+
+// ------ Life Cycle ------
+
+// Initialize a store, keeping the compacted list in prefs and the change log at path.
+- (id)initWithPrefs:(Cuppa_PrefsWriter *)prefs logPath:(NSString *)path;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Load the beverage list, replaying the log over the compacted list. The returned list is the
+// live list the store saves; edit it in place and report each edit below.
+- (NSMutableArray *)load;
+
+// Replace the whole beverage list (such as when restoring defaults) and compact.
+- (void)replaceBevys:(NSMutableArray *)bevys;
+
+// Record that the name, brew time or cup shape of a beverage has changed.
+- (void)bevyChanged:(Cuppa_Bevy *)bevy;
+
+// Record that a beverage has been inserted into the list at index.
+- (void)bevyInserted:(Cuppa_Bevy *)bevy atIndex:(NSUInteger)index;
+
+// Record that a beverage has been removed from the list.
+- (void)bevyRemoved:(Cuppa_Bevy *)bevy;
+
+// Record that a beverage has been moved to index.
+- (void)bevyMoved:(Cuppa_Bevy *)bevy toIndex:(NSUInteger)index;
+
+// Record that the whole list has been put in a new order (such as by sorting).
+- (void)bevysReordered;
+
+// Write out the whole list and start a new, empty log.
+- (void)compact;
+
+// ------ Accessors ------
+
+// Returns the live beverage list.
+- (NSMutableArray *)bevys;
+
+// Returns the number of changes recorded since the last compaction.
+- (NSUInteger)logCount;
+
+// Returns the generation of the compacted list.
+- (NSInteger)generation;
+
+// Returns the number of bytes written to the log and catalogs so far (wait for the preferences
+// writer first, to count everything handed to it).
+- (unsigned long long)bytesWritten;
+
+@end // @interface Cuppa_BevyStore
+
+// *************************************************************************************************
+
+#endif // _CUPPA_BEVYSTORE_H
+
+// end Cuppa_BevyStore.h
@@ -0,0 +1,644 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_BevyStore
+           - Saves the beverage list as a log of the changes made to it, so that an edit writes
+             only the beverage that changed rather than the whole list.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_BevyStore.h"
+#import "Cuppa_Catalog.h"
+#import "Cuppa_LazyBevys.h"
+
+// Internal Constants
+
+// Preference keys for the compacted list and its generation
+static NSString *const sBevysKey = @"bevys";
+static NSString *const sGenerationKey = @"bevysGeneration";
+
+// Preference key for the name of the catalog a long compacted list is kept in instead
+static NSString *const sCatalogKey = @"bevysCatalog";
+
+// Change log record keys
+static NSString *const sChangeKey = @"change";
+static NSString *const sIndexKey = @"index";
+static NSString *const sIdentifierKey = @"identifier";
+static NSString *const sIdentifiersKey = @"identifiers";
+static NSString *const sGenerationRecordKey = @"generation";
+
+// Code!
+
+@implementation Cuppa_BevyStore
+;
+
+// *************************************************************************************************
+
+// Returns the standard location of the change log, in the application support folder.
++ (NSString *)defaultLogPath
+{
+    NSArray *folders; // application support folders
+    NSString *folder; // our folder within them
+    NSString *bundleID; // our bundle identifier
+
+    folders = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask,
+                                                  YES);
+    NSAssert([folders count] > 0, @"No application support folder.\n");
+    bundleID = [[NSBundle mainBundle] bundleIdentifier];
+    folder = [[folders objectAtIndex:0] stringByAppendingPathComponent:(bundleID ? bundleID
+                                                                                 : @"Cuppa")];
+    return [folder stringByAppendingPathComponent:@"Beverages.log"];
+
+} // end +defaultLogPath
+
+// *************************************************************************************************
+
+// Initialize a store, keeping the compacted list in prefs and the change log at path.
+- (id)initWithPrefs:(Cuppa_PrefsWriter *)prefs logPath:(NSString *)path
+{
+    // parameter checks
+    NSAssert(prefs != nil, @"Bad prefs parameter.\n");
+    NSAssert(path != nil, @"Bad path parameter.\n");
+
+    self = [super init];
+    mPrefs = [prefs retain];
+    mLogPath = [path copy];
+    mLog = nil;
+    mBevys = [[NSMutableArray alloc] init];
+    mPositions = nil;
+    mGeneration = 0;
+    mLogCount = 0;
+    mCompactPending = NO;
+    mBytesWritten = 0;
+    return self;
+
+} // end -initWithPrefs:logPath:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the log and the list, once the queue is done with them
+    [mPrefs waitUntilWritten];
+    [mLog closeFile];
+    [mLog release];
+    [mLogPath release];
+    [mPrefs release];
+    [mBevys release];
+    [mPositions release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Load the beverage list, replaying the log over the compacted list. The returned list is the
+// live list the store saves; edit it in place and report each edit below.
+- (NSMutableArray *)load
+{
+    NSString *name; // name of the catalog saved with the compacted list, if any
+    Cuppa_Catalog *catalog; // that catalog
+    NSArray *lines; // lines of the change log
+    NSDictionary *header; // first line of the change log
+    NSDictionary *record; // current log record
+    NSUInteger i; // loop counter
+    BOOL stale; // flag: the log does not apply to the compacted list
+    BOOL torn; // flag: the log ends in a partly written change
+
+    // start from the compacted list, read straight from its catalog if it was saved as one
+    [mBevys release];
+    mGeneration = [[mPrefs objectForKey:sGenerationKey] integerValue];
+    name = [mPrefs objectForKey:sCatalogKey];
+    catalog = nil;
+    if ([name isKindOfClass:[NSString class]])
+    {
+        name = [[mLogPath stringByDeletingLastPathComponent] stringByAppendingPathComponent:name];
+        catalog = [[Cuppa_Catalog alloc] initWithContentsOfFile:name];
+    }
+    if (catalog)
+        mBevys = [[Cuppa_LazyBevys alloc] initWithCatalog:catalog hotCapacity:CUPPA_LAZYBEVYS_HOT_ROWS];
+    else
+        mBevys = [[Cuppa_Bevy fromDictionary:[mPrefs objectForKey:sBevysKey]] retain];
+    [catalog release];
+    mLogCount = 0;
+
+    // the first line of the log says which compacted list it belongs to; a list saved without a
+    // generation was written whole, before the log existed (or is the registered default list,
+    // whose identifiers change every launch), so it has no usable log
+    lines = [[NSString stringWithContentsOfFile:mLogPath encoding:NSUTF8StringEncoding error:NULL]
+             componentsSeparatedByString:@"\n"];
+    header = ([lines count] > 0) ? [self recordFromLine:[lines objectAtIndex:0]] : nil;
+    stale = ([mPrefs objectForKey:sGenerationKey] == nil || header == nil ||
+             [[header objectForKey:sGenerationRecordKey] integerValue] != mGeneration);
+
+    // replay each change since then; a torn last line from a crash just fails to parse
+    torn = NO;
+    for (i = 1; !stale && i < [lines count]; i++)
+    {
+        record = [self recordFromLine:[lines objectAtIndex:i]];
+        if (record)
+        {
+            [self replay:record];
+            mLogCount++;
+        }
+        else if ([[lines objectAtIndex:i] length] > 0)
+        {
+            torn = YES;
+        }
+    }
+
+    [mPositions release];
+    mPositions = nil;
+
+#if !defined(NDEBUG)
+    printf("Loaded %lu bevys, replayed %lu changes%s\n", (unsigned long)[mBevys count],
+           (unsigned long)mLogCount, stale ? " (log stale)" : "");
+#endif
+
+    // write out a fresh list if the log is missing, stale, torn or due for it; otherwise keep
+    // adding to it
+    if (stale || torn || mLogCount >= CUPPA_BEVYSTORE_COMPACT_CHANGES)
+    {
+        [self compact];
+    }
+    else
+    {
+        [mPrefs performWrite:^{
+            [mLog release];
+            mLog = [[NSFileHandle fileHandleForWritingAtPath:mLogPath] retain];
+            [mLog seekToEndOfFile];
+            if (mLog)
+                mCompactPending = NO;
+        }];
+    }
+
+    return mBevys;
+
+} // end -load
+
+// *************************************************************************************************
+
+// Replace the whole beverage list (such as when restoring defaults) and compact.
+- (void)replaceBevys:(NSMutableArray *)bevys
+{
+    // parameter checks
+    NSAssert(bevys != nil, @"Bad bevys parameter.\n");
+
+    // record new info
+    [bevys retain];
+    [mBevys release];
+    mBevys = bevys;
+    [self compact];
+
+} // end -replaceBevys:
+
+// *************************************************************************************************
+
+// Record that the name, brew time or cup shape of a beverage has changed.
+- (void)bevyChanged:(Cuppa_Bevy *)bevy
+{
+    NSMutableDictionary *record; // log record
+
+    // parameter checks
+    NSAssert(bevy != nil, @"Bad bevy parameter.\n");
+
+    record = [bevy dictionary];
+    [record setObject:@"update" forKey:sChangeKey];
+    [self append:record];
+
+} // end -bevyChanged:
+
+// *************************************************************************************************
+
+// Record that a beverage has been inserted into the list at index.
+- (void)bevyInserted:(Cuppa_Bevy *)bevy atIndex:(NSUInteger)index
+{
+    NSMutableDictionary *record; // log record
+
+    // parameter checks
+    NSAssert(bevy != nil, @"Bad bevy parameter.\n");
+
+    record = [bevy dictionary];
+    [record setObject:@"insert" forKey:sChangeKey];
+    [record setObject:[NSNumber numberWithUnsignedInteger:index] forKey:sIndexKey];
+    [self append:record];
+
+} // end -bevyInserted:atIndex:
+
+// *************************************************************************************************
+
+// Record that a beverage has been removed from the list.
+- (void)bevyRemoved:(Cuppa_Bevy *)bevy
+{
+    // parameter checks
+    NSAssert(bevy != nil, @"Bad bevy parameter.\n");
+
+    [self append:[NSDictionary dictionaryWithObjectsAndKeys:@"remove", sChangeKey,
+                                                            [bevy identifier], sIdentifierKey,
+                                                            nil]];
+
+} // end -bevyRemoved:
+
+// *************************************************************************************************
+
+// Record that a beverage has been moved to index.
+- (void)bevyMoved:(Cuppa_Bevy *)bevy toIndex:(NSUInteger)index
+{
+    // parameter checks
+    NSAssert(bevy != nil, @"Bad bevy parameter.\n");
+
+    [self append:[NSDictionary dictionaryWithObjectsAndKeys:@"move", sChangeKey,
+                                                            [bevy identifier], sIdentifierKey,
+                                                            [NSNumber numberWithUnsignedInteger:index],
+                                                            sIndexKey,
+                                                            nil]];
+
+} // end -bevyMoved:toIndex:
+
+// *************************************************************************************************
+
+// Record that the whole list has been put in a new order (such as by sorting).
+- (void)bevysReordered
+{
+    NSMutableArray *identifiers; // identifiers in the new order
+    NSUInteger i; // loop counter
+
+    // read the identifiers through the rows, so a lazy list does not make an object of each
+    identifiers = [NSMutableArray arrayWithCapacity:[mBevys count]];
+    for (i = 0; i < [mBevys count]; i++)
+    {
+        [identifiers addObject:[mBevys bevyIdentifierAtIndex:i]];
+    }
+
+    [self append:[NSDictionary dictionaryWithObjectsAndKeys:@"order", sChangeKey,
+                                                            identifiers, sIdentifiersKey,
+                                                            nil]];
+
+} // end -bevysReordered
+
+// *************************************************************************************************
+
+// Write out the whole list and start a new, empty log.
+- (void)compact
+{
+    [self compactWithCatalog:([mBevys count] >= CUPPA_BEVYSTORE_CATALOG_ROWS)];
+
+} // end -compact
+
+// *************************************************************************************************
+
+// Write out the whole list, as a catalog or into the preferences, and start a new, empty log.
+- (void)compactWithCatalog:(BOOL)useCatalog
+{
+    NSInteger generation; // generation of the new log
+    NSArray *rows; // snapshot of the list, for the catalog
+    Cuppa_Catalog *catalog; // catalog the snapshot reads unchanged rows from
+    NSString *path; // path of the new catalog
+    __block BOOL written; // flag: the catalog was written
+
+    // the new list (and its generation) must be durable before the old log is replaced, so that
+    // a crash in between leaves a stale log behind rather than a list with changes missing
+    generation = ++mGeneration;
+    mLogCount = 0;
+    written = YES;
+    if (useCatalog)
+    {
+        // a long list is written on the queue, ahead of the preferences that name it; only rows
+        // that have been edited are converted here, the rest are copied from the old catalog
+        rows = [mBevys bevyRows];
+        catalog = [mBevys bevyCatalog];
+        path = [self catalogPathForGeneration:generation];
+        [mPrefs performWrite:^{
+            NSData *data; // the catalog
+
+            [[NSFileManager defaultManager]
+                      createDirectoryAtPath:[path stringByDeletingLastPathComponent]
+                withIntermediateDirectories:YES
+                                 attributes:nil
+                                      error:NULL];
+            data = [Cuppa_Catalog fromRows:rows ofCatalog:catalog];
+            written = [data writeToFile:path atomically:YES];
+            if (written)
+                mBytesWritten += [data length];
+        }];
+        [mPrefs removeObjectForKey:sBevysKey];
+        [mPrefs setObject:[path lastPathComponent] forKey:sCatalogKey];
+    }
+    else
+    {
+        [mPrefs setObject:[mBevys bevyDictionaries] forKey:sBevysKey];
+        [mPrefs removeObjectForKey:sCatalogKey];
+    }
+    [mPrefs setObject:[NSNumber numberWithInteger:generation] forKey:sGenerationKey];
+    [mPrefs checkpoint:^{
+        // if the catalog could not be written, the list has to go in the preferences after all
+        if (!written)
+        {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self compactWithCatalog:NO];
+            });
+            return;
+        }
+        [self removeCatalogsExceptGeneration:(useCatalog ? generation : 0)];
+        [self startLogForGeneration:generation];
+    }];
+
+#if !defined(NDEBUG)
+    printf("Compacted %lu bevys, generation %ld%s\n", (unsigned long)[mBevys count],
+           (long)generation, useCatalog ? " (catalog)" : "");
+#endif
+
+} // end -compactWithCatalog:
+
+// *************************************************************************************************
+
+// Returns the path of the catalog saved with a generation of the list.
+- (NSString *)catalogPathForGeneration:(NSInteger)generation
+{
+    return [[mLogPath stringByDeletingLastPathComponent] stringByAppendingPathComponent:
+            [NSString stringWithFormat:@"Beverages-%ld.catalog", (long)generation]];
+
+} // end -catalogPathForGeneration:
+
+// *************************************************************************************************
+
+// Remove every catalog but the one saved with a generation (or all of them, for generation 0).
+// Runs on the prefs queue, once the preferences no longer name the catalogs being removed.
+- (void)removeCatalogsExceptGeneration:(NSInteger)generation
+{
+    NSFileManager *files; // file manager
+    NSString *folder; // folder the catalogs are kept in
+    NSString *kept; // name of the catalog to keep
+    NSString *name; // name of a file in the folder
+
+    files = [NSFileManager defaultManager];
+    folder = [mLogPath stringByDeletingLastPathComponent];
+    kept = [[self catalogPathForGeneration:generation] lastPathComponent];
+
+    // older catalogs may still be mapped by the live list, which is fine once they are unlinked
+    for (name in [files contentsOfDirectoryAtPath:folder error:NULL])
+    {
+        if ([name hasPrefix:@"Beverages-"] && [[name pathExtension] isEqualToString:@"catalog"] &&
+            ![name isEqualToString:kept])
+        {
+            [files removeItemAtPath:[folder stringByAppendingPathComponent:name] error:NULL];
+        }
+    }
+
+} // end -removeCatalogsExceptGeneration:
+
+// *************************************************************************************************
+
+// Replace the log with an empty one for a generation of the list. Runs on the prefs queue.
+- (void)startLogForGeneration:(NSInteger)generation
+{
+    NSData *header; // first line of the new log
+
+    [mLog closeFile];
+    [mLog release];
+    mLog = nil;
+    header = [NSJSONSerialization dataWithJSONObject:[NSDictionary dictionaryWithObject:
+                                                      [NSNumber numberWithInteger:generation]
+                                                                                  forKey:sGenerationRecordKey]
+                                             options:0
+                                               error:NULL];
+    [[NSFileManager defaultManager] createDirectoryAtPath:[mLogPath stringByDeletingLastPathComponent]
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:NULL];
+    if ([header writeToFile:mLogPath atomically:YES])
+    {
+        mBytesWritten += [header length];
+        mLog = [[NSFileHandle fileHandleForWritingAtPath:mLogPath] retain];
+        [mLog seekToEndOfFile];
+    }
+
+    // changes can be logged again; if the log could not be started, they are dropped until the
+    // next compaction, rather than each one compacting again
+    if (mLog)
+        mCompactPending = NO;
+
+} // end -startLogForGeneration:
+
+// *************************************************************************************************
+
+// Append a change to the log, compacting once the log is long enough.
+- (void)append:(NSDictionary *)record
+{
+    // the record is encoded and written on the queue, in step with the list it applies to
+    [mPrefs performWrite:^{
+        [self writeRecord:record];
+    }];
+
+    if (++mLogCount >= CUPPA_BEVYSTORE_COMPACT_CHANGES)
+        [self compact];
+
+} // end -append:
+
+// *************************************************************************************************
+
+// Write a change to the end of the log. Runs on the prefs queue.
+- (void)writeRecord:(NSDictionary *)record
+{
+    NSMutableData *data; // record as a line of the log
+
+    // without a log, the only way to save the change is to write the whole list; one compaction
+    // saves this change and every one after it up to the compaction, so those are dropped
+    if (!mLog)
+    {
+        if (!mCompactPending)
+        {
+            mCompactPending = YES;
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self compact];
+            });
+        }
+        return;
+    }
+
+    // one record per line, so a torn write only loses the last change
+    data = [NSMutableData dataWithData:[NSJSONSerialization dataWithJSONObject:record
+                                                                        options:0
+                                                                          error:NULL]];
+    [data appendBytes:"\n" length:1];
+    [mLog writeData:data];
+    mBytesWritten += [data length];
+
+} // end -writeRecord:
+
+// *************************************************************************************************
+
+// Returns the log record on a line of the log, or nil if there is not a valid one.
+- (NSDictionary *)recordFromLine:(NSString *)line
+{
+    NSData *data; // line as data
+    id record; // parsed line
+
+    data = [line dataUsingEncoding:NSUTF8StringEncoding];
+    if ([data length] == 0)
+        return nil;
+    record = [NSJSONSerialization JSONObjectWithData:data options:0 error:NULL];
+    return [record isKindOfClass:[NSDictionary class]] ? record : nil;
+
+} // end -recordFromLine:
+
+// *************************************************************************************************
+
+// Apply a change from the log to the live list.
+- (void)replay:(NSDictionary *)record
+{
+    NSString *change; // kind of change
+    NSUInteger index; // current index of the beverage the change is about
+    NSUInteger target; // index the change puts it at
+    Cuppa_Bevy *bevy; // beverage the change is about
+    NSArray *identifiers; // new order of the list
+    NSUInteger *rows; // row each row of the new order comes from
+    bool *placed; // flag for each row: already placed in the new order?
+    NSUInteger count; // number of rows placed so far
+    NSUInteger i; // loop counter
+
+    change = [record objectForKey:sChangeKey];
+    index = [self indexOfIdentifier:[record objectForKey:sIdentifierKey]];
+    target = MIN((NSUInteger)[[record objectForKey:sIndexKey] integerValue], [mBevys count]);
+
+    if ([change isEqualToString:@"update"] && index != NSNotFound)
+    {
+        [[mBevys objectAtIndex:index] updateFromDictionary:record];
+        return;
+    }
+    else if ([change isEqualToString:@"insert"] && index == NSNotFound)
+    {
+        [mBevys insertObject:[Cuppa_Bevy bevyFromDictionary:record] atIndex:target];
+    }
+    else if ([change isEqualToString:@"remove"] && index != NSNotFound)
+    {
+        [mBevys removeObjectAtIndex:index];
+    }
+    else if ([change isEqualToString:@"move"] && index != NSNotFound)
+    {
+        bevy = [[mBevys objectAtIndex:index] retain];
+        [mBevys removeObjectAtIndex:index];
+        [mBevys insertObject:bevy atIndex:MIN(target, [mBevys count])];
+        [bevy release];
+    }
+    else if ([change isEqualToString:@"order"])
+    {
+        // the rows are moved by index, so a lazy list does not make an object of each of them;
+        // anything the order does not mention keeps its place after the rest
+        identifiers = [record objectForKey:sIdentifiersKey];
+        rows = malloc(([mBevys count] + 1) * sizeof(NSUInteger));
+        placed = calloc([mBevys count] + 1, sizeof(bool));
+        NSAssert(rows != NULL && placed != NULL, @"Out of memory for the new order.\n");
+        count = 0;
+        for (i = 0; i < [identifiers count]; i++)
+        {
+            index = [self indexOfIdentifier:[identifiers objectAtIndex:i]];
+            if (index != NSNotFound && !placed[index])
+            {
+                rows[count++] = index;
+                placed[index] = true;
+            }
+        }
+        for (i = 0; i < [mBevys count]; i++)
+        {
+            if (!placed[i])
+                rows[count++] = i;
+        }
+        [mBevys reorderBevysByRows:rows];
+        free(rows);
+        free(placed);
+    }
+    else
+    {
+        return;
+    }
+
+    // the list has changed shape, so every index has to be found again
+    [mPositions release];
+    mPositions = nil;
+
+} // end -replay:
+
+// *************************************************************************************************
+
+// Returns the index in the live list of the beverage with an identifier, or NSNotFound.
+// Only used while replaying the log, when the indexes are looked up once and remembered.
+- (NSUInteger)indexOfIdentifier:(NSString *)identifier
+{
+    NSUInteger i; // loop counter
+    NSNumber *index; // remembered index
+
+    if (!identifier)
+        return NSNotFound;
+    if (!mPositions)
+    {
+        mPositions = [[NSMutableDictionary alloc] initWithCapacity:[mBevys count]];
+        for (i = 0; i < [mBevys count]; i++)
+        {
+            [mPositions setObject:[NSNumber numberWithUnsignedInteger:i]
+                           forKey:[mBevys bevyIdentifierAtIndex:i]];
+        }
+    }
+    index = [mPositions objectForKey:identifier];
+    return index ? [index unsignedIntegerValue] : NSNotFound;
+
+} // end -indexOfIdentifier:
+
+// *************************************************************************************************
+
+// Returns the live beverage list.
+- (NSMutableArray *)bevys
+{
+    // return requested info
+    return mBevys;
+
+} // end -bevys
+
+// *************************************************************************************************
+
+// Returns the number of changes recorded since the last compaction.
+- (NSUInteger)logCount
+{
+    // return requested info
+    return mLogCount;
+
+} // end -logCount
+
+// *************************************************************************************************
+
+// Returns the generation of the compacted list.
+- (NSInteger)generation
+{
+    // return requested info
+    return mGeneration;
+
+} // end -generation
+
+// *************************************************************************************************
+
+// Returns the number of bytes written to the log and catalogs so far (wait for the preferences
+// writer first, to count everything handed to it).
+- (unsigned long long)bytesWritten
+{
+    // return requested info
+    return mBytesWritten;
+
+} // end -bytesWritten
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_BevyStore
+
+// end Cuppa_BevyStore.m
@@ -0,0 +1,99 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_Brew
+           - The Brew class tracks a single active timer, such as which beverage is steeping and
+             when it will be ready.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_BREW_H
+#define _CUPPA_BREW_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+
+// Class Interface
+
+@interface Cuppa_Brew : NSObject
+{
+    NSString *mName; // name of the beverage being brewed
+    int mBrewTime; // total brew time in seconds
+    int mCupShape; // cup shape of the beverage, a shape code from Cuppa_Shape.h
+    NSString *mAlarmSound; // path of the beverage's own alarm sound, or nil for the usual one
+    NSTimeInterval mDeadline; // absolute time when the brew is complete
+    NSUInteger mTimerID; // identifier of this brew in the timer queue
+    int mSecondsShown; // seconds remaining when the brew was last checked
+    NSString *mIdentifier; // unique identifier for the brew's notification
+    bool mNotifyScheduled; // flag: completion notification has been scheduled?
+}
+
+// ------ Life Cycle ------
+
+// Initialize a brew of a beverage, completing at deadline.
+// The beverage details are copied, so later edits to the beverage do not affect the brew.
+- (id)initWithBevy:(Cuppa_Bevy *)bevy deadline:(NSTimeInterval)deadline;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Sets the identifier of this brew in the timer queue.
+- (void)setTimerID:(NSUInteger)timerID;
+
+// Sets the seconds remaining when the brew was last checked.
+- (void)setSecondsShown:(int)secondsShown;
+
+// Sets whether the completion notification has been scheduled.
+- (void)setNotifyScheduled:(bool)notifyScheduled;
+
+// ------ Accessors ------
+
+// Returns the name of the beverage being brewed.
+- (NSString *)name;
+
+// Returns the total brew time in seconds.
+- (int)brewTime;
+
+// Returns the cup shape of the beverage being brewed.
+- (int)cupShape;
+
+// Returns the path of the beverage's own alarm sound, or nil for the usual one.
+- (NSString *)alarmSound;
+
+// Returns the absolute time when the brew is complete.
+- (NSTimeInterval)deadline;
+
+// Returns the identifier of this brew in the timer queue.
+- (NSUInteger)timerID;
+
+// Returns the seconds remaining when the brew was last checked.
+- (int)secondsShown;
+
+// Returns a unique identifier for the brew's notification.
+- (NSString *)identifier;
+
+// Returns whether the completion notification has been scheduled.
+- (bool)notifyScheduled;
+
+@end // @interface Cuppa_Brew
+
+// *************************************************************************************************
+
+#endif // _CUPPA_BREW_H
+
+// end Cuppa_Brew.h
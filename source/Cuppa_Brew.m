@@ -0,0 +1,188 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_Brew
+           - The Brew class tracks a single active timer, such as which beverage is steeping and
+             when it will be ready.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Brew.h"
+#import "Cuppa_TimerQueue.h"
+
+// Code!
+
+@implementation Cuppa_Brew
+;
+
+// *************************************************************************************************
+
+// Initialize a brew of a beverage, completing at deadline.
+// The beverage details are copied, so later edits to the beverage do not affect the brew.
+- (id)initWithBevy:(Cuppa_Bevy *)bevy deadline:(NSTimeInterval)deadline
+{
+    // parameter checks
+    NSAssert(bevy != nil, @"Bad bevy parameter.\n");
+
+    self = [super init];
+    mName = [[bevy name] copy];
+    mBrewTime = [bevy brewTime];
+    mCupShape = [bevy cupShape];
+    mAlarmSound = [[bevy alarmSound] copy];
+    mDeadline = deadline;
+    mTimerID = CUPPA_TIMER_NONE;
+    mSecondsShown = mBrewTime;
+    mIdentifier = [[[NSUUID UUID] UUIDString] copy];
+    mNotifyScheduled = false;
+    return self;
+
+} // end -initWithBevy:deadline:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the strings
+    [mName release];
+    [mAlarmSound release];
+    [mIdentifier release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Sets the identifier of this brew in the timer queue.
+- (void)setTimerID:(NSUInteger)timerID
+{
+    // record new info
+    mTimerID = timerID;
+
+} // end -setTimerID:
+
+// *************************************************************************************************
+
+// Sets the seconds remaining when the brew was last checked.
+- (void)setSecondsShown:(int)secondsShown
+{
+    // record new info
+    mSecondsShown = secondsShown;
+
+} // end -setSecondsShown:
+
+// *************************************************************************************************
+
+// Sets whether the completion notification has been scheduled.
+- (void)setNotifyScheduled:(bool)notifyScheduled
+{
+    // record new info
+    mNotifyScheduled = notifyScheduled;
+
+} // end -setNotifyScheduled:
+
+// *************************************************************************************************
+
+// Returns the name of the beverage being brewed.
+- (NSString *)name
+{
+    // return requested info
+    return mName;
+
+} // end -name
+
+// *************************************************************************************************
+
+// Returns the total brew time in seconds.
+- (int)brewTime
+{
+    // return requested info
+    return mBrewTime;
+
+} // end -brewTime
+
+// *************************************************************************************************
+
+// Returns the cup shape of the beverage being brewed.
+- (int)cupShape
+{
+    // return requested info
+    return mCupShape;
+
+} // end -cupShape
+
+// *************************************************************************************************
+
+// Returns the path of the beverage's own alarm sound, or nil for the usual one.
+- (NSString *)alarmSound
+{
+    // return requested info
+    return mAlarmSound;
+
+} // end -alarmSound
+
+// *************************************************************************************************
+
+// Returns the absolute time when the brew is complete.
+- (NSTimeInterval)deadline
+{
+    // return requested info
+    return mDeadline;
+
+} // end -deadline
+
+// *************************************************************************************************
+
+// Returns the identifier of this brew in the timer queue.
+- (NSUInteger)timerID
+{
+    // return requested info
+    return mTimerID;
+
+} // end -timerID
+
+// *************************************************************************************************
+
+// Returns the seconds remaining when the brew was last checked.
+- (int)secondsShown
+{
+    // return requested info
+    return mSecondsShown;
+
+} // end -secondsShown
+
+// *************************************************************************************************
+
+// Returns a unique identifier for the brew's notification.
+- (NSString *)identifier
+{
+    // return requested info
+    return mIdentifier;
+
+} // end -identifier
+
+// *************************************************************************************************
+
+// Returns whether the completion notification has been scheduled.
+- (bool)notifyScheduled
+{
+    // return requested info
+    return mNotifyScheduled;
+
+} // end -notifyScheduled
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_Brew
+
+// end Cuppa_Brew.m
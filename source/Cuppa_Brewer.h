@@ -0,0 +1,127 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_Brewer
+           - The Brewer class runs the brew state machine: it starts, counts down and completes
+             brews against a clock, and reports what happens to a delegate.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_BREWER_H
+#define _CUPPA_BREWER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Brew.h"
+#import "Cuppa_Clock.h"
+#import "Cuppa_TimerBackend.h"
+
+// Protocol Interface
+
+@class Cuppa_Brewer;
+
+// Receives the events of a brewer. Times are read from the brewer's clock.
+@protocol Cuppa_BrewerDelegate <NSObject>
+
+// The countdown of the next brew to complete should now show secondsRemain.
+- (void)brewer:(Cuppa_Brewer *)brewer showBrew:(Cuppa_Brew *)brew secondsRemain:(int)secondsRemain;
+
+// A brew has reached a new second of its final countdown (only when sound is on).
+- (void)brewerBeep:(Cuppa_Brewer *)brewer;
+
+// A brew is complete.
+- (void)brewer:(Cuppa_Brewer *)brewer brewComplete:(Cuppa_Brew *)brew;
+
+// The last active brew is complete.
+- (void)brewerIdle:(Cuppa_Brewer *)brewer;
+
+// The brewer next needs a tick at time, or never if time is INFINITY.
+- (void)brewer:(Cuppa_Brewer *)brewer wakeAt:(NSTimeInterval)time;
+
+@end // @protocol Cuppa_BrewerDelegate
+
+// Class Interface
+
+@interface Cuppa_Brewer : NSObject
+{
+    Cuppa_Clock *mClock; // time source for brew deadlines
+    id<Cuppa_TimerBackend> mBrews; // active brews (Cuppa_Brew objects), ordered by deadline
+    id<Cuppa_BrewerDelegate> mDelegate; // receives brew events (not retained)
+    BOOL mShowTimer; // flag: countdown timer is shown?
+    BOOL mMakeSound; // flag: countdown beeps are played?
+    NSTimeInterval mNextWakeup; // time the next tick is needed, or INFINITY
+}
+
+// ------ Life Cycle ------
+
+// Initialize a brewer that times brews by clock, tracking them in backend.
+- (id)initWithClock:(Cuppa_Clock *)clock backend:(id<Cuppa_TimerBackend>)backend;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Sets the object that receives brew events.
+- (void)setDelegate:(id<Cuppa_BrewerDelegate>)delegate;
+
+// Sets whether the countdown timer is shown.
+- (void)setShowTimer:(BOOL)showTimer;
+
+// Sets whether countdown beeps are played.
+- (void)setMakeSound:(BOOL)makeSound;
+
+// Start brewing a beverage, alongside any brews already under way. Returns the new brew.
+- (Cuppa_Brew *)startBrew:(Cuppa_Bevy *)bevy;
+
+// Cancel all active brews.
+- (void)cancelAllBrews;
+
+// Bring the countdown up to date and complete any brews whose deadline has passed.
+- (void)tick;
+
+// Run a brewer on a virtual clock forward to time, ticking at each wakeup it asks for, so brews
+// can be simulated without waiting for them. Returns the number of ticks.
+- (NSUInteger)runUntil:(NSTimeInterval)time;
+
+// ------ Accessors ------
+
+// Returns the time source for brew deadlines.
+- (Cuppa_Clock *)clock;
+
+// Returns the number of active brews.
+- (NSUInteger)count;
+
+// Returns the next brew to complete, or nil if there are no active brews.
+- (Cuppa_Brew *)nextBrew;
+
+// Returns the deadline of the last brew to complete, or 0 if there are no active brews.
+- (NSTimeInterval)lastDeadline;
+
+// Returns the time the next tick is needed, or INFINITY if there are no active brews.
+- (NSTimeInterval)nextWakeup;
+
+// Call block for every active brew, in no particular order. The block must not start or cancel
+// brews.
+- (void)enumerateBrewsUsingBlock:(void (^)(Cuppa_Brew *brew))block;
+
+@end // @interface Cuppa_Brewer
+
+// *************************************************************************************************
+
+#endif // _CUPPA_BREWER_H
+
+// end Cuppa_Brewer.h
@@ -0,0 +1,337 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_Brewer
+           - The Brewer class runs the brew state machine: it starts, counts down and completes
+             brews against a clock, and reports what happens to a delegate.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Brewer.h"
+#import "Cuppa_Schedule.h"
+
+// Code!
+
+@implementation Cuppa_Brewer
+;
+
+// *************************************************************************************************
+
+// Initialize a brewer that times brews by clock, tracking them in backend.
+- (id)initWithClock:(Cuppa_Clock *)clock backend:(id<Cuppa_TimerBackend>)backend
+{
+    // parameter checks
+    NSAssert(clock != nil, @"Bad clock parameter.\n");
+    NSAssert(backend != nil, @"Bad backend parameter.\n");
+    NSAssert([backend count] == 0, @"Backend already has timers.\n");
+
+    self = [super init];
+    mClock = [clock retain];
+    mBrews = [backend retain];
+    mDelegate = nil;
+    mShowTimer = YES;
+    mMakeSound = YES;
+    mNextWakeup = INFINITY;
+    return self;
+
+} // end -initWithClock:backend:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the brews and the clock
+    [mBrews release];
+    [mClock release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Work out when the next tick is needed and tell the delegate.
+- (void)scheduleWakeup
+{
+    NSTimeInterval now; // current time
+    __block NSTimeInterval wakeup; // delay until the next badge change, beep or alarm
+
+    // nothing to wake up for if there are no active brews
+    if ([mBrews count] == 0)
+    {
+        mNextWakeup = INFINITY;
+        [mDelegate brewer:self wakeAt:mNextWakeup];
+        return;
+    }
+
+    // only wake up when something visible or audible happens, rather than every second;
+    // the countdown timer follows the next brew to complete
+    now = [mClock now];
+    wakeup = CuppaScheduleNextWakeup([(Cuppa_Brew *)[mBrews nextObject] deadline] - now,
+                                     mShowTimer, mMakeSound);
+
+    // other brews can only beep before then if they are nearly done
+    if (mMakeSound)
+    {
+        [mBrews enumerateTimersDueBefore:(now + wakeup + CUPPA_SCHEDULE_BEEP_SECONDS + 1)
+                              usingBlock:^(id object, NSTimeInterval deadline)
+        {
+            wakeup = MIN(wakeup, CuppaScheduleNextWakeup(deadline - now, false, true));
+        }];
+    }
+
+    mNextWakeup = now + wakeup;
+    [mDelegate brewer:self wakeAt:mNextWakeup];
+
+} // end -scheduleWakeup
+
+// *************************************************************************************************
+
+// Sets the object that receives brew events.
+- (void)setDelegate:(id<Cuppa_BrewerDelegate>)delegate
+{
+    // record new info
+    mDelegate = delegate;
+
+} // end -setDelegate:
+
+// *************************************************************************************************
+
+// Sets whether the countdown timer is shown.
+- (void)setShowTimer:(BOOL)showTimer
+{
+    // record new info
+    mShowTimer = showTimer;
+
+    // show or hide the countdown timer now, rather than at the next wakeup
+    if ([mBrews count] > 0)
+    {
+        [self tick];
+    }
+
+} // end -setShowTimer:
+
+// *************************************************************************************************
+
+// Sets whether countdown beeps are played.
+- (void)setMakeSound:(BOOL)makeSound
+{
+    // record new info
+    mMakeSound = makeSound;
+
+    // countdown beeps change when the next tick is needed
+    if ([mBrews count] > 0)
+    {
+        [self scheduleWakeup];
+    }
+
+} // end -setMakeSound:
+
+// *************************************************************************************************
+
+// Start brewing a beverage, alongside any brews already under way. Returns the new brew.
+- (Cuppa_Brew *)startBrew:(Cuppa_Bevy *)bevy
+{
+    Cuppa_Brew *brew; // the new brew
+
+    // parameter checks
+    NSAssert(bevy != nil, @"Bad bevy parameter.\n");
+
+    brew = [[[Cuppa_Brew alloc] initWithBevy:bevy deadline:([mClock now] + [bevy brewTime])]
+            autorelease];
+    [brew setTimerID:[mBrews addTimerWithDeadline:[brew deadline] object:brew]];
+
+    // show the new countdown and arm the next tick
+    [self tick];
+
+    return brew;
+
+} // end -startBrew:
+
+// *************************************************************************************************
+
+// Cancel all active brews.
+- (void)cancelAllBrews
+{
+    [mBrews removeAllTimers];
+    [self scheduleWakeup];
+
+} // end -cancelAllBrews
+
+// *************************************************************************************************
+
+// Bring the countdown up to date and complete any brews whose deadline has passed.
+- (void)tick
+{
+    NSTimeInterval now; // current time
+    NSMutableArray *completed; // brews whose deadline has passed
+    Cuppa_Brew *brew; // brew being checked
+    int secondsRemain; // seconds remaining in the next brew to complete
+    __block BOOL beep; // flag: a brew reached a new second of its countdown
+
+    // collect every brew whose deadline has passed
+    now = [mClock now];
+    completed = [NSMutableArray array];
+    while ((brew = [mBrews popTimerDueBy:now]) != nil)
+    {
+        [completed addObject:brew];
+    }
+
+    // still timing?
+    if ([mBrews count] > 0)
+    {
+        // the countdown timer shows the next brew to complete
+        brew = [mBrews nextObject];
+        secondsRemain = CuppaScheduleSecondsRemain([brew deadline] - now);
+        if (secondsRemain > [brew brewTime])
+        {
+            // never show more than the full brew time
+            secondsRemain = [brew brewTime];
+        }
+        [mDelegate brewer:self showBrew:brew secondsRemain:secondsRemain];
+
+        // emit a beep for the final 5 seconds, once per second however many brews are ending
+        beep = NO;
+        [mBrews enumerateTimersDueBefore:(now + CUPPA_SCHEDULE_BEEP_SECONDS + 1)
+                              usingBlock:^(id object, NSTimeInterval deadline)
+        {
+            Cuppa_Brew *endingBrew = (Cuppa_Brew *)object;
+            int secs = CuppaScheduleSecondsRemain(deadline - now);
+            if (secs <= CUPPA_SCHEDULE_BEEP_SECONDS && secs != [endingBrew secondsShown])
+            {
+                [endingBrew setSecondsShown:secs];
+                beep = YES;
+            }
+        }];
+        if (mMakeSound && beep)
+        {
+            [mDelegate brewerBeep:self];
+        }
+    }
+    else if ([completed count] > 0)
+    {
+        [mDelegate brewerIdle:self];
+    }
+
+    // sleep until the next time anything changes
+    [self scheduleWakeup];
+
+    // or are some beverages ready?
+    for (brew in completed)
+    {
+        [mDelegate brewer:self brewComplete:brew];
+    }
+
+} // end -tick
+
+// *************************************************************************************************
+
+// Run a brewer on a virtual clock forward to time, ticking at each wakeup it asks for, so brews
+// can be simulated without waiting for them. Returns the number of ticks.
+- (NSUInteger)runUntil:(NSTimeInterval)time
+{
+    NSUInteger ticks = 0; // ticks run so far
+
+    // parameter checks
+    NSAssert([mClock policy] == CUPPA_CLOCK_VIRTUAL,
+             @"Brews can only be simulated on a virtual clock.\n");
+
+    while (mNextWakeup <= time)
+    {
+        [mClock setVirtualTime:MAX(mNextWakeup, [mClock now])];
+        [self tick];
+        ticks++;
+    }
+    if (time > [mClock now])
+    {
+        [mClock setVirtualTime:time];
+    }
+
+    return ticks;
+
+} // end -runUntil:
+
+// *************************************************************************************************
+
+// Returns the time source for brew deadlines.
+- (Cuppa_Clock *)clock
+{
+    // return requested info
+    return mClock;
+
+} // end -clock
+
+// *************************************************************************************************
+
+// Returns the number of active brews.
+- (NSUInteger)count
+{
+    // return requested info
+    return [mBrews count];
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the next brew to complete, or nil if there are no active brews.
+- (Cuppa_Brew *)nextBrew
+{
+    // return requested info
+    return [mBrews nextObject];
+
+} // end -nextBrew
+
+// *************************************************************************************************
+
+// Returns the deadline of the last brew to complete, or 0 if there are no active brews.
+- (NSTimeInterval)lastDeadline
+{
+    __block NSTimeInterval lastDeadline = 0.0; // latest deadline so far
+
+    [mBrews enumerateTimersDueBefore:INFINITY usingBlock:^(id object, NSTimeInterval deadline)
+    {
+        lastDeadline = MAX(lastDeadline, deadline);
+    }];
+
+    return lastDeadline;
+
+} // end -lastDeadline
+
+// *************************************************************************************************
+
+// Returns the time the next tick is needed, or INFINITY if there are no active brews.
+- (NSTimeInterval)nextWakeup
+{
+    // return requested info
+    return mNextWakeup;
+
+} // end -nextWakeup
+
+// *************************************************************************************************
+
+// Call block for every active brew, in no particular order. The block must not start or cancel
+// brews.
+- (void)enumerateBrewsUsingBlock:(void (^)(Cuppa_Brew *brew))block
+{
+    [mBrews enumerateTimersDueBefore:INFINITY usingBlock:^(id object, NSTimeInterval deadline)
+    {
+        block((Cuppa_Brew *)object);
+    }];
+
+} // end -enumerateBrewsUsingBlock:
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_Brewer
+
+// end Cuppa_Brewer.m
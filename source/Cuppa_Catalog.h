@@ -0,0 +1,132 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_Catalog
+           - A beverage list in a compact binary file, read in place (memory-mapped) a field at a
+             time instead of being loaded whole.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_CATALOG_H
+#define _CUPPA_CATALOG_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+
+// Constants
+
+enum
+{
+    CUPPA_CATALOG_VERSION = 2, // format version written, and the only one read
+    CUPPA_CATALOG_HEADER_SIZE = 32, // bytes in the file header
+    CUPPA_CATALOG_RECORD_SIZE = 20 // bytes in each beverage record
+};
+
+// Class Interface
+
+// The file is little-endian throughout:
+//
+//   header   "CUPC", version, record size, record count, string count, offset of the string
+//            offsets, offset of the string bytes, length of the string bytes (eight 32-bit words)
+//   records  one per beverage: string numbers of the name, identifier, cup shape label and alarm
+//            sound path (empty for the usual sound), then the brew time (five 32-bit words)
+//   offsets  string count + 1 words; string n is the bytes from offset n to offset n + 1
+//   bytes    the UTF-8 text of every distinct string, each stored once
+//
+// Opening a catalog only checks the header; every field read is bounds checked, and a field
+// that is out of bounds reads as empty.
+@interface Cuppa_Catalog : NSObject
+{
+    NSData *mData; // catalog file contents (mapped where possible)
+    const uint8_t *mRecords; // first beverage record
+    const uint8_t *mOffsets; // first string offset
+    const uint8_t *mStrings; // first string byte
+    NSUInteger mCount; // number of beverage records
+    NSUInteger mStringCount; // number of distinct strings
+    NSUInteger mStringsLength; // number of string bytes
+    NSUInteger *mNameHandles; // name arena handle held for each string read as a name (and for
+                              // an empty name after the last), or NSNotFound
+}
+
+// ------ Class Methods ------
+
+// Convert an array of beverage dictionaries (as stored in user defaults) to catalog data.
++ (NSData *)fromDictionary:(NSArray *)dictArray;
+
+// Convert rows to catalog data. Each row is a beverage dictionary, or the index (NSNumber) of a
+// beverage in catalog, which is copied from there without being decoded. Safe to call on any
+// thread, as long as nothing else changes the rows.
++ (NSData *)fromRows:(NSArray *)rows ofCatalog:(Cuppa_Catalog *)catalog;
+
+// Convert an array of beverages to catalog data.
++ (NSData *)fromBevys:(NSArray *)bevyArray;
+
+// ------ Life Cycle ------
+
+// Initialize a catalog reading data. Returns nil if the data is not a catalog this version reads.
+- (id)initWithData:(NSData *)data;
+
+// Initialize a catalog reading a file, mapped into memory where possible. Returns nil if the file
+// cannot be read or is not a catalog this version reads.
+- (id)initWithContentsOfFile:(NSString *)path;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Accessors ------
+
+// Returns the number of beverages in the catalog.
+- (NSUInteger)count;
+
+// Returns the name of the beverage at index.
+- (NSString *)nameAtIndex:(NSUInteger)index;
+
+// Returns the handle of the name of the beverage at index in the shared Cuppa_NameArena, held for
+// the life of the catalog. Each distinct name in the catalog is only decoded the first time it is
+// read.
+- (NSUInteger)nameHandleAtIndex:(NSUInteger)index;
+
+// Returns the stable identifier of the beverage at index.
+- (NSString *)identifierAtIndex:(NSUInteger)index;
+
+// Returns the brew time of the beverage at index, clamped to the allowed range.
+- (int)brewTimeAtIndex:(NSUInteger)index;
+
+// Returns the cup shape of the beverage at index, a shape code from Cuppa_Shape.h.
+- (int)cupShapeAtIndex:(NSUInteger)index;
+
+// Returns the path of the alarm sound of the beverage at index, or nil for the usual sound.
+- (NSString *)alarmSoundAtIndex:(NSUInteger)index;
+
+// Returns a new beverage object for the beverage at index.
+- (Cuppa_Bevy *)bevyAtIndex:(NSUInteger)index;
+
+// Returns new beverage objects for the whole catalog.
+- (NSMutableArray *)bevys;
+
+// Returns the beverage at index as a dictionary, in the form Cuppa_Bevy stores in user defaults.
+- (NSMutableDictionary *)dictionaryAtIndex:(NSUInteger)index;
+
+// Convert the catalog to an array of beverage dictionaries, to allow user defaults storage.
+- (NSMutableArray *)toDictionary;
+
+@end // @interface Cuppa_Catalog
+
+// *************************************************************************************************
+
+#endif // _CUPPA_CATALOG_H
+
+// end Cuppa_Catalog.h
@@ -0,0 +1,538 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_Catalog
+           - A beverage list in a compact binary file, read in place (memory-mapped) a field at a
+             time instead of being loaded whole.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Catalog.h"
+#import "Cuppa_NameArena.h"
+#import "Cuppa_ShapeTable.h"
+
+// Internal Constants
+
+// Identifies a catalog file
+static const char sMagic[4] = { 'C', 'U', 'P', 'C' };
+
+// Word numbers of the header fields (after the magic) and of the record fields
+enum
+{
+    sHeaderVersion = 1,
+    sHeaderRecordSize,
+    sHeaderCount,
+    sHeaderStringCount,
+    sHeaderOffsets,
+    sHeaderStrings,
+    sHeaderStringsLength
+};
+enum
+{
+    sRecordName = 0,
+    sRecordIdentifier,
+    sRecordCupShape,
+    sRecordAlarmSound,
+    sRecordBrewTime
+};
+
+// Code!
+
+// Returns word n of a little-endian table, which need not be aligned.
+static inline uint32_t CuppaCatalogWord(const uint8_t *table, NSUInteger n)
+{
+    uint32_t word; // word as stored
+
+    memcpy(&word, table + (n * sizeof(word)), sizeof(word));
+    return NSSwapLittleIntToHost(word);
+}
+
+// Appends a word to data, little-endian.
+static inline void CuppaCatalogAppendWord(NSMutableData *data, NSUInteger value)
+{
+    uint32_t word = NSSwapHostIntToLittle((uint32_t)value); // word as stored
+
+    [data appendBytes:&word length:sizeof(word)];
+}
+
+@implementation Cuppa_Catalog
+;
+
+// *************************************************************************************************
+
+// Convert an array of beverage dictionaries (as stored in user defaults) to catalog data.
++ (NSData *)fromDictionary:(NSArray *)dictArray
+{
+    // parameter checks
+    NSAssert(dictArray != nil, @"Bad dictionary array parameter.\n");
+
+    return [self fromRows:dictArray ofCatalog:nil];
+
+} // end +fromDictionary:
+
+// *************************************************************************************************
+
+// Convert rows to catalog data. Each row is a beverage dictionary, or the index (NSNumber) of a
+// beverage in catalog, which is copied from there without being decoded. Safe to call on any
+// thread, as long as nothing else changes the rows.
++ (NSData *)fromRows:(NSArray *)rows ofCatalog:(Cuppa_Catalog *)catalog
+{
+    NSMutableData *data; // catalog being written
+    NSMutableData *records; // beverage records
+    NSMutableData *offsets; // string offsets
+    NSMutableData *strings; // string bytes
+    NSMutableDictionary *numbers; // number of each distinct string written so far
+    id row; // current row
+    NSDictionary *dict; // current row, if it is a beverage dictionary
+    NSUInteger index; // current row's index in catalog, if it is not
+    NSString *fields[4]; // name, identifier, cup shape label and alarm sound of the beverage
+    int brewTime; // brew time of the beverage
+    NSNumber *number; // string number of the current field
+    NSData *text; // UTF-8 text of the current field
+    Cuppa_ShapeTable *shapes; // known cup shapes
+    NSUInteger i, j; // loop counters
+
+    // parameter checks
+    NSAssert(rows != nil, @"Bad rows parameter.\n");
+
+    shapes = [Cuppa_ShapeTable sharedTable];
+    records = [NSMutableData dataWithCapacity:[rows count] * CUPPA_CATALOG_RECORD_SIZE];
+    offsets = [NSMutableData data];
+    strings = [NSMutableData data];
+    numbers = [NSMutableDictionary dictionary];
+    CuppaCatalogAppendWord(offsets, 0);
+
+    for (i = 0; i < [rows count]; i++)
+    {
+        row = [rows objectAtIndex:i];
+        if ([row isKindOfClass:[NSNumber class]])
+        {
+            // a row still in its catalog has been filled in already, and its label checked
+            NSAssert(catalog != nil, @"Row index without a catalog.\n");
+            index = [row unsignedIntegerValue];
+            for (j = 0; j < 4; j++)
+            {
+                fields[j] = [catalog stringField:j atIndex:index];
+            }
+            brewTime = [catalog brewTimeAtIndex:index];
+        }
+        else
+        {
+            // fill in anything an older version did not store, the way Cuppa_Bevy would
+            dict = row;
+            fields[sRecordName] = [dict objectForKey:@"name"];
+            fields[sRecordIdentifier] = [dict objectForKey:@"identifier"];
+            if (!fields[sRecordIdentifier])
+                fields[sRecordIdentifier] = [[NSUUID UUID] UUIDString];
+            fields[sRecordCupShape] = [shapes labelForShape:
+                                       [shapes shapeForLabel:[dict objectForKey:@"cupShape"]]];
+            fields[sRecordAlarmSound] = [dict objectForKey:@"alarmSound"];
+            if (![fields[sRecordAlarmSound] isKindOfClass:[NSString class]])
+                fields[sRecordAlarmSound] = @"";
+            brewTime = [[dict objectForKey:@"brewTime"] intValue];
+            NSAssert(fields[sRecordName] != nil, @"Beverage has no name.\n");
+        }
+
+        // each distinct string is stored once, and records refer to it by number
+        for (j = 0; j < 4; j++)
+        {
+            number = [numbers objectForKey:fields[j]];
+            if (!number)
+            {
+                number = [NSNumber numberWithUnsignedInteger:[numbers count]];
+                [numbers setObject:number forKey:fields[j]];
+                text = [fields[j] dataUsingEncoding:NSUTF8StringEncoding];
+                [strings appendData:text];
+                CuppaCatalogAppendWord(offsets, [strings length]);
+            }
+            CuppaCatalogAppendWord(records, [number unsignedIntegerValue]);
+        }
+        CuppaCatalogAppendWord(records, brewTime);
+    }
+
+    // the header says where everything is
+    data = [NSMutableData dataWithCapacity:CUPPA_CATALOG_HEADER_SIZE + [records length] +
+                                           [offsets length] + [strings length]];
+    [data appendBytes:sMagic length:sizeof(sMagic)];
+    CuppaCatalogAppendWord(data, CUPPA_CATALOG_VERSION);
+    CuppaCatalogAppendWord(data, CUPPA_CATALOG_RECORD_SIZE);
+    CuppaCatalogAppendWord(data, [rows count]);
+    CuppaCatalogAppendWord(data, [numbers count]);
+    CuppaCatalogAppendWord(data, CUPPA_CATALOG_HEADER_SIZE + [records length]);
+    CuppaCatalogAppendWord(data, CUPPA_CATALOG_HEADER_SIZE + [records length] + [offsets length]);
+    CuppaCatalogAppendWord(data, [strings length]);
+    NSAssert([data length] == CUPPA_CATALOG_HEADER_SIZE, @"Catalog header is the wrong size.\n");
+    [data appendData:records];
+    [data appendData:offsets];
+    [data appendData:strings];
+
+    return data;
+
+} // end +fromRows:ofCatalog:
+
+// *************************************************************************************************
+
+// Convert an array of beverages to catalog data.
++ (NSData *)fromBevys:(NSArray *)bevyArray
+{
+    return [self fromDictionary:[Cuppa_Bevy toDictionary:bevyArray]];
+
+} // end +fromBevys:
+
+// *************************************************************************************************
+
+// Initialize a catalog reading data. Returns nil if the data is not a catalog this version reads.
+- (id)initWithData:(NSData *)data
+{
+    const uint8_t *bytes; // start of the catalog
+    uint64_t length; // length of the catalog
+    uint64_t offsets, strings; // where the string offsets and string bytes start
+
+    // parameter checks
+    NSAssert(data != nil, @"Bad data parameter.\n");
+
+    self = [super init];
+    mData = [data retain];
+    bytes = [data bytes];
+    length = [data length];
+
+    // check the header, and that everything it describes is inside the data
+    if (length < CUPPA_CATALOG_HEADER_SIZE || memcmp(bytes, sMagic, sizeof(sMagic)) != 0 ||
+        CuppaCatalogWord(bytes, sHeaderVersion) != CUPPA_CATALOG_VERSION ||
+        CuppaCatalogWord(bytes, sHeaderRecordSize) != CUPPA_CATALOG_RECORD_SIZE)
+    {
+        [self release];
+        return nil;
+    }
+    mCount = CuppaCatalogWord(bytes, sHeaderCount);
+    mStringCount = CuppaCatalogWord(bytes, sHeaderStringCount);
+    mStringsLength = CuppaCatalogWord(bytes, sHeaderStringsLength);
+    offsets = CuppaCatalogWord(bytes, sHeaderOffsets);
+    strings = CuppaCatalogWord(bytes, sHeaderStrings);
+    if (CUPPA_CATALOG_HEADER_SIZE + (uint64_t)mCount * CUPPA_CATALOG_RECORD_SIZE > length ||
+        offsets + ((uint64_t)mStringCount + 1) * sizeof(uint32_t) > length ||
+        strings + mStringsLength > length)
+    {
+        [self release];
+        return nil;
+    }
+    mRecords = bytes + CUPPA_CATALOG_HEADER_SIZE;
+    mOffsets = bytes + offsets;
+    mStrings = bytes + strings;
+
+    return self;
+
+} // end -initWithData:
+
+// *************************************************************************************************
+
+// Initialize a catalog reading a file, mapped into memory where possible. Returns nil if the file
+// cannot be read or is not a catalog this version reads.
+- (id)initWithContentsOfFile:(NSString *)path
+{
+    NSData *data; // file contents
+
+    // parameter checks
+    NSAssert(path != nil, @"Bad path parameter.\n");
+
+    data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:NULL];
+    if (!data)
+    {
+        [self release];
+        return nil;
+    }
+    return [self initWithData:data];
+
+} // end -initWithContentsOfFile:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    NSUInteger i; // loop counter
+
+    // release our hold on the names and the data (which unmaps it)
+    for (i = 0; mNameHandles && i <= mStringCount; i++)
+    {
+        if (mNameHandles[i] != NSNotFound)
+            [[Cuppa_NameArena sharedArena] releaseHandle:mNameHandles[i]];
+    }
+    free(mNameHandles);
+    [mData release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Returns the number of beverages in the catalog.
+- (NSUInteger)count
+{
+    // return requested info
+    return mCount;
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the bytes of a string by number, setting length, or NULL if it is out of bounds.
+- (const char *)bytesWithNumber:(NSUInteger)number length:(NSUInteger *)length
+{
+    NSUInteger start, end; // where the string's bytes are
+
+    if (number >= mStringCount)
+        return NULL;
+    start = CuppaCatalogWord(mOffsets, number);
+    end = CuppaCatalogWord(mOffsets, number + 1);
+    if (start > end || end > mStringsLength)
+        return NULL;
+
+    // return requested info
+    *length = end - start;
+    return (const char *)(mStrings + start);
+
+} // end -bytesWithNumber:length:
+
+// *************************************************************************************************
+
+// Returns a string by number, or an empty string if it is out of bounds or not UTF-8.
+- (NSString *)stringWithNumber:(NSUInteger)number
+{
+    const char *bytes; // the string's bytes
+    NSUInteger length; // number of bytes
+    NSString *string; // decoded string
+
+    bytes = [self bytesWithNumber:number length:&length];
+    if (!bytes)
+        return @"";
+
+    // bytes that are not UTF-8 read as empty too
+    string = [[[NSString alloc] initWithBytes:bytes
+                                       length:length
+                                     encoding:NSUTF8StringEncoding] autorelease];
+    return string ? string : @"";
+
+} // end -stringWithNumber:
+
+// *************************************************************************************************
+
+// Returns string field of the beverage at index, or an empty string if it is out of bounds.
+- (NSString *)stringField:(NSUInteger)field atIndex:(NSUInteger)index
+{
+    // parameter checks
+    NSAssert(index < mCount, @"Bad index parameter.\n");
+
+    // return requested info
+    return [self stringWithNumber:CuppaCatalogWord(mRecords + (index * CUPPA_CATALOG_RECORD_SIZE),
+                                                   field)];
+
+} // end -stringField:atIndex:
+
+// *************************************************************************************************
+
+// Returns the name of the beverage at index.
+- (NSString *)nameAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [[Cuppa_NameArena sharedArena] nameForHandle:[self nameHandleAtIndex:index]];
+
+} // end -nameAtIndex:
+
+// *************************************************************************************************
+
+// Returns the handle of the name of the beverage at index in the shared Cuppa_NameArena, held for
+// the life of the catalog. Each distinct name in the catalog is only decoded the first time it is
+// read.
+- (NSUInteger)nameHandleAtIndex:(NSUInteger)index
+{
+    NSUInteger number; // string number of the name
+    NSUInteger i; // loop counter
+
+    // parameter checks
+    NSAssert(index < mCount, @"Bad index parameter.\n");
+
+    // a name out of bounds reads as empty, and its handle is kept after the last string's
+    number = CuppaCatalogWord(mRecords + (index * CUPPA_CATALOG_RECORD_SIZE), sRecordName);
+    if (number >= mStringCount)
+        number = mStringCount;
+
+    // look up each string in the arena once, the first time any beverage uses it as a name
+    if (!mNameHandles)
+    {
+        mNameHandles = malloc((mStringCount + 1) * sizeof(NSUInteger));
+        NSAssert(mNameHandles != NULL, @"Out of memory for name handles.\n");
+        for (i = 0; i <= mStringCount; i++)
+        {
+            mNameHandles[i] = NSNotFound;
+        }
+    }
+    if (mNameHandles[number] == NSNotFound)
+        mNameHandles[number] = [[Cuppa_NameArena sharedArena]
+            handleForName:((number < mStringCount) ? [self stringWithNumber:number] : @"")];
+
+    // return requested info
+    return mNameHandles[number];
+
+} // end -nameHandleAtIndex:
+
+// *************************************************************************************************
+
+// Returns the stable identifier of the beverage at index.
+- (NSString *)identifierAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [self stringField:sRecordIdentifier atIndex:index];
+
+} // end -identifierAtIndex:
+
+// *************************************************************************************************
+
+// Returns the brew time of the beverage at index, clamped to the allowed range.
+- (int)brewTimeAtIndex:(NSUInteger)index
+{
+    uint32_t brewTime; // brew time as stored
+
+    // parameter checks
+    NSAssert(index < mCount, @"Bad index parameter.\n");
+
+    brewTime = CuppaCatalogWord(mRecords + (index * CUPPA_CATALOG_RECORD_SIZE), sRecordBrewTime);
+    return (int)MAX(MIN(brewTime, CUPPA_BEVY_BREW_TIME_MAX), CUPPA_BEVY_BREW_TIME_MIN);
+
+} // end -brewTimeAtIndex:
+
+// *************************************************************************************************
+
+// Returns the cup shape of the beverage at index, a shape code from Cuppa_Shape.h.
+- (int)cupShapeAtIndex:(NSUInteger)index
+{
+    const char *bytes; // bytes of the shape label
+    NSUInteger length; // number of bytes
+
+    // parameter checks
+    NSAssert(index < mCount, @"Bad index parameter.\n");
+
+    // match the label bytes where they are, without making a string of them
+    bytes = [self bytesWithNumber:CuppaCatalogWord(mRecords + (index * CUPPA_CATALOG_RECORD_SIZE),
+                                                   sRecordCupShape)
+                           length:&length];
+
+    // return requested info
+    return [[Cuppa_ShapeTable sharedTable] shapeForLabelBytes:bytes length:(bytes ? length : 0)];
+
+} // end -cupShapeAtIndex:
+
+// *************************************************************************************************
+
+// Returns the path of the alarm sound of the beverage at index, or nil for the usual sound.
+- (NSString *)alarmSoundAtIndex:(NSUInteger)index
+{
+    NSString *alarmSound; // stored path, empty for the usual sound
+
+    alarmSound = [self stringField:sRecordAlarmSound atIndex:index];
+
+    // return requested info
+    return ([alarmSound length] > 0) ? alarmSound : nil;
+
+} // end -alarmSoundAtIndex:
+
+// *************************************************************************************************
+
+// Returns a new beverage object for the beverage at index.
+- (Cuppa_Bevy *)bevyAtIndex:(NSUInteger)index
+{
+    Cuppa_Bevy *bevy; // new beverage object
+    NSString *identifier; // stored identifier
+
+    bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+    [bevy setName:[self nameAtIndex:index]];
+    [bevy setBrewTime:[self brewTimeAtIndex:index]];
+    [bevy setCupShape:[self cupShapeAtIndex:index]];
+    [bevy setAlarmSound:[self alarmSoundAtIndex:index]];
+    identifier = [self identifierAtIndex:index];
+    if ([identifier length] > 0)
+        [bevy setIdentifier:identifier];
+
+    return bevy;
+
+} // end -bevyAtIndex:
+
+// *************************************************************************************************
+
+// Returns new beverage objects for the whole catalog.
+- (NSMutableArray *)bevys
+{
+    NSMutableArray *bevyArray; // array of Cuppa_Bevys
+    NSUInteger i; // loop counter
+
+    bevyArray = [NSMutableArray arrayWithCapacity:mCount];
+    for (i = 0; i < mCount; i++)
+    {
+        [bevyArray addObject:[self bevyAtIndex:i]];
+    }
+
+    return bevyArray;
+
+} // end -bevys
+
+// *************************************************************************************************
+
+// Returns the beverage at index as a dictionary, in the form Cuppa_Bevy stores in user defaults.
+- (NSMutableDictionary *)dictionaryAtIndex:(NSUInteger)index
+{
+    NSMutableDictionary *dict; // dictionary object
+    NSString *identifier; // stored identifier
+    NSString *alarmSound; // stored alarm sound, if any
+
+    // the shape label is passed through a shape so an unknown one comes out as the default
+    dict = [NSMutableDictionary dictionary];
+    [dict setObject:[self nameAtIndex:index] forKey:@"name"];
+    [dict setObject:[NSNumber numberWithInt:[self brewTimeAtIndex:index]] forKey:@"brewTime"];
+    [dict setObject:[[Cuppa_ShapeTable sharedTable] labelForShape:[self cupShapeAtIndex:index]]
+             forKey:@"cupShape"];
+    identifier = [self identifierAtIndex:index];
+    if ([identifier length] > 0)
+        [dict setObject:identifier forKey:@"identifier"];
+    alarmSound = [self alarmSoundAtIndex:index];
+    if (alarmSound)
+        [dict setObject:alarmSound forKey:@"alarmSound"];
+
+    return dict;
+
+} // end -dictionaryAtIndex:
+
+// *************************************************************************************************
+
+// Convert the catalog to an array of beverage dictionaries, to allow user defaults storage.
+- (NSMutableArray *)toDictionary
+{
+    NSMutableArray *dictArray; // array of dictionarys
+    NSUInteger i; // loop counter
+
+    // no beverage objects are needed along the way
+    dictArray = [NSMutableArray arrayWithCapacity:mCount];
+    for (i = 0; i < mCount; i++)
+    {
+        [dictArray addObject:[self dictionaryAtIndex:i]];
+    }
+
+    return dictArray;
+
+} // end -toDictionary
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_Catalog
+
+// end Cuppa_Catalog.m
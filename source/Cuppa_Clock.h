@@ -0,0 +1,93 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_Clock
+           - The Clock class supplies the current time for brew deadlines from a monotonic source,
+             so clock changes and network time corrections never move a brew.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_CLOCK_H
+#define _CUPPA_CLOCK_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Constants
+
+enum
+{
+    CUPPA_CLOCK_AWAKE = 0, // counts only the time the Mac is awake
+    CUPPA_CLOCK_CONTINUOUS, // also counts the time the Mac is asleep, as tea keeps steeping
+    CUPPA_CLOCK_VIRTUAL // only moves when told to, for simulating brews
+};
+
+// Class Interface
+
+@interface Cuppa_Clock : NSObject
+{
+    int mPolicy; // how the clock keeps time, one of the CUPPA_CLOCK_* constants
+    double mSecondsPerTick; // scale from host time units to seconds
+    NSTimeInterval mVirtualTime; // time a virtual clock has spent awake
+    NSTimeInterval mVirtualSleep; // time a virtual clock has spent asleep
+    NSTimeInterval mVirtualJumps; // total jumps of a virtual clock's wall-clock date
+    BOOL mCountsSleep; // flag: a virtual clock's time includes the time asleep?
+}
+
+// ------ Life Cycle ------
+
+// Default initializer: a continuous clock.
+- (id)init;
+
+// Initialize a clock that keeps time according to policy.
+- (id)initWithPolicy:(int)policy;
+
+// ------ Manipulators ------
+
+// Sets the current time of a virtual clock, as if it were awake until then.
+- (void)setVirtualTime:(NSTimeInterval)time;
+
+// Moves a virtual clock forward by interval, awake.
+- (void)advanceBy:(NSTimeInterval)interval;
+
+// Sets whether a virtual clock's time includes the time it is asleep, as a continuous clock's
+// does (the default), or not, as an awake clock's does.
+- (void)setCountsSleep:(BOOL)countsSleep;
+
+// Moves a virtual clock through interval seconds asleep. Its wall-clock date moves on, but its
+// time only moves on if it counts sleep.
+- (void)sleepFor:(NSTimeInterval)interval;
+
+// Moves a virtual clock's wall-clock date by interval, either way, as when the system time is
+// changed. Its time does not move.
+- (void)jumpWallClockBy:(NSTimeInterval)interval;
+
+// ------ Accessors ------
+
+// Returns how the clock keeps time.
+- (int)policy;
+
+// Returns the current time in seconds. Only differences between times are meaningful, and the
+// time never goes backwards.
+- (NSTimeInterval)now;
+
+// Returns the wall-clock date: the system's, or for a virtual clock, the reference date moved on
+// by the time spent awake and asleep and by any jumps. Brew deadlines are never kept on it.
+- (NSDate *)date;
+
+@end // @interface Cuppa_Clock
+
+// *************************************************************************************************
+
+#endif // _CUPPA_CLOCK_H
+
+// end Cuppa_Clock.h
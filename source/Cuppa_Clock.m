@@ -0,0 +1,202 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_Clock
+           - The Clock class supplies the current time for brew deadlines from a monotonic source,
+             so clock changes and network time corrections never move a brew.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#if defined(__APPLE__)
+#include <mach/mach_time.h>
+#else
+#include <time.h>
+#endif
+
+// Cuppa Includes
+
+#import "Cuppa_Clock.h"
+
+// Code!
+
+@implementation Cuppa_Clock
+;
+
+// *************************************************************************************************
+
+// Default initializer: a continuous clock.
+- (id)init
+{
+    return [self initWithPolicy:CUPPA_CLOCK_CONTINUOUS];
+
+} // end -init
+
+// *************************************************************************************************
+
+// Initialize a clock that keeps time according to policy.
+- (id)initWithPolicy:(int)policy
+{
+#if defined(__APPLE__)
+    mach_timebase_info_data_t timebase; // host time units
+#endif
+
+    // parameter checks
+    NSAssert(policy >= CUPPA_CLOCK_AWAKE && policy <= CUPPA_CLOCK_VIRTUAL,
+             @"Bad clock policy parameter.\n");
+
+    self = [super init];
+    mPolicy = policy;
+#if defined(__APPLE__)
+    mach_timebase_info(&timebase);
+    mSecondsPerTick = ((double)timebase.numer / (double)timebase.denom) / NSEC_PER_SEC;
+#else
+    mSecondsPerTick = 1e-9; // nanoseconds
+#endif
+    mVirtualTime = 0.0;
+    mVirtualSleep = 0.0;
+    mVirtualJumps = 0.0;
+    mCountsSleep = YES;
+    return self;
+
+} // end -initWithPolicy:
+
+// *************************************************************************************************
+
+// Sets the current time of a virtual clock, as if it were awake until then.
+- (void)setVirtualTime:(NSTimeInterval)time
+{
+    // parameter checks
+    NSAssert(mPolicy == CUPPA_CLOCK_VIRTUAL, @"Only a virtual clock can be set.\n");
+    NSAssert(time >= [self now], @"Bad time parameter.\n");
+
+    // record new info
+    mVirtualTime += time - [self now];
+
+} // end -setVirtualTime:
+
+// *************************************************************************************************
+
+// Moves a virtual clock forward by interval, awake.
+- (void)advanceBy:(NSTimeInterval)interval
+{
+    // parameter checks
+    NSAssert(mPolicy == CUPPA_CLOCK_VIRTUAL, @"Only a virtual clock can be advanced.\n");
+    NSAssert(interval >= 0.0, @"Bad interval parameter.\n");
+
+    // record new info
+    mVirtualTime += interval;
+
+} // end -advanceBy:
+
+// *************************************************************************************************
+
+// Sets whether a virtual clock's time includes the time it is asleep, as a continuous clock's
+// does (the default), or not, as an awake clock's does.
+- (void)setCountsSleep:(BOOL)countsSleep
+{
+    // parameter checks
+    NSAssert(mPolicy == CUPPA_CLOCK_VIRTUAL, @"Only a virtual clock can be told to count sleep.\n");
+    NSAssert(mVirtualSleep == 0.0, @"A clock that has slept can't change how it counts sleep.\n");
+
+    // record new info
+    mCountsSleep = countsSleep;
+
+} // end -setCountsSleep:
+
+// *************************************************************************************************
+
+// Moves a virtual clock through interval seconds asleep. Its wall-clock date moves on, but its
+// time only moves on if it counts sleep.
+- (void)sleepFor:(NSTimeInterval)interval
+{
+    // parameter checks
+    NSAssert(mPolicy == CUPPA_CLOCK_VIRTUAL, @"Only a virtual clock can be put to sleep.\n");
+    NSAssert(interval >= 0.0, @"Bad interval parameter.\n");
+
+    // record new info
+    mVirtualSleep += interval;
+
+} // end -sleepFor:
+
+// *************************************************************************************************
+
+// Moves a virtual clock's wall-clock date by interval, either way, as when the system time is
+// changed. Its time does not move.
+- (void)jumpWallClockBy:(NSTimeInterval)interval
+{
+    // parameter checks
+    NSAssert(mPolicy == CUPPA_CLOCK_VIRTUAL, @"Only a virtual clock's date can be moved.\n");
+
+    // record new info
+    mVirtualJumps += interval;
+
+} // end -jumpWallClockBy:
+
+// *************************************************************************************************
+
+// Returns how the clock keeps time.
+- (int)policy
+{
+    // return requested info
+    return mPolicy;
+
+} // end -policy
+
+// *************************************************************************************************
+
+// Returns the current time in seconds. Only differences between times are meaningful, and the
+// time never goes backwards.
+- (NSTimeInterval)now
+{
+#if !defined(__APPLE__)
+    struct timespec time; // host time (elsewhere, for running brews headless)
+
+    // the boot time clock goes on counting while the system is suspended
+    if (mPolicy != CUPPA_CLOCK_VIRTUAL)
+    {
+        clock_gettime((mPolicy == CUPPA_CLOCK_AWAKE) ? CLOCK_MONOTONIC : CLOCK_BOOTTIME, &time);
+        return (NSTimeInterval)time.tv_sec + (NSTimeInterval)time.tv_nsec * mSecondsPerTick;
+    }
+#endif
+
+    switch (mPolicy)
+    {
+#if defined(__APPLE__)
+        case CUPPA_CLOCK_AWAKE:
+            return (NSTimeInterval)mach_absolute_time() * mSecondsPerTick;
+        case CUPPA_CLOCK_CONTINUOUS:
+            return (NSTimeInterval)mach_continuous_time() * mSecondsPerTick;
+#endif
+        default:
+            return mCountsSleep ? (mVirtualTime + mVirtualSleep) : mVirtualTime;
+    }
+
+} // end -now
+
+// *************************************************************************************************
+
+// Returns the wall-clock date: the system's, or for a virtual clock, the reference date moved on
+// by the time spent awake and asleep and by any jumps. Brew deadlines are never kept on it.
+- (NSDate *)date
+{
+    if (mPolicy != CUPPA_CLOCK_VIRTUAL)
+        return [NSDate date];
+
+    // return requested info
+    return [NSDate dateWithTimeIntervalSinceReferenceDate:(mVirtualTime + mVirtualSleep +
+                                                           mVirtualJumps)];
+
+} // end -date
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_Clock
+
+// end Cuppa_Clock.m
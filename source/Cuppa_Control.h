@@ -28,8 +28,17 @@
 
 // Cuppa Includes
 
+#import "Cuppa_AlarmSounds.h"
+#import "Cuppa_AudioCues.h"
 #import "Cuppa_Bevy.h"
+#import "Cuppa_BevySortKeys.h"
+#import "Cuppa_BevyStore.h"
+#import "Cuppa_Brew.h"
+#import "Cuppa_Brewer.h"
+#import "Cuppa_NotifyBackend.h"
+#import "Cuppa_PrefsWriter.h"
 #import "Cuppa_Render.h"
+#import "Cuppa_SpeechAlerts.h"
 #if !APPSTORE_BUILD
 #import "Sparkle/SPUStandardUpdaterController.h"
 #endif
@@ -41,7 +50,7 @@
 
 // Class Interface
 
-@interface Cuppa_Control : NSObject <NSUserNotificationCenterDelegate, UNUserNotificationCenterDelegate, NSTableViewDelegate, NSTableViewDataSource, NSTextFieldDelegate>
+@interface Cuppa_Control : NSObject <NSUserNotificationCenterDelegate, UNUserNotificationCenterDelegate, NSTableViewDelegate, NSTableViewDataSource, NSTextFieldDelegate, NSMenuDelegate, Cuppa_BrewerDelegate>
 {
     // IB connected objects
     IBOutlet NSWindow *mPrefsWindow; // application preferences window
@@ -64,12 +73,21 @@
     
     // general data
     NSMutableArray *mBevys; // array of beverages
+    Cuppa_BevyStore *mBevyStore; // saves the array of beverages
+    Cuppa_BevySortKeys *mSortKeys; // sort keys of beverage names, kept between sorts
+    Cuppa_PrefsWriter *mPrefs; // writes preference changes in batches
     NSMenu *mDockMenu; // popup dock tile menu
     NSMenu *mAppMenu; // application menu
-    NSTimer *mBrewTimer; // used to time the brew process
-    int mSecondsRemain; // seconds remaining until the brew is complete
-    int mSecondsTotal; // total seconds to brew
-    NSDate *mAlarmTime; // absolute time for next alarm
+    NSArray *mDockMenuIdentifiers; // identifiers of the beverages shown in the dock menu
+    NSArray *mAppMenuIdentifiers; // identifiers of the beverages shown in the application menu
+    NSArray *mMenuBevys; // beverages the menus should show
+    bool mMenusStale; // flag: the menus need updating before they are next shown
+    NSTimer *mBrewTimer; // wakes us for the next change in any active brew
+    Cuppa_Brewer *mBrewer; // brew state machine for all active brews
+    id<Cuppa_NotifyBackend> mNotifier; // sends brew notifications
+    Cuppa_AudioCues *mAudio; // plays and schedules the beep, pour and spoon, or nil if no output
+    Cuppa_AlarmSounds *mAlarms; // beverage alarm sounds, imported as they are chosen or brewed
+    Cuppa_SpeechAlerts *mSpeech; // speaks brew alerts synthesized ahead of time, or nil
     Cuppa_Render *mRender; // render state and operations
     int mBounceIcon; // flag: bounce dock icon when brew complete?
     int mMakeSound; // flag: make sound when brew complete?
@@ -81,7 +99,7 @@
     int mNotifyOSX; // flag: notify Notification Center?
     bool mTestNotify; // flag: indicates we are doing a test notification
     bool mOSXNotifyAvail; // flag: shows if OS X Notification Center is available
-    Cuppa_Bevy *mCurrentBevy; // the currently brewing beverage
+    bool mAlertShowing; // flag: a brewing complete alert is on screen
     Cuppa_Bevy *genericbevy; // quick timer beverage
     
 }
@@ -105,6 +123,24 @@
 // Handle a tick from the brew timer.
 - (void)updateTick:(id)sender;
 
+// Show the countdown of the next brew to complete.
+- (void)brewer:(Cuppa_Brewer *)brewer showBrew:(Cuppa_Brew *)brew secondsRemain:(int)secondsRemain;
+
+// Play a countdown beep.
+- (void)brewerBeep:(Cuppa_Brewer *)brewer;
+
+// Handle completion of a brew.
+- (void)brewer:(Cuppa_Brewer *)brewer brewComplete:(Cuppa_Brew *)brew;
+
+// Show the final image once the last brew is complete.
+- (void)brewerIdle:(Cuppa_Brewer *)brewer;
+
+// Arm or stop the brew timer for the brewer's next tick.
+- (void)brewer:(Cuppa_Brewer *)brewer wakeAt:(NSTimeInterval)time;
+
+// Catch up with active brews after the system wakes from sleep.
+- (void)systemDidWake:(NSNotification *)notification;
+
 // A particular beverage has been selected for brewing.
 - (void)startBrewing:(id)sender;
 
@@ -123,13 +159,29 @@
 // A request to do a notification test has been made.
 - (IBAction)testNotify:(id)sender;
 
-// Start the repeating brew timer (fires every second).
-- (void)startBrewTimer;
+// Arm the one-shot brew timer to fire after wakeup seconds.
+- (void)startBrewTimer:(NSTimeInterval)wakeup;
 
-// Stop the repeating brew timer.
+// Stop the brew timer.
 - (void)stopBrewTimer;
 
-// Set up and start a timer.
+// Play a sound cue, or the system sound of the same name if the cue can't be played.
+- (void)playSound:(NSString *)name;
+
+// Returns the cue to play when a brew is complete: its beverage's own alarm sound, if it has one
+// that is ready to play, or else the spoon.
+- (NSString *)alarmCue:(Cuppa_Brew *)brew;
+
+// Returns YES if a brew is still under way.
+- (BOOL)isBrewing:(Cuppa_Brew *)brew;
+
+// Returns the text of the alert for a brew, which is also what is spoken.
+- (NSString *)alertText:(Cuppa_Brew *)brew;
+
+// Schedule the countdown beeps and completion sound of a brew on the audio clock.
+- (void)scheduleSounds:(Cuppa_Brew *)brew;
+
+// Set up and start a timer, alongside any that are already active.
 - (void)setTimer:(Cuppa_Bevy *)bevy;
 
 // Handle toggle of bounce icon flag.
@@ -168,6 +220,12 @@
 // Handle change of cup shape via popup in beverage table.
 - (IBAction)cupShapePicked:(id)sender;
 
+// Handle a request to choose an alarm sound for the clicked beverage in the beverage table.
+- (IBAction)chooseAlarmSound:(id)sender;
+
+// Handle a request to go back to the usual alarm sound for the clicked beverage.
+- (IBAction)clearAlarmSound:(id)sender;
+
 // Return the view for a cell in the beverage table (view-based).
 - (NSView *)tableView:(NSTableView *)tableView
    viewForTableColumn:(NSTableColumn *)tableColumn
@@ -197,10 +255,26 @@
 - (void)tableView:(NSTableView *)tableView
 sortDescriptorsDidChange:(NSArray *)oldDescriptors;
 
-// Update the active beverage list, including a rebuild of the dock menu.
+// Update the active beverage list, including an update of the dock menu.
 // Param bevys is an ordered array of the beverages to use.
+// The menus themselves are brought up to date when they are next opened (see -updateMenus).
 - (void)setBevys:(NSMutableArray *)bevys;
 
+// Bring the beverage items in the dock and application menus up to date, if they need it.
+- (void)updateMenus;
+
+// Bring the Beverages menu up to date just before it is shown (or searched for a shortcut).
+- (void)menuNeedsUpdate:(NSMenu *)menu;
+
+// Update the beverage items at the top of a menu, which show the beverages with oldIdentifiers, to
+// show those with identifiers instead; each is found at the same index in the menu's beverages.
+// Items for beverages still in the list are kept (and only touched if they have changed), so a
+// rename or reorder does not rebuild the whole menu. Number keys are assigned if keys is set.
+- (void)updateMenu:(NSMenu *)menu
+              from:(NSArray *)oldIdentifiers
+                to:(NSArray *)identifiers
+    keyEquivalents:(BOOL)keys;
+
 // Handle a click on the link to iTunes App Store
 - (IBAction)loadWebsite:(id)sender;
 
@@ -212,14 +286,20 @@ sortDescriptorsDidChange:(NSArray *)oldDescriptors;
 // Handle an application quit.
 - (void)applicationWillTerminate:(NSNotification *)aNotification;
 
+// Save settings whenever the user switches away, in case we don't get to quit cleanly.
+- (void)applicationDidResignActive:(NSNotification *)aNotification;
+
 // Restore default settings/beverages.
 - (void)restoreDefaults:(id)sender;
 
 // Build the application dock menu as required.
 - (NSMenu *)applicationDockMenu:(NSApplication *)sender;
 
-// Send notification to OS X Notification Center
-- (void)notifyOSX;
+// Schedule a Notification Center notification for a brew, delay seconds from now.
+- (void)notifyOSX:(Cuppa_Brew *)brew after:(NSTimeInterval)delay;
+
+// Withdraw the Notification Center notification for a brew, if it has not been delivered yet.
+- (void)withdrawNotifyOSX:(Cuppa_Brew *)brew;
 
 @end // @interface Cuppa_Control
 
@@ -12,12 +12,31 @@
 
 // Cuppa Includes
 
+#import "Cuppa_AlarmSounds.h"
+#import "Cuppa_AudioUnitOutput.h"
 #import "Cuppa_Bevy.h"
+#import "Cuppa_BevyColumns.h"
+#import "Cuppa_BevyMenu.h"
+#import "Cuppa_BevyStore.h"
+#import "Cuppa_Brew.h"
 #import "Cuppa_Control.h"
+#import "Cuppa_LazyBevys.h"
+#import "Cuppa_NotifyCenter.h"
+#import "Cuppa_PrefsWriter.h"
+#import "Cuppa_Schedule.h"
+#import "Cuppa_SpeechSynth.h"
+#import "Cuppa_TimeFormat.h"
+#import "Cuppa_TimerQueue.h"
+#import "Cuppa_TimerWheel.h"
 #if !APPSTORE_BUILD
 #import "Sparkle/SPUStandardUpdaterController.h"
 #endif
 
+// Internal Constants
+
+// Preference changes are collected for this long before being written together
+static const NSTimeInterval sPrefsWriteDelay = 2.0;
+
 // Code!
 
 @implementation Cuppa_Control
@@ -31,6 +50,11 @@
     
     NSMutableDictionary *appDefaults; // dictionary of these application defaults
     NSUserDefaults *defaults; // user defaults object used to store preferences
+    Cuppa_Clock *clock; // time source for brew deadlines
+    id<Cuppa_TimerBackend> backend; // timer engine for active brews
+    Cuppa_AudioUnitOutput *output; // audio device the sound cues play through
+    Cuppa_SpeechSynth *synth; // synthesizes brew alerts ahead of time
+    NSString *speechFolder; // folder brew alerts are synthesized into
     
     // chain up to superclass
     self = [super init];
@@ -60,6 +84,7 @@
     [appDefaults setObject:@"NO" forKey:@"showSteep"];
     [appDefaults setObject:@"NO" forKey:@"autoStart"];
     [appDefaults setObject:@"YES" forKey:@"notifyOSX"];
+    [appDefaults setObject:@"NO" forKey:@"timerWheel"];
     [appDefaults setObject:[Cuppa_Bevy toDictionary:mBevys] forKey:@"bevys"];
     [defaults registerDefaults:appDefaults];
     
@@ -93,8 +118,15 @@
     mAutoStart = [defaults boolForKey:@"autoStart"];
     mNotifyOSX = [defaults boolForKey:@"notifyOSX"];
     
-    mBevys = [Cuppa_Bevy fromDictionary:[defaults objectForKey:@"bevys"]];
+    // from here on, preference changes are written in batches off the main thread
+    mPrefs = [[Cuppa_PrefsWriter alloc] initWithBackend:defaults delay:sPrefsWriteDelay];
+    
+    // load the beverage list, with any changes logged since it was last saved whole
+    mBevyStore = [[Cuppa_BevyStore alloc] initWithPrefs:mPrefs
+                                                logPath:[Cuppa_BevyStore defaultLogPath]];
+    mBevys = [mBevyStore load];
     [mBevys retain];
+    mSortKeys = [[Cuppa_BevySortKeys alloc] init];
     mDockMenu = nil;
     [self setBevys:mBevys];
     
@@ -108,8 +140,63 @@
     
     // no active timer on startup
     mBrewTimer = nil;
-    mSecondsRemain = 0;
-    mAlarmTime = nil;
+    mAlertShowing = false;
+    
+    // brew deadlines use a monotonic clock that keeps running while the Mac sleeps,
+    // as the tea keeps steeping
+    clock = [[[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_CONTINUOUS] autorelease];
+    
+    // (the timing wheel is an alternative engine, chosen by the hidden timerWheel default)
+    if ([defaults boolForKey:@"timerWheel"])
+        backend = [[[Cuppa_TimerWheel alloc] init] autorelease];
+    else
+        backend = [[[Cuppa_TimerQueue alloc] init] autorelease];
+    
+    // decode our sounds (compressed when the app is built) once up front, so each cue plays
+    // straight away when it is needed, and countdown beeps can be scheduled on the audio clock
+    // against the same brew deadlines
+    output = [[[Cuppa_AudioUnitOutput alloc] init] autorelease];
+    mAudio = nil;
+    if (output)
+    {
+        mAudio = [[Cuppa_AudioCues alloc] initWithOutput:output clock:clock];
+        [mAudio loadCue:@"beep" fromFile:[[NSBundle mainBundle] pathForResource:@"beep"
+                                                                          ofType:@"aifc"]];
+        [mAudio loadCue:@"pour" fromFile:[[NSBundle mainBundle] pathForResource:@"pour"
+                                                                          ofType:@"aifc"]];
+        [mAudio loadCue:@"spoon" fromFile:[[NSBundle mainBundle] pathForResource:@"spoon"
+                                                                           ofType:@"aifc"]];
+    }
+    
+    // beverage alarm sounds are converted for the same output when they are first needed
+    mAlarms = nil;
+    if (mAudio)
+    {
+        mAlarms = [[Cuppa_AlarmSounds alloc] initWithAudio:mAudio
+                                                    folder:[Cuppa_AlarmSounds defaultFolder]];
+    }
+    
+    // brew alerts are synthesized as each brew starts, so they can be spoken through the same
+    // output the moment the brew is complete
+    mSpeech = nil;
+    if (mAudio)
+    {
+        synth = [[[Cuppa_SpeechSynth alloc] init] autorelease];
+        speechFolder = [NSTemporaryDirectory() stringByAppendingPathComponent:@"Speech"];
+        mSpeech = [[Cuppa_SpeechAlerts alloc] initWithBackend:synth
+                                                        audio:mAudio
+                                                       folder:speechFolder];
+    }
+    
+    // create the brewer to run our brews (it only needs to wake for countdown beeps that can't be
+    // scheduled ahead)
+    mBrewer = [[Cuppa_Brewer alloc] initWithClock:clock backend:backend];
+    [mBrewer setDelegate:self];
+    [mBrewer setShowTimer:mShowTimer];
+    [mBrewer setMakeSound:(mMakeSound && !mAudio)];
+    
+    // brew notifications go to the system Notification Center
+    mNotifier = [[Cuppa_NotifyCenter alloc] init];
     
     // initialize speech synthesizer
     _speechSynth = [[NSSpeechSynthesizer alloc] initWithVoice:nil];
@@ -125,6 +212,7 @@
 - (void)awakeFromNib
 {
     NSMenu *mMainMenu; // main menu object
+    NSMenu *menu; // beverage table context menu
     NSMenuItem *item; // current menu item
     
     // On older macOS versions, keep App Nap permanently disabled as a
@@ -182,6 +270,18 @@
     // setup preferences table for drag 'n' drop
     [mBevyTable registerForDraggedTypes:[NSArray arrayWithObjects:@"RowIndexPboardType", nil]];
     
+    // each beverage's alarm sound is chosen from the table's context menu
+    menu = [[[NSMenu alloc] initWithTitle:@""] autorelease];
+    item = [menu addItemWithTitle:NSLocalizedString(@"Choose Alarm Sound...", nil)
+                           action:@selector(chooseAlarmSound:)
+                    keyEquivalent:@""];
+    [item setTarget:self];
+    item = [menu addItemWithTitle:NSLocalizedString(@"Use Default Alarm Sound", nil)
+                           action:@selector(clearAlarmSound:)
+                    keyEquivalent:@""];
+    [item setTarget:self];
+    [mBevyTable setMenu:menu];
+    
     // ensure settings are up to date
     if ([mBounceSwitch state] != (mBounceIcon ? NSOnState : NSOffState))
     {
@@ -242,7 +342,10 @@
         item = [[NSMenuItem alloc] initWithTitle:NSLocalizedString(@"Beverages", nil) action:nil keyEquivalent:@""];
         [mMainMenu insertItem:item atIndex:1];
         mAppMenu = [[NSMenu alloc] initWithTitle:NSLocalizedString(@"Beverages", nil)];
+        [mAppMenu setDelegate:self];
         [mMainMenu setSubmenu:mAppMenu forItem:item];
+        [mAppMenuIdentifiers release];
+        mAppMenuIdentifiers = nil;
         
         // add a separator
         [mAppMenu insertItem:[NSMenuItem separatorItem] atIndex:0];
@@ -285,6 +388,12 @@
         [self setTimer:bevy];
     }
     
+    // the brew timer does not run while the system sleeps, so catch up as soon as it wakes
+    [[[NSWorkspace sharedWorkspace] notificationCenter] addObserver:self
+                                                           selector:@selector(systemDidWake:)
+                                                               name:NSWorkspaceDidWakeNotification
+                                                             object:nil];
+    
 } // end -awakeFromNib
 
 // *************************************************************************************************
@@ -292,148 +401,197 @@
 // Handle a tick from the brew timer.
 - (void)updateTick:(id)sender
 {
+    // a one-shot timer that has fired is no longer ours to invalidate
+    if (sender == mBrewTimer)
+    {
+        mBrewTimer = nil;
+    }
     
-    // update the brew state
-    if (mAlarmTime != nil || mSecondsRemain > 0)
+    [mBrewer tick];
+    
+} // end -updateTick:
+
+// *************************************************************************************************
+
+// Show the countdown of the next brew to complete.
+- (void)brewer:(Cuppa_Brewer *)brewer showBrew:(Cuppa_Brew *)brew secondsRemain:(int)secondsRemain
+{
+    // update brew time remaining for countdown timer
+    if (mShowTimer)
     {
-        // calculate time remaining til brewing complete
-        if (mAlarmTime != nil)
-        {
-            mSecondsRemain = floor([mAlarmTime timeIntervalSinceNow]);
-        }
-        else
+        [mRender setBrewRemain:secondsRemain];
+    }
+    else
+    {
+        // hide countdown timer if show timer option got disabled
+        [mRender setBrewRemain:0];
+    }
+    
+    // update brew state
+    [mRender setBrewState:((float)([brew brewTime] - secondsRemain) / (float)[brew brewTime])];
+    [mRender render];
+    
+} // end -brewer:showBrew:secondsRemain:
+
+// *************************************************************************************************
+
+// Play a countdown beep.
+- (void)brewerBeep:(Cuppa_Brewer *)brewer
+{
+    [self playSound:@"beep"];
+    
+} // end -brewerBeep:
+
+// *************************************************************************************************
+
+// Show the final image once the last brew is complete.
+- (void)brewerIdle:(Cuppa_Brewer *)brewer
+{
+    // no brew time remaining for countdown timer
+    [mRender setBrewRemain:0];
+    
+    // ensure the final image is displayed
+    [mRender setBrewState:0.0f];
+    [mRender render];
+    
+} // end -brewerIdle:
+
+// *************************************************************************************************
+
+// Arm or stop the brew timer for the brewer's next tick.
+- (void)brewer:(Cuppa_Brewer *)brewer wakeAt:(NSTimeInterval)time
+{
+    if (isinf(time))
+    {
+        [self stopBrewTimer];
+    }
+    else
+    {
+#if !defined(NDEBUG)
+        printf("Next brew timer wakeup in %.2f secs\n", time - [[brewer clock] now]);
+#endif
+        [self startBrewTimer:MAX(time - [[brewer clock] now], 0.0)];
+    }
+    
+} // end -brewer:wakeAt:
+
+// *************************************************************************************************
+
+// Handle completion of a brew.
+- (void)brewer:(Cuppa_Brewer *)brewer brewComplete:(Cuppa_Brew *)brew
+{
+#if !defined(NDEBUG)
+    printf("Brew complete: %s\n", [[brew name] UTF8String]);
+#endif
+    
+    // alert message text contains beverage name
+    NSString *alertInfoText = [self alertText:brew];
+    
+    // bounce the dock icon until user clicks (more useful than NSInformationalRequest)
+    if (mBounceIcon)
+    {
+        [NSApp requestUserAttention:NSCriticalRequest];
+    }
+    
+    // play a nice sound (or the beverage's own), unless it was scheduled to play right on the
+    // deadline
+    if (mMakeSound)
+    {
+        NSString *alarm = [self alarmCue:brew];
+        if (![mAudio retireCue:alarm tag:[brew timerID]])
         {
-            mSecondsRemain = 0;
+            [self playSound:alarm];
         }
+    }
+    
+    // speak it, straight away if it was synthesized when the brew started
+    if (mSpeakAlert && ![mSpeech speakString:alertInfoText])
+    {
+        [self.speechSynth startSpeakingString:alertInfoText];
+    }
+    
+    // send a message to OS X Notification Center, unless one was already scheduled for now
+    if (mNotifyOSX && ![brew notifyScheduled])
+    {
+        [self notifyOSX:brew after:0.0];
+    }
+    
+    // show a little alert window (one at a time, other brews keep timing behind it)
+    if (mShowAlert && !mAlertShowing)
+    {
+        // force activation
+        [[NSApplication sharedApplication] activateIgnoringOtherApps:YES];
         
-        // still timing?
-        if (mSecondsRemain > 0)
+        // It's more complicated if we want to allow keyboard shortcuts
+        NSAlert *brewAlert = [[[NSAlert alloc] init] autorelease];
+        [brewAlert setMessageText:NSLocalizedString(@"Brewing complete...", nil)];
+        [brewAlert setInformativeText:alertInfoText];
+        NSButton *okButton = [brewAlert addButtonWithTitle:NSLocalizedString(@"OK", nil)];
+        [okButton setKeyEquivalent:@"\r"];
+        NSButton *quitButton = [brewAlert addButtonWithTitle:NSLocalizedString(@"Quit Cuppa", nil)];
+        [quitButton setKeyEquivalent:@"q"];
+        [quitButton setKeyEquivalentModifierMask:NSEventModifierFlagCommand];
+        mAlertShowing = true;
+        NSModalResponse response = [brewAlert runModal];
+        mAlertShowing = false;
+        if (response == NSAlertSecondButtonReturn)
         {
-            // update brew time remaining for countdown timer
-            if (mShowTimer)
-            {
-                [mRender setBrewRemain:mSecondsRemain];
-            }
-            else
-            {
-                // hide countdown timer if show timer option got disabled
-                [mRender setBrewRemain:0];
-            }
-            
-            // update brew state
-            [mRender setBrewState:((float)(mSecondsTotal - mSecondsRemain) / (float)mSecondsTotal)];
-            [mRender render];
-            
-            // emit a beep for the final 5 seconds
-            if (mMakeSound && mSecondsRemain <= 5 && mSecondsRemain >= 1)
-            {
-                NSSound *beepSound = [NSSound soundNamed:@"beep"];
-                [beepSound play];
-            }
+            // User wants to quit, how sad!
+            [[NSApplication sharedApplication] terminate:self];
         }
+    }
     
-        // or is the beverage ready?
-        else
-        {
-#if !defined(NDEBUG)
-            printf("Brew complete!\n");
-#endif
-            
-            // reset the timer variables
-            mSecondsRemain = 0;
-            mAlarmTime = nil;
-            
-            // stop the repeating tick timer
-            [self stopBrewTimer];
-        
-            // no brew time remaining for countdown timer
-            [mRender setBrewRemain:0];
-            
-            // ensure the final image is displayed
-            [mRender setBrewState:0.0f];
-            [mRender render];
-
-            // alert message text contains beverage name
-            NSString *alertInfoText = [NSString stringWithFormat:NSLocalizedString(@"%@ is now ready!",
-                                                                                   nil),
-                                       [mCurrentBevy name]];
-        
-            // bounce the dock icon until user clicks (more useful than NSInformationalRequest)
-            if (mBounceIcon)
-            {
-                [NSApp requestUserAttention:NSCriticalRequest];
-            }
-        
-            // play a nice sound
-            if (mMakeSound)
-            {
-                NSSound *doneSound = [NSSound soundNamed:@"spoon"];
-                [doneSound play];
-            }
-        
-            // speak it
-            if (mSpeakAlert)
-            {
-                [self.speechSynth startSpeakingString:alertInfoText];
-            }
-        
-            // send a message to OS X Notification Center
-            if (mNotifyOSX)
-            {
-                [self notifyOSX];
-            }
-        
-            // show a little alert window
-            if (mShowAlert)
-            {
-                // force activation
-                [[NSApplication sharedApplication] activateIgnoringOtherApps:YES];
+    // as a courtesy, reopen Preferences if user was testing
+    if (mTestNotify)
+    {
+        mTestNotify = false;
         
-                // It's more complicated if we want to allow keyboard shortcuts
-                NSAlert *brewAlert = [[[NSAlert alloc] init] autorelease];
-                [brewAlert setMessageText:NSLocalizedString(@"Brewing complete...", nil)];
-                [brewAlert setInformativeText:alertInfoText];
-                NSButton *okButton = [brewAlert addButtonWithTitle:NSLocalizedString(@"OK", nil)];
-                [okButton setKeyEquivalent:@"\r"];
-                NSButton *quitButton = [brewAlert addButtonWithTitle:NSLocalizedString(@"Quit Cuppa", nil)];
-                [quitButton setKeyEquivalent:@"q"];
-                [quitButton setKeyEquivalentModifierMask:NSEventModifierFlagCommand];
-                if ([brewAlert runModal] == NSAlertSecondButtonReturn)
-                {
-                    // User wants to quit, how sad!
-                    [[NSApplication sharedApplication] terminate:self];
-                }
-            }
+        [[NSApplication sharedApplication] activateIgnoringOtherApps:YES];
+        [self showPrefs:nil];
+    }
+    
+} // end -brewer:brewComplete:
 
-            // as a courtesy, reopen Preferences if user was testing
-            if (mTestNotify)
-            {
-                mTestNotify = false;
-        
-                [[NSApplication sharedApplication] activateIgnoringOtherApps:YES];
-                [self showPrefs:nil];
-            }
-            
-        } // end if
-        
-    } // end if
-} // end -updateTick:
+// *************************************************************************************************
+
+// Catch up with active brews after the system wakes from sleep.
+- (void)systemDidWake:(NSNotification *)notification
+{
+    // the audio clock stopped while we slept, so hand the scheduled sounds over again
+    [mAudio resynchronize];
+    
+    // brews that completed during sleep each complete once, right away
+    if ([mBrewer count] > 0)
+    {
+        [mBrewer tick];
+    }
+    
+} // end -systemDidWake:
 
 // *************************************************************************************************
 
 // A particular beverage has been selected for brewing.
 - (void)startBrewing:(id)sender
 {
-    Cuppa_Bevy *bevy; // matching beverage object
+    Cuppa_Bevy *bevy = nil; // matching beverage object
+    NSString *identifier; // identifier of the beverage
+    NSUInteger i; // loop counter
     
-    // which beverage have they choosen?
-    bevy = (Cuppa_Bevy *)[sender representedObject];
+    // which beverage have they choosen? only that one is made an object of
+    identifier = (NSString *)[sender representedObject];
+    for (i = 0; identifier && i < [mMenuBevys count]; i++)
+    {
+        if ([[mMenuBevys bevyIdentifierAtIndex:i] isEqualToString:identifier])
+        {
+            bevy = (Cuppa_Bevy *)[mMenuBevys objectAtIndex:i];
+            break;
+        }
+    }
     if (!bevy)
     {
         // Bother, we didn't find it! This shouldn't happen.
         NSAssert(bevy != nil, @"Could not find matching bevy in array!\n");
-        mSecondsRemain = 0;
-        mAlarmTime = nil;
+        return;
     }
     
 #if !defined(NDEBUG)
@@ -457,12 +615,15 @@
     printf("Cancel timer.\n");
 #endif
     
-    // reset the timer variables
-    mSecondsRemain = 0;
-    mAlarmTime = nil;
+    // withdraw the notifications and sounds scheduled for the active brews
+    [mBrewer enumerateBrewsUsingBlock:^(Cuppa_Brew *brew)
+    {
+        [self withdrawNotifyOSX:brew];
+        [mAudio cancelTag:[brew timerID]];
+    }];
     
-    // stop the repeating tick timer
-    [self stopBrewTimer];
+    // cancel every active brew (which also stops the brew timer)
+    [mBrewer cancelAllBrews];
     
     // reset the dock icon
     [mRender restore];
@@ -617,8 +778,8 @@
 
 // *************************************************************************************************
 
-// Start the repeating brew timer (fires every second).
-- (void)startBrewTimer
+// Arm the one-shot brew timer to fire after wakeup seconds.
+- (void)startBrewTimer:(NSTimeInterval)wakeup
 {
     // Invalidate any existing timer first
     [mBrewTimer invalidate];
@@ -635,16 +796,18 @@
         }
     }
     
-    mBrewTimer = [NSTimer scheduledTimerWithTimeInterval:1.0
-                                                  target:self
-                                                selector:@selector(updateTick:)
-                                                userInfo:nil
-                                                 repeats:YES];
+    // Keep timing while an alert or menu is up
+    mBrewTimer = [NSTimer timerWithTimeInterval:wakeup
+                                         target:self
+                                       selector:@selector(updateTick:)
+                                       userInfo:nil
+                                        repeats:NO];
+    [[NSRunLoop currentRunLoop] addTimer:mBrewTimer forMode:NSRunLoopCommonModes];
 }
 
 // *************************************************************************************************
 
-// Stop the repeating brew timer.
+// Stop the brew timer.
 - (void)stopBrewTimer
 {
     [mBrewTimer invalidate];
@@ -663,45 +826,124 @@
 
 // *************************************************************************************************
 
-// Set up and start a timer.
-- (void)setTimer:(Cuppa_Bevy *)bevy
+// Play a sound cue, or the system sound of the same name if the cue can't be played.
+- (void)playSound:(NSString *)name
 {
-    // Do we have a timer outstanding?
-    if (mSecondsRemain > 0)
-    {
-        // Check with the user before starting a new timer
-        NSAlert *alert = [[NSAlert alloc] init];
-        [alert setMessageText:NSLocalizedString(@"Warning!", nil)];
-        [alert setInformativeText:NSLocalizedString(@"There is an active timer. Cancel and start a new timer?", nil)];
-        [alert addButtonWithTitle:NSLocalizedString(@"No", nil)];
-        [alert addButtonWithTitle:NSLocalizedString(@"Yes", nil)];
-        [alert setAlertStyle:NSAlertStyleCritical];
-        NSInteger returnCode = [alert runModal];
-        if (returnCode == NSAlertFirstButtonReturn) {
-            return;
-        }
+    // the cue is already decoded, so it starts without going through NSSound
+    if (![mAudio playCue:name])
+    {
+        [[NSSound soundNamed:name] play];
     }
 
-    NSSound *startSound; // start sound
+} // end -playSound:
+
+// *************************************************************************************************
+
+// Returns the text of the alert for a brew, which is also what is spoken.
+- (NSString *)alertText:(Cuppa_Brew *)brew
+{
+    // alert message text contains beverage name
+    return [NSString stringWithFormat:NSLocalizedString(@"%@ is now ready!", nil), [brew name]];
+    
+} // end -alertText:
+
+// *************************************************************************************************
+
+// Returns the cue to play when a brew is complete: its beverage's own alarm sound, if it has one
+// that is ready to play, or else the spoon.
+- (NSString *)alarmCue:(Cuppa_Brew *)brew
+{
+    NSString *cue = nil; // cue of the alarm sound
+    
+    // the sound is imported when the brew starts, so it is only looked up here
+    if ([brew alarmSound] && mAlarms)
+        cue = [mAlarms cueForPath:[brew alarmSound]];
+    
+    return cue ? cue : @"spoon";
+    
+} // end -alarmCue:
+
+// *************************************************************************************************
+
+// Returns YES if a brew is still under way.
+- (BOOL)isBrewing:(Cuppa_Brew *)brew
+{
+    __block BOOL found = NO; // flag: brew is among those under way
+    
+    [mBrewer enumerateBrewsUsingBlock:^(Cuppa_Brew *other)
+    {
+        if (other == brew)
+            found = YES;
+    }];
+    
+    return found;
+    
+} // end -isBrewing:
+
+// *************************************************************************************************
+
+// Schedule the countdown beeps and completion sound of a brew on the audio clock.
+- (void)scheduleSounds:(Cuppa_Brew *)brew
+{
+    int secs; // seconds before the deadline of a countdown beep
     
-    // setup the brewing state
-    mCurrentBevy = bevy;
-    mSecondsTotal = [bevy brewTime];
-    mSecondsRemain = mSecondsTotal + 1;
-    mAlarmTime = [[NSDate alloc] initWithTimeIntervalSinceNow:mSecondsRemain];
+    // a beep as each of the final seconds starts (but not before the brew)
+    for (secs = MIN(CUPPA_SCHEDULE_BEEP_SECONDS, [brew brewTime]); secs > 0; secs--)
+    {
+        [mAudio scheduleCue:@"beep" atTime:([brew deadline] - secs) tag:[brew timerID]];
+    }
     
-    // start the repeating tick timer
-    [self startBrewTimer];
+    // then the alarm; the beverage's own sound is read in the background the first time it is
+    // brewed, so it is scheduled once it is ready (straight away after that)
+    if (![brew alarmSound] || !mAlarms)
+    {
+        [mAudio scheduleCue:@"spoon" atTime:[brew deadline] tag:[brew timerID]];
+        return;
+    }
+    [mAlarms prepareSoundAtPath:[brew alarmSound] completion:^(NSString *cue) {
+        // the brew may have been cancelled, or the sound turned off, in the meantime
+        if (mMakeSound && [self isBrewing:brew])
+        {
+            [mAudio scheduleCue:(cue ? cue : @"spoon") atTime:[brew deadline] tag:[brew timerID]];
+        }
+    }];
+    
+} // end -scheduleSounds:
+
+// *************************************************************************************************
+
+// Set up and start a timer, alongside any that are already active.
+- (void)setTimer:(Cuppa_Bevy *)bevy
+{
+    Cuppa_Brew *brew; // the new brew
     
     // play the start sound
     if (mMakeSound)
     {
-        startSound = [NSSound soundNamed:@"pour"];
-        [startSound play];
+        [self playSound:@"pour"];
+    }
+    
+    // start brewing alongside any brews already under way; the brewer updates the onscreen
+    // image and arms the brew timer
+    brew = [mBrewer startBrew:bevy];
+    
+    // schedule the countdown beeps and completion sound against the brew deadline
+    if (mMakeSound)
+    {
+        [self scheduleSounds:brew];
+    }
+    
+    // synthesize the spoken alert now, so there is no wait for it when the brew is complete
+    if (mSpeakAlert)
+    {
+        [mSpeech prepareString:[self alertText:brew]];
     }
     
-    // update the onscreen image
-    [self updateTick:self];
+    // schedule the completion notification now, so it arrives on time even if we are asleep
+    if (mNotifyOSX)
+    {
+        [self notifyOSX:brew after:([brew deadline] - [[mBrewer clock] now])];
+    }
     
 } // end -setTimer:
 
@@ -718,7 +960,7 @@
     mBounceIcon = !mBounceIcon;
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setBool:mBounceIcon forKey:@"bounceIcon"];
+    [mPrefs setBool:mBounceIcon forKey:@"bounceIcon"];
     
 } // end -toggleBounce:
 
@@ -735,7 +977,19 @@
     mMakeSound = !mMakeSound;
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setBool:mMakeSound forKey:@"makeSound"];
+    [mPrefs setBool:mMakeSound forKey:@"makeSound"];
+    
+    // schedule or cancel the sounds of the brews under way
+    [mBrewer enumerateBrewsUsingBlock:^(Cuppa_Brew *brew)
+    {
+        if (mMakeSound)
+            [self scheduleSounds:brew];
+        else
+            [mAudio cancelTag:[brew timerID]];
+    }];
+    
+    // countdown beeps that aren't scheduled change when the brew timer next needs to wake up
+    [mBrewer setMakeSound:(mMakeSound && !mAudio)];
     
 } // end -toggleSound:
 
@@ -752,7 +1006,16 @@
     mSpeakAlert = !mSpeakAlert;
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setBool:mSpeakAlert forKey:@"speakAlert"];
+    [mPrefs setBool:mSpeakAlert forKey:@"speakAlert"];
+    
+    // synthesize the spoken alerts of the brews under way
+    if (mSpeakAlert)
+    {
+        [mBrewer enumerateBrewsUsingBlock:^(Cuppa_Brew *brew)
+        {
+            [mSpeech prepareString:[self alertText:brew]];
+        }];
+    }
     
 } // end -toggleSpeak:
 
@@ -769,7 +1032,7 @@
     mShowAlert = !mShowAlert;
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setBool:mShowAlert forKey:@"showAlert"];
+    [mPrefs setBool:mShowAlert forKey:@"showAlert"];
     
 } // end -toggleAlert:
 
@@ -786,7 +1049,10 @@
     mShowTimer = !mShowTimer;
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setBool:mShowTimer forKey:@"showTimer"];
+    [mPrefs setBool:mShowTimer forKey:@"showTimer"];
+    
+    // show or hide the countdown timer now, rather than at the next wakeup
+    [mBrewer setShowTimer:mShowTimer];
     
 } // end -toggleTimer:
 
@@ -803,7 +1069,7 @@
     mShowSteep = !mShowSteep;
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setBool:mShowSteep forKey:@"showSteep"];
+    [mPrefs setBool:mShowSteep forKey:@"showSteep"];
     
     // update the menus
     [self setBevys:mBevys];
@@ -823,7 +1089,7 @@
     mAutoStart = !mAutoStart;
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setBool:mAutoStart forKey:@"autoStart"];
+    [mPrefs setBool:mAutoStart forKey:@"autoStart"];
     
 } // end -toggleSteep:
 
@@ -847,7 +1113,20 @@
     mNotifyOSX = !mNotifyOSX;
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setBool:mNotifyOSX forKey:@"notifyOSX"];
+    [mPrefs setBool:mNotifyOSX forKey:@"notifyOSX"];
+    
+    // schedule or withdraw the notifications for brews already under way
+    [mBrewer enumerateBrewsUsingBlock:^(Cuppa_Brew *brew)
+    {
+        if (mNotifyOSX)
+        {
+            [self notifyOSX:brew after:([brew deadline] - [[mBrewer clock] now])];
+        }
+        else
+        {
+            [self withdrawNotifyOSX:brew];
+        }
+    }];
     
 } // end -toggleNotifyOSX
 
@@ -872,8 +1151,7 @@
     [mBevyTable reloadData];
     
     // store to prefs
-    [[NSUserDefaults standardUserDefaults] setObject:[Cuppa_Bevy toDictionary:mBevys]
-                                              forKey:@"bevys"];
+    [mBevyStore bevyInserted:bevy atIndex:0];
     
 } // end -addBevyButton:
 
@@ -889,13 +1167,13 @@
     // remove the selected beverage from the array, provided there's at least one left
     if ([mBevys count] > 1)
     {
+        // store to prefs (while we still have the beverage)
+        [mBevyStore bevyRemoved:[mBevys objectAtIndex:[mBevyTable selectedRow]]];
+        [mSortKeys forgetIdentifier:[mBevys bevyIdentifierAtIndex:[mBevyTable selectedRow]]];
+        
         [mBevys removeObjectAtIndex:[mBevyTable selectedRow]];
         [self setBevys:mBevys];
         [mBevyTable reloadData];
-        
-        // store to prefs
-        [[NSUserDefaults standardUserDefaults] setObject:[Cuppa_Bevy toDictionary:mBevys]
-                                                  forKey:@"bevys"];
     }
     else
     {
@@ -922,8 +1200,7 @@
    viewForTableColumn:(NSTableColumn *)tableColumn
                   row:(NSInteger)row
 {
-    Cuppa_Bevy *bevy = [mBevys objectAtIndex:row];
-    
+    // rows are only read here, so a large catalog does not become beverage objects as it scrolls
     if ([[tableColumn identifier] isEqualToString:@"image"])
     {
         NSTableCellView *cellView = [tableView makeViewWithIdentifier:@"image" owner:self];
@@ -944,7 +1221,7 @@
             // Populate if empty
             if ([popup numberOfItems] == 0)
             {
-                for (int shape = 0; shape < CUPPA_SHAPE_MAX; shape++)
+                for (int shape = 0; shape < [Cuppa_Shape shapeCount]; shape++)
                 {
                     [popup addItemWithTitle:@""];
                     NSMenuItem *item = [popup lastItem];
@@ -952,7 +1229,7 @@
                     [item setTag:shape];
                 }
             }
-            [popup selectItemWithTag:[bevy cupShape]];
+            [popup selectItemWithTag:[mBevys bevyCupShapeAtIndex:row]];
         }
         
         return cellView;
@@ -961,7 +1238,7 @@
     if ([[tableColumn identifier] isEqualToString:@"name"])
     {
         NSTableCellView *cellView = [tableView makeViewWithIdentifier:@"name" owner:self];
-        [[cellView textField] setStringValue:[bevy name]];
+        [[cellView textField] setStringValue:[mBevys bevyNameAtIndex:row]];
         [[cellView textField] setEditable:YES];
         [[cellView textField] setDelegate:self];
         return cellView;
@@ -1001,7 +1278,7 @@
             // Convert brew time (seconds) to an NSDate using a fixed reference date
             // Reference date is 2001-01-01 00:00:00 UTC; with UTC timezone on picker,
             // adding brewTime seconds gives us h:m:s directly
-            int brewTime = [bevy brewTime];
+            int brewTime = [mBevys bevyBrewTimeAtIndex:row];
             NSDate *midnight = [NSDate dateWithTimeIntervalSinceReferenceDate:0];
             [picker setDateValue:[midnight dateByAddingTimeInterval:brewTime]];
         }
@@ -1041,8 +1318,7 @@
     [self setBevys:mBevys];
     
     // Store to prefs
-    [[NSUserDefaults standardUserDefaults] setObject:[Cuppa_Bevy toDictionary:mBevys]
-                                              forKey:@"bevys"];
+    [mBevyStore bevyChanged:bevy];
     
 } // end -brewTimePicked:
 
@@ -1064,13 +1340,76 @@
     [self setBevys:mBevys];
     
     // Store to prefs
-    [[NSUserDefaults standardUserDefaults] setObject:[Cuppa_Bevy toDictionary:mBevys]
-                                              forKey:@"bevys"];
+    [mBevyStore bevyChanged:bevy];
     
 } // end -cupShapePicked:
 
 // *************************************************************************************************
 
+// Handle a request to choose an alarm sound for the clicked beverage in the beverage table.
+- (IBAction)chooseAlarmSound:(id)sender
+{
+    NSInteger row = [mBevyTable clickedRow];
+    if (row < 0 || row >= (NSInteger)[mBevys count])
+        return;
+    
+    // custom sounds are played by our own audio output, so there is nothing to choose without one
+    if (!mAlarms)
+    {
+        NSBeep();
+        return;
+    }
+    
+    Cuppa_Bevy *bevy = [mBevys objectAtIndex:row];
+    NSOpenPanel *panel = [NSOpenPanel openPanel];
+    [panel setAllowedFileTypes:@[ @"aif", @"aiff", @"aifc" ]];
+    [panel setAllowsMultipleSelection:NO];
+    [panel beginSheetModalForWindow:mPrefsWindow completionHandler:^(NSModalResponse result) {
+        if (result != NSModalResponseOK)
+            return;
+        
+        // the sound is checked, imported and copied in the background, so the beverage never
+        // depends on the original and its first brew plays the sound without reading it again
+        [mAlarms keepSoundAtPath:[[panel URL] path] completion:^(NSString *path) {
+            if (!path)
+            {
+                NSAlert *alert = [[[NSAlert alloc] init] autorelease];
+                [alert setMessageText:NSLocalizedString(@"This sound can't be used as an alarm.",
+                                                        nil)];
+                [alert setInformativeText:[NSString stringWithFormat:
+                    NSLocalizedString(@"Choose an AIFF sound no longer than %d seconds.", nil),
+                    CUPPA_ALARMSOUNDS_MAX_SECONDS]];
+                [alert runModal];
+                return;
+            }
+            [bevy setAlarmSound:path];
+            
+            // Store to prefs
+            [mBevyStore bevyChanged:bevy];
+        }];
+    }];
+    
+} // end -chooseAlarmSound:
+
+// *************************************************************************************************
+
+// Handle a request to go back to the usual alarm sound for the clicked beverage.
+- (IBAction)clearAlarmSound:(id)sender
+{
+    NSInteger row = [mBevyTable clickedRow];
+    if (row < 0 || row >= (NSInteger)[mBevys count])
+        return;
+    
+    Cuppa_Bevy *bevy = [mBevys objectAtIndex:row];
+    [bevy setAlarmSound:nil];
+    
+    // Store to prefs
+    [mBevyStore bevyChanged:bevy];
+    
+} // end -clearAlarmSound:
+
+// *************************************************************************************************
+
 // Handle name editing via text field in beverage table.
 - (void)controlTextDidEndEditing:(NSNotification *)notification
 {
@@ -1090,11 +1429,11 @@
     {
         Cuppa_Bevy *bevy = [mBevys objectAtIndex:row];
         [bevy setName:[textField stringValue]];
+        [mSortKeys forgetIdentifier:[bevy identifier]];
         [self setBevys:mBevys];
         
         // Store to prefs
-        [[NSUserDefaults standardUserDefaults] setObject:[Cuppa_Bevy toDictionary:mBevys]
-                                                  forKey:@"bevys"];
+        [mBevyStore bevyChanged:bevy];
     }
     
 } // end -controlTextDidEndEditing:
@@ -1198,14 +1537,13 @@
         [temp retain];
         [mBevys removeObjectAtIndex:dragRow];
         [mBevys insertObject:temp atIndex:(dragRow < row ? (row - 1) : row)];
+        [mBevyStore bevyMoved:temp toIndex:(dragRow < row ? (row - 1) : row)];
         [temp release];
     }
     
     // update dock menu and preferences table
     [self setBevys:mBevys];
     [mBevyTable reloadData];
-    [[NSUserDefaults standardUserDefaults] setObject:[Cuppa_Bevy toDictionary:mBevys]
-                                              forKey:@"bevys"];
     
     // drop accepted!
     return YES;
@@ -1225,260 +1563,150 @@ sortDescriptorsDidChange:(NSArray *)oldDescriptors
     // find out the sort parameters
     NSArray *newDescriptors = [tableView sortDescriptors];
     
-    // do the sort
-    [mBevys sortUsingDescriptors:newDescriptors];
+    // do the sort, using the typed column comparators where the descriptors allow
+    if (![Cuppa_BevyColumns sortBevys:mBevys usingDescriptors:newDescriptors sortKeys:mSortKeys])
+        [mBevys sortUsingDescriptors:newDescriptors];
     
     // update dock menu and preferences table
     [self setBevys:mBevys];
     [mBevyTable reloadData];
-    [[NSUserDefaults standardUserDefaults] setObject:[Cuppa_Bevy toDictionary:mBevys]
-                                              forKey:@"bevys"];
+    [mBevyStore bevysReordered];
 }
 
 // *************************************************************************************************
 
-// Update the active beverage list, including a rebuild of the dock menu.
+// Update the active beverage list, including an update of the dock menu.
 // Param bevys is an ordered array of the beverages to use.
+// The menus themselves are brought up to date when they are next opened (see -updateMenus).
 - (void)setBevys:(NSMutableArray *)bevys
 {
-    int i; // loop counter
-    int hours; // hours digit of brew time
-    Cuppa_Bevy *bevy; // current beverage object
     NSMenuItem *item; // current menu item
-    NSInvocation *invocation; // invocation used to determine item selected
+    NSString *prefsTitle; // title of the preferences/settings item
     
     // parameter checks
     assert(bevys);
     
-    // clear out the old menu if it exists
-    if (mDockMenu)
-    {
-        // clear out old menu items first, since we're rebuilding the menu
-        [mDockMenu removeAllItems];
-    }
-    else
+    // create the dock menu the first time through
+    if (!mDockMenu)
     {
         // this menu is "merged" onto the top of the standard dock menu
         mDockMenu = [[NSMenu alloc] initWithTitle:@"Cuppa"]; // title not used
-    }
-    
-    // create new dock menu
-    // this menu is "merged" onto the top of the standard dock menu
-    
-    // iterate over the beverages in order
-    for (i = 0; i < [bevys count]; i++)
-    {
-        // access the beverage object
-        bevy = (Cuppa_Bevy *)[bevys objectAtIndex:i];
-        NSAssert(bevy != nil, @"Could not find bevy in array.\n");
         
-        // created an invocation used to determine which item has been selected
-        // this is required to avoid the OSX bug described in -startBrewing:
-        invocation = [NSInvocation invocationWithMethodSignature:[self
-                                                                  methodSignatureForSelector:@selector(startBrewing:)]];
+        // add a separator
+        [mDockMenu addItem:[NSMenuItem separatorItem]];
+        
+        // add the quick timer item
+        item = [[[NSMenuItem alloc] initWithTitle:NSLocalizedString(@"Quick Timer...", nil)
+                                           action:@selector(showQuickTimer:)
+                                    keyEquivalent:@""] autorelease];
+        [item setTarget:self];
+        [item setEnabled:YES];
+        [mDockMenu addItem:item];
+        
+        // add the cancel timer item
+        item = [[[NSMenuItem alloc] initWithTitle:NSLocalizedString(@"Cancel", nil)
+                                           action:@selector(cancelTimer:)
+                                    keyEquivalent:@""] autorelease];
+        [item setTarget:self];
+        [item setEnabled:YES];
+        [mDockMenu addItem:item];
         
-        // get the image for this beverage
-        NSImage *bevyImage = [Cuppa_Shape imageForShape:[bevy cupShape]];
+        // add a separator
+        [mDockMenu addItem:[NSMenuItem separatorItem]];
         
-        if (mShowSteep)
+        // add the preferences/settings item
+        if (@available(macOS 13.0, *))
         {
-            // build a menu item for the beverage -- with steep times
-            hours = [bevy brewTime] / 3600;
-            if (hours > 0)
-            {
-                item = [[[NSMenuItem alloc] initWithTitle:[NSString stringWithFormat:@"%@ (%d:%02d:%02d)",
-                                                           [bevy name],
-                                                           hours,
-                                                           ([bevy brewTime] - (hours * 3600)) / 60,
-                                                           ([bevy brewTime] - (hours * 3600)) % 60]
-                                                   action:@selector(invoke)
-                                            keyEquivalent:@""] autorelease];
-                [item setRepresentedObject:bevy];
-            }
-            else
-            {
-                item = [[[NSMenuItem alloc] initWithTitle:[NSString stringWithFormat:@"%@ (%d:%02d)",
-                                                           [bevy name],
-                                                           [bevy brewTime] / 60,
-                                                           [bevy brewTime] % 60]
-                                                   action:@selector(invoke)
-                                            keyEquivalent:@""] autorelease];
-                [item setRepresentedObject:bevy];
-            }
+            prefsTitle = NSLocalizedString(@"Settings...", nil);
         }
         else
         {
-            // build a menu item for the beverage -- without steep times
-            item = [[[NSMenuItem alloc] initWithTitle:[NSString stringWithFormat:@"%@",
-                                                       [bevy name]]
-                                               action:@selector(invoke)
-                                        keyEquivalent:@""] autorelease];
-            [item setRepresentedObject:bevy];
+            prefsTitle = NSLocalizedString(@"Preferences...", nil);
         }
-        
-        // wire up the invocation and the item
-        [invocation setSelector:@selector(startBrewing:)];
-        [invocation setTarget:self];
-        [invocation setArgument:&item atIndex:2];
-        [item setTarget:[invocation retain]];
+        item = [[[NSMenuItem alloc] initWithTitle:prefsTitle
+                                           action:@selector(showPrefs:)
+                                    keyEquivalent:@""] autorelease];
+        [item setTarget:self];
         [item setEnabled:YES];
-        [item setImage:bevyImage];
-        
-        // append the item to the menu
-        [mDockMenu insertItem:item atIndex:i];
+        [mDockMenu addItem:item];
         
-    } // end for
+        // we use static item enabling
+        [mDockMenu setAutoenablesItems:NO];
+    }
     
-    // add a separator
-    [mDockMenu insertItem:[NSMenuItem separatorItem] atIndex:i];
-    i++;
+    // the menus need every beverage, so for a large list they only catch up when opened
+    [bevys retain];
+    [mMenuBevys release];
+    mMenuBevys = bevys;
+    mMenusStale = true;
     
-    // add the quick timer item
-    item = [[[NSMenuItem alloc] initWithTitle:NSLocalizedString(@"Quick Timer...", nil)
-                                       action:@selector(showQuickTimer:)
-                                keyEquivalent:@""] autorelease];
-    [item setTarget:self];
-    [item setEnabled:YES];
-    [mDockMenu insertItem:item atIndex:(i)];
-    i++;
-    
-    // add the cancel timer item
-    item = [[[NSMenuItem alloc] initWithTitle:NSLocalizedString(@"Cancel", nil)
-                                       action:@selector(cancelTimer:)
-                                keyEquivalent:@""] autorelease];
-    [item setTarget:self];
-    [item setEnabled:YES];
-    [mDockMenu insertItem:item atIndex:(i)];
-    i++;
+} // end -setBevys:
+
+// *************************************************************************************************
+
+// Bring the beverage items in the dock and application menus up to date, if they need it.
+- (void)updateMenus
+{
+    NSMutableArray *identifiers; // identifiers of the beverages the menus should show
+    NSUInteger i; // loop counter
     
-    // add a separator
-    [mDockMenu insertItem:[NSMenuItem separatorItem] atIndex:i];
-    i++;
+    // nothing to do if nothing has changed
+    if (!mMenusStale)
+        return;
+    mMenusStale = false;
     
-    // add the preferences/settings item
-    NSString *prefsTitle;
-    if (@available(macOS 13.0, *))
+    // the menus remember what they show by identifier, so a lazy list does not make an object of
+    // each beverage
+    identifiers = [NSMutableArray arrayWithCapacity:[mMenuBevys count]];
+    for (i = 0; i < [mMenuBevys count]; i++)
     {
-        prefsTitle = NSLocalizedString(@"Settings...", nil);
+        [identifiers addObject:[mMenuBevys bevyIdentifierAtIndex:i]];
     }
-    else
-    {
-        prefsTitle = NSLocalizedString(@"Preferences...", nil);
-    }
-    item = [[[NSMenuItem alloc] initWithTitle:prefsTitle
-                                       action:@selector(showPrefs:)
-                                keyEquivalent:@""] autorelease];
-    [item setTarget:self];
-    [item setEnabled:YES];
-    [mDockMenu insertItem:item atIndex:(i)];
-    i++;
     
-    // we use static item enabling
-    [mDockMenu setAutoenablesItems:NO];
+    // bring the beverage items at the top of the dock menu up to date
+    [self updateMenu:mDockMenu from:mDockMenuIdentifiers to:identifiers keyEquivalents:NO];
+    [mDockMenuIdentifiers release];
+    mDockMenuIdentifiers = [identifiers copy];
     
     // update the bevy menu
     if (mAppMenu)
     {
-        
-        // clear out the old menu
-        i = (int)[mAppMenu numberOfItems] - 3;
-        while (i-- > 0)
-        {
-            [mAppMenu removeItemAtIndex:0];
-        }
-        
-        // iterate over the beverages in order
-        for (i = 0; i < [bevys count]; i++)
-        {
-            // access the beverage object
-            bevy = (Cuppa_Bevy *)[bevys objectAtIndex:i];
-            NSAssert(bevy != nil, @"Could not find bevy in array.\n");
-            
-            // created an invocation used to determine which item has been selected
-            // this is required to avoid the OSX bug described in -startBrewing:
-            invocation = [NSInvocation invocationWithMethodSignature:[self
-                                                                      methodSignatureForSelector:@selector(startBrewing:)]];
-            
-            // get the image for this beverage
-            NSImage *bevyImage = [Cuppa_Shape imageForShape:[bevy cupShape]];
-            
-            if (mShowSteep)
-            {
-                // build a menu item for the beverage -- with steep times
-                hours = [bevy brewTime] / 3600;
-                if (hours > 0)
-                {
-                    item = [[[NSMenuItem alloc] initWithTitle:[NSString stringWithFormat:@"%@ (%d:%02d:%02d)",
-                                                               [bevy name],
-                                                               hours,
-                                                               ([bevy brewTime] - (hours * 3600)) / 60,
-                                                               ([bevy brewTime] - (hours * 3600)) % 60]
-                                                       action:@selector(invoke)
-                                                keyEquivalent:@""] autorelease];
-                    [item setImage:bevyImage];
-                    [item setRepresentedObject:bevy];
-                }
-                else
-                {
-                    item = [[[NSMenuItem alloc] initWithTitle:[NSString stringWithFormat:@"%@ (%d:%02d)",
-                                                               [bevy name],
-                                                               [bevy brewTime] / 60,
-                                                               [bevy brewTime] % 60]
-                                                       action:@selector(invoke)
-                                                keyEquivalent:@""] autorelease];
-                    [item setImage:bevyImage];
-                    [item setRepresentedObject:bevy];
-                }
-            }
-            else
-            {
-                // build a menu item for the beverage -- without steep times
-                item = [[[NSMenuItem alloc] initWithTitle:[NSString stringWithFormat:@"%@",
-                                                           [bevy name]]
-                                                   action:@selector(invoke)
-                                            keyEquivalent:@""] autorelease];
-                [item setImage:bevyImage];
-                [item setRepresentedObject:bevy];
-            }
-            
-            // wire up the invocation and the item
-            [invocation setSelector:@selector(startBrewing:)];
-            [invocation setTarget:self];
-            [invocation setArgument:&item atIndex:2];
-            [item setTarget:[invocation retain]];
-            
-            // set the key equivalent for this item
-            if (i < 40)
-            {
-                [item setKeyEquivalent:[NSString stringWithFormat:@"%d", (i % 10)]];
-                if (i < 10)
-                {
-                    [item setKeyEquivalentModifierMask:NSEventModifierFlagCommand];
-                }
-                else if (i < 20)
-                {
-                    [item setKeyEquivalentModifierMask:NSEventModifierFlagCommand + NSEventModifierFlagOption];
-                }
-                else if (i < 30)
-                {
-                    [item setKeyEquivalentModifierMask:NSEventModifierFlagCommand + NSEventModifierFlagControl];
-                }
-                else
-                {
-                    [item setKeyEquivalentModifierMask:NSEventModifierFlagCommand + NSEventModifierFlagShift];
-                }
-            }
-            
-            // enable the item
-            [item setEnabled:YES];
-            
-            // append the item to the menu
-            [mAppMenu insertItem:item atIndex:i];
-            
-        } // end for
+        [self updateMenu:mAppMenu from:mAppMenuIdentifiers to:identifiers keyEquivalents:YES];
+        [mAppMenuIdentifiers release];
+        mAppMenuIdentifiers = [identifiers copy];
     }
     
-} // end -setBevys:
+} // end -updateMenus
+
+// *************************************************************************************************
+
+// Bring the Beverages menu up to date just before it is shown (or searched for a shortcut).
+- (void)menuNeedsUpdate:(NSMenu *)menu
+{
+    [self updateMenus];
+    
+} // end -menuNeedsUpdate:
+
+// *************************************************************************************************
+
+// Update the beverage items at the top of a menu, which show the beverages with oldIdentifiers, to
+// show those with identifiers instead; each is found at the same index in the menu's beverages.
+// Items for beverages still in the list are kept (and only touched if they have changed), so a
+// rename or reorder does not rebuild the whole menu. Number keys are assigned if keys is set.
+- (void)updateMenu:(NSMenu *)menu
+              from:(NSArray *)oldIdentifiers
+                to:(NSArray *)identifiers
+    keyEquivalents:(BOOL)keys
+{
+    [Cuppa_BevyMenu updateMenu:menu
+                          from:oldIdentifiers
+                            to:identifiers
+                         bevys:mMenuBevys
+                     showSteep:mShowSteep
+                keyEquivalents:keys
+                        target:self];
+    
+} // end -updateMenu:from:to:keyEquivalents:
 
 // *************************************************************************************************
 
@@ -1503,34 +1731,24 @@ sortDescriptorsDidChange:(NSArray *)oldDescriptors
 // Handle an application quit notice.
 - (NSApplicationTerminateReply)applicationShouldTerminate:(NSApplication *)theApplication
 {
-    int hours;
-    char countString[16];
+    int secondsRemain; // seconds until the last active brew is complete
+    char countString[CUPPA_TIME_STRING_MAX]; // formatted time remaining
     
 #if !defined(NDEBUG)
     printf("Application terminating?.\n");
 #endif
     
     // Do we have a timer outstanding?
-    if (mSecondsRemain <= 0)
+    if ([mBrewer count] == 0)
     {
         return NSTerminateNow;
     }
     
-    // yep we do, check with the user before quitting
-    hours = mSecondsRemain / 3600;
-    if (hours > 0)
-    {
-        sprintf(countString, "%01d:%02d:%02d",
-                hours,
-                (mSecondsRemain - (hours * 3600)) / 60,
-                (mSecondsRemain - (hours * 3600)) % 60);
-    }
-    else
-    {
-        sprintf(countString, "%01d:%02d",
-                mSecondsRemain / 60,
-                mSecondsRemain % 60);
-    }
+    // yep we do, find out how long until the last one is done
+    secondsRemain = CuppaScheduleSecondsRemain([mBrewer lastDeadline] - [[mBrewer clock] now]);
+    
+    // check with the user before quitting
+    [Cuppa_TimeFormat formatSeconds:secondsRemain buffer:countString size:sizeof(countString)];
     
     NSAlert *alert = [[NSAlert alloc] init];
     [alert setMessageText:NSLocalizedString(@"Warning!", nil)];
@@ -1563,13 +1781,31 @@ sortDescriptorsDidChange:(NSArray *)oldDescriptors
     NSAssert(mRender, @"Render object is nil.\n");
     [mRender restore];
     
-    // Ensure the user's settings are saved for the next run.
-    [[NSUserDefaults standardUserDefaults] synchronize];
+    // Brews don't outlive us, so neither should their notifications.
+    [mBrewer enumerateBrewsUsingBlock:^(Cuppa_Brew *brew)
+    {
+        [self withdrawNotifyOSX:brew];
+    }];
+    
+    // Ensure the user's settings are saved for the next run, with the beverage list whole again.
+    if ([mBevyStore logCount] > 0)
+        [mBevyStore compact];
+    [mPrefs checkpoint:nil];
+    [mPrefs waitUntilWritten];
     
 } // end -appQuit:
 
 // *************************************************************************************************
 
+// Save settings whenever the user switches away, in case we don't get to quit cleanly.
+- (void)applicationDidResignActive:(NSNotification *)aNotification
+{
+    [mPrefs checkpoint:nil];
+    
+} // end -applicationDidResignActive:
+
+// *************************************************************************************************
+
 // Restore default beverages.
 - (void)restoreDefaults:(id)sender
 {
@@ -1577,55 +1813,49 @@ sortDescriptorsDidChange:(NSArray *)oldDescriptors
     printf("Restoring defaults.\n");
 #endif
     
-    // default notification settings
-    mBounceIcon = true;
-    if ([mBounceSwitch state] != NSOnState)
-        [mBounceSwitch setNextState];
-    [[NSUserDefaults standardUserDefaults] setBool:mBounceIcon forKey:@"bounceIcon"];
+    // default notification settings, each changed through its toggle handler so the brews under
+    // way pick up the change (sounds, notifications and the countdown are rescheduled as needed)
+    if (!mBounceIcon)
+        [self toggleBounce:nil];
+    [mBounceSwitch setState:(mBounceIcon ? NSOnState : NSOffState)];
     
-    mMakeSound = true;
-    if ([mSoundSwitch state] != NSOnState)
-        [mSoundSwitch setNextState];
-    [[NSUserDefaults standardUserDefaults] setBool:mMakeSound forKey:@"makeSound"];
+    if (!mMakeSound)
+        [self toggleSound:nil];
+    [mSoundSwitch setState:(mMakeSound ? NSOnState : NSOffState)];
     
-    mSpeakAlert = false;
-    if ([mSpeakSwitch state] != NSOnState)
-        [mSpeakSwitch setNextState];
-    [[NSUserDefaults standardUserDefaults] setBool:mSpeakAlert forKey:@"speakAlert"];
+    if (mSpeakAlert)
+        [self toggleSpeak:nil];
+    [mSpeakSwitch setState:(mSpeakAlert ? NSOnState : NSOffState)];
     
-    mShowAlert = true;
-    if ([mAlertSwitch state] != NSOnState)
-        [mAlertSwitch setNextState];
-    [[NSUserDefaults standardUserDefaults] setBool:mShowAlert forKey:@"showAlert"];
+    if (!mShowAlert)
+        [self toggleAlert:nil];
+    [mAlertSwitch setState:(mShowAlert ? NSOnState : NSOffState)];
     
-    mShowTimer = true;
-    if ([mTimerSwitch state] != NSOnState)
-        [mTimerSwitch setNextState];
-    [[NSUserDefaults standardUserDefaults] setBool:mShowTimer forKey:@"showTimer"];
+    if (!mShowTimer)
+        [self toggleTimer:nil];
+    [mTimerSwitch setState:(mShowTimer ? NSOnState : NSOffState)];
     
-    mShowSteep = true;
-    if ([mSteepSwitch state] != NSOnState)
-        [mSteepSwitch setNextState];
-    [[NSUserDefaults standardUserDefaults] setBool:mShowSteep forKey:@"showSteep"];
+    if (!mShowSteep)
+        [self toggleSteep:nil];
+    [mSteepSwitch setState:(mShowSteep ? NSOnState : NSOffState)];
     
-    mAutoStart = false;
-    if ([mAutoStartSwitch state] != NSOnState)
-        [mAutoStartSwitch setNextState];
-    [[NSUserDefaults standardUserDefaults] setBool:mAutoStart forKey:@"autoStart"];
+    if (mAutoStart)
+        [self toggleAutoStart:nil];
+    [mAutoStartSwitch setState:(mAutoStart ? NSOnState : NSOffState)];
     
-    mNotifyOSX = true;
-    if ([mOSXNotifySwitch state] != NSOnState)
-        [mOSXNotifySwitch setNextState];
-    [[NSUserDefaults standardUserDefaults] setBool:mNotifyOSX forKey:@"notifyOSX"];
+    // (the toggle leaves Notification Center alone if it is not available)
+    if (!mNotifyOSX)
+        [self toggleNotifyOSX:nil];
+    [mOSXNotifySwitch setState:(mNotifyOSX ? NSOnState : NSOffState)];
     
     // apply the default beverage set
     [mBevys autorelease];
     mBevys = [Cuppa_Bevy defaultBevys];
     [mBevys retain];
+    [mSortKeys forgetAll];
     [self setBevys:mBevys];
     [mBevyTable reloadData];
-    [[NSUserDefaults standardUserDefaults] setObject:[Cuppa_Bevy toDictionary:mBevys]
-                                              forKey:@"bevys"];
+    [mBevyStore replaceBevys:mBevys];
     
 } // end -restoreDefaults:
 
@@ -1634,43 +1864,43 @@ sortDescriptorsDidChange:(NSArray *)oldDescriptors
 // Build the application dock menu as required.
 - (NSMenu *)applicationDockMenu:(NSApplication *)sender
 {
-    // return our custom dock menu
+    // return our custom dock menu, brought up to date
+    [self updateMenus];
     return mDockMenu;
     
 } // end -applicationDockMenu:
 
 // *************************************************************************************************
 
-// Send notification to OS X Notification Center
-- (void)notifyOSX
+// Schedule a Notification Center notification for a brew, delay seconds from now.
+- (void)notifyOSX:(Cuppa_Brew *)brew after:(NSTimeInterval)delay
 {
 #if !defined(NDEBUG)
-    printf("notifying Notification Center, current bevy: %@\n", [mCurrentBevy name]);
+    printf("notifying Notification Center, current bevy: %s\n", [[brew name] UTF8String]);
 #endif
     
-    if (@available(macOS 10.14, *)) {
-        // create a unique request identifier
-        NSString *uuidString = [[NSUUID UUID] UUIDString];
-        
-        // use new Notification Center API, if available
-        UNMutableNotificationContent *notification = [[UNMutableNotificationContent alloc] init];
-        notification.title = NSLocalizedString(@"Brewing complete...", nil);
-        notification.body = [NSString stringWithFormat:NSLocalizedString(@"%@ is now ready!", nil), [mCurrentBevy name]];
-        // NB: playing a sound is handled in updateTick for consistency
-        // notification.sound = [UNNotificationSound soundNamed:@"spoon.aiff"];
-        UNNotificationRequest *request = [UNNotificationRequest requestWithIdentifier:uuidString content:notification trigger:nil];
-        [[UNUserNotificationCenter currentNotificationCenter] addNotificationRequest:request withCompletionHandler:^(NSError * _Nullable error) {}];
-    }
-    else
+    [mNotifier scheduleNotification:[brew identifier]
+                              title:NSLocalizedString(@"Brewing complete...", nil)
+                               body:[self alertText:brew]
+                              after:delay];
+    [brew setNotifyScheduled:true];
+    
+} // end -notifyOSX:after:
+
+// *************************************************************************************************
+
+// Withdraw the Notification Center notification for a brew, if it has not been delivered yet.
+- (void)withdrawNotifyOSX:(Cuppa_Brew *)brew
+{
+    if ([brew notifyScheduled])
     {
-        // fall back to previous API
-        NSUserNotification *notification = [[NSUserNotification alloc] init];
-        notification.title = NSLocalizedString(@"Brewing complete...", nil);
-        notification.informativeText = [NSString stringWithFormat:NSLocalizedString(@"%@ is now ready!", nil), [mCurrentBevy name]];
-        [[NSUserNotificationCenter defaultUserNotificationCenter] deliverNotification:notification];
+        [mNotifier withdrawNotification:[brew identifier]];
+        [brew setNotifyScheduled:false];
     }
     
-} // end -notifyOSX
+} // end -withdrawNotifyOSX:
+
+// *************************************************************************************************
 
 // App delegate to allow notification in foreground
 - (void)userNotificationCenter:(UNUserNotificationCenter *)center
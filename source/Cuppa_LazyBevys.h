@@ -0,0 +1,125 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_LazyBevys
+           - A beverage list over a packed catalog, which only creates beverage objects for the
+             rows that are actually used.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_LAZYBEVYS_H
+#define _CUPPA_LAZYBEVYS_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Catalog.h"
+
+// Constants
+
+enum
+{
+    CUPPA_LAZYBEVYS_HOT_ROWS = 128 // rows read for display that are kept decoded
+};
+
+// Class Interface
+
+// Any row fetched with -objectAtIndex: (to start, edit or show in a menu) becomes a real
+// Cuppa_Bevy that stays in the list, so it is always the same object. The bevy* accessors below
+// only read a row: single fields come straight from the catalog, and rows read whole with
+// -bevyForReadingAtIndex: are decoded into a small cache of recently used rows that are never
+// made part of the list, so they can be dropped again safely.
+@interface Cuppa_LazyBevys : NSMutableArray
+{
+    Cuppa_Catalog *mCatalog; // packed rows
+    NSMutableArray *mSlots; // each row: its Cuppa_Bevy, or its catalog index (NSNumber)
+    NSMutableDictionary *mHot; // decoded rows recently read, by catalog index
+    NSMutableArray *mHotOrder; // catalog indexes of the decoded rows, least recently read first
+    NSUInteger mHotCapacity; // most decoded rows to keep
+}
+
+// ------ Life Cycle ------
+
+// Initialize a list of every beverage in a catalog, keeping capacity decoded rows.
+- (id)initWithCatalog:(Cuppa_Catalog *)catalog hotCapacity:(NSUInteger)capacity;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Accessors ------
+
+// Returns the number of rows that have become beverage objects.
+- (NSUInteger)materializedCount;
+
+// Returns the number of decoded rows kept for reading.
+- (NSUInteger)hotCount;
+
+@end // @interface Cuppa_LazyBevys
+
+// Category Interface
+
+// Read a row of any beverage list without needing a beverage object for it. Plain arrays just ask
+// the object; Cuppa_LazyBevys reads the catalog.
+@interface NSArray (Cuppa_LazyBevys)
+
+// Returns a beverage to read every field of a row from, without making the row an object of the
+// list. It may be dropped once another row is read, so retain it to keep it, and never change it.
+- (Cuppa_Bevy *)bevyForReadingAtIndex:(NSUInteger)index;
+
+// Returns the name of the beverage at index.
+- (NSString *)bevyNameAtIndex:(NSUInteger)index;
+
+// Returns the handle of the name of the beverage at index in the shared Cuppa_NameArena.
+- (NSUInteger)bevyNameHandleAtIndex:(NSUInteger)index;
+
+// Returns the brew time of the beverage at index.
+- (int)bevyBrewTimeAtIndex:(NSUInteger)index;
+
+// Returns the cup shape of the beverage at index.
+- (int)bevyCupShapeAtIndex:(NSUInteger)index;
+
+// Returns the stable identifier of the beverage at index.
+- (NSString *)bevyIdentifierAtIndex:(NSUInteger)index;
+
+// Convert the list to an array of beverage dictionaries, to allow user defaults storage.
+- (NSMutableArray *)bevyDictionaries;
+
+// Returns a snapshot of the rows for saving off the main thread: a beverage dictionary for each
+// row that has a beverage object, and the index (NSNumber) in -bevyCatalog of each row that does
+// not. Pass both to +[Cuppa_Catalog fromRows:ofCatalog:].
+- (NSArray *)bevyRows;
+
+// Returns the catalog the rows without beverage objects are read from, or nil.
+- (Cuppa_Catalog *)bevyCatalog;
+
+@end // @interface NSArray (Cuppa_LazyBevys)
+
+// Returns a beverage to read every field of a row from, without making the row an object of the
+// list. It may be dropped once another row is read, so retain it to keep it, and never change it.
+- (Cuppa_Bevy *)bevyForReadingAtIndex:(NSUInteger)index;
+
+// Rearrange the rows of any beverage list without needing a beverage object for each of them.
+@interface NSMutableArray (Cuppa_LazyBevys)
+
+// Put the rows in a new order: row i becomes the row that was at rows[i], for every row.
+- (void)reorderBevysByRows:(const NSUInteger *)rows;
+
+@end // @interface NSMutableArray (Cuppa_LazyBevys)
+
+// *************************************************************************************************
+
+#endif // _CUPPA_LAZYBEVYS_H
+
+// end Cuppa_LazyBevys.h
@@ -0,0 +1,506 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_LazyBevys
+           - A beverage list over a packed catalog, which only creates beverage objects for the
+             rows that are actually used.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Catalog.h"
+#import "Cuppa_LazyBevys.h"
+#import "Cuppa_NameArena.h"
+
+// Code!
+
+@implementation Cuppa_LazyBevys
+;
+
+// *************************************************************************************************
+
+// Initialize a list of every beverage in a catalog, keeping capacity decoded rows.
+- (id)initWithCatalog:(Cuppa_Catalog *)catalog hotCapacity:(NSUInteger)capacity
+{
+    NSUInteger i; // loop counter
+
+    // NSMutableArray's own initializers lead back to -initWithCapacity: on some runtimes
+    self = [super initWithCapacity:0];
+    mCatalog = [catalog retain];
+    mSlots = [[NSMutableArray alloc] initWithCapacity:[catalog count]];
+    for (i = 0; i < [catalog count]; i++)
+    {
+        [mSlots addObject:[NSNumber numberWithUnsignedInteger:i]];
+    }
+    mHot = [[NSMutableDictionary alloc] init];
+    mHotOrder = [[NSMutableArray alloc] init];
+    mHotCapacity = MAX(capacity, 1);
+    return self;
+
+} // end -initWithCatalog:hotCapacity:
+
+// *************************************************************************************************
+
+// Initialize an empty list (for NSMutableArray).
+- (id)initWithCapacity:(NSUInteger)capacity
+{
+    return [self initWithCatalog:nil hotCapacity:CUPPA_LAZYBEVYS_HOT_ROWS];
+
+} // end -initWithCapacity:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the rows
+    [mCatalog release];
+    [mSlots release];
+    [mHot release];
+    [mHotOrder release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Returns the number of rows (for NSArray).
+- (NSUInteger)count
+{
+    // return requested info
+    return [mSlots count];
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the beverage object for a row, creating it if need be (for NSArray).
+- (id)objectAtIndex:(NSUInteger)index
+{
+    id slot; // row as stored
+    Cuppa_Bevy *bevy; // beverage object for the row
+
+    slot = [mSlots objectAtIndex:index];
+    if ([slot isKindOfClass:[Cuppa_Bevy class]])
+        return slot;
+
+    // a decoded row has only been read, so it can become the row's object
+    bevy = [mHot objectForKey:slot];
+    if (bevy)
+    {
+        [bevy retain];
+        [mHot removeObjectForKey:slot];
+        [mHotOrder removeObject:slot];
+    }
+    else
+    {
+        bevy = [[mCatalog bevyAtIndex:[slot unsignedIntegerValue]] retain];
+    }
+    [mSlots replaceObjectAtIndex:index withObject:bevy];
+    [bevy release];
+
+    return bevy;
+
+} // end -objectAtIndex:
+
+// *************************************************************************************************
+
+// Insert a beverage object (for NSMutableArray).
+- (void)insertObject:(id)anObject atIndex:(NSUInteger)index
+{
+    // parameter checks
+    NSAssert([anObject isKindOfClass:[Cuppa_Bevy class]], @"Bad object parameter.\n");
+
+    [mSlots insertObject:anObject atIndex:index];
+
+} // end -insertObject:atIndex:
+
+// *************************************************************************************************
+
+// Remove a row (for NSMutableArray).
+- (void)removeObjectAtIndex:(NSUInteger)index
+{
+    [mSlots removeObjectAtIndex:index];
+
+} // end -removeObjectAtIndex:
+
+// *************************************************************************************************
+
+// Append a beverage object (for NSMutableArray).
+- (void)addObject:(id)anObject
+{
+    [self insertObject:anObject atIndex:[mSlots count]];
+
+} // end -addObject:
+
+// *************************************************************************************************
+
+// Remove the last row (for NSMutableArray).
+- (void)removeLastObject
+{
+    [mSlots removeLastObject];
+
+} // end -removeLastObject
+
+// *************************************************************************************************
+
+// Replace a row with a beverage object (for NSMutableArray).
+- (void)replaceObjectAtIndex:(NSUInteger)index withObject:(id)anObject
+{
+    // parameter checks
+    NSAssert([anObject isKindOfClass:[Cuppa_Bevy class]], @"Bad object parameter.\n");
+
+    [mSlots replaceObjectAtIndex:index withObject:anObject];
+
+} // end -replaceObjectAtIndex:withObject:
+
+// *************************************************************************************************
+
+// Returns the beverage to read a row from: its object if it has one, otherwise a decoded copy
+// kept among the recently read rows.
+- (Cuppa_Bevy *)bevyForReadingAtIndex:(NSUInteger)index
+{
+    id slot; // row as stored
+    Cuppa_Bevy *bevy; // decoded row
+
+    slot = [mSlots objectAtIndex:index];
+    if ([slot isKindOfClass:[Cuppa_Bevy class]])
+        return slot;
+
+    // most recently read rows go to the end, and the first one goes once there are too many
+    bevy = [mHot objectForKey:slot];
+    if (bevy)
+    {
+        [mHotOrder removeObject:slot];
+    }
+    else
+    {
+        bevy = [mCatalog bevyAtIndex:[slot unsignedIntegerValue]];
+        [mHot setObject:bevy forKey:slot];
+        if ([mHotOrder count] >= mHotCapacity)
+        {
+            [mHot removeObjectForKey:[mHotOrder objectAtIndex:0]];
+            [mHotOrder removeObjectAtIndex:0];
+        }
+    }
+    [mHotOrder addObject:slot];
+
+    // it stays valid until the caller is done with it, even if it is dropped from the cache
+    return [[bevy retain] autorelease];
+
+} // end -bevyForReadingAtIndex:
+
+// *************************************************************************************************
+
+// Returns the name of the beverage at index.
+- (NSString *)bevyNameAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [[Cuppa_NameArena sharedArena] nameForHandle:[self bevyNameHandleAtIndex:index]];
+
+} // end -bevyNameAtIndex:
+
+// *************************************************************************************************
+
+// Returns the handle of the name of the beverage at index in the shared Cuppa_NameArena.
+- (NSUInteger)bevyNameHandleAtIndex:(NSUInteger)index
+{
+    id slot; // row as stored
+
+    // the name alone is cheap to read, so it does not need a decoded row
+    slot = [mSlots objectAtIndex:index];
+    if ([slot isKindOfClass:[Cuppa_Bevy class]])
+        return [slot nameHandle];
+    return [mCatalog nameHandleAtIndex:[slot unsignedIntegerValue]];
+
+} // end -bevyNameHandleAtIndex:
+
+// *************************************************************************************************
+
+// Returns the brew time of the beverage at index.
+- (int)bevyBrewTimeAtIndex:(NSUInteger)index
+{
+    id slot; // row as stored
+
+    // the brew time alone is cheap to read, so it does not need a decoded row
+    slot = [mSlots objectAtIndex:index];
+    if ([slot isKindOfClass:[Cuppa_Bevy class]])
+        return [slot brewTime];
+    return [mCatalog brewTimeAtIndex:[slot unsignedIntegerValue]];
+
+} // end -bevyBrewTimeAtIndex:
+
+// *************************************************************************************************
+
+// Returns the cup shape of the beverage at index.
+- (int)bevyCupShapeAtIndex:(NSUInteger)index
+{
+    id slot; // row as stored
+
+    // the cup shape alone is cheap to read, so it does not need a decoded row
+    slot = [mSlots objectAtIndex:index];
+    if ([slot isKindOfClass:[Cuppa_Bevy class]])
+        return [slot cupShape];
+    return [mCatalog cupShapeAtIndex:[slot unsignedIntegerValue]];
+
+} // end -bevyCupShapeAtIndex:
+
+// *************************************************************************************************
+
+// Returns the stable identifier of the beverage at index.
+- (NSString *)bevyIdentifierAtIndex:(NSUInteger)index
+{
+    id slot; // row as stored
+
+    // the identifier alone is cheap to read, so it does not need a decoded row
+    slot = [mSlots objectAtIndex:index];
+    if ([slot isKindOfClass:[Cuppa_Bevy class]])
+        return [slot identifier];
+    return [mCatalog identifierAtIndex:[slot unsignedIntegerValue]];
+
+} // end -bevyIdentifierAtIndex:
+
+// *************************************************************************************************
+
+// Convert the list to an array of beverage dictionaries, to allow user defaults storage.
+- (NSMutableArray *)bevyDictionaries
+{
+    NSMutableArray *dictArray; // array of dictionarys
+    id slot; // row as stored
+
+    dictArray = [NSMutableArray arrayWithCapacity:[mSlots count]];
+    for (slot in mSlots)
+    {
+        if ([slot isKindOfClass:[Cuppa_Bevy class]])
+            [dictArray addObject:[slot dictionary]];
+        else
+            [dictArray addObject:[mCatalog dictionaryAtIndex:[slot unsignedIntegerValue]]];
+    }
+
+    return dictArray;
+
+} // end -bevyDictionaries
+
+// *************************************************************************************************
+
+// Returns a snapshot of the rows for saving off the main thread.
+- (NSArray *)bevyRows
+{
+    NSMutableArray *rows; // rows as saved
+    id slot; // row as stored
+
+    // only rows that have objects can change, so only they need converting now
+    rows = [NSMutableArray arrayWithCapacity:[mSlots count]];
+    for (slot in mSlots)
+    {
+        if ([slot isKindOfClass:[Cuppa_Bevy class]])
+            [rows addObject:[slot dictionary]];
+        else
+            [rows addObject:slot];
+    }
+
+    return rows;
+
+} // end -bevyRows
+
+// *************************************************************************************************
+
+// Returns the catalog the rows without beverage objects are read from.
+- (Cuppa_Catalog *)bevyCatalog
+{
+    // return requested info
+    return mCatalog;
+
+} // end -bevyCatalog
+
+// *************************************************************************************************
+
+// Put the rows in a new order: row i becomes the row that was at rows[i], for every row.
+- (void)reorderBevysByRows:(const NSUInteger *)rows
+{
+    NSMutableArray *slots; // rows in their new order
+    NSUInteger i; // loop counter
+
+    // parameter checks
+    NSAssert(rows != NULL || [mSlots count] == 0, @"Bad rows parameter.\n");
+
+    // move the rows as stored, so no row becomes a beverage object
+    slots = [[NSMutableArray alloc] initWithCapacity:[mSlots count]];
+    for (i = 0; i < [mSlots count]; i++)
+    {
+        [slots addObject:[mSlots objectAtIndex:rows[i]]];
+    }
+    [mSlots release];
+    mSlots = slots;
+
+} // end -reorderBevysByRows:
+
+// *************************************************************************************************
+
+// Returns the number of rows that have become beverage objects.
+- (NSUInteger)materializedCount
+{
+    NSUInteger count = 0; // rows with objects
+    id slot; // row as stored
+
+    for (slot in mSlots)
+    {
+        if ([slot isKindOfClass:[Cuppa_Bevy class]])
+            count++;
+    }
+
+    // return requested info
+    return count;
+
+} // end -materializedCount
+
+// *************************************************************************************************
+
+// Returns the number of decoded rows kept for reading.
+- (NSUInteger)hotCount
+{
+    // return requested info
+    return [mHot count];
+
+} // end -hotCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_LazyBevys
+
+// *************************************************************************************************
+
+@implementation NSArray (Cuppa_LazyBevys)
+;
+
+// *************************************************************************************************
+
+// Returns the beverage to read a row from (a plain list just has the object).
+- (Cuppa_Bevy *)bevyForReadingAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [self objectAtIndex:index];
+
+} // end -bevyForReadingAtIndex:
+
+// *************************************************************************************************
+
+// Returns the name of the beverage at index.
+- (NSString *)bevyNameAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [[self objectAtIndex:index] name];
+
+} // end -bevyNameAtIndex:
+
+// *************************************************************************************************
+
+// Returns the handle of the name of the beverage at index in the shared Cuppa_NameArena.
+- (NSUInteger)bevyNameHandleAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [[self objectAtIndex:index] nameHandle];
+
+} // end -bevyNameHandleAtIndex:
+
+// *************************************************************************************************
+
+// Returns the brew time of the beverage at index.
+- (int)bevyBrewTimeAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [[self objectAtIndex:index] brewTime];
+
+} // end -bevyBrewTimeAtIndex:
+
+// *************************************************************************************************
+
+// Returns the cup shape of the beverage at index.
+- (int)bevyCupShapeAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [[self objectAtIndex:index] cupShape];
+
+} // end -bevyCupShapeAtIndex:
+
+// *************************************************************************************************
+
+// Returns the stable identifier of the beverage at index.
+- (NSString *)bevyIdentifierAtIndex:(NSUInteger)index
+{
+    // return requested info
+    return [[self objectAtIndex:index] identifier];
+
+} // end -bevyIdentifierAtIndex:
+
+// *************************************************************************************************
+
+// Convert the list to an array of beverage dictionaries, to allow user defaults storage.
+- (NSMutableArray *)bevyDictionaries
+{
+    return [Cuppa_Bevy toDictionary:self];
+
+} // end -bevyDictionaries
+
+// *************************************************************************************************
+
+// Returns a snapshot of the rows for saving off the main thread.
+- (NSArray *)bevyRows
+{
+    return [self bevyDictionaries];
+
+} // end -bevyRows
+
+// *************************************************************************************************
+
+// Returns the catalog the rows without beverage objects are read from (a plain list has none).
+- (Cuppa_Catalog *)bevyCatalog
+{
+    return nil;
+
+} // end -bevyCatalog
+
+// *************************************************************************************************
+
+@end // @implementation NSArray (Cuppa_LazyBevys)
+
+// *************************************************************************************************
+
+@implementation NSMutableArray (Cuppa_LazyBevys)
+;
+
+// *************************************************************************************************
+
+// Put the rows in a new order: row i becomes the row that was at rows[i], for every row.
+- (void)reorderBevysByRows:(const NSUInteger *)rows
+{
+    NSMutableArray *sorted; // rows in their new order
+    NSUInteger i; // loop counter
+
+    // parameter checks
+    NSAssert(rows != NULL || [self count] == 0, @"Bad rows parameter.\n");
+
+    sorted = [NSMutableArray arrayWithCapacity:[self count]];
+    for (i = 0; i < [self count]; i++)
+    {
+        [sorted addObject:[self objectAtIndex:rows[i]]];
+    }
+    [self setArray:sorted];
+
+} // end -reorderBevysByRows:
+
+// *************************************************************************************************
+
+@end // @implementation NSMutableArray (Cuppa_LazyBevys)
+
+// end Cuppa_LazyBevys.m
@@ -0,0 +1,77 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_ListDiff
+           - Works out the fewest removals and insertions that turn one list into another, so a
+             view of the list can be updated in place instead of rebuilt.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_LISTDIFF_H
+#define _CUPPA_LISTDIFF_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Class Interface
+
+// Items are matched by equality (-isEqual:), which for objects that don't override it means the
+// same object in both lists, so an item edited in place is kept; whether a kept item needs
+// refreshing is up to the caller. The items kept in place are a longest common subsequence of the
+// two lists, so the removals and insertions are as few as can be, repeated items included. Items
+// that change position are both removed and inserted; an inserted item equal to a removed one is
+// taken as that item moved. (Each new item is paired with every equal old item, so lists of many
+// equal items take time in proportion to their product.)
+@interface Cuppa_ListDiff : NSObject
+{
+    NSMutableIndexSet *mRemoved; // indexes in the old list of items to remove
+    NSMutableIndexSet *mInserted; // indexes in the new list of items to insert
+    NSUInteger *mOldIndexes; // index in the old list of each new item, or NSNotFound
+    NSUInteger *mNewIndexes; // index in the new list of each old item, or NSNotFound
+    NSUInteger mOldCount; // number of items in the old list
+    NSUInteger mNewCount; // number of items in the new list
+}
+
+// ------ Life Cycle ------
+
+// Initialize the differences between two lists.
+- (id)initFromList:(NSArray *)oldList toList:(NSArray *)newList;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Accessors ------
+
+// Returns the indexes in the old list of the items to remove, including moved items.
+// Remove them from the highest index down, before making any insertions.
+- (NSIndexSet *)removed;
+
+// Returns the indexes in the new list of the items to insert, including moved items.
+// Insert them from the lowest index up, after making all the removals.
+- (NSIndexSet *)inserted;
+
+// Returns the index in the old list of an item in the new list, or NSNotFound if it is new.
+- (NSUInteger)oldIndexForNewIndex:(NSUInteger)index;
+
+// Returns the index in the new list of an item in the old list, or NSNotFound if it is gone.
+- (NSUInteger)newIndexForOldIndex:(NSUInteger)index;
+
+// Returns the total number of removals and insertions.
+- (NSUInteger)changeCount;
+
+@end // @interface Cuppa_ListDiff
+
+// *************************************************************************************************
+
+#endif // _CUPPA_LISTDIFF_H
+
+// end Cuppa_ListDiff.h
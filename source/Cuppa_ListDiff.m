@@ -0,0 +1,231 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_ListDiff
+           - Works out the fewest removals and insertions that turn one list into another, so a
+             view of the list can be updated in place instead of rebuilt.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <CoreFoundation/CoreFoundation.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_ListDiff.h"
+
+// Code!
+
+@implementation Cuppa_ListDiff
+;
+
+// *************************************************************************************************
+
+// Initialize the differences between two lists.
+- (id)initFromList:(NSArray *)oldList toList:(NSArray *)newList
+{
+    CFMutableDictionaryRef lasts; // last old index (plus one) of each old item, by equality
+    NSUInteger *earlier; // for each old item, the old index of the equal item before it
+    NSUInteger i, j; // loop counters
+    NSUInteger *pairOld, *pairNew; // old and new index of each pair of equal items
+    NSUInteger *links; // for each pair, the previous pair in its run
+    NSUInteger pairCount = 0; // number of pairs of equal items
+    NSUInteger pairCapacity; // room for pairs
+    NSUInteger *tails; // for each run length, the pair ending the lowest run of that length
+    NSUInteger runLength = 0; // length of the longest run of pairs in both lists' order
+    NSUInteger low, high, middle; // binary search bounds
+    NSUInteger k; // pair being placed
+
+    // parameter checks
+    NSAssert(oldList != nil, @"Bad old list parameter.\n");
+    NSAssert(newList != nil, @"Bad new list parameter.\n");
+
+    self = [super init];
+    mOldCount = [oldList count];
+    mNewCount = [newList count];
+    pairCapacity = mNewCount + 1;
+    mOldIndexes = malloc((mNewCount + 1) * sizeof(NSUInteger));
+    mNewIndexes = malloc((mOldCount + 1) * sizeof(NSUInteger));
+    earlier = malloc((mOldCount + 1) * sizeof(NSUInteger));
+    pairOld = malloc(pairCapacity * sizeof(NSUInteger));
+    pairNew = malloc(pairCapacity * sizeof(NSUInteger));
+    links = malloc(pairCapacity * sizeof(NSUInteger));
+    tails = malloc((MIN(mOldCount, mNewCount) + 1) * sizeof(NSUInteger));
+    NSAssert(mOldIndexes && mNewIndexes && earlier && pairOld && pairNew && links && tails,
+             @"Out of memory for list differences.\n");
+
+    // chain each old item to the equal items before it; items are compared with -isEqual: and
+    // -hash
+    lasts = CFDictionaryCreateMutable(NULL, (CFIndex)mOldCount, &kCFTypeDictionaryKeyCallBacks,
+                                      NULL);
+    for (i = 0; i < mOldCount; i++)
+    {
+        k = (NSUInteger)(uintptr_t)CFDictionaryGetValue(lasts,
+                                                        (const void *)[oldList objectAtIndex:i]);
+        earlier[i] = (k > 0) ? k - 1 : NSNotFound;
+        CFDictionarySetValue(lasts, (const void *)[oldList objectAtIndex:i],
+                             (const void *)(uintptr_t)(i + 1));
+        mNewIndexes[i] = NSNotFound;
+    }
+
+    // the items that stay put are a longest common subsequence of the lists: the longest run of
+    // pairs of equal items rising in both lists, found a pair at a time; each new item's pairs
+    // are taken from its last old match down, so no run holds two of them
+    for (j = 0; j < mNewCount; j++)
+    {
+        mOldIndexes[j] = NSNotFound;
+        i = (NSUInteger)(uintptr_t)CFDictionaryGetValue(lasts,
+                                                        (const void *)[newList objectAtIndex:j]);
+        for (i = (i > 0) ? i - 1 : NSNotFound; i != NSNotFound; i = earlier[i])
+        {
+            // make room for the pair (only items repeated in the old list need more than one)
+            if (pairCount == pairCapacity)
+            {
+                pairCapacity *= 2;
+                pairOld = realloc(pairOld, pairCapacity * sizeof(NSUInteger));
+                pairNew = realloc(pairNew, pairCapacity * sizeof(NSUInteger));
+                links = realloc(links, pairCapacity * sizeof(NSUInteger));
+                NSAssert(pairOld && pairNew && links, @"Out of memory for list differences.\n");
+            }
+            k = pairCount++;
+            pairOld[k] = i;
+            pairNew[k] = j;
+
+            // extend the lowest run the pair can follow
+            low = 0;
+            high = runLength;
+            while (low < high)
+            {
+                middle = (low + high) / 2;
+                if (pairOld[tails[middle]] < i)
+                    low = middle + 1;
+                else
+                    high = middle;
+            }
+            links[k] = (low > 0) ? tails[low - 1] : NSNotFound;
+            tails[low] = k;
+            if (low == runLength)
+                runLength++;
+        }
+    }
+
+    // everything else is removed and inserted
+    mRemoved = [[NSMutableIndexSet alloc] initWithIndexesInRange:NSMakeRange(0, mOldCount)];
+    mInserted = [[NSMutableIndexSet alloc] initWithIndexesInRange:NSMakeRange(0, mNewCount)];
+    for (k = (runLength > 0) ? tails[runLength - 1] : NSNotFound; k != NSNotFound; k = links[k])
+    {
+        mOldIndexes[pairNew[k]] = pairOld[k];
+        mNewIndexes[pairOld[k]] = pairNew[k];
+        [mRemoved removeIndex:pairOld[k]];
+        [mInserted removeIndex:pairNew[k]];
+    }
+
+    // but an inserted item equal to a removed one is that item moved
+    for (j = [mInserted firstIndex]; j != NSNotFound; j = [mInserted indexGreaterThanIndex:j])
+    {
+        i = (NSUInteger)(uintptr_t)CFDictionaryGetValue(lasts,
+                                                        (const void *)[newList objectAtIndex:j]);
+        for (i = (i > 0) ? i - 1 : NSNotFound; i != NSNotFound; i = earlier[i])
+        {
+            if (mNewIndexes[i] == NSNotFound)
+            {
+                mOldIndexes[j] = i;
+                mNewIndexes[i] = j;
+                break;
+            }
+        }
+    }
+    CFRelease(lasts);
+
+    free(earlier);
+    free(pairOld);
+    free(pairNew);
+    free(links);
+    free(tails);
+    return self;
+
+} // end -initFromList:toList:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the index sets
+    [mRemoved release];
+    [mInserted release];
+    free(mOldIndexes);
+    free(mNewIndexes);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Returns the indexes in the old list of the items to remove, including moved items.
+// Remove them from the highest index down, before making any insertions.
+- (NSIndexSet *)removed
+{
+    // return requested info
+    return mRemoved;
+
+} // end -removed
+
+// *************************************************************************************************
+
+// Returns the indexes in the new list of the items to insert, including moved items.
+// Insert them from the lowest index up, after making all the removals.
+- (NSIndexSet *)inserted
+{
+    // return requested info
+    return mInserted;
+
+} // end -inserted
+
+// *************************************************************************************************
+
+// Returns the index in the old list of an item in the new list, or NSNotFound if it is new.
+- (NSUInteger)oldIndexForNewIndex:(NSUInteger)index
+{
+    // parameter checks
+    NSAssert(index < mNewCount, @"Bad index parameter.\n");
+
+    // return requested info
+    return mOldIndexes[index];
+
+} // end -oldIndexForNewIndex:
+
+// *************************************************************************************************
+
+// Returns the index in the new list of an item in the old list, or NSNotFound if it is gone.
+- (NSUInteger)newIndexForOldIndex:(NSUInteger)index
+{
+    // parameter checks
+    NSAssert(index < mOldCount, @"Bad index parameter.\n");
+
+    // return requested info
+    return mNewIndexes[index];
+
+} // end -newIndexForOldIndex:
+
+// *************************************************************************************************
+
+// Returns the total number of removals and insertions.
+- (NSUInteger)changeCount
+{
+    // return requested info
+    return [mRemoved count] + [mInserted count];
+
+} // end -changeCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_ListDiff
+
+// end Cuppa_ListDiff.m
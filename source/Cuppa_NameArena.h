@@ -0,0 +1,80 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_NameArena
+           - Keeps one copy of each distinct beverage name, and a counted handle for it.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_NAMEARENA_H
+#define _CUPPA_NAMEARENA_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Class Interface
+
+// Beverages with the same name share one string. Each handle is counted: it stays valid (and
+// names the same string) until every holder has released it, and then the name is dropped and
+// the handle may be given to another name. Safe on any thread.
+@interface Cuppa_NameArena : NSObject
+{
+    NSMapTable *mHandles; // handle + 1 of each distinct name, unboxed, by name
+    NSString **mNames; // each distinct name by handle, or nil for a free handle
+    NSUInteger *mHolds; // holds on each handle; for a free handle, the next free handle instead
+    NSUInteger mCapacity; // number of handles there is room for
+    NSUInteger mHandleCount; // number of handles ever given out (live or free)
+    NSUInteger mFreeHandle; // free handle to give out next, or NSNotFound
+    NSUInteger mCount; // number of distinct names
+    NSUInteger mCharacterCount; // characters in all the distinct names
+}
+
+// ------ Class Methods ------
+
+// Returns the arena shared by every beverage.
++ (Cuppa_NameArena *)sharedArena;
+
+// ------ Life Cycle ------
+
+// Initialize an empty arena.
+- (id)init;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Returns the handle for a name, adding the name if it is new, and holds it for the caller. Each
+// call must be balanced by a -releaseHandle:.
+- (NSUInteger)handleForName:(NSString *)name;
+
+// Release a hold on a handle. Once nothing holds it, its name is dropped.
+- (void)releaseHandle:(NSUInteger)handle;
+
+// ------ Accessors ------
+
+// Returns the name with a handle, which must be held.
+- (NSString *)nameForHandle:(NSUInteger)handle;
+
+// Returns the number of distinct names.
+- (NSUInteger)count;
+
+// Returns the number of characters in all the distinct names.
+- (NSUInteger)characterCount;
+
+@end // @interface Cuppa_NameArena
+
+// *************************************************************************************************
+
+#endif // _CUPPA_NAMEARENA_H
+
+// end Cuppa_NameArena.h
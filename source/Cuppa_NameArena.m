@@ -0,0 +1,211 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_NameArena
+           - Keeps one copy of each distinct beverage name, and a counted handle for it.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_NameArena.h"
+
+// Internal Constants
+
+// Handles there is room for in a new arena
+static const NSUInteger sInitialCapacity = 256;
+
+// Code!
+
+@implementation Cuppa_NameArena
+;
+
+// *************************************************************************************************
+
+// Returns the arena shared by every beverage.
++ (Cuppa_NameArena *)sharedArena
+{
+    static Cuppa_NameArena *arena = nil; // arena shared by every beverage
+    static dispatch_once_t once; // guards the creation
+
+    // catalogs may be read off the main thread, so the first caller may not be on main
+    dispatch_once(&once, ^{
+        arena = [[Cuppa_NameArena alloc] init];
+    });
+
+    // return requested info
+    return arena;
+
+} // end +sharedArena
+
+// *************************************************************************************************
+
+// Initialize an empty arena.
+- (id)init
+{
+    self = [super init];
+    mHandles = [[NSMapTable alloc]
+        initWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPersonality)
+              valueOptions:(NSPointerFunctionsOpaqueMemory | NSPointerFunctionsIntegerPersonality)
+                  capacity:sInitialCapacity];
+    mCapacity = sInitialCapacity;
+    mNames = calloc(mCapacity, sizeof(NSString *));
+    mHolds = calloc(mCapacity, sizeof(NSUInteger));
+    NSAssert(mNames != NULL && mHolds != NULL, @"Out of memory for names.\n");
+    mHandleCount = 0;
+    mFreeHandle = NSNotFound;
+    mCount = 0;
+    mCharacterCount = 0;
+    return self;
+
+} // end -init
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    NSUInteger i; // loop counter
+
+    // release our hold on the names
+    for (i = 0; i < mHandleCount; i++)
+    {
+        [mNames[i] release];
+    }
+    free(mNames);
+    free(mHolds);
+    [mHandles release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Returns the handle for a name, adding the name if it is new, and holds it for the caller.
+- (NSUInteger)handleForName:(NSString *)name
+{
+    NSUInteger handle; // handle of the name
+    NSString *copy; // our own copy of a new name
+
+    // parameter checks
+    NSAssert(name != nil, @"Bad name parameter.\n");
+
+    @synchronized(self)
+    {
+        // the map holds handle + 1, so that a missing name reads as 0
+        handle = (NSUInteger)NSMapGet(mHandles, name);
+        if (handle != 0)
+        {
+            mHolds[handle - 1]++;
+            return handle - 1;
+        }
+
+        // reuse a free handle, or take a new one
+        if (mFreeHandle != NSNotFound)
+        {
+            handle = mFreeHandle;
+            mFreeHandle = mHolds[handle];
+        }
+        else
+        {
+            if (mHandleCount == mCapacity)
+            {
+                mCapacity *= 2;
+                mNames = realloc(mNames, mCapacity * sizeof(NSString *));
+                mHolds = realloc(mHolds, mCapacity * sizeof(NSUInteger));
+                NSAssert(mNames != NULL && mHolds != NULL, @"Out of memory for names.\n");
+            }
+            handle = mHandleCount++;
+        }
+
+        // keep an immutable copy, so a mutable string passed in can't change under us
+        copy = [name copy];
+        mNames[handle] = copy;
+        mHolds[handle] = 1;
+        NSMapInsert(mHandles, copy, (const void *)(handle + 1));
+        mCount++;
+        mCharacterCount += [copy length];
+    }
+
+    return handle;
+
+} // end -handleForName:
+
+// *************************************************************************************************
+
+// Release a hold on a handle. Once nothing holds it, its name is dropped.
+- (void)releaseHandle:(NSUInteger)handle
+{
+    @synchronized(self)
+    {
+        // parameter checks
+        NSAssert(handle < mHandleCount && mNames[handle] != nil, @"Bad handle parameter.\n");
+
+        if (--mHolds[handle] > 0)
+            return;
+
+        // drop the name, and put the handle on the free list (threaded through the holds)
+        NSMapRemove(mHandles, mNames[handle]);
+        mCount--;
+        mCharacterCount -= [mNames[handle] length];
+        [mNames[handle] release];
+        mNames[handle] = nil;
+        mHolds[handle] = mFreeHandle;
+        mFreeHandle = handle;
+    }
+
+} // end -releaseHandle:
+
+// *************************************************************************************************
+
+// Returns the name with a handle, which must be held.
+- (NSString *)nameForHandle:(NSUInteger)handle
+{
+    NSString *name; // name with the handle
+
+    @synchronized(self)
+    {
+        // parameter checks
+        NSAssert(handle < mHandleCount && mNames[handle] != nil, @"Bad handle parameter.\n");
+
+        name = mNames[handle];
+    }
+
+    // return requested info
+    return name;
+
+} // end -nameForHandle:
+
+// *************************************************************************************************
+
+// Returns the number of distinct names.
+- (NSUInteger)count
+{
+    // return requested info
+    return mCount;
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the number of characters in all the distinct names.
+- (NSUInteger)characterCount
+{
+    // return requested info
+    return mCharacterCount;
+
+} // end -characterCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_NameArena
+
+// end Cuppa_NameArena.m
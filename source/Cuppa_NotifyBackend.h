@@ -0,0 +1,46 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Protocol: Cuppa_NotifyBackend
+           - The interface shared by the notification senders that tell the user a brew is ready.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_NOTIFYBACKEND_H
+#define _CUPPA_NOTIFYBACKEND_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Protocol Interface
+
+@protocol Cuppa_NotifyBackend <NSObject>
+
+// ------ Manipulators ------
+
+// Schedule a notification to be delivered delay seconds from now (straight away if delay is 0).
+// A notification scheduled with the same identifier as a pending one replaces it.
+- (void)scheduleNotification:(NSString *)identifier
+                       title:(NSString *)title
+                        body:(NSString *)body
+                       after:(NSTimeInterval)delay;
+
+// Withdraw a notification that has not been delivered yet.
+- (void)withdrawNotification:(NSString *)identifier;
+
+@end // @protocol Cuppa_NotifyBackend
+
+// *************************************************************************************************
+
+#endif // _CUPPA_NOTIFYBACKEND_H
+
+// end Cuppa_NotifyBackend.h
@@ -0,0 +1,54 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_NotifyCenter
+           - Sends brew notifications through the system Notification Center, scheduled ahead so
+             they are delivered on time whether or not Cuppa is awake.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_NOTIFYCENTER_H
+#define _CUPPA_NOTIFYCENTER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_NotifyBackend.h"
+
+// Class Interface
+
+@interface Cuppa_NotifyCenter : NSObject <Cuppa_NotifyBackend>
+{
+    // no instance vars
+}
+
+// ------ Manipulators ------
+
+// Schedule a notification to be delivered delay seconds from now (straight away if delay is 0).
+// A notification scheduled with the same identifier as a pending one replaces it.
+- (void)scheduleNotification:(NSString *)identifier
+                       title:(NSString *)title
+                        body:(NSString *)body
+                       after:(NSTimeInterval)delay;
+
+// Withdraw a notification that has not been delivered yet.
+- (void)withdrawNotification:(NSString *)identifier;
+
+@end // @interface Cuppa_NotifyCenter
+
+// *************************************************************************************************
+
+#endif // _CUPPA_NOTIFYCENTER_H
+
+// end Cuppa_NotifyCenter.h
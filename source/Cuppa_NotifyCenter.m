@@ -0,0 +1,120 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_NotifyCenter
+           - Sends brew notifications through the system Notification Center, scheduled ahead so
+             they are delivered on time whether or not Cuppa is awake.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <UserNotifications/UserNotifications.h>
+
+// Cuppa Includes
+
+#import "Cuppa_NotifyCenter.h"
+
+// Code!
+
+@implementation Cuppa_NotifyCenter
+;
+
+// *************************************************************************************************
+
+// Schedule a notification to be delivered delay seconds from now (straight away if delay is 0).
+// A notification scheduled with the same identifier as a pending one replaces it.
+- (void)scheduleNotification:(NSString *)identifier
+                       title:(NSString *)title
+                        body:(NSString *)body
+                       after:(NSTimeInterval)delay
+{
+    // parameter checks
+    NSAssert(identifier != nil, @"Bad identifier parameter.\n");
+
+#if !defined(NDEBUG)
+    printf("Scheduling notification %s in %.2f secs\n", [identifier UTF8String], delay);
+#endif
+
+    if (@available(macOS 10.14, *)) {
+        // use new Notification Center API, if available
+        UNMutableNotificationContent *notification = [[[UNMutableNotificationContent alloc] init]
+                                                      autorelease];
+        notification.title = title;
+        notification.body = body;
+        // NB: playing a sound is handled in brewer:brewComplete: for consistency
+        // notification.sound = [UNNotificationSound soundNamed:@"spoon.aiff"];
+
+        // a time interval trigger must be in the future; otherwise deliver straight away
+        UNTimeIntervalNotificationTrigger *trigger = nil;
+        if (delay > 0.0)
+        {
+            trigger = [UNTimeIntervalNotificationTrigger triggerWithTimeInterval:delay repeats:NO];
+        }
+        UNNotificationRequest *request = [UNNotificationRequest requestWithIdentifier:identifier
+                                                                              content:notification
+                                                                              trigger:trigger];
+        [[UNUserNotificationCenter currentNotificationCenter] addNotificationRequest:request withCompletionHandler:^(NSError * _Nullable error) {}];
+    }
+    else
+    {
+        // fall back to previous API
+        NSUserNotification *notification = [[[NSUserNotification alloc] init] autorelease];
+        notification.identifier = identifier;
+        notification.title = title;
+        notification.informativeText = body;
+        if (delay > 0.0)
+        {
+            notification.deliveryDate = [NSDate dateWithTimeIntervalSinceNow:delay];
+            [[NSUserNotificationCenter defaultUserNotificationCenter] scheduleNotification:notification];
+        }
+        else
+        {
+            [[NSUserNotificationCenter defaultUserNotificationCenter] deliverNotification:notification];
+        }
+    }
+
+} // end -scheduleNotification:title:body:after:
+
+// *************************************************************************************************
+
+// Withdraw a notification that has not been delivered yet.
+- (void)withdrawNotification:(NSString *)identifier
+{
+    NSUserNotificationCenter *center; // previous API notification center
+
+    // parameter checks
+    NSAssert(identifier != nil, @"Bad identifier parameter.\n");
+
+#if !defined(NDEBUG)
+    printf("Withdrawing notification %s\n", [identifier UTF8String]);
+#endif
+
+    if (@available(macOS 10.14, *)) {
+        [[UNUserNotificationCenter currentNotificationCenter]
+         removePendingNotificationRequestsWithIdentifiers:@[identifier]];
+    }
+    else
+    {
+        center = [NSUserNotificationCenter defaultUserNotificationCenter];
+        for (NSUserNotification *notification in [center scheduledNotifications])
+        {
+            if ([[notification identifier] isEqualToString:identifier])
+            {
+                [center removeScheduledNotification:notification];
+            }
+        }
+    }
+
+} // end -withdrawNotification:
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_NotifyCenter
+
+// end Cuppa_NotifyCenter.m
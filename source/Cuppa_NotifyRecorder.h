@@ -0,0 +1,80 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_NotifyRecorder
+           - Stands in for the system Notification Center when brews are simulated, recording
+             the notifications scheduled and withdrawn instead of showing them.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_NOTIFYRECORDER_H
+#define _CUPPA_NOTIFYRECORDER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Clock.h"
+#import "Cuppa_NotifyBackend.h"
+
+// Class Interface
+
+@interface Cuppa_NotifyRecorder : NSObject <Cuppa_NotifyBackend>
+{
+    Cuppa_Clock *mClock; // time source for delivery times
+    NSMutableDictionary *mPending; // delivery times (NSNumber) of notifications, by identifier
+    NSUInteger mScheduledCount; // number of notifications scheduled so far
+    NSUInteger mWithdrawnCount; // number of pending notifications withdrawn so far
+}
+
+// ------ Life Cycle ------
+
+// Initialize a recorder that times notifications by clock.
+- (id)initWithClock:(Cuppa_Clock *)clock;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Record a notification to be delivered delay seconds from now.
+- (void)scheduleNotification:(NSString *)identifier
+                       title:(NSString *)title
+                        body:(NSString *)body
+                       after:(NSTimeInterval)delay;
+
+// Record the withdrawal of a notification, if it is still pending.
+- (void)withdrawNotification:(NSString *)identifier;
+
+// ------ Accessors ------
+
+// Returns the time (by the recorder's clock) a notification is delivered, or INFINITY if there
+// is no such notification.
+- (NSTimeInterval)deliveryTimeForNotification:(NSString *)identifier;
+
+// Returns the number of notifications recorded and not withdrawn, delivered or not.
+- (NSUInteger)notificationCount;
+
+// Returns the number of notifications scheduled so far.
+- (NSUInteger)scheduledCount;
+
+// Returns the number of pending notifications withdrawn so far.
+- (NSUInteger)withdrawnCount;
+
+@end // @interface Cuppa_NotifyRecorder
+
+// *************************************************************************************************
+
+#endif // _CUPPA_NOTIFYRECORDER_H
+
+// end Cuppa_NotifyRecorder.h
@@ -0,0 +1,143 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_NotifyRecorder
+           - Stands in for the system Notification Center when brews are simulated, recording
+             the notifications scheduled and withdrawn instead of showing them.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_NotifyRecorder.h"
+
+// Code!
+
+@implementation Cuppa_NotifyRecorder
+;
+
+// *************************************************************************************************
+
+// Initialize a recorder that times notifications by clock.
+- (id)initWithClock:(Cuppa_Clock *)clock
+{
+    // parameter checks
+    NSAssert(clock != nil, @"Bad clock parameter.\n");
+
+    self = [super init];
+    mClock = [clock retain];
+    mPending = [[NSMutableDictionary alloc] init];
+    mScheduledCount = 0;
+    mWithdrawnCount = 0;
+    return self;
+
+} // end -initWithClock:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the records and the clock
+    [mPending release];
+    [mClock release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Record a notification to be delivered delay seconds from now.
+- (void)scheduleNotification:(NSString *)identifier
+                       title:(NSString *)title
+                        body:(NSString *)body
+                       after:(NSTimeInterval)delay
+{
+    // parameter checks
+    NSAssert(identifier != nil, @"Bad identifier parameter.\n");
+
+    // record new info
+    [mPending setObject:[NSNumber numberWithDouble:([mClock now] + MAX(delay, 0.0))]
+                 forKey:identifier];
+    mScheduledCount++;
+
+} // end -scheduleNotification:title:body:after:
+
+// *************************************************************************************************
+
+// Record the withdrawal of a notification, if it is still pending.
+- (void)withdrawNotification:(NSString *)identifier
+{
+    NSTimeInterval delivery; // recorded delivery time
+
+    // parameter checks
+    NSAssert(identifier != nil, @"Bad identifier parameter.\n");
+
+    // only notifications not yet delivered can be withdrawn
+    delivery = [self deliveryTimeForNotification:identifier];
+    if (!isinf(delivery) && delivery > [mClock now])
+    {
+        [mPending removeObjectForKey:identifier];
+        mWithdrawnCount++;
+    }
+
+} // end -withdrawNotification:
+
+// *************************************************************************************************
+
+// Returns the time (by the recorder's clock) a notification is delivered, or INFINITY if there
+// is no such notification.
+- (NSTimeInterval)deliveryTimeForNotification:(NSString *)identifier
+{
+    NSNumber *delivery = [mPending objectForKey:identifier]; // recorded delivery time
+
+    if (delivery == nil)
+        return INFINITY;
+
+    return [delivery doubleValue];
+
+} // end -deliveryTimeForNotification:
+
+// *************************************************************************************************
+
+// Returns the number of notifications recorded and not withdrawn, delivered or not.
+- (NSUInteger)notificationCount
+{
+    // return requested info
+    return [mPending count];
+
+} // end -notificationCount
+
+// *************************************************************************************************
+
+// Returns the number of notifications scheduled so far.
+- (NSUInteger)scheduledCount
+{
+    // return requested info
+    return mScheduledCount;
+
+} // end -scheduledCount
+
+// *************************************************************************************************
+
+// Returns the number of pending notifications withdrawn so far.
+- (NSUInteger)withdrawnCount
+{
+    // return requested info
+    return mWithdrawnCount;
+
+} // end -withdrawnCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_NotifyRecorder
+
+// end Cuppa_NotifyRecorder.m
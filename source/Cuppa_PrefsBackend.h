@@ -0,0 +1,56 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Protocol: Cuppa_PrefsBackend
+           - Where preferences are finally written, so that NSUserDefaults can be swapped out.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_PREFSBACKEND_H
+#define _CUPPA_PREFSBACKEND_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Protocol Interface
+
+// Backends are written from a background queue (one write at a time), so they must not need the
+// main thread.
+@protocol Cuppa_PrefsBackend <NSObject>
+
+// ------ Manipulators ------
+
+// Set the value stored for a key.
+- (void)setObject:(id)value forKey:(NSString *)key;
+
+// Remove the value stored for a key.
+- (void)removeObjectForKey:(NSString *)key;
+
+// Make everything written so far durable. Returns NO if that failed.
+- (BOOL)synchronize;
+
+// ------ Accessors ------
+
+// Returns the value stored for a key, or nil.
+- (id)objectForKey:(NSString *)key;
+
+@end // @protocol Cuppa_PrefsBackend
+
+// NSUserDefaults already does all of this.
+@interface NSUserDefaults (Cuppa_PrefsBackend) <Cuppa_PrefsBackend>
+@end
+
+// *************************************************************************************************
+
+#endif // _CUPPA_PREFSBACKEND_H
+
+// end Cuppa_PrefsBackend.h
@@ -0,0 +1,78 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_PrefsRecorder
+           - A preferences backend that keeps values in memory and counts what is written, for
+             checking batching and durability without touching the user's real preferences.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_PREFSRECORDER_H
+#define _CUPPA_PREFSRECORDER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_PrefsBackend.h"
+
+// Class Interface
+
+@interface Cuppa_PrefsRecorder : NSObject <Cuppa_PrefsBackend>
+{
+    NSMutableDictionary *mValues; // values written so far
+    NSDictionary *mDurable; // values as of the last synchronize
+    NSUInteger mWriteCount; // number of values set or removed so far
+    NSUInteger mSynchronizeCount; // number of synchronizes so far
+}
+
+// ------ Life Cycle ------
+
+// Default initializer.
+- (id)init;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Record the value stored for a key.
+- (void)setObject:(id)value forKey:(NSString *)key;
+
+// Record the removal of the value stored for a key.
+- (void)removeObjectForKey:(NSString *)key;
+
+// Record that everything written so far is durable.
+- (BOOL)synchronize;
+
+// ------ Accessors ------
+
+// Returns the value written for a key, or nil.
+- (id)objectForKey:(NSString *)key;
+
+// Returns the value for a key as of the last synchronize (what would survive a crash), or nil.
+- (id)durableObjectForKey:(NSString *)key;
+
+// Returns the number of values set or removed so far.
+- (NSUInteger)writeCount;
+
+// Returns the number of synchronizes so far.
+- (NSUInteger)synchronizeCount;
+
+@end // @interface Cuppa_PrefsRecorder
+
+// *************************************************************************************************
+
+#endif // _CUPPA_PREFSRECORDER_H
+
+// end Cuppa_PrefsRecorder.h
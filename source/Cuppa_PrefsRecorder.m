@@ -0,0 +1,149 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_PrefsRecorder
+           - A preferences backend that keeps values in memory and counts what is written, for
+             checking batching and durability without touching the user's real preferences.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_PrefsRecorder.h"
+
+// Code!
+
+@implementation Cuppa_PrefsRecorder
+;
+
+// *************************************************************************************************
+
+// Default initializer.
+- (id)init
+{
+    self = [super init];
+    mValues = [[NSMutableDictionary alloc] init];
+    mDurable = [[NSDictionary alloc] init];
+    mWriteCount = 0;
+    mSynchronizeCount = 0;
+    return self;
+
+} // end -init
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the values
+    [mValues release];
+    [mDurable release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Record the value stored for a key.
+- (void)setObject:(id)value forKey:(NSString *)key
+{
+    // writes come from the writer's queue, reads from anywhere
+    @synchronized(self)
+    {
+        [mValues setObject:value forKey:key];
+        mWriteCount++;
+    }
+
+} // end -setObject:forKey:
+
+// *************************************************************************************************
+
+// Record the removal of the value stored for a key.
+- (void)removeObjectForKey:(NSString *)key
+{
+    @synchronized(self)
+    {
+        [mValues removeObjectForKey:key];
+        mWriteCount++;
+    }
+
+} // end -removeObjectForKey:
+
+// *************************************************************************************************
+
+// Record that everything written so far is durable.
+- (BOOL)synchronize
+{
+    @synchronized(self)
+    {
+        [mDurable release];
+        mDurable = [mValues copy];
+        mSynchronizeCount++;
+    }
+    return YES;
+
+} // end -synchronize
+
+// *************************************************************************************************
+
+// Returns the value written for a key, or nil.
+- (id)objectForKey:(NSString *)key
+{
+    id value; // value written
+
+    @synchronized(self)
+    {
+        value = [[mValues objectForKey:key] retain];
+    }
+    return [value autorelease];
+
+} // end -objectForKey:
+
+// *************************************************************************************************
+
+// Returns the value for a key as of the last synchronize (what would survive a crash), or nil.
+- (id)durableObjectForKey:(NSString *)key
+{
+    id value; // durable value
+
+    @synchronized(self)
+    {
+        value = [[mDurable objectForKey:key] retain];
+    }
+    return [value autorelease];
+
+} // end -durableObjectForKey:
+
+// *************************************************************************************************
+
+// Returns the number of values set or removed so far.
+- (NSUInteger)writeCount
+{
+    // return requested info
+    return mWriteCount;
+
+} // end -writeCount
+
+// *************************************************************************************************
+
+// Returns the number of synchronizes so far.
+- (NSUInteger)synchronizeCount
+{
+    // return requested info
+    return mSynchronizeCount;
+
+} // end -synchronizeCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_PrefsRecorder
+
+// end Cuppa_PrefsRecorder.m
@@ -0,0 +1,92 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_PrefsWriter
+           - Collects preference changes and writes them in batches, off the main thread.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_PREFSWRITER_H
+#define _CUPPA_PREFSWRITER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_PrefsBackend.h"
+
+// Class Interface
+
+// Changes are held until delay seconds after the first one, then only the last value of each key
+// is written. Writes happen in order on a serial background queue; blocks passed to
+// -performWrite: and -checkpoint: join the same queue, so a file written alongside the
+// preferences stays in step with them.
+@interface Cuppa_PrefsWriter : NSObject
+{
+    id<Cuppa_PrefsBackend> mBackend; // where changes are written
+    dispatch_queue_t mQueue; // serial queue the writes are made on
+    NSMutableDictionary *mPending; // changes not yet handed to the queue (NSNull for removal)
+    NSTimeInterval mDelay; // how long to collect changes before writing them
+    bool mFlushPending; // flag: a flush has been scheduled
+    NSUInteger mFlushCount; // number of batches handed to the queue
+}
+
+// ------ Life Cycle ------
+
+// Initialize a writer for a backend, collecting changes for delay seconds.
+- (id)initWithBackend:(id<Cuppa_PrefsBackend>)backend delay:(NSTimeInterval)delay;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Set the value stored for a key. The value is copied.
+- (void)setObject:(id)value forKey:(NSString *)key;
+
+// Set the value stored for a key to a flag.
+- (void)setBool:(BOOL)value forKey:(NSString *)key;
+
+// Remove the value stored for a key.
+- (void)removeObjectForKey:(NSString *)key;
+
+// Hand any pending changes to the queue now, rather than waiting for the delay.
+- (void)flush;
+
+// Flush, then make everything durable and run block (which may be nil) on the queue.
+- (void)checkpoint:(void (^)(void))block;
+
+// Run a block on the queue, after the changes handed to it so far.
+- (void)performWrite:(void (^)(void))block;
+
+// Wait for everything handed to the queue so far to be written.
+- (void)waitUntilWritten;
+
+// ------ Accessors ------
+
+// Returns the value for a key, including changes not yet written.
+- (id)objectForKey:(NSString *)key;
+
+// Returns the number of batches handed to the queue.
+- (NSUInteger)flushCount;
+
+// Returns the number of changes waiting to be handed to the queue.
+- (NSUInteger)pendingCount;
+
+@end // @interface Cuppa_PrefsWriter
+
+// *************************************************************************************************
+
+#endif // _CUPPA_PREFSWRITER_H
+
+// end Cuppa_PrefsWriter.h
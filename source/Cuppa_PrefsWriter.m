@@ -0,0 +1,234 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_PrefsWriter
+           - Collects preference changes and writes them in batches, off the main thread.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_PrefsWriter.h"
+
+// Code!
+
+@implementation NSUserDefaults (Cuppa_PrefsBackend)
+@end
+
+@implementation Cuppa_PrefsWriter
+;
+
+// *************************************************************************************************
+
+// Initialize a writer for a backend, collecting changes for delay seconds.
+- (id)initWithBackend:(id<Cuppa_PrefsBackend>)backend delay:(NSTimeInterval)delay
+{
+    // parameter checks
+    NSAssert(backend != nil, @"Bad backend parameter.\n");
+    NSAssert(delay >= 0.0, @"Bad delay parameter.\n");
+
+    self = [super init];
+    mBackend = [backend retain];
+    mQueue = dispatch_queue_create("com.nathancosgray.cuppa.prefs", DISPATCH_QUEUE_SERIAL);
+    mPending = [[NSMutableDictionary alloc] init];
+    mDelay = delay;
+    mFlushPending = false;
+    mFlushCount = 0;
+    return self;
+
+} // end -initWithBackend:delay:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // nothing may be lost, so write what is left before letting go
+    [self flush];
+    [self waitUntilWritten];
+    dispatch_release(mQueue);
+    [mPending release];
+    [mBackend release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Set the value stored for a key. The value is copied.
+- (void)setObject:(id)value forKey:(NSString *)key
+{
+    id copy; // value as written
+
+    // parameter checks
+    NSAssert(value != nil, @"Bad value parameter.\n");
+    NSAssert(key != nil, @"Bad key parameter.\n");
+
+    // the queue will read the value later, so it must not change under it
+    copy = [value copy];
+    [mPending setObject:copy forKey:key];
+    [copy release];
+
+    // write it (and whatever follows it closely) once the delay is up
+    if (!mFlushPending)
+    {
+        mFlushPending = true;
+        [self performSelector:@selector(flush)
+                   withObject:nil
+                   afterDelay:mDelay
+                      inModes:@[ NSRunLoopCommonModes ]];
+    }
+
+} // end -setObject:forKey:
+
+// *************************************************************************************************
+
+// Set the value stored for a key to a flag.
+- (void)setBool:(BOOL)value forKey:(NSString *)key
+{
+    [self setObject:[NSNumber numberWithBool:value] forKey:key];
+
+} // end -setBool:forKey:
+
+// *************************************************************************************************
+
+// Remove the value stored for a key.
+- (void)removeObjectForKey:(NSString *)key
+{
+    [self setObject:[NSNull null] forKey:key];
+
+} // end -removeObjectForKey:
+
+// *************************************************************************************************
+
+// Hand any pending changes to the queue now, rather than waiting for the delay.
+- (void)flush
+{
+    NSMutableDictionary *batch; // changes handed to the queue
+    id<Cuppa_PrefsBackend> backend; // where they are written
+
+    // a flush now makes the scheduled one unnecessary
+    if (mFlushPending)
+    {
+        [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(flush) object:nil];
+        mFlushPending = false;
+    }
+    if ([mPending count] == 0)
+        return;
+
+    // hand over the batch and start a new one
+    batch = mPending;
+    mPending = [[NSMutableDictionary alloc] init];
+    backend = mBackend;
+    mFlushCount++;
+    dispatch_async(mQueue, ^{
+        for (NSString *key in batch)
+        {
+            id value = [batch objectForKey:key];
+            if (value == [NSNull null])
+                [backend removeObjectForKey:key];
+            else
+                [backend setObject:value forKey:key];
+        }
+    });
+    [batch release];
+
+#if !defined(NDEBUG)
+    printf("Flushed preferences batch %lu\n", (unsigned long)mFlushCount);
+#endif
+
+} // end -flush
+
+// *************************************************************************************************
+
+// Flush, then make everything durable and run block (which may be nil) on the queue.
+- (void)checkpoint:(void (^)(void))block
+{
+    id<Cuppa_PrefsBackend> backend; // where changes are written
+
+    [self flush];
+    backend = mBackend;
+    dispatch_async(mQueue, ^{
+        [backend synchronize];
+        if (block)
+            block();
+    });
+
+} // end -checkpoint:
+
+// *************************************************************************************************
+
+// Run a block on the queue, after the changes handed to it so far.
+- (void)performWrite:(void (^)(void))block
+{
+    // parameter checks
+    NSAssert(block != nil, @"Bad block parameter.\n");
+
+    dispatch_async(mQueue, block);
+
+} // end -performWrite:
+
+// *************************************************************************************************
+
+// Wait for everything handed to the queue so far to be written.
+- (void)waitUntilWritten
+{
+    dispatch_sync(mQueue, ^{
+    });
+
+} // end -waitUntilWritten
+
+// *************************************************************************************************
+
+// Returns the value for a key, including changes not yet written.
+- (id)objectForKey:(NSString *)key
+{
+    id value; // pending value
+
+    // parameter checks
+    NSAssert(key != nil, @"Bad key parameter.\n");
+
+    // the newest value is the pending one, if there is one
+    value = [mPending objectForKey:key];
+    if (value)
+        return (value == [NSNull null]) ? nil : value;
+
+    // otherwise it is in the backend, once the queue has caught up
+    [self waitUntilWritten];
+    return [mBackend objectForKey:key];
+
+} // end -objectForKey:
+
+// *************************************************************************************************
+
+// Returns the number of batches handed to the queue.
+- (NSUInteger)flushCount
+{
+    // return requested info
+    return mFlushCount;
+
+} // end -flushCount
+
+// *************************************************************************************************
+
+// Returns the number of changes waiting to be handed to the queue.
+- (NSUInteger)pendingCount
+{
+    // return requested info
+    return [mPending count];
+
+} // end -pendingCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_PrefsWriter
+
+// end Cuppa_PrefsWriter.m
@@ -22,6 +22,28 @@
 #import <AppKit/AppKit.h>
 #import <Foundation/Foundation.h>
 
+// Cuppa Includes
+
+#import "Cuppa_TimeFormat.h"
+
+// Constants
+
+enum
+{
+    CUPPA_RENDER_LABEL_MAX = CUPPA_TIME_STRING_MAX // room for the longest badge label
+};
+
+// Protocol Interface
+
+// Receives the rendered dock tile badge. The application dock tile (NSDockTile) is the usual
+// sink; anything else that can take a badge label will do.
+@protocol Cuppa_RenderSink <NSObject>
+
+// Show label as the badge, or no badge if label is nil.
+- (void)setBadgeLabel:(NSString *)label;
+
+@end // @protocol Cuppa_RenderSink
+
 // Class Interface
 
 @interface Cuppa_Render : NSObject
@@ -29,12 +51,28 @@
     int mCupShape; // what kind of cuppa are we using (one of CUPPA_RENDER_SHAPE_*).
     float mBrewState; // what brew state are we in?
     int mBrewRemain; // brewing time remaining
+    id<Cuppa_RenderSink> mSink; // receives the badge, or nil for the application dock tile
+    char mLabel[CUPPA_RENDER_LABEL_MAX]; // badge label last committed ("" for no badge)
+    bool mRenderPending; // flag: a render has been requested but not yet committed?
+    NSUInteger mRendersRequested; // number of calls to -render
+    NSUInteger mRendersCommitted; // number of badge updates actually sent to the sink
 }
 
+// ------ Life Cycle ------
+
+// Default initializer.
+- (id)init;
+
+// Deallocate.
+- (void)dealloc;
+
 // ------ Manipulators ------
 
+// Set the sink that receives the badge (nil for the application dock tile). The sink is retained.
+- (void)setSink:(id<Cuppa_RenderSink>)sink;
+
 // Set the cup shape.
-// Param cupShape must be one of the shape CUPPA_SHAPE_* constants defined in Cuppa_Shape.h.
+// Param cupShape must be a shape code from Cuppa_Shape.h.
 - (void)setCupShape:(int)cupShape;
 
 // Set the brew state.
@@ -48,14 +86,25 @@
 // ------ Accessors ------
 
 // Render the interface in it's current state. No state changes will be visible until this call.
+// Renders requested in the same pass of the run loop are coalesced into one, and nothing is sent
+// to the sink if the badge would not change.
 - (void)render;
 
+// Commit any requested render straight away, rather than on the next pass of the run loop.
+- (void)flush;
+
 // Restore the standard Cuppa dock tile (must call this on application exit).
 - (void)restore;
 
 // Returns the current cup shape.
 - (int)cupShape;
 
+// Returns the number of renders requested so far.
+- (NSUInteger)rendersRequested;
+
+// Returns the number of renders that changed the badge so far.
+- (NSUInteger)rendersCommitted;
+
 @end // @interface Cuppa_Render
 
 // *************************************************************************************************
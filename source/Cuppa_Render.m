@@ -26,13 +26,57 @@
 
 // *************************************************************************************************
 
+// Default initializer.
+- (id)init
+{
+    self = [super init];
+    mCupShape = CUPPA_SHAPE_DEFAULT;
+    mBrewState = 0.0f;
+    mBrewRemain = 0;
+    mSink = nil;
+    mLabel[0] = '\0';
+    mRenderPending = false;
+    mRendersRequested = 0;
+    mRendersCommitted = 0;
+    return self;
+    
+} // end -init
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the sink
+    [mSink release];
+    [super dealloc];
+    
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Set the sink that receives the badge (nil for the application dock tile). The sink is retained.
+- (void)setSink:(id<Cuppa_RenderSink>)sink
+{
+    // record new info
+    [sink retain];
+    [mSink release];
+    mSink = sink;
+    
+    // the new sink has not been shown anything yet
+    mLabel[0] = '\0';
+    
+} // end -setSink:
+
+// *************************************************************************************************
+
 // Set the cup shape.
-// Param cupShape must be one of the shape CUPPA_SHAPE_* constants defined in Cuppa_Shape.h.
+// Param cupShape must be a shape code from Cuppa_Shape.h.
 - (void)setCupShape:(int)cupShape
 {
     // parameter checks
     NSAssert(cupShape >= 0, @"Cup shape index < 0.\n");
-    NSAssert(cupShape < CUPPA_SHAPE_MAX, @"Cup shape index >= MAX.\n");
+    NSAssert(cupShape < [Cuppa_Shape shapeCount], @"Cup shape index >= count.\n");
     
     // store the new state, image will change on next call to -render
     mCupShape = cupShape;
@@ -70,48 +114,83 @@
 
 // *************************************************************************************************
 
+// Returns the sink that receives the badge.
+- (id<Cuppa_RenderSink>)sink
+{
+    // the application dock tile takes a badge label just like any other sink
+    if (mSink == nil)
+        return (id<Cuppa_RenderSink>)[[NSApplication sharedApplication] dockTile];
+    
+    return mSink;
+    
+} // end -sink
+
+// *************************************************************************************************
+
 // Render the interface in its current state. No state changes will be visible until this call.
+// Renders requested in the same pass of the run loop are coalesced into one, and nothing is sent
+// to the sink if the badge would not change.
 - (void)render
 {
-    int hours;
-    char countString[8];
+    mRendersRequested++;
+    
+    // one render per pass of the run loop is plenty, however many changes led up to it
+    if (mRenderPending)
+        return;
+    mRenderPending = true;
+    [self performSelector:@selector(flush)
+               withObject:nil
+               afterDelay:0.0
+                  inModes:@[NSRunLoopCommonModes]];
+    
+} // end -render
+
+// *************************************************************************************************
+
+// Commit any requested render straight away, rather than on the next pass of the run loop.
+- (void)flush
+{
+    char countString[CUPPA_RENDER_LABEL_MAX];
+    
+    if (!mRenderPending)
+        return;
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(flush) object:nil];
+    mRenderPending = false;
     
     if (mBrewRemain > 0)
     {
-        // Convert seconds into a time string of format 'hh:mm:ss' or 'mm:ss'.
-        hours = mBrewRemain / 3600;
-        if (hours > 0)
-        {
-            sprintf(countString, "%01d:%02d:%02d",
-                    hours,
-                    (mBrewRemain - (hours * 3600)) / 60,
-                    (mBrewRemain - (hours * 3600)) % 60);
-        }
-        else
-        {
-            sprintf(countString, "%01d:%02d",
-                    mBrewRemain / 60,
-                    mBrewRemain % 60);
-        }
-        
-        // Add a badge to the dock icon.
-        [[[NSApplication sharedApplication] dockTile] setBadgeLabel:
-         [NSString stringWithFormat:@"%s", countString]];
+        // Convert seconds into a time string of format 'h:mm:ss' or 'm:ss'.
+        [Cuppa_TimeFormat formatSeconds:mBrewRemain buffer:countString size:sizeof(countString)];
     }
     else
-        [[[NSApplication sharedApplication] dockTile] setBadgeLabel:nil];
+        countString[0] = '\0';
     
-    return;
+    // Leave the dock tile alone if the badge is already showing this.
+    if (strcmp(countString, mLabel) == 0)
+        return;
+    strcpy(mLabel, countString);
+    mRendersCommitted++;
     
-} // end -render
+    // Add a badge to the dock icon, or take it away.
+    if (mLabel[0] != '\0')
+        [[self sink] setBadgeLabel:[NSString stringWithUTF8String:mLabel]];
+    else
+        [[self sink] setBadgeLabel:nil];
+    
+} // end -flush
 
 // *************************************************************************************************
 
 // Restore the standard Cuppa dock tile (must call this on application exit).
 - (void)restore
 {
+    // Forget any render still to come
+    [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(flush) object:nil];
+    mRenderPending = false;
+    
     // Remove badge
-    [[[NSApplication sharedApplication] dockTile] setBadgeLabel:nil];
+    [[self sink] setBadgeLabel:nil];
+    mLabel[0] = '\0';
     
 } // end -restore
 
@@ -127,6 +206,26 @@
 
 // *************************************************************************************************
 
+// Returns the number of renders requested so far.
+- (NSUInteger)rendersRequested
+{
+    // return the requested info
+    return mRendersRequested;
+    
+} // end -rendersRequested
+
+// *************************************************************************************************
+
+// Returns the number of renders that changed the badge so far.
+- (NSUInteger)rendersCommitted
+{
+    // return the requested info
+    return mRendersCommitted;
+    
+} // end -rendersCommitted
+
+// *************************************************************************************************
+
 @end // @implementation Cuppa_Render
 
 // end Cuppa_Render.m
@@ -0,0 +1,86 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Module:   Cuppa_Schedule
+           - Works out when the next observable change in a brew will happen, so that the brew
+             timer only needs to wake up when there is something to show or play.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// C Includes
+
+#include <math.h>
+
+// Cuppa Includes
+
+#include "Cuppa_Schedule.h"
+
+// Internal Constants
+
+// Wake up this long after a second boundary, so the new value is sure to be showing
+static const double sWakeupSlack = 0.01;
+
+// Code!
+
+// *************************************************************************************************
+
+// Returns the whole seconds remaining (as displayed) for a brew whose deadline is interval away.
+// Returns 0 once the brew is complete.
+int CuppaScheduleSecondsRemain(double interval)
+{
+    // brew is complete once its deadline has passed
+    if (interval <= 0.0)
+        return 0;
+
+    return (int)ceil(interval);
+
+} // end CuppaScheduleSecondsRemain()
+
+// *************************************************************************************************
+
+// Returns the delay until the next observable change for a brew whose deadline is interval away:
+// the next badge digit change (if showTimer), the next countdown beep (if makeSound), or the
+// final alarm. Returns 0 if the brew is already complete.
+double CuppaScheduleNextWakeup(double interval, bool showTimer, bool makeSound)
+{
+    int remain; // seconds currently displayed
+    int target; // next displayed value that anyone will notice
+
+    // nothing to wait for if the brew is already complete
+    remain = CuppaScheduleSecondsRemain(interval);
+    if (remain <= 0)
+        return 0.0;
+
+    if (showTimer)
+    {
+        // the badge changes every second
+        target = remain - 1;
+    }
+    else if (makeSound && remain > CUPPA_SCHEDULE_BEEP_SECONDS)
+    {
+        // sleep until the first countdown beep
+        target = CUPPA_SCHEDULE_BEEP_SECONDS;
+    }
+    else if (makeSound)
+    {
+        // in the beep window, so wake for each remaining beep
+        target = remain - 1;
+    }
+    else
+    {
+        // nothing to see or hear until the final alarm
+        target = 0;
+    }
+
+    // the target value is displayed as soon as no more than target seconds remain
+    return (interval - target) + sWakeupSlack;
+
+} // end CuppaScheduleNextWakeup()
+
+// *************************************************************************************************
+
+// end Cuppa_Schedule.c
@@ -0,0 +1,54 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Module:   Cuppa_Schedule
+           - Works out when the next observable change in a brew will happen, so that the brew
+             timer only needs to wake up when there is something to show or play.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_SCHEDULE_H
+#define _CUPPA_SCHEDULE_H
+
+// C Includes
+
+#include <stdbool.h>
+
+// Constants
+
+enum
+{
+    CUPPA_SCHEDULE_BEEP_SECONDS = 5 // countdown beeps are played for the final seconds of a brew
+};
+
+// Function Interface
+
+// The schedule is plain C (no Foundation), so it builds and is tested anywhere, not only in the
+// app. Times are in seconds, as NSTimeInterval is.
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// Returns the whole seconds remaining (as displayed) for a brew whose deadline is interval away.
+// Returns 0 once the brew is complete.
+int CuppaScheduleSecondsRemain(double interval);
+
+// Returns the delay until the next observable change for a brew whose deadline is interval away:
+// the next badge digit change (if showTimer), the next countdown beep (if makeSound), or the
+// final alarm. Returns 0 if the brew is already complete.
+double CuppaScheduleNextWakeup(double interval, bool showTimer, bool makeSound);
+
+#if defined(__cplusplus)
+}
+#endif
+
+// *************************************************************************************************
+
+#endif // _CUPPA_SCHEDULE_H
+
+// end Cuppa_Schedule.h
@@ -21,15 +21,16 @@
 
 #import <Foundation/Foundation.h>
 
+// Forward Declarations
+
+@class NSImage;
+
 // Constants
 
 enum
 {
-    // Cup Shapes
-    CUPPA_SHAPE_DEFAULT = 0,
-    CUPPA_SHAPE_CUP,
-    CUPPA_SHAPE_FLOWER,
-    CUPPA_SHAPE_MAX
+    // Cup Shapes (the rest are listed in Shapes.plist, see Cuppa_ShapeTable)
+    CUPPA_SHAPE_DEFAULT = 0
 };
 
 // Class Interface
@@ -41,6 +42,9 @@ enum
 
 // ------ Class Methods ------
 
+// Returns the number of shapes in the shape registry. Shape codes run from 0 to one less than this.
++ (int)shapeCount;
+
 // Returns a (non human interface) string which represents the shape.
 // Returns CUPPA_SHAPE_DEFAULT if the shape is not recognized.
 + (NSString *)labelForShape:(int)shape;
@@ -49,10 +53,28 @@ enum
 // Returns CUPPA_SHAPE_DEFAULT if the label string is not recognized.
 + (int)shapeForLabel:(NSString *)label;
 
-// Returns an image which represents the shape.
+// Returns a shape constant from the UTF-8 bytes of a label returned by LabelForShape:.
+// Returns CUPPA_SHAPE_DEFAULT if the label is not recognized.
++ (int)shapeForLabelBytes:(const char *)bytes length:(NSUInteger)length;
+
+// Returns an image which represents the shape, at menu size (16x16 points).
 // Returns CUPPA_SHAPE_DEFAULT if the shape is not recognized.
 + (NSImage *)imageForShape:(int)shape;
 
+// Returns a template image which represents the shape at a size in points, drawn once into a
+// bitmap at scale pixels per point (or left as vectors if scale is 0). Images are cached, shared
+// and must not be changed. Returns CUPPA_SHAPE_DEFAULT if the shape is not recognized.
++ (NSImage *)imageForShape:(int)shape size:(NSSize)size scale:(CGFloat)scale;
+
+// Returns the key under which an image of a shape is cached.
++ (NSString *)imageKeyForShape:(int)shape size:(NSSize)size scale:(CGFloat)scale;
+
+// Returns the number of shape images handed out from the cache.
++ (NSUInteger)imageCacheHits;
+
+// Returns the number of shape images made (and cached).
++ (NSUInteger)imageDecodes;
+
 @end // @interface Cuppa_Shape
 
 // *************************************************************************************************
@@ -18,20 +18,17 @@
 // Cuppa Includes
 
 #import "Cuppa_Shape.h"
+#import "Cuppa_ShapeRegistry.h"
+#import "Cuppa_ShapeTable.h"
 
 // Internal Constants
 
-static NSString *sLabels[] =
-{
-    @"default",
-    @"cup",
-    @"flower"};
+// Shape images made so far, by cache key
+static NSMutableDictionary *sImages = nil;
 
-static NSString * const CuppaShapeImageNames[] = {
-    @"QuickAction",        // CUPPA_SHAPE_DEFAULT = 0
-    @"QuickActionCup",     // CUPPA_SHAPE_CUP
-    @"QuickActionFlower",  // CUPPA_SHAPE_FLOWER
-};
+// Shape image cache counters
+static NSUInteger sImageCacheHits = 0;
+static NSUInteger sImageDecodes = 0;
 
 // Code!
 
@@ -40,16 +37,38 @@ static NSString * const CuppaShapeImageNames[] = {
 
 // *************************************************************************************************
 
+// Start the image cache.
++ (void)initialize
+{
+    if (self != [Cuppa_Shape class])
+        return;
+
+    sImages = [[NSMutableDictionary alloc] init];
+
+} // end +initialize
+
+// *************************************************************************************************
+
+// Returns the number of shapes in the shape registry.
++ (int)shapeCount
+{
+    // return requested info
+    return (int)[[Cuppa_ShapeTable sharedTable] count];
+
+} // end +shapeCount
+
+// *************************************************************************************************
+
 // Returns a (non human interface) string which represents the shape.
 // Returns CUPPA_SHAPE_DEFAULT if the shape is not recognized.
 + (NSString *)labelForShape:(int)shape
 {
     // parameter checks - return default if not found (for backwards compatibility)
-    if (shape < 0 || shape >= CUPPA_SHAPE_MAX)
+    if (shape < 0 || shape >= [self shapeCount])
         shape = CUPPA_SHAPE_DEFAULT;
 
     // return label string
-    return sLabels[shape];
+    return [[Cuppa_ShapeTable sharedTable] labelForShape:shape];
     
 } // end +labelForShape:
 
@@ -59,39 +78,155 @@ static NSString * const CuppaShapeImageNames[] = {
 // Returns CUPPA_SHAPE_DEFAULT if the label string is not recognized.
 + (int)shapeForLabel:(NSString *)label
 {
-    int i; // loop counter
-    
-    // parameter checks - return default if nil (for backwards compatibility)
-    if (label == nil)
-        return CUPPA_SHAPE_DEFAULT;
-    
-    // check for label matchs
-    for (i = 0; i < CUPPA_SHAPE_MAX; i++)
-    {
-        if ([label isEqualToString:sLabels[i]])
-            return i;
-    }
-    
-    // match not found! fallback to default
-    return CUPPA_SHAPE_DEFAULT;
+    return [[Cuppa_ShapeTable sharedTable] shapeForLabel:label];
     
 } // end +shapeForLabel:
 
 // *************************************************************************************************
 
-// Returns an image which represents the shape.
+// Returns a shape constant from the UTF-8 bytes of a label returned by LabelForShape:.
+// Returns CUPPA_SHAPE_DEFAULT if the label is not recognized.
++ (int)shapeForLabelBytes:(const char *)bytes length:(NSUInteger)length
+{
+    return [[Cuppa_ShapeTable sharedTable] shapeForLabelBytes:bytes length:length];
+    
+} // end +shapeForLabelBytes:length:
+
+// *************************************************************************************************
+
+// Returns an image which represents the shape, at menu size (16x16 points).
 // Returns CUPPA_SHAPE_DEFAULT if the shape is not recognized.
 + (NSImage *)imageForShape:(int)shape
 {
+    // menus draw templates themselves, so vectors look right on any display
+    return [self imageForShape:shape size:NSMakeSize(16, 16) scale:0.0];
+
+} // end +imageForShape:
+
+// *************************************************************************************************
+
+// Returns a template image which represents the shape at a size in points, drawn once into a
+// bitmap at scale pixels per point (or left as vectors if scale is 0). Images are cached, shared
+// and must not be changed. Returns CUPPA_SHAPE_DEFAULT if the shape is not recognized.
++ (NSImage *)imageForShape:(int)shape size:(NSSize)size scale:(CGFloat)scale
+{
+    NSString *key; // cache key for the image
+    NSImage *image; // image to return
+    NSImage *source; // shared named image
+    NSBezierPath *path; // outline to draw if there is no image
+    NSAffineTransform *transform; // fits the outline to size
+    NSBitmapImageRep *bitmap; // image drawn at scale
+    NSInteger width, height; // size of the bitmap in pixels
+
     // parameter checks - return default if not found (for backwards compatibility)
-    if (shape < 0 || shape >= CUPPA_SHAPE_MAX)
+    if (shape < 0 || shape >= [self shapeCount])
         shape = CUPPA_SHAPE_DEFAULT;
+    NSAssert(size.width > 0 && size.height > 0, @"Bad size parameter.\n");
 
-    NSImage *image = [NSImage imageNamed:CuppaShapeImageNames[shape]];
-    [image setSize:NSMakeSize(16, 16)];
+    key = [self imageKeyForShape:shape size:size scale:scale];
+    image = [sImages objectForKey:key];
+    if (image)
+    {
+        sImageCacheHits++;
+        return image;
+    }
+
+    // work on a copy, so the image shared by imageNamed: is never changed
+    source = [NSImage imageNamed:[[Cuppa_ShapeRegistry sharedRegistry] imageNameForShape:shape]];
+    path = [[Cuppa_ShapeRegistry sharedRegistry] pathForShape:shape];
+    if (source)
+    {
+        image = [[source copy] autorelease];
+    }
+    else if (path)
+    {
+        // no image for this shape, so draw its outline (given in a 16x16 box) instead
+        image = [[[NSImage alloc] initWithSize:size] autorelease];
+        transform = [NSAffineTransform transform];
+        [transform scaleXBy:(size.width / 16.0) yBy:(size.height / 16.0)];
+        [image lockFocus];
+        [[NSColor blackColor] set];
+        [[transform transformBezierPath:path] fill];
+        [image unlockFocus];
+    }
+    else
+    {
+        return nil;
+    }
+    [image setSize:size];
     [image setTemplate:YES];
+
+    // draw it once at the requested scale, if asked to
+    if (scale > 0.0)
+    {
+        width = (NSInteger)ceil(size.width * scale);
+        height = (NSInteger)ceil(size.height * scale);
+        bitmap = [[NSBitmapImageRep alloc] initWithBitmapDataPlanes:NULL
+                                                         pixelsWide:width
+                                                         pixelsHigh:height
+                                                      bitsPerSample:8
+                                                    samplesPerPixel:4
+                                                           hasAlpha:YES
+                                                           isPlanar:NO
+                                                     colorSpaceName:NSDeviceRGBColorSpace
+                                                        bytesPerRow:0
+                                                       bitsPerPixel:0];
+        [bitmap setSize:size];
+        [NSGraphicsContext saveGraphicsState];
+        [NSGraphicsContext
+            setCurrentContext:[NSGraphicsContext graphicsContextWithBitmapImageRep:bitmap]];
+        [image drawInRect:NSMakeRect(0, 0, size.width, size.height)
+                 fromRect:NSZeroRect
+                operation:NSCompositingOperationSourceOver
+                 fraction:1.0];
+        [NSGraphicsContext restoreGraphicsState];
+        image = [[[NSImage alloc] initWithSize:size] autorelease];
+        [image addRepresentation:bitmap];
+        [image setTemplate:YES];
+        [bitmap release];
+    }
+
+    sImageDecodes++;
+    [sImages setObject:image forKey:key];
     return image;
-}
+
+} // end +imageForShape:size:scale:
+
+// *************************************************************************************************
+
+// Returns the key under which an image of a shape is cached.
++ (NSString *)imageKeyForShape:(int)shape size:(NSSize)size scale:(CGFloat)scale
+{
+    // unknown shapes share the default shape's images, and any scale below 0 means vectors
+    if (shape < 0 || shape >= [self shapeCount])
+        shape = CUPPA_SHAPE_DEFAULT;
+    if (scale < 0.0)
+        scale = 0.0;
+
+    return [NSString stringWithFormat:@"%d:%gx%g@%g", shape, (double)size.width,
+                                      (double)size.height, (double)scale];
+
+} // end +imageKeyForShape:size:scale:
+
+// *************************************************************************************************
+
+// Returns the number of shape images handed out from the cache.
++ (NSUInteger)imageCacheHits
+{
+    // return requested info
+    return sImageCacheHits;
+
+} // end +imageCacheHits
+
+// *************************************************************************************************
+
+// Returns the number of shape images made (and cached).
++ (NSUInteger)imageDecodes
+{
+    // return requested info
+    return sImageDecodes;
+
+} // end +imageDecodes
 
 // *************************************************************************************************
 
@@ -0,0 +1,98 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_ShapeRegistry
+           - The cup shapes known to Cuppa, loaded from a table of shapes rather than compiled in.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_SHAPEREGISTRY_H
+#define _CUPPA_SHAPEREGISTRY_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <AppKit/AppKit.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_ShapeTable.h"
+
+// Class Interface
+
+// Each entry of the table is a dictionary with a "label" (stored with beverages), an "image"
+// (asset name) and optionally a "path": an outline in a 16x16 box, drawn if the image is missing,
+// as M x y, L x y, C x1 y1 x2 y2 x y and Z commands separated by spaces or commas.
+//
+// The labels and codes come from a Cuppa_ShapeTable, which needs only Foundation; the registry
+// adds what needs AppKit. A shape's code is its position in the table, so codes are only good for
+// the life of the registry; beverages are stored by label. The first entry is the default shape.
+@interface Cuppa_ShapeRegistry : NSObject
+{
+    Cuppa_ShapeTable *mTable; // labels and codes of the shapes
+    NSArray *mImageNames; // image name of each shape, by code
+    NSArray *mPaths; // outline of each shape (NSBezierPath) or NSNull, by code
+}
+
+// ------ Class Methods ------
+
+// Returns the registry loaded from Shapes.plist in the application bundle.
++ (Cuppa_ShapeRegistry *)sharedRegistry;
+
+// Returns the outline described by a path string, or nil if it is not a valid outline.
++ (NSBezierPath *)pathFromString:(NSString *)string;
+
+// ------ Life Cycle ------
+
+// Initialize a registry for the shapes of a table.
+- (id)initWithTable:(Cuppa_ShapeTable *)table;
+
+// Initialize a registry from a table of shape entries. Entries without a label, or with a label
+// already used, are skipped; if no entry is usable there is just a default shape.
+- (id)initWithEntries:(NSArray *)entries;
+
+// Initialize a registry from a property list file holding a table of shape entries.
+- (id)initWithContentsOfFile:(NSString *)path;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Accessors ------
+
+// Returns the table of labels and codes.
+- (Cuppa_ShapeTable *)table;
+
+// Returns the number of shapes. Shape codes run from 0 to one less than this.
+- (NSUInteger)count;
+
+// Returns the shape code for a label, or 0 (the default shape) if the label is not known.
+- (int)shapeForLabel:(NSString *)label;
+
+// Returns the shape code for the UTF-8 bytes of a label, or 0 (the default shape) if the label is
+// not known.
+- (int)shapeForLabelBytes:(const char *)bytes length:(NSUInteger)length;
+
+// Returns the label of a shape.
+- (NSString *)labelForShape:(int)shape;
+
+// Returns the image name of a shape.
+- (NSString *)imageNameForShape:(int)shape;
+
+// Returns the outline of a shape, or nil if it has none.
+- (NSBezierPath *)pathForShape:(int)shape;
+
+@end // @interface Cuppa_ShapeRegistry
+
+// *************************************************************************************************
+
+#endif // _CUPPA_SHAPEREGISTRY_H
+
+// end Cuppa_ShapeRegistry.h
@@ -0,0 +1,263 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_ShapeRegistry
+           - The cup shapes known to Cuppa, loaded from a table of shapes rather than compiled in.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <AppKit/AppKit.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_ShapeRegistry.h"
+#import "Cuppa_ShapeTable.h"
+
+// Internal Constants
+
+// Registry loaded from the application bundle
+static Cuppa_ShapeRegistry *sSharedRegistry = nil;
+
+// Code!
+
+@implementation Cuppa_ShapeRegistry
+;
+
+// *************************************************************************************************
+
+// Returns the registry loaded from Shapes.plist in the application bundle.
++ (Cuppa_ShapeRegistry *)sharedRegistry
+{
+    if (!sSharedRegistry)
+    {
+        sSharedRegistry = [[Cuppa_ShapeRegistry alloc]
+                           initWithTable:[Cuppa_ShapeTable sharedTable]];
+    }
+
+    // return requested info
+    return sSharedRegistry;
+
+} // end +sharedRegistry
+
+// *************************************************************************************************
+
+// Returns the outline described by a path string, or nil if it is not a valid outline.
++ (NSBezierPath *)pathFromString:(NSString *)string
+{
+    NSScanner *scanner; // reads the path string
+    NSBezierPath *path; // outline so far
+    NSCharacterSet *commands; // command letters
+    NSString *command; // current command letter
+    double values[6]; // current command's numbers
+    int count; // number of numbers the current command takes
+    int i; // loop counter
+
+    if ([string length] == 0)
+        return nil;
+
+    commands = [NSCharacterSet characterSetWithCharactersInString:@"MLCZ"];
+    scanner = [NSScanner scannerWithString:string];
+    [scanner setCharactersToBeSkipped:
+                 [NSCharacterSet characterSetWithCharactersInString:@" ,\t\n"]];
+    path = [NSBezierPath bezierPath];
+    while (![scanner isAtEnd])
+    {
+        // every command but the first needs a current point, which only M gives us
+        if (![scanner scanCharactersFromSet:commands intoString:&command] ||
+            [command length] != 1 || ([path isEmpty] && ![command isEqualToString:@"M"]))
+            return nil;
+        count = [command isEqualToString:@"C"] ? 6 : ([command isEqualToString:@"Z"] ? 0 : 2);
+        for (i = 0; i < count; i++)
+        {
+            if (![scanner scanDouble:&values[i]])
+                return nil;
+        }
+
+        if ([command isEqualToString:@"M"])
+            [path moveToPoint:NSMakePoint(values[0], values[1])];
+        else if ([command isEqualToString:@"L"])
+            [path lineToPoint:NSMakePoint(values[0], values[1])];
+        else if ([command isEqualToString:@"C"])
+            [path curveToPoint:NSMakePoint(values[4], values[5])
+                 controlPoint1:NSMakePoint(values[0], values[1])
+                 controlPoint2:NSMakePoint(values[2], values[3])];
+        else
+            [path closePath];
+    }
+
+    return [path isEmpty] ? nil : path;
+
+} // end +pathFromString:
+
+// *************************************************************************************************
+
+// Initialize a registry for the shapes of a table.
+- (id)initWithTable:(Cuppa_ShapeTable *)table
+{
+    NSMutableArray *imageNames, *paths; // shape details, by code
+    NSDictionary *entry; // current shape's entry
+    NSString *imageName; // current shape's image name
+    NSBezierPath *path; // current shape's outline
+    int shape; // loop counter
+
+    // parameter checks
+    NSAssert(table != nil, @"Bad table parameter.\n");
+
+    imageNames = [NSMutableArray arrayWithCapacity:[table count]];
+    paths = [NSMutableArray arrayWithCapacity:[table count]];
+    for (shape = 0; shape < (int)[table count]; shape++)
+    {
+        entry = [table entryForShape:shape];
+        imageName = [entry objectForKey:@"image"];
+        if (![imageName isKindOfClass:[NSString class]])
+            imageName = @"";
+        path = nil;
+        if ([[entry objectForKey:@"path"] isKindOfClass:[NSString class]])
+            path = [Cuppa_ShapeRegistry pathFromString:[entry objectForKey:@"path"]];
+        [imageNames addObject:imageName];
+        [paths addObject:(path ? (id)path : (id)[NSNull null])];
+    }
+
+    self = [super init];
+    mTable = [table retain];
+    mImageNames = [imageNames copy];
+    mPaths = [paths copy];
+    return self;
+
+} // end -initWithTable:
+
+// *************************************************************************************************
+
+// Initialize a registry from a table of shape entries. Entries without a label, or with a label
+// already used, are skipped; if no entry is usable there is just a default shape.
+- (id)initWithEntries:(NSArray *)entries
+{
+    Cuppa_ShapeTable *table; // labels and codes of the entries
+    id registry; // registry for them
+
+    table = [[Cuppa_ShapeTable alloc] initWithEntries:entries];
+    registry = [self initWithTable:table];
+    [table release];
+    return registry;
+
+} // end -initWithEntries:
+
+// *************************************************************************************************
+
+// Initialize a registry from a property list file holding a table of shape entries.
+- (id)initWithContentsOfFile:(NSString *)path
+{
+    Cuppa_ShapeTable *table; // labels and codes of the entries
+    id registry; // registry for them
+
+    table = [[Cuppa_ShapeTable alloc] initWithContentsOfFile:path];
+    registry = [self initWithTable:table];
+    [table release];
+    return registry;
+
+} // end -initWithContentsOfFile:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the shapes
+    [mTable release];
+    [mImageNames release];
+    [mPaths release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Returns the table of labels and codes.
+- (Cuppa_ShapeTable *)table
+{
+    // return requested info
+    return mTable;
+
+} // end -table
+
+// *************************************************************************************************
+
+// Returns the number of shapes. Shape codes run from 0 to one less than this.
+- (NSUInteger)count
+{
+    // return requested info
+    return [mTable count];
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the shape code for a label, or 0 (the default shape) if the label is not known.
+- (int)shapeForLabel:(NSString *)label
+{
+    // return requested info
+    return [mTable shapeForLabel:label];
+
+} // end -shapeForLabel:
+
+// *************************************************************************************************
+
+// Returns the shape code for the UTF-8 bytes of a label, or 0 (the default shape) if the label is
+// not known.
+- (int)shapeForLabelBytes:(const char *)bytes length:(NSUInteger)length
+{
+    // return requested info
+    return [mTable shapeForLabelBytes:bytes length:length];
+
+} // end -shapeForLabelBytes:length:
+
+// *************************************************************************************************
+
+// Returns the label of a shape.
+- (NSString *)labelForShape:(int)shape
+{
+    // return requested info
+    return [mTable labelForShape:shape];
+
+} // end -labelForShape:
+
+// *************************************************************************************************
+
+// Returns the image name of a shape.
+- (NSString *)imageNameForShape:(int)shape
+{
+    // parameter checks
+    NSAssert(shape >= 0 && (NSUInteger)shape < [mTable count], @"Bad shape parameter.\n");
+
+    // return requested info
+    return [mImageNames objectAtIndex:shape];
+
+} // end -imageNameForShape:
+
+// *************************************************************************************************
+
+// Returns the outline of a shape, or nil if it has none.
+- (NSBezierPath *)pathForShape:(int)shape
+{
+    id path; // outline, or NSNull
+
+    // parameter checks
+    NSAssert(shape >= 0 && (NSUInteger)shape < [mTable count], @"Bad shape parameter.\n");
+
+    path = [mPaths objectAtIndex:shape];
+    return (path == [NSNull null]) ? nil : path;
+
+} // end -pathForShape:
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_ShapeRegistry
+
+// end Cuppa_ShapeRegistry.m
@@ -0,0 +1,86 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_ShapeTable
+           - The labels of the cup shapes known to Cuppa and their codes, without their images.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_SHAPETABLE_H
+#define _CUPPA_SHAPETABLE_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Class Interface
+
+// The part of the shape table that beverages and catalogs need: which labels there are and what
+// code each has. It only needs Foundation, so it can be used off the main thread and in tools
+// without AppKit; Cuppa_ShapeRegistry adds the images and outlines on top of it.
+//
+// A shape's code is its position in the table, so codes are only good for the life of the
+// table; beverages are stored by label. The first entry is the default shape. Lookups by code
+// index an array, and lookups by label hash the label's bytes into an open-addressed table.
+@interface Cuppa_ShapeTable : NSObject
+{
+    NSUInteger mCount; // number of shapes
+    NSArray *mEntries; // entry of each shape, by code
+    NSArray *mLabels; // label of each shape, by code
+    char *mLabelBytes; // UTF-8 bytes of every label
+    NSUInteger *mLabelStarts; // start of each label's bytes, plus the end of the last
+    uint32_t *mSlots; // code + 1 of the label in each hash slot, or 0 for an empty slot
+    NSUInteger mSlotMask; // number of hash slots - 1 (the number of slots is a power of two)
+}
+
+// ------ Class Methods ------
+
+// Returns the table loaded from Shapes.plist in the application bundle. Safe on any thread.
++ (Cuppa_ShapeTable *)sharedTable;
+
+// ------ Life Cycle ------
+
+// Initialize a table from shape entries: dictionaries with a "label" and whatever else the
+// registry reads. Entries without a label, or with a label already used, are skipped; if no
+// entry is usable there is just a default shape.
+- (id)initWithEntries:(NSArray *)entries;
+
+// Initialize a table from a property list file holding shape entries.
+- (id)initWithContentsOfFile:(NSString *)path;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Accessors ------
+
+// Returns the number of shapes. Shape codes run from 0 to one less than this.
+- (NSUInteger)count;
+
+// Returns the shape code for a label, or 0 (the default shape) if the label is not known.
+- (int)shapeForLabel:(NSString *)label;
+
+// Returns the shape code for the UTF-8 bytes of a label, or 0 (the default shape) if the label is
+// not known.
+- (int)shapeForLabelBytes:(const char *)bytes length:(NSUInteger)length;
+
+// Returns the label of a shape.
+- (NSString *)labelForShape:(int)shape;
+
+// Returns the entry a shape was made from.
+- (NSDictionary *)entryForShape:(int)shape;
+
+@end // @interface Cuppa_ShapeTable
+
+// *************************************************************************************************
+
+#endif // _CUPPA_SHAPETABLE_H
+
+// end Cuppa_ShapeTable.h
@@ -0,0 +1,278 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_ShapeTable
+           - The labels of the cup shapes known to Cuppa and their codes, without their images.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_ShapeTable.h"
+
+// Internal Constants
+
+// Entry of the default shape, used if the table has no usable entries
+static NSString * const sDefaultLabel = @"default";
+static NSString * const sDefaultImage = @"QuickAction";
+
+// Code!
+
+// Hash the bytes of a label (FNV-1a).
+static inline uint32_t CuppaShapeTableHash(const char *bytes, NSUInteger length)
+{
+    uint32_t hash = 2166136261u; // hash so far
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < length; i++)
+    {
+        hash ^= (uint8_t)bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+@implementation Cuppa_ShapeTable
+;
+
+// *************************************************************************************************
+
+// Returns the table loaded from Shapes.plist in the application bundle.
++ (Cuppa_ShapeTable *)sharedTable
+{
+    static Cuppa_ShapeTable *table = nil; // table loaded from the application bundle
+    static dispatch_once_t once; // guards the load
+
+    // catalogs are written on the preferences queue, so the first caller may not be on main
+    dispatch_once(&once, ^{
+        table = [[Cuppa_ShapeTable alloc] initWithContentsOfFile:
+                 [[NSBundle mainBundle] pathForResource:@"Shapes" ofType:@"plist"]];
+    });
+
+    // return requested info
+    return table;
+
+} // end +sharedTable
+
+// *************************************************************************************************
+
+// Initialize a table from shape entries. Entries without a label, or with a label already used,
+// are skipped; if no entry is usable there is just a default shape.
+- (id)initWithEntries:(NSArray *)entries
+{
+    NSMutableArray *kept; // usable entries, by code
+    NSMutableArray *labels; // their labels, by code
+    NSMutableSet *seen; // labels used so far
+    NSDictionary *entry; // current entry
+    NSString *label; // current entry's label
+    NSUInteger length; // total length of the labels' bytes
+    NSUInteger slot; // hash slot of the current label
+    NSUInteger slotCount; // number of hash slots
+    NSUInteger i; // loop counter
+
+    kept = [NSMutableArray array];
+    labels = [NSMutableArray array];
+    seen = [NSMutableSet set];
+    for (entry in entries)
+    {
+        if (![entry isKindOfClass:[NSDictionary class]])
+            continue;
+        label = [entry objectForKey:@"label"];
+        if (![label isKindOfClass:[NSString class]] || [label length] == 0)
+            continue;
+
+        // the first entry with a label wins, so a table can't change what a label means
+        if ([seen containsObject:label])
+            continue;
+        [seen addObject:label];
+        [kept addObject:entry];
+        [labels addObject:label];
+    }
+
+    // a table always has a default shape
+    if ([kept count] == 0)
+    {
+        return [self initWithEntries:[NSArray arrayWithObject:
+            [NSDictionary dictionaryWithObjectsAndKeys:sDefaultLabel, @"label",
+                                                       sDefaultImage, @"image", nil]]];
+    }
+
+    self = [super init];
+    mCount = [kept count];
+    mEntries = [kept copy];
+    mLabels = [labels copy];
+
+    // pack every label's bytes together
+    length = 0;
+    for (label in labels)
+    {
+        length += strlen([label UTF8String]);
+    }
+    mLabelBytes = malloc(length + 1);
+    mLabelStarts = malloc((mCount + 1) * sizeof(NSUInteger));
+    NSAssert(mLabelBytes != NULL && mLabelStarts != NULL, @"Out of memory for shape labels.\n");
+    mLabelStarts[0] = 0;
+    for (i = 0; i < mCount; i++)
+    {
+        label = [labels objectAtIndex:i];
+        length = strlen([label UTF8String]);
+        memcpy(mLabelBytes + mLabelStarts[i], [label UTF8String], length);
+        mLabelStarts[i + 1] = mLabelStarts[i] + length;
+    }
+
+    // room for at least twice as many labels as there are, so probes stay short
+    for (slotCount = 4; slotCount < 2 * mCount; slotCount *= 2)
+        ;
+    mSlotMask = slotCount - 1;
+    mSlots = calloc(slotCount, sizeof(uint32_t));
+    NSAssert(mSlots != NULL, @"Out of memory for shape labels.\n");
+
+    // put each label in the first empty slot on from its hash slot
+    for (i = 0; i < mCount; i++)
+    {
+        slot = CuppaShapeTableHash(mLabelBytes + mLabelStarts[i],
+                                   mLabelStarts[i + 1] - mLabelStarts[i]) & mSlotMask;
+        while (mSlots[slot] != 0)
+        {
+            slot = (slot + 1) & mSlotMask;
+        }
+        mSlots[slot] = (uint32_t)i + 1;
+    }
+
+    return self;
+
+} // end -initWithEntries:
+
+// *************************************************************************************************
+
+// Initialize a table from a property list file holding shape entries.
+- (id)initWithContentsOfFile:(NSString *)path
+{
+    NSArray *entries = nil; // shape entries
+
+    if (path)
+        entries = [NSArray arrayWithContentsOfFile:path];
+
+#if !defined(NDEBUG)
+    if (!entries)
+        printf("No shape table, using the default shape only.\n");
+#endif
+
+    return [self initWithEntries:entries];
+
+} // end -initWithContentsOfFile:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the shapes
+    [mEntries release];
+    [mLabels release];
+    free(mLabelBytes);
+    free(mLabelStarts);
+    free(mSlots);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Returns the number of shapes. Shape codes run from 0 to one less than this.
+- (NSUInteger)count
+{
+    // return requested info
+    return mCount;
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the shape code for a label, or 0 (the default shape) if the label is not known.
+- (int)shapeForLabel:(NSString *)label
+{
+    const char *bytes; // label as UTF-8
+
+    if (![label isKindOfClass:[NSString class]])
+        return 0;
+
+    // get at the label's bytes, copying them only if we must
+#if defined(__APPLE__)
+    bytes = CFStringGetCStringPtr((CFStringRef)label, kCFStringEncodingUTF8);
+    if (!bytes)
+        bytes = [label UTF8String];
+#else
+    bytes = [label UTF8String];
+#endif
+
+    return [self shapeForLabelBytes:bytes length:(bytes ? strlen(bytes) : 0)];
+
+} // end -shapeForLabel:
+
+// *************************************************************************************************
+
+// Returns the shape code for the UTF-8 bytes of a label, or 0 (the default shape) if the label is
+// not known.
+- (int)shapeForLabelBytes:(const char *)bytes length:(NSUInteger)length
+{
+    NSUInteger slot; // hash slot being probed
+    NSUInteger shape; // shape code + 1 in the slot
+
+    if (bytes == NULL || length == 0)
+        return 0;
+
+    // probe on from the label's hash slot until we find it, or an empty slot
+    slot = CuppaShapeTableHash(bytes, length) & mSlotMask;
+    while ((shape = mSlots[slot]) != 0)
+    {
+        if (mLabelStarts[shape] - mLabelStarts[shape - 1] == length &&
+            memcmp(mLabelBytes + mLabelStarts[shape - 1], bytes, length) == 0)
+            return (int)(shape - 1);
+        slot = (slot + 1) & mSlotMask;
+    }
+
+    // match not found! fallback to default
+    return 0;
+
+} // end -shapeForLabelBytes:length:
+
+// *************************************************************************************************
+
+// Returns the label of a shape.
+- (NSString *)labelForShape:(int)shape
+{
+    // parameter checks
+    NSAssert(shape >= 0 && (NSUInteger)shape < mCount, @"Bad shape parameter.\n");
+
+    // return requested info
+    return [mLabels objectAtIndex:shape];
+
+} // end -labelForShape:
+
+// *************************************************************************************************
+
+// Returns the entry a shape was made from.
+- (NSDictionary *)entryForShape:(int)shape
+{
+    // parameter checks
+    NSAssert(shape >= 0 && (NSUInteger)shape < mCount, @"Bad shape parameter.\n");
+
+    // return requested info
+    return [mEntries objectAtIndex:shape];
+
+} // end -entryForShape:
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_ShapeTable
+
+// end Cuppa_ShapeTable.m
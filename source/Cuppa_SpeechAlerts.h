@@ -0,0 +1,91 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_SpeechAlerts
+           - Synthesizes spoken brew alerts ahead of time, so they play the moment a brew is
+             complete.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_SPEECHALERTS_H
+#define _CUPPA_SPEECHALERTS_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioCues.h"
+#import "Cuppa_SpeechBackend.h"
+
+// Constants
+
+enum
+{
+    CUPPA_SPEECHALERTS_KEPT = 8 // most alerts kept ready to play
+};
+
+// Class Interface
+
+// An alert is synthesized to a file when it is prepared, then loaded as a cue (and the file
+// removed), so speaking it is just playing a sound. Alerts are kept by text, voice and locale, so
+// brewing the same beverage again speaks the alert already made; the alerts spoken least recently
+// are forgotten once more than CUPPA_SPEECHALERTS_KEPT are ready.
+@interface Cuppa_SpeechAlerts : NSObject
+{
+    id<Cuppa_SpeechBackend> mBackend; // synthesizes alerts to files
+    Cuppa_AudioCues *mAudio; // plays the alerts
+    NSString *mFolder; // folder alerts are synthesized into
+    NSMutableArray *mReady; // keys of the alerts loaded as cues, least recently used first
+    NSMutableSet *mPending; // keys of the alerts being synthesized
+    NSUInteger mFileCount; // number of files synthesized so far, to name the next one
+}
+
+// ------ Life Cycle ------
+
+// Initialize an empty set of alerts, synthesized by backend into folder and played by audio.
+- (id)initWithBackend:(id<Cuppa_SpeechBackend>)backend
+                audio:(Cuppa_AudioCues *)audio
+               folder:(NSString *)folder;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Start synthesizing an alert, unless it is ready or under way already.
+- (void)prepareString:(NSString *)text;
+
+// Play an alert. Returns NO if it isn't ready (or can't be played), for it to be spoken live.
+- (BOOL)speakString:(NSString *)text;
+
+// ------ Accessors ------
+
+// Returns the key an alert is kept under: its text, in the current voice and locale.
+- (NSString *)keyForString:(NSString *)text;
+
+// Returns YES if an alert is ready to play.
+- (BOOL)isReadyForString:(NSString *)text;
+
+// Returns the number of alerts ready to play.
+- (NSUInteger)readyCount;
+
+// Returns the number of alerts being synthesized.
+- (NSUInteger)pendingCount;
+
+@end // @interface Cuppa_SpeechAlerts
+
+// *************************************************************************************************
+
+#endif // _CUPPA_SPEECHALERTS_H
+
+// end Cuppa_SpeechAlerts.h
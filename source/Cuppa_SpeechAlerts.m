@@ -0,0 +1,211 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_SpeechAlerts
+           - Synthesizes spoken brew alerts ahead of time, so they play the moment a brew is
+             complete.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioCues.h"
+#import "Cuppa_SpeechAlerts.h"
+
+// Code!
+
+@implementation Cuppa_SpeechAlerts
+;
+
+// *************************************************************************************************
+
+// Initialize an empty set of alerts, synthesized by backend into folder and played by audio.
+- (id)initWithBackend:(id<Cuppa_SpeechBackend>)backend
+                audio:(Cuppa_AudioCues *)audio
+               folder:(NSString *)folder
+{
+    // parameter checks
+    NSAssert(backend != nil, @"Bad backend parameter.\n");
+    NSAssert(audio != nil, @"Bad audio parameter.\n");
+    NSAssert(folder != nil, @"Bad folder parameter.\n");
+
+    self = [super init];
+    mBackend = [backend retain];
+    mAudio = [audio retain];
+    mFolder = [folder copy];
+    mReady = [[NSMutableArray alloc] init];
+    mPending = [[NSMutableSet alloc] init];
+    mFileCount = 0;
+
+    return self;
+
+} // end -initWithBackend:audio:folder:
+
+// *************************************************************************************************
+
+// Returns the name of the cue an alert is loaded as.
+- (NSString *)cueForKey:(NSString *)key
+{
+    // return requested info
+    return [@"speech:" stringByAppendingString:key];
+
+} // end -cueForKey:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    NSUInteger i; // loop counter
+
+    // the alerts' cues go too
+    for (i = 0; i < [mReady count]; i++)
+    {
+        [mAudio removeCue:[self cueForKey:[mReady objectAtIndex:i]]];
+    }
+    [mBackend release];
+    [mAudio release];
+    [mFolder release];
+    [mReady release];
+    [mPending release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Load a synthesized alert as a cue and remove its file, forgetting the least recently used
+// alerts if there are now too many.
+- (void)finishKey:(NSString *)key path:(NSString *)path written:(BOOL)written
+{
+    // the cue holds the sound, so the file is only needed until it is loaded
+    [mPending removeObject:key];
+    if (written && [mAudio loadCue:[self cueForKey:key] fromFile:path])
+    {
+        [mReady addObject:key];
+        while ([mReady count] > CUPPA_SPEECHALERTS_KEPT)
+        {
+            [mAudio removeCue:[self cueForKey:[mReady objectAtIndex:0]]];
+            [mReady removeObjectAtIndex:0];
+        }
+    }
+    [[NSFileManager defaultManager] removeItemAtPath:path error:NULL];
+
+#if !defined(NDEBUG)
+    printf("Speech alert %s: %s\n", (written ? "ready" : "failed"), [key UTF8String]);
+#endif
+
+} // end -finishKey:path:written:
+
+// *************************************************************************************************
+
+// Start synthesizing an alert, unless it is ready or under way already.
+- (void)prepareString:(NSString *)text
+{
+    NSString *key; // key of the alert
+    NSString *path; // file the alert is synthesized into
+
+    // parameter checks
+    NSAssert(text != nil, @"Bad text parameter.\n");
+
+    key = [self keyForString:text];
+    if ([mReady containsObject:key] || [mPending containsObject:key])
+        return;
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:mFolder
+                                   withIntermediateDirectories:YES
+                                                    attributes:nil
+                                                         error:NULL])
+        return;
+
+    // record new info
+    [mPending addObject:key];
+    path = [mFolder stringByAppendingPathComponent:
+            [NSString stringWithFormat:@"speech-%lu.aiff", (unsigned long)++mFileCount]];
+
+    [mBackend synthesizeString:text toFile:path completion:^(BOOL written) {
+        [self finishKey:key path:path written:written];
+    }];
+
+} // end -prepareString:
+
+// *************************************************************************************************
+
+// Play an alert. Returns NO if it isn't ready (or can't be played), for it to be spoken live.
+- (BOOL)speakString:(NSString *)text
+{
+    NSString *key; // key of the alert
+
+    // parameter checks
+    NSAssert(text != nil, @"Bad text parameter.\n");
+
+    key = [self keyForString:text];
+    if (![mReady containsObject:key])
+        return NO;
+
+    // record new info (this alert is now the most recently used)
+    [key retain];
+    [mReady removeObject:key];
+    [mReady addObject:key];
+    [key release];
+
+    return [mAudio playCue:[self cueForKey:key]];
+
+} // end -speakString:
+
+// *************************************************************************************************
+
+// Returns the key an alert is kept under: its text, in the current voice and locale.
+- (NSString *)keyForString:(NSString *)text
+{
+    // parameter checks
+    NSAssert(text != nil, @"Bad text parameter.\n");
+
+    // return requested info
+    return [NSString stringWithFormat:@"%@|%@|%@", [mBackend voice],
+                                      [[NSLocale currentLocale] localeIdentifier], text];
+
+} // end -keyForString:
+
+// *************************************************************************************************
+
+// Returns YES if an alert is ready to play.
+- (BOOL)isReadyForString:(NSString *)text
+{
+    // return requested info
+    return [mReady containsObject:[self keyForString:text]];
+
+} // end -isReadyForString:
+
+// *************************************************************************************************
+
+// Returns the number of alerts ready to play.
+- (NSUInteger)readyCount
+{
+    // return requested info
+    return [mReady count];
+
+} // end -readyCount
+
+// *************************************************************************************************
+
+// Returns the number of alerts being synthesized.
+- (NSUInteger)pendingCount
+{
+    // return requested info
+    return [mPending count];
+
+} // end -pendingCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_SpeechAlerts
+
+// end Cuppa_SpeechAlerts.m
@@ -0,0 +1,48 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Protocol: Cuppa_SpeechBackend
+           - The interface shared by the speech synthesizers that turn brew alerts into sound
+             files ahead of time.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_SPEECHBACKEND_H
+#define _CUPPA_SPEECHBACKEND_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Protocol Interface
+
+@protocol Cuppa_SpeechBackend <NSObject>
+
+// ------ Manipulators ------
+
+// Synthesize text to an AIFF file at path, then call handler on the main thread with whether the
+// file was written. Requests are handled one at a time, in the order they are made.
+- (void)synthesizeString:(NSString *)text
+                  toFile:(NSString *)path
+              completion:(void (^)(BOOL written))handler;
+
+// ------ Accessors ------
+
+// Returns the identifier of the voice text is spoken in.
+- (NSString *)voice;
+
+@end // @protocol Cuppa_SpeechBackend
+
+// *************************************************************************************************
+
+#endif // _CUPPA_SPEECHBACKEND_H
+
+// end Cuppa_SpeechBackend.h
@@ -0,0 +1,76 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_SpeechRecorder
+           - Stands in for the speech synthesizer when speech is simulated, recording what is
+             asked for and writing silence in its place.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_SPEECHRECORDER_H
+#define _CUPPA_SPEECHRECORDER_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_SpeechBackend.h"
+
+// Class Interface
+
+// Each request is finished (and its handler called) before it returns, so nothing waits on a run
+// loop. The silence written lasts about as long as the text would take to say.
+@interface Cuppa_SpeechRecorder : NSObject <Cuppa_SpeechBackend>
+{
+    NSString *mVoice; // identifier of the voice being simulated
+    double mSampleRate; // frames per second of the files written
+    NSMutableArray *mRequests; // text of each request, in the order they were made
+}
+
+// ------ Life Cycle ------
+
+// Initialize a recorder that simulates voice, writing files at sampleRate.
+- (id)initWithVoice:(NSString *)voice sampleRate:(double)sampleRate;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Record a request for text, write silence for it to an AIFF file at path, and call handler
+// with whether the file was written.
+- (void)synthesizeString:(NSString *)text
+                  toFile:(NSString *)path
+              completion:(void (^)(BOOL written))handler;
+
+// Change the voice being simulated.
+- (void)setVoice:(NSString *)voice;
+
+// ------ Accessors ------
+
+// Returns the identifier of the voice being simulated.
+- (NSString *)voice;
+
+// Returns the text of each request, in the order they were made.
+- (NSArray *)requests;
+
+// Returns the number of requests made so far.
+- (NSUInteger)requestCount;
+
+@end // @interface Cuppa_SpeechRecorder
+
+// *************************************************************************************************
+
+#endif // _CUPPA_SPEECHRECORDER_H
+
+// end Cuppa_SpeechRecorder.h
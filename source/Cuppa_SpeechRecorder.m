@@ -0,0 +1,183 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_SpeechRecorder
+           - Stands in for the speech synthesizer when speech is simulated, recording what is
+             asked for and writing silence in its place.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_SpeechRecorder.h"
+
+// Internal Constants
+
+// Seconds of silence written for each character of text, about the pace of speech
+static const NSTimeInterval sSecondsPerCharacter = 0.06;
+
+// Code!
+
+// Appends the low count bytes of value to data, big-endian.
+static void CuppaSpeechAppendBig(NSMutableData *data, uint64_t value, NSUInteger count)
+{
+    uint8_t byte; // current byte
+    NSUInteger i; // loop counter
+
+    for (i = count; i > 0; i--)
+    {
+        byte = (uint8_t)(value >> ((i - 1) * 8));
+        [data appendBytes:&byte length:1];
+    }
+}
+
+// Appends value to data as an 80-bit IEEE extended float, as the AIFF sample rate is stored.
+static void CuppaSpeechAppendExtended(NSMutableData *data, double value)
+{
+    double fraction; // value is fraction * 2^exponent, with fraction in [0.5, 1)
+    int exponent; // power of two
+
+    if (value <= 0.0)
+    {
+        CuppaSpeechAppendBig(data, 0, 2);
+        CuppaSpeechAppendBig(data, 0, 8);
+        return;
+    }
+    fraction = frexp(value, &exponent);
+    CuppaSpeechAppendBig(data, (uint64_t)(exponent - 1 + 16383), 2);
+    CuppaSpeechAppendBig(data, (uint64_t)ldexp(fraction, 64), 8);
+}
+
+@implementation Cuppa_SpeechRecorder
+;
+
+// *************************************************************************************************
+
+// Initialize a recorder that simulates voice, writing files at sampleRate.
+- (id)initWithVoice:(NSString *)voice sampleRate:(double)sampleRate
+{
+    // parameter checks
+    NSAssert(voice != nil, @"Bad voice parameter.\n");
+    NSAssert(sampleRate > 0.0, @"Bad sampleRate parameter.\n");
+
+    self = [super init];
+    mVoice = [voice copy];
+    mSampleRate = sampleRate;
+    mRequests = [[NSMutableArray alloc] init];
+
+    return self;
+
+} // end -initWithVoice:sampleRate:
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release the records
+    [mVoice release];
+    [mRequests release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Record a request for text, write silence for it to an AIFF file at path, and call handler
+// with whether the file was written.
+- (void)synthesizeString:(NSString *)text
+                  toFile:(NSString *)path
+              completion:(void (^)(BOOL written))handler
+{
+    NSMutableData *data; // file being written
+    NSUInteger frameCount; // frames of silence
+    NSUInteger soundLength; // bytes of samples (mono, 16-bit)
+
+    // parameter checks
+    NSAssert(text != nil, @"Bad text parameter.\n");
+    NSAssert(path != nil, @"Bad path parameter.\n");
+    NSAssert(handler != nil, @"Bad handler parameter.\n");
+
+    // record new info
+    [mRequests addObject:[[text copy] autorelease]];
+
+    // FORM, COMM and SSND chunks of a mono 16-bit AIFF file
+    frameCount = (NSUInteger)ceil([text length] * sSecondsPerCharacter * mSampleRate);
+    soundLength = frameCount * 2;
+    data = [NSMutableData dataWithCapacity:54 + soundLength];
+    [data appendBytes:"FORM" length:4];
+    CuppaSpeechAppendBig(data, 46 + soundLength, 4);
+    [data appendBytes:"AIFF" length:4];
+    [data appendBytes:"COMM" length:4];
+    CuppaSpeechAppendBig(data, 18, 4);
+    CuppaSpeechAppendBig(data, 1, 2);
+    CuppaSpeechAppendBig(data, frameCount, 4);
+    CuppaSpeechAppendBig(data, 16, 2);
+    CuppaSpeechAppendExtended(data, mSampleRate);
+    [data appendBytes:"SSND" length:4];
+    CuppaSpeechAppendBig(data, 8 + soundLength, 4);
+    CuppaSpeechAppendBig(data, 0, 4);
+    CuppaSpeechAppendBig(data, 0, 4);
+    [data increaseLengthBy:soundLength];
+
+    handler([data writeToFile:path atomically:YES]);
+
+} // end -synthesizeString:toFile:completion:
+
+// *************************************************************************************************
+
+// Change the voice being simulated.
+- (void)setVoice:(NSString *)voice
+{
+    // parameter checks
+    NSAssert(voice != nil, @"Bad voice parameter.\n");
+
+    // record new info
+    [mVoice release];
+    mVoice = [voice copy];
+
+} // end -setVoice:
+
+// *************************************************************************************************
+
+// Returns the identifier of the voice being simulated.
+- (NSString *)voice
+{
+    // return requested info
+    return mVoice;
+
+} // end -voice
+
+// *************************************************************************************************
+
+// Returns the text of each request, in the order they were made.
+- (NSArray *)requests
+{
+    // return requested info
+    return mRequests;
+
+} // end -requests
+
+// *************************************************************************************************
+
+// Returns the number of requests made so far.
+- (NSUInteger)requestCount
+{
+    // return requested info
+    return [mRequests count];
+
+} // end -requestCount
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_SpeechRecorder
+
+// end Cuppa_SpeechRecorder.m
@@ -0,0 +1,69 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_SpeechSynth
+           - Synthesizes speech to sound files with the system speech synthesizer.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_SPEECHSYNTH_H
+#define _CUPPA_SPEECHSYNTH_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <AppKit/AppKit.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_SpeechBackend.h"
+
+// Class Interface
+
+// The synthesizer only writes one file at a time, so requests wait in a queue for their turn.
+@interface Cuppa_SpeechSynth : NSObject <Cuppa_SpeechBackend, NSSpeechSynthesizerDelegate>
+{
+    NSSpeechSynthesizer *mSynth; // writes speech to files
+    NSMutableArray *mQueue; // requests (text, path and handler) not yet finished, in order
+    bool mSpeaking; // flag: the first request is being synthesized
+}
+
+// ------ Life Cycle ------
+
+// Initialize a synthesizer that speaks in the default voice.
+- (id)init;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Synthesize text to an AIFF file at path, then call handler on the main thread with whether the
+// file was written. Requests are handled one at a time, in the order they are made.
+- (void)synthesizeString:(NSString *)text
+                  toFile:(NSString *)path
+              completion:(void (^)(BOOL written))handler;
+
+// Handle the end of synthesis of the first request, and start on the next.
+- (void)speechSynthesizer:(NSSpeechSynthesizer *)sender didFinishSpeaking:(BOOL)finished;
+
+// ------ Accessors ------
+
+// Returns the identifier of the voice text is spoken in.
+- (NSString *)voice;
+
+@end // @interface Cuppa_SpeechSynth
+
+// *************************************************************************************************
+
+#endif // _CUPPA_SPEECHSYNTH_H
+
+// end Cuppa_SpeechSynth.h
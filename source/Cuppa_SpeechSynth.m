@@ -0,0 +1,151 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_SpeechSynth
+           - Synthesizes speech to sound files with the system speech synthesizer.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <AppKit/AppKit.h>
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_SpeechSynth.h"
+
+// Internal Constants
+
+// Keys of the parts of a queued request
+static NSString *const sTextKey = @"text";
+static NSString *const sPathKey = @"path";
+static NSString *const sHandlerKey = @"handler";
+
+// Code!
+
+@implementation Cuppa_SpeechSynth
+;
+
+// *************************************************************************************************
+
+// Initialize a synthesizer that speaks in the default voice.
+- (id)init
+{
+    self = [super init];
+    mSynth = [[NSSpeechSynthesizer alloc] initWithVoice:nil];
+    [mSynth setDelegate:self];
+    mQueue = [[NSMutableArray alloc] init];
+    mSpeaking = false;
+    return self;
+
+} // end -init
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // stop synthesizing, and drop any requests still waiting
+    [mSynth setDelegate:nil];
+    [mSynth stopSpeaking];
+    [mSynth release];
+    [mQueue release];
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Start synthesizing the first request in the queue, failing any that can't be started.
+- (void)startNext
+{
+    NSDictionary *request; // request to start
+    void (^handler)(BOOL written); // called once the request is done
+
+    while (!mSpeaking && [mQueue count] > 0)
+    {
+        request = [mQueue objectAtIndex:0];
+        mSpeaking = [mSynth startSpeakingString:[request objectForKey:sTextKey]
+                                          toURL:[NSURL fileURLWithPath:
+                                                 [request objectForKey:sPathKey]]];
+        if (mSpeaking)
+            return;
+
+        // the handler may make another request, so the queue is up to date before it is called
+        [request retain];
+        [mQueue removeObjectAtIndex:0];
+        handler = [request objectForKey:sHandlerKey];
+        handler(NO);
+        [request release];
+    }
+
+} // end -startNext
+
+// *************************************************************************************************
+
+// Synthesize text to an AIFF file at path, then call handler on the main thread with whether the
+// file was written. Requests are handled one at a time, in the order they are made.
+- (void)synthesizeString:(NSString *)text
+                  toFile:(NSString *)path
+              completion:(void (^)(BOOL written))handler
+{
+    // parameter checks
+    NSAssert(text != nil, @"Bad text parameter.\n");
+    NSAssert(path != nil, @"Bad path parameter.\n");
+    NSAssert(handler != nil, @"Bad handler parameter.\n");
+
+    // record new info
+    [mQueue addObject:[NSDictionary dictionaryWithObjectsAndKeys:text, sTextKey,
+                                                                 path, sPathKey,
+                                                                 [[handler copy] autorelease],
+                                                                 sHandlerKey,
+                                                                 nil]];
+
+    // start straight away if nothing else is being synthesized
+    [self startNext];
+
+} // end -synthesizeString:toFile:completion:
+
+// *************************************************************************************************
+
+// Handle the end of synthesis of the first request, and start on the next.
+- (void)speechSynthesizer:(NSSpeechSynthesizer *)sender didFinishSpeaking:(BOOL)finished
+{
+    NSDictionary *request; // request just finished
+    void (^handler)(BOOL written); // called now it is done
+
+    if (!mSpeaking || [mQueue count] == 0)
+        return;
+
+    // the handler may make another request, so the queue is up to date before it is called
+    mSpeaking = false;
+    request = [[mQueue objectAtIndex:0] retain];
+    [mQueue removeObjectAtIndex:0];
+    handler = [request objectForKey:sHandlerKey];
+    handler(finished);
+    [request release];
+
+    [self startNext];
+
+} // end -speechSynthesizer:didFinishSpeaking:
+
+// *************************************************************************************************
+
+// Returns the identifier of the voice text is spoken in.
+- (NSString *)voice
+{
+    // return requested info
+    return [mSynth voice];
+
+} // end -voice
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_SpeechSynth
+
+// end Cuppa_SpeechSynth.m
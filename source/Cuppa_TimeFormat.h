@@ -0,0 +1,62 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_TimeFormat
+           - Formats brew times as 'h:mm:ss' or 'm:ss' into caller supplied buffers, without
+             allocating, for the dock badge, the menus and the quit warning.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_TIMEFORMAT_H
+#define _CUPPA_TIMEFORMAT_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Constants
+
+enum
+{
+    CUPPA_TIME_STRING_MAX = 16 // room for any formatted time, including the terminator
+};
+
+// Class Interface
+
+@interface Cuppa_TimeFormat : NSObject
+{
+    // no instance vars
+}
+
+// ------ Class Methods ------
+
+// Write seconds as 'h:mm:ss' (with hours) or 'm:ss' (without) into buffer, using separator
+// between the fields. Negative seconds are written as zero. The result is always terminated and
+// is truncated if buffer is too small. Returns the length written, not counting the terminator.
++ (size_t)formatSeconds:(int)seconds
+              separator:(char)separator
+                 buffer:(char *)buffer
+                   size:(size_t)size;
+
+// Write seconds into buffer as above, with the time separator of the current locale.
++ (size_t)formatSeconds:(int)seconds buffer:(char *)buffer size:(size_t)size;
+
+// Returns the time separator of the current locale (':' unless the locale uses another plain
+// ASCII character). Looked up once and remembered.
++ (char)localeSeparator;
+
+@end // @interface Cuppa_TimeFormat
+
+// *************************************************************************************************
+
+#endif // _CUPPA_TIMEFORMAT_H
+
+// end Cuppa_TimeFormat.h
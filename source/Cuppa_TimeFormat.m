@@ -0,0 +1,146 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_TimeFormat
+           - Formats brew times as 'h:mm:ss' or 'm:ss' into caller supplied buffers, without
+             allocating, for the dock badge, the menus and the quit warning.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimeFormat.h"
+
+// Internal Constants
+
+// Two digit forms of 00 to 99, so each field is copied rather than divided out digit by digit
+static const char sTwoDigits[200] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Code!
+
+@implementation Cuppa_TimeFormat
+;
+
+// *************************************************************************************************
+
+// Write seconds as 'h:mm:ss' (with hours) or 'm:ss' (without) into buffer, using separator
+// between the fields. Negative seconds are written as zero. The result is always terminated and
+// is truncated if buffer is too small. Returns the length written, not counting the terminator.
++ (size_t)formatSeconds:(int)seconds
+              separator:(char)separator
+                 buffer:(char *)buffer
+                   size:(size_t)size
+{
+    char scratch[CUPPA_TIME_STRING_MAX]; // formatted time, before it is copied to buffer
+    char lead[12]; // leading field, written backwards
+    int leadLength = 0; // number of digits in the leading field
+    size_t length = 0; // length of the formatted time
+    int hours, minutes; // fields of the time
+    int leading; // value of the leading field
+
+    // parameter checks
+    NSAssert(buffer != NULL && size > 0, @"Bad buffer parameter.\n");
+
+    if (seconds < 0)
+        seconds = 0;
+    hours = seconds / 3600;
+    minutes = (seconds / 60) % 60;
+    seconds %= 60;
+
+    // the leading field has no padding: hours if there are any, otherwise minutes
+    leading = (hours > 0) ? hours : minutes;
+    do
+    {
+        lead[leadLength++] = (char)('0' + (leading % 10));
+        leading /= 10;
+    } while (leading > 0);
+    while (leadLength > 0)
+        scratch[length++] = lead[--leadLength];
+
+    // then two digits each for minutes (after hours) and seconds
+    if (hours > 0)
+    {
+        scratch[length++] = separator;
+        scratch[length++] = sTwoDigits[minutes * 2];
+        scratch[length++] = sTwoDigits[minutes * 2 + 1];
+    }
+    scratch[length++] = separator;
+    scratch[length++] = sTwoDigits[seconds * 2];
+    scratch[length++] = sTwoDigits[seconds * 2 + 1];
+
+    // hand over as much as fits
+    if (length > size - 1)
+        length = size - 1;
+    memcpy(buffer, scratch, length);
+    buffer[length] = '\0';
+
+    return length;
+
+} // end +formatSeconds:separator:buffer:size:
+
+// *************************************************************************************************
+
+// Write seconds into buffer as above, with the time separator of the current locale.
++ (size_t)formatSeconds:(int)seconds buffer:(char *)buffer size:(size_t)size
+{
+    return [self formatSeconds:seconds separator:[self localeSeparator] buffer:buffer size:size];
+
+} // end +formatSeconds:buffer:size:
+
+// *************************************************************************************************
+
+// Returns the time separator of the current locale (':' unless the locale uses another plain
+// ASCII character). Looked up once and remembered.
++ (char)localeSeparator
+{
+    static char separator = '\0'; // remembered separator
+    static dispatch_once_t once; // guards the lookup
+
+    dispatch_once(&once, ^{
+        NSString *format; // locale's pattern for hours, minutes and seconds
+        NSUInteger i; // loop counter
+        unichar c; // pattern character being checked
+
+        // the separator is whatever the locale puts straight after the hours
+        separator = ':';
+        format = [NSDateFormatter dateFormatFromTemplate:@"Hms"
+                                                 options:0
+                                                  locale:[NSLocale currentLocale]];
+        for (i = 0; i + 1 < [format length]; i++)
+        {
+            c = [format characterAtIndex:i];
+            if (c == 'H' || c == 'h' || c == 'k' || c == 'K')
+            {
+                c = [format characterAtIndex:(i + 1)];
+                if (c != 'H' && c != 'h' && c != 'k' && c != 'K')
+                {
+                    if (c > ' ' && c < 0x7f && c != '\'' && !isalnum(c))
+                        separator = (char)c;
+                    break;
+                }
+            }
+        }
+    });
+
+    return separator;
+
+} // end +localeSeparator
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_TimeFormat
+
+// end Cuppa_TimeFormat.m
@@ -0,0 +1,73 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Protocol: Cuppa_TimerBackend
+           - The interface shared by the timer engines that track active brews by deadline.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_TIMERBACKEND_H
+#define _CUPPA_TIMERBACKEND_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Constants
+
+enum
+{
+    CUPPA_TIMER_NONE = 0 // never returned as a timer identifier
+};
+
+// Protocol Interface
+
+@protocol Cuppa_TimerBackend <NSObject>
+
+// ------ Manipulators ------
+
+// Add a timer that expires at deadline, retaining object until the timer expires or is cancelled.
+// Returns an identifier for the timer (never CUPPA_TIMER_NONE).
+- (NSUInteger)addTimerWithDeadline:(NSTimeInterval)deadline object:(id)object;
+
+// Cancel a timer. Returns NO if the timer had already expired or been cancelled.
+- (BOOL)cancelTimer:(NSUInteger)timerID;
+
+// Remove the earliest timer if it expires at or before time.
+// Returns its (autoreleased) object, or nil if no timer has expired.
+- (id)popTimerDueBy:(NSTimeInterval)time;
+
+// Cancel all timers.
+- (void)removeAllTimers;
+
+// ------ Accessors ------
+
+// Returns the number of active timers.
+- (NSUInteger)count;
+
+// Returns the deadline of the earliest timer, or INFINITY if there are no timers.
+- (NSTimeInterval)nextDeadline;
+
+// Returns the object of the earliest timer, or nil if there are no timers.
+- (id)nextObject;
+
+// Call block for every timer that expires before time, in no particular order.
+// The block must not add or remove timers.
+- (void)enumerateTimersDueBefore:(NSTimeInterval)time
+                      usingBlock:(void (^)(id object, NSTimeInterval deadline))block;
+
+@end // @protocol Cuppa_TimerBackend
+
+// *************************************************************************************************
+
+#endif // _CUPPA_TIMERBACKEND_H
+
+// end Cuppa_TimerBackend.h
@@ -0,0 +1,99 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_TimerQueue
+           - Tracks any number of active timers in a min-heap keyed on absolute deadline, so the
+             earliest timer can always be found without visiting the others.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_TIMERQUEUE_H
+#define _CUPPA_TIMERQUEUE_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimerBackend.h"
+
+// Types
+
+// Storage for a single timer (internal to Cuppa_TimerQueue).
+typedef struct
+{
+    NSTimeInterval deadline; // absolute time when the timer expires
+    id object; // retained object associated with the timer
+    NSUInteger generation; // incremented each time the slot is reused
+    NSUInteger heapIndex; // position of the slot in the heap, if in use
+} Cuppa_TimerSlot;
+
+// Class Interface
+
+@interface Cuppa_TimerQueue : NSObject <Cuppa_TimerBackend>
+{
+    Cuppa_TimerSlot *mSlots; // timer storage, addressed by the low bits of the timer identifier
+    NSUInteger *mHeap; // slot numbers ordered as a binary min-heap on deadline
+    NSUInteger *mFreeSlots; // stack of unused slot numbers
+    NSUInteger mFreeCount; // number of unused slot numbers on the stack
+    NSUInteger mCapacity; // number of allocated slots
+    NSUInteger mCount; // number of active timers
+}
+
+// ------ Life Cycle ------
+
+// Default initializer.
+- (id)init;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Add a timer that expires at deadline, retaining object until the timer expires or is cancelled.
+// Returns an identifier for the timer (never CUPPA_TIMER_NONE). O(log n).
+- (NSUInteger)addTimerWithDeadline:(NSTimeInterval)deadline object:(id)object;
+
+// Cancel a timer. Returns NO if the timer had already expired or been cancelled. O(log n).
+- (BOOL)cancelTimer:(NSUInteger)timerID;
+
+// Remove the earliest timer if it expires at or before time.
+// Returns its (autoreleased) object, or nil if no timer has expired. O(log n).
+- (id)popTimerDueBy:(NSTimeInterval)time;
+
+// Cancel all timers.
+- (void)removeAllTimers;
+
+// ------ Accessors ------
+
+// Returns the number of active timers.
+- (NSUInteger)count;
+
+// Returns the deadline of the earliest timer, or INFINITY if there are no timers. O(1).
+- (NSTimeInterval)nextDeadline;
+
+// Returns the object of the earliest timer, or nil if there are no timers. O(1).
+- (id)nextObject;
+
+// Call block for every timer that expires before time, in no particular order.
+// Only the matching timers (and their direct children in the heap) are visited.
+// The block must not add or remove timers.
+- (void)enumerateTimersDueBefore:(NSTimeInterval)time
+                      usingBlock:(void (^)(id object, NSTimeInterval deadline))block;
+
+@end // @interface Cuppa_TimerQueue
+
+// *************************************************************************************************
+
+#endif // _CUPPA_TIMERQUEUE_H
+
+// end Cuppa_TimerQueue.h
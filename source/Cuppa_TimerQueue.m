@@ -0,0 +1,328 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_TimerQueue
+           - Tracks any number of active timers in a min-heap keyed on absolute deadline, so the
+             earliest timer can always be found without visiting the others.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimerQueue.h"
+
+// Internal Constants
+
+static const NSUInteger sInitialCapacity = 16; // slots allocated by the first timer
+static const int sSlotBits = 32; // low bits of a timer identifier hold the slot number
+
+// Code!
+
+@implementation Cuppa_TimerQueue
+;
+
+// *************************************************************************************************
+
+// Default initializer.
+- (id)init
+{
+    self = [super init];
+    mSlots = NULL;
+    mHeap = NULL;
+    mFreeSlots = NULL;
+    mFreeCount = 0;
+    mCapacity = 0;
+    mCount = 0;
+    return self;
+
+} // end -init
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the timer objects
+    [self removeAllTimers];
+    free(mSlots);
+    free(mHeap);
+    free(mFreeSlots);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Make room for at least one more timer.
+- (void)growIfNeeded
+{
+    NSUInteger i; // loop counter
+    NSUInteger capacity; // new number of slots
+
+    if (mFreeCount > 0)
+        return;
+
+    capacity = (mCapacity == 0) ? sInitialCapacity : (mCapacity * 2);
+    mSlots = realloc(mSlots, capacity * sizeof(Cuppa_TimerSlot));
+    mHeap = realloc(mHeap, capacity * sizeof(NSUInteger));
+    mFreeSlots = realloc(mFreeSlots, capacity * sizeof(NSUInteger));
+    NSAssert(mSlots && mHeap && mFreeSlots, @"Out of memory for timers.\n");
+
+    // push the new slots so the lowest numbers are used first
+    for (i = capacity; i > mCapacity; i--)
+    {
+        mSlots[i - 1].object = nil;
+        mSlots[i - 1].generation = 0;
+        mFreeSlots[mFreeCount++] = i - 1;
+    }
+    mCapacity = capacity;
+
+} // end -growIfNeeded
+
+// *************************************************************************************************
+
+// Returns the slot for a timer identifier, or NSNotFound if the timer is no longer active.
+- (NSUInteger)slotForTimer:(NSUInteger)timerID
+{
+    NSUInteger slot = timerID & ((1UL << sSlotBits) - 1);
+
+    if (slot >= mCapacity || mSlots[slot].object == nil ||
+        mSlots[slot].generation != (timerID >> sSlotBits))
+        return NSNotFound;
+
+    return slot;
+
+} // end -slotForTimer:
+
+// *************************************************************************************************
+
+// Place a slot at a heap position and record the position in the slot.
+- (void)setHeapIndex:(NSUInteger)index toSlot:(NSUInteger)slot
+{
+    mHeap[index] = slot;
+    mSlots[slot].heapIndex = index;
+
+} // end -setHeapIndex:toSlot:
+
+// *************************************************************************************************
+
+// Move the slot at a heap position up towards the root until the heap is ordered.
+- (void)siftUp:(NSUInteger)index
+{
+    NSUInteger slot = mHeap[index];
+    NSTimeInterval deadline = mSlots[slot].deadline;
+
+    while (index > 0)
+    {
+        NSUInteger parent = (index - 1) / 2;
+        if (mSlots[mHeap[parent]].deadline <= deadline)
+            break;
+        [self setHeapIndex:index toSlot:mHeap[parent]];
+        index = parent;
+    }
+    [self setHeapIndex:index toSlot:slot];
+
+} // end -siftUp:
+
+// *************************************************************************************************
+
+// Move the slot at a heap position down towards the leaves until the heap is ordered.
+- (void)siftDown:(NSUInteger)index
+{
+    NSUInteger slot = mHeap[index];
+    NSTimeInterval deadline = mSlots[slot].deadline;
+
+    for (;;)
+    {
+        NSUInteger child = index * 2 + 1;
+        if (child >= mCount)
+            break;
+
+        // pick the earlier of the two children
+        if (child + 1 < mCount &&
+            mSlots[mHeap[child + 1]].deadline < mSlots[mHeap[child]].deadline)
+            child++;
+
+        if (deadline <= mSlots[mHeap[child]].deadline)
+            break;
+        [self setHeapIndex:index toSlot:mHeap[child]];
+        index = child;
+    }
+    [self setHeapIndex:index toSlot:slot];
+
+} // end -siftDown:
+
+// *************************************************************************************************
+
+// Take a slot out of the heap and return it to the free stack. Returns the slot's object, which
+// the caller now owns.
+- (id)removeSlot:(NSUInteger)slot
+{
+    NSUInteger index = mSlots[slot].heapIndex;
+    id object = mSlots[slot].object;
+
+    // fill the hole with the last heap entry, then restore the heap order
+    mCount--;
+    if (index != mCount)
+    {
+        [self setHeapIndex:index toSlot:mHeap[mCount]];
+        if (index > 0 && mSlots[mHeap[index]].deadline < mSlots[mHeap[(index - 1) / 2]].deadline)
+            [self siftUp:index];
+        else
+            [self siftDown:index];
+    }
+
+    // recycle the slot
+    mSlots[slot].object = nil;
+    mFreeSlots[mFreeCount++] = slot;
+
+    return object;
+
+} // end -removeSlot:
+
+// *************************************************************************************************
+
+// Add a timer that expires at deadline, retaining object until the timer expires or is cancelled.
+// Returns an identifier for the timer (never CUPPA_TIMER_NONE). O(log n).
+- (NSUInteger)addTimerWithDeadline:(NSTimeInterval)deadline object:(id)object
+{
+    NSUInteger slot; // storage for the new timer
+
+    // parameter checks
+    NSAssert(object != nil, @"Bad timer object parameter.\n");
+
+    [self growIfNeeded];
+    slot = mFreeSlots[--mFreeCount];
+
+    // fill in the slot, bumping the generation so old identifiers for it go stale
+    mSlots[slot].deadline = deadline;
+    mSlots[slot].object = [object retain];
+    mSlots[slot].generation = (mSlots[slot].generation + 1) & ((1UL << sSlotBits) - 1);
+    if (mSlots[slot].generation == 0)
+        mSlots[slot].generation = 1;
+
+    // add to the bottom of the heap and let it rise into place
+    mHeap[mCount] = slot;
+    mSlots[slot].heapIndex = mCount;
+    mCount++;
+    [self siftUp:mCount - 1];
+
+    return (mSlots[slot].generation << sSlotBits) | slot;
+
+} // end -addTimerWithDeadline:object:
+
+// *************************************************************************************************
+
+// Cancel a timer. Returns NO if the timer had already expired or been cancelled. O(log n).
+- (BOOL)cancelTimer:(NSUInteger)timerID
+{
+    NSUInteger slot = [self slotForTimer:timerID];
+
+    if (slot == NSNotFound)
+        return NO;
+
+    [[self removeSlot:slot] release];
+    return YES;
+
+} // end -cancelTimer:
+
+// *************************************************************************************************
+
+// Remove the earliest timer if it expires at or before time.
+// Returns its (autoreleased) object, or nil if no timer has expired. O(log n).
+- (id)popTimerDueBy:(NSTimeInterval)time
+{
+    if (mCount == 0 || mSlots[mHeap[0]].deadline > time)
+        return nil;
+
+    return [[self removeSlot:mHeap[0]] autorelease];
+
+} // end -popTimerDueBy:
+
+// *************************************************************************************************
+
+// Cancel all timers.
+- (void)removeAllTimers
+{
+    while (mCount > 0)
+    {
+        [[self removeSlot:mHeap[mCount - 1]] release];
+    }
+
+} // end -removeAllTimers
+
+// *************************************************************************************************
+
+// Returns the number of active timers.
+- (NSUInteger)count
+{
+    // return requested info
+    return mCount;
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the deadline of the earliest timer, or INFINITY if there are no timers. O(1).
+- (NSTimeInterval)nextDeadline
+{
+    if (mCount == 0)
+        return INFINITY;
+
+    return mSlots[mHeap[0]].deadline;
+
+} // end -nextDeadline
+
+// *************************************************************************************************
+
+// Returns the object of the earliest timer, or nil if there are no timers. O(1).
+- (id)nextObject
+{
+    if (mCount == 0)
+        return nil;
+
+    return mSlots[mHeap[0]].object;
+
+} // end -nextObject
+
+// *************************************************************************************************
+
+// Visit a heap position and its subtree while the deadlines are before time.
+- (void)enumerateFrom:(NSUInteger)index
+            dueBefore:(NSTimeInterval)time
+           usingBlock:(void (^)(id object, NSTimeInterval deadline))block
+{
+    // children never expire before their parent, so the whole subtree can be skipped
+    while (index < mCount && mSlots[mHeap[index]].deadline < time)
+    {
+        block(mSlots[mHeap[index]].object, mSlots[mHeap[index]].deadline);
+        [self enumerateFrom:(index * 2 + 1) dueBefore:time usingBlock:block];
+        index = index * 2 + 2;
+    }
+
+} // end -enumerateFrom:dueBefore:usingBlock:
+
+// *************************************************************************************************
+
+// Call block for every timer that expires before time, in no particular order.
+// Only the matching timers (and their direct children in the heap) are visited.
+- (void)enumerateTimersDueBefore:(NSTimeInterval)time
+                      usingBlock:(void (^)(id object, NSTimeInterval deadline))block
+{
+    [self enumerateFrom:0 dueBefore:time usingBlock:block];
+
+} // end -enumerateTimersDueBefore:usingBlock:
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_TimerQueue
+
+// end Cuppa_TimerQueue.m
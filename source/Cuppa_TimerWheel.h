@@ -0,0 +1,118 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_TimerWheel
+           - Tracks any number of active timers in a two level hashed timing wheel, so timers can
+             be started and cancelled in constant time however many are active.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+#ifndef _CUPPA_TIMERWHEEL_H
+#define _CUPPA_TIMERWHEEL_H
+
+#if !defined(__OBJC__)
+#error "Objective-C only source file."
+#endif
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimerBackend.h"
+
+// Constants
+
+enum
+{
+    // Each wheel level has 256 slots; one second per slot on the inner wheel and 256 seconds per
+    // slot on the outer wheel covers 18:12:16, so every brew between CUPPA_BEVY_BREW_TIME_MIN and
+    // CUPPA_BEVY_BREW_TIME_MAX (see Cuppa_Bevy.h) fits without an overflow list.
+    CUPPA_WHEEL_BITS = 8,
+    CUPPA_WHEEL_SLOTS = 1 << CUPPA_WHEEL_BITS,
+    CUPPA_WHEEL_LISTS = 2 * CUPPA_WHEEL_SLOTS
+};
+
+// Types
+
+// Storage for a single timer (internal to Cuppa_TimerWheel).
+typedef struct
+{
+    NSTimeInterval deadline; // absolute time when the timer expires
+    id object; // retained object associated with the timer
+    int64_t tick; // whole second of the deadline
+    NSUInteger generation; // incremented each time the node is reused
+    NSInteger list; // wheel slot list holding the node
+    NSInteger next; // next node in the slot list, or -1
+    NSInteger prev; // previous node in the slot list, or -1
+} Cuppa_WheelNode;
+
+// Class Interface
+
+@interface Cuppa_TimerWheel : NSObject <Cuppa_TimerBackend>
+{
+    Cuppa_WheelNode *mNodes; // timer storage, addressed by the low bits of the timer identifier
+    NSUInteger *mFreeNodes; // stack of unused node numbers
+    NSUInteger mFreeCount; // number of unused node numbers on the stack
+    NSUInteger mCapacity; // number of allocated nodes
+    NSUInteger mCount; // number of active timers
+    NSUInteger mInnerCount; // number of active timers on the inner wheel
+    NSInteger mLists[CUPPA_WHEEL_LISTS]; // first node in each slot, inner wheel then outer wheel
+    int64_t mCurrentTick; // the whole second the wheel has turned to
+    BOOL mUnturned; // flag: mCurrentTick is the earliest deadline added since the wheel was empty?
+    NSInteger mEarliest; // cached earliest node, or -1 if it needs to be found again
+}
+
+// ------ Life Cycle ------
+
+// Default initializer.
+- (id)init;
+
+// Deallocate.
+- (void)dealloc;
+
+// ------ Manipulators ------
+
+// Add a timer that expires at deadline, retaining object until the timer expires or is cancelled.
+// Returns an identifier for the timer (never CUPPA_TIMER_NONE). O(1).
+- (NSUInteger)addTimerWithDeadline:(NSTimeInterval)deadline object:(id)object;
+
+// Cancel a timer. Returns NO if the timer had already expired or been cancelled. O(1).
+- (BOOL)cancelTimer:(NSUInteger)timerID;
+
+// Remove the earliest timer if it expires at or before time.
+// Returns its (autoreleased) object, or nil if no timer has expired.
+- (id)popTimerDueBy:(NSTimeInterval)time;
+
+// Cancel all timers.
+- (void)removeAllTimers;
+
+// ------ Accessors ------
+
+// Returns the number of active timers.
+- (NSUInteger)count;
+
+// Returns the deadline of the earliest timer, or INFINITY if there are no timers.
+- (NSTimeInterval)nextDeadline;
+
+// Returns the object of the earliest timer, or nil if there are no timers.
+- (id)nextObject;
+
+// Call block for every timer that expires before time, in no particular order.
+// Only the wheel slots up to time are visited, unless time is more than a turn of the outer
+// wheel away. The block must not add or remove timers.
+- (void)enumerateTimersDueBefore:(NSTimeInterval)time
+                      usingBlock:(void (^)(id object, NSTimeInterval deadline))block;
+
+@end // @interface Cuppa_TimerWheel
+
+// *************************************************************************************************
+
+#endif // _CUPPA_TIMERWHEEL_H
+
+// end Cuppa_TimerWheel.h
@@ -0,0 +1,544 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Class:    Cuppa_TimerWheel
+           - Tracks any number of active timers in a two level hashed timing wheel, so timers can
+             be started and cancelled in constant time however many are active.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimerWheel.h"
+
+// Internal Constants
+
+static const NSUInteger sInitialCapacity = 16; // nodes allocated by the first timer
+static const int sNodeBits = 32; // low bits of a timer identifier hold the node number
+static const int64_t sSlotMask = CUPPA_WHEEL_SLOTS - 1; // slot number within a wheel
+
+// Returns the whole second containing a time.
+static int64_t TickForTime(NSTimeInterval time)
+{
+    return (int64_t)floor(time);
+}
+
+// Code!
+
+@implementation Cuppa_TimerWheel
+;
+
+// *************************************************************************************************
+
+// Default initializer.
+- (id)init
+{
+    int i; // loop counter
+
+    self = [super init];
+    mNodes = NULL;
+    mFreeNodes = NULL;
+    mFreeCount = 0;
+    mCapacity = 0;
+    mCount = 0;
+    mInnerCount = 0;
+    for (i = 0; i < CUPPA_WHEEL_LISTS; i++)
+        mLists[i] = -1;
+    mCurrentTick = 0;
+    mUnturned = NO;
+    mEarliest = -1;
+    return self;
+
+} // end -init
+
+// *************************************************************************************************
+
+// Deallocate.
+- (void)dealloc
+{
+    // release our hold on the timer objects
+    [self removeAllTimers];
+    free(mNodes);
+    free(mFreeNodes);
+    [super dealloc];
+
+} // end -dealloc
+
+// *************************************************************************************************
+
+// Make room for at least one more timer.
+- (void)growIfNeeded
+{
+    NSUInteger i; // loop counter
+    NSUInteger capacity; // new number of nodes
+
+    if (mFreeCount > 0)
+        return;
+
+    capacity = (mCapacity == 0) ? sInitialCapacity : (mCapacity * 2);
+    mNodes = realloc(mNodes, capacity * sizeof(Cuppa_WheelNode));
+    mFreeNodes = realloc(mFreeNodes, capacity * sizeof(NSUInteger));
+    NSAssert(mNodes && mFreeNodes, @"Out of memory for timers.\n");
+
+    // push the new nodes so the lowest numbers are used first
+    for (i = capacity; i > mCapacity; i--)
+    {
+        mNodes[i - 1].object = nil;
+        mNodes[i - 1].generation = 0;
+        mFreeNodes[mFreeCount++] = i - 1;
+    }
+    mCapacity = capacity;
+
+} // end -growIfNeeded
+
+// *************************************************************************************************
+
+// Returns the node for a timer identifier, or -1 if the timer is no longer active.
+- (NSInteger)nodeForTimer:(NSUInteger)timerID
+{
+    NSUInteger node = timerID & ((1UL << sNodeBits) - 1);
+
+    if (node >= mCapacity || mNodes[node].object == nil ||
+        mNodes[node].generation != (timerID >> sNodeBits))
+        return -1;
+
+    return (NSInteger)node;
+
+} // end -nodeForTimer:
+
+// *************************************************************************************************
+
+// Add a node to the slot list for its deadline.
+- (void)linkNode:(NSInteger)node
+{
+    int64_t tick = mNodes[node].tick;
+    NSInteger list; // slot list for the node
+
+    // timers that are already due stay in the current slot until they are popped
+    if (tick < mCurrentTick)
+        tick = mCurrentTick;
+
+    if ((tick >> CUPPA_WHEEL_BITS) == (mCurrentTick >> CUPPA_WHEEL_BITS))
+    {
+        // due within the current turn of the inner wheel
+        list = (NSInteger)(tick & sSlotMask);
+        mInnerCount++;
+    }
+    else
+    {
+        // due on a later turn; timers a whole turn of the outer wheel away share its slots
+        list = CUPPA_WHEEL_SLOTS + (NSInteger)((tick >> CUPPA_WHEEL_BITS) & sSlotMask);
+    }
+
+    mNodes[node].list = list;
+    mNodes[node].prev = -1;
+    mNodes[node].next = mLists[list];
+    if (mLists[list] >= 0)
+        mNodes[mLists[list]].prev = node;
+    mLists[list] = node;
+
+} // end -linkNode:
+
+// *************************************************************************************************
+
+// Remove a node from its slot list.
+- (void)unlinkNode:(NSInteger)node
+{
+    NSInteger list = mNodes[node].list;
+
+    if (mNodes[node].prev >= 0)
+        mNodes[mNodes[node].prev].next = mNodes[node].next;
+    else
+        mLists[list] = mNodes[node].next;
+    if (mNodes[node].next >= 0)
+        mNodes[mNodes[node].next].prev = mNodes[node].prev;
+
+    if (list < CUPPA_WHEEL_SLOTS)
+        mInnerCount--;
+
+} // end -unlinkNode:
+
+// *************************************************************************************************
+
+// Take a node off the wheel and return it to the free stack. Returns the node's object, which
+// the caller now owns.
+- (id)removeNode:(NSInteger)node
+{
+    id object = mNodes[node].object;
+
+    [self unlinkNode:node];
+    mNodes[node].object = nil;
+    mFreeNodes[mFreeCount++] = (NSUInteger)node;
+    mCount--;
+
+    if (node == mEarliest)
+        mEarliest = -1;
+
+    return object;
+
+} // end -removeNode:
+
+// *************************************************************************************************
+
+// Move a wheel that has not turned since it was empty back to an earlier whole second, relinking
+// every timer. O(n), but each time only while timers are added in falling order before the first
+// pop.
+- (void)rebaseToTick:(int64_t)tick
+{
+    NSUInteger node; // loop counter
+
+    mCurrentTick = tick;
+    for (node = 0; node < mCapacity; node++)
+    {
+        if (mNodes[node].object != nil)
+        {
+            [self unlinkNode:(NSInteger)node];
+            [self linkNode:(NSInteger)node];
+        }
+    }
+
+} // end -rebaseToTick:
+
+// *************************************************************************************************
+
+// Turn the wheel forward to a whole second, cascading timers down from the outer wheel.
+// Slots are passed over a turn of the inner wheel at a time, so a long sleep costs little.
+- (void)turnToTick:(int64_t)target
+{
+    int64_t next; // tick the wheel turns to next
+    int64_t tick; // slot being passed over
+    NSInteger node, following; // nodes being moved
+    NSInteger carried; // due timers carried forward to the new current slot
+
+    while (mCurrentTick < target)
+    {
+        // an empty wheel can jump straight there
+        if (mCount == 0)
+        {
+            mCurrentTick = target;
+            break;
+        }
+
+        // turn to the end of this turn of the inner wheel, or to target if sooner
+        next = ((mCurrentTick >> CUPPA_WHEEL_BITS) + 1) << CUPPA_WHEEL_BITS;
+        if (next > target)
+            next = target;
+
+        // anything in the slots passed over is already due, so it moves along with the wheel
+        carried = -1;
+        for (tick = mCurrentTick; tick < next && mInnerCount > 0; tick++)
+        {
+            node = mLists[tick & sSlotMask];
+            mLists[tick & sSlotMask] = -1;
+            while (node >= 0)
+            {
+                following = mNodes[node].next;
+                mNodes[node].next = carried;
+                carried = node;
+                mInnerCount--;
+                node = following;
+            }
+        }
+        mCurrentTick = next;
+
+        // starting a new turn of the inner wheel, so bring its timers down from the outer wheel
+        if ((mCurrentTick & sSlotMask) == 0)
+        {
+            node = mLists[CUPPA_WHEEL_SLOTS + ((mCurrentTick >> CUPPA_WHEEL_BITS) & sSlotMask)];
+            while (node >= 0)
+            {
+                following = mNodes[node].next;
+                if ((mNodes[node].tick >> CUPPA_WHEEL_BITS) == (mCurrentTick >> CUPPA_WHEEL_BITS))
+                {
+                    [self unlinkNode:node];
+                    [self linkNode:node];
+                }
+                node = following;
+            }
+        }
+
+        for (node = carried; node >= 0; node = following)
+        {
+            following = mNodes[node].next;
+            [self linkNode:node];
+        }
+    }
+
+} // end -turnToTick:
+
+// *************************************************************************************************
+
+// Returns the earliest node in a slot list, or -1 if it is empty. If block is not negative, only
+// nodes due on that turn of the inner wheel are considered.
+- (NSInteger)earliestInList:(NSInteger)list block:(int64_t)block
+{
+    NSInteger node; // node being checked
+    NSInteger best = -1; // earliest node so far
+
+    for (node = mLists[list]; node >= 0; node = mNodes[node].next)
+    {
+        if (block >= 0 && (mNodes[node].tick >> CUPPA_WHEEL_BITS) != block)
+            continue;
+        if (best < 0 || mNodes[node].deadline < mNodes[best].deadline)
+            best = node;
+    }
+
+    return best;
+
+} // end -earliestInList:block:
+
+// *************************************************************************************************
+
+// Returns the node with the earliest deadline, or -1 if there are no timers.
+- (NSInteger)earliestNode
+{
+    int64_t slot; // slot being checked
+    int64_t block; // turn of the inner wheel being checked
+
+    if (mEarliest >= 0 || mCount == 0)
+        return mEarliest;
+
+    if (mInnerCount > 0)
+    {
+        // the first occupied slot of the inner wheel holds the earliest timer
+        for (slot = mCurrentTick & sSlotMask; slot < CUPPA_WHEEL_SLOTS && mEarliest < 0; slot++)
+            mEarliest = [self earliestInList:(NSInteger)slot block:-1];
+    }
+    else
+    {
+        // otherwise it is on the first occupied turn of the outer wheel
+        for (block = (mCurrentTick >> CUPPA_WHEEL_BITS) + 1;
+             block < (mCurrentTick >> CUPPA_WHEEL_BITS) + CUPPA_WHEEL_SLOTS && mEarliest < 0;
+             block++)
+            mEarliest = [self earliestInList:(CUPPA_WHEEL_SLOTS + (NSInteger)(block & sSlotMask))
+                                       block:block];
+
+        // failing that, every timer is at least a whole turn of the outer wheel away
+        if (mEarliest < 0)
+        {
+            for (slot = 0; slot < CUPPA_WHEEL_SLOTS; slot++)
+            {
+                NSInteger node = [self earliestInList:(CUPPA_WHEEL_SLOTS + (NSInteger)slot)
+                                                block:-1];
+                if (node >= 0 &&
+                    (mEarliest < 0 || mNodes[node].deadline < mNodes[mEarliest].deadline))
+                    mEarliest = node;
+            }
+        }
+    }
+
+    return mEarliest;
+
+} // end -earliestNode
+
+// *************************************************************************************************
+
+// Add a timer that expires at deadline, retaining object until the timer expires or is cancelled.
+// Returns an identifier for the timer (never CUPPA_TIMER_NONE). O(1).
+- (NSUInteger)addTimerWithDeadline:(NSTimeInterval)deadline object:(id)object
+{
+    NSInteger node; // storage for the new timer
+
+    // parameter checks
+    NSAssert(object != nil, @"Bad timer object parameter.\n");
+
+    [self growIfNeeded];
+    node = (NSInteger)mFreeNodes[--mFreeCount];
+
+    // an empty wheel has nothing to turn past, so start it at the first deadline rather than
+    // turning it a turn at a time from wherever it stopped (from zero, days of uptime away);
+    // until it turns, that start is only a guess, so earlier deadlines move it back
+    if (mCount == 0 && TickForTime(deadline) > mCurrentTick)
+    {
+        mCurrentTick = TickForTime(deadline);
+        mUnturned = YES;
+    }
+    else if (mUnturned && TickForTime(deadline) < mCurrentTick)
+    {
+        [self rebaseToTick:TickForTime(deadline)];
+    }
+
+    // fill in the node, bumping the generation so old identifiers for it go stale
+    mNodes[node].deadline = deadline;
+    mNodes[node].object = [object retain];
+    mNodes[node].tick = TickForTime(deadline);
+    mNodes[node].generation = (mNodes[node].generation + 1) & ((1UL << sNodeBits) - 1);
+    if (mNodes[node].generation == 0)
+        mNodes[node].generation = 1;
+
+    [self linkNode:node];
+    mCount++;
+
+    // keep the cached earliest timer up to date
+    if (mEarliest >= 0 && deadline < mNodes[mEarliest].deadline)
+        mEarliest = node;
+
+    return (mNodes[node].generation << sNodeBits) | (NSUInteger)node;
+
+} // end -addTimerWithDeadline:object:
+
+// *************************************************************************************************
+
+// Cancel a timer. Returns NO if the timer had already expired or been cancelled. O(1).
+- (BOOL)cancelTimer:(NSUInteger)timerID
+{
+    NSInteger node = [self nodeForTimer:timerID];
+
+    if (node < 0)
+        return NO;
+
+    [[self removeNode:node] release];
+    return YES;
+
+} // end -cancelTimer:
+
+// *************************************************************************************************
+
+// Remove the earliest timer if it expires at or before time.
+// Returns its (autoreleased) object, or nil if no timer has expired.
+- (id)popTimerDueBy:(NSTimeInterval)time
+{
+    NSInteger node; // earliest timer
+
+    // the current time settles where an unturned wheel starts
+    if (mUnturned && TickForTime(time) < mCurrentTick)
+        [self rebaseToTick:TickForTime(time)];
+    mUnturned = NO;
+    [self turnToTick:TickForTime(time)];
+
+    node = [self earliestNode];
+    if (node < 0 || mNodes[node].deadline > time)
+        return nil;
+
+    return [[self removeNode:node] autorelease];
+
+} // end -popTimerDueBy:
+
+// *************************************************************************************************
+
+// Cancel all timers.
+- (void)removeAllTimers
+{
+    NSUInteger node; // loop counter
+    int i; // loop counter
+
+    for (node = 0; node < mCapacity && mCount > 0; node++)
+    {
+        if (mNodes[node].object != nil)
+            [[self removeNode:(NSInteger)node] release];
+    }
+
+    for (i = 0; i < CUPPA_WHEEL_LISTS; i++)
+        mLists[i] = -1;
+    mInnerCount = 0;
+    mEarliest = -1;
+
+} // end -removeAllTimers
+
+// *************************************************************************************************
+
+// Returns the number of active timers.
+- (NSUInteger)count
+{
+    // return requested info
+    return mCount;
+
+} // end -count
+
+// *************************************************************************************************
+
+// Returns the deadline of the earliest timer, or INFINITY if there are no timers.
+- (NSTimeInterval)nextDeadline
+{
+    NSInteger node = [self earliestNode];
+
+    if (node < 0)
+        return INFINITY;
+
+    return mNodes[node].deadline;
+
+} // end -nextDeadline
+
+// *************************************************************************************************
+
+// Returns the object of the earliest timer, or nil if there are no timers.
+- (id)nextObject
+{
+    NSInteger node = [self earliestNode];
+
+    if (node < 0)
+        return nil;
+
+    return mNodes[node].object;
+
+} // end -nextObject
+
+// *************************************************************************************************
+
+// Call block for every timer that expires before time, in no particular order.
+// Only the wheel slots up to time are visited, unless time is more than a turn of the outer
+// wheel away. The block must not add or remove timers.
+- (void)enumerateTimersDueBefore:(NSTimeInterval)time
+                      usingBlock:(void (^)(id object, NSTimeInterval deadline))block
+{
+    NSUInteger i; // loop counter
+    NSInteger node; // node being checked
+    int64_t last; // last whole second to visit
+    int64_t tick; // slot being visited
+    int64_t turn; // turn of the inner wheel being visited
+
+    if (mCount == 0)
+        return;
+
+    if (isinf(time) ||
+        TickForTime(time) - mCurrentTick >= (int64_t)CUPPA_WHEEL_SLOTS * (CUPPA_WHEEL_SLOTS - 1))
+    {
+        // too far ahead to be worth walking the wheel, so just visit every timer
+        for (i = 0; i < mCapacity; i++)
+        {
+            if (mNodes[i].object != nil && mNodes[i].deadline < time)
+                block(mNodes[i].object, mNodes[i].deadline);
+        }
+        return;
+    }
+
+    last = TickForTime(time);
+
+    // inner wheel, from the current slot to the end of this turn
+    for (tick = mCurrentTick;
+         mInnerCount > 0 && tick <= last &&
+         (tick >> CUPPA_WHEEL_BITS) == (mCurrentTick >> CUPPA_WHEEL_BITS);
+         tick++)
+    {
+        for (node = mLists[tick & sSlotMask]; node >= 0; node = mNodes[node].next)
+        {
+            if (mNodes[node].deadline < time)
+                block(mNodes[node].object, mNodes[node].deadline);
+        }
+    }
+
+    // outer wheel, for the later turns up to time
+    for (turn = (mCurrentTick >> CUPPA_WHEEL_BITS) + 1; turn <= (last >> CUPPA_WHEEL_BITS); turn++)
+    {
+        for (node = mLists[CUPPA_WHEEL_SLOTS + (turn & sSlotMask)]; node >= 0; node = mNodes[node].next)
+        {
+            if ((mNodes[node].tick >> CUPPA_WHEEL_BITS) == turn && mNodes[node].deadline < time)
+                block(mNodes[node].object, mNodes[node].deadline);
+        }
+    }
+
+} // end -enumerateTimersDueBefore:usingBlock:
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_TimerWheel
+
+// end Cuppa_TimerWheel.m
@@ -0,0 +1,404 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_AlarmSoundsTests
+           - Checks alarm sounds are read once, converted to the output format or streamed by
+             length, kept once however many places they come from, forgotten least recent first,
+             and copied to our folder by content hash, against sounds written to a scratch folder.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AlarmSounds.h"
+#import "Cuppa_AudioBuffer.h"
+#import "Cuppa_AudioCues.h"
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioRecorder.h"
+#import "Cuppa_Clock.h"
+
+// Internal Constants
+
+// Frames per second sounds are played at
+static const double sSampleRate = 44100.0;
+
+// Frames per second the sounds are written at (so they have to be converted)
+static const double sFileRate = 22050.0;
+
+// How long to wait for an import before giving up
+static const NSTimeInterval sTimeout = 10.0;
+
+// Code!
+
+// Appends the low count bytes of value to data, big-endian.
+static void CuppaTestAppendBig(NSMutableData *data, uint64_t value, NSUInteger count)
+{
+    uint8_t byte; // current byte
+    NSUInteger i; // loop counter
+
+    for (i = count; i > 0; i--)
+    {
+        byte = (uint8_t)(value >> ((i - 1) * 8));
+        [data appendBytes:&byte length:1];
+    }
+}
+
+// Appends value to data as an 80-bit IEEE extended float, as the AIFF sample rate is stored.
+static void CuppaTestAppendExtended(NSMutableData *data, double value)
+{
+    double fraction; // value is fraction * 2^exponent, with fraction in [0.5, 1)
+    int exponent; // power of two
+
+    fraction = frexp(value, &exponent);
+    CuppaTestAppendBig(data, (uint64_t)(exponent - 1 + 16383), 2);
+    CuppaTestAppendBig(data, (uint64_t)ldexp(fraction, 64), 8);
+}
+
+// *************************************************************************************************
+
+@interface Cuppa_AlarmSoundsTests : XCTestCase
+{
+    NSString *mFolder; // scratch folder the sounds are written to
+    Cuppa_Clock *mClock; // virtual clock the sounds are played on
+    Cuppa_AudioRecorder *mRecorder; // stands in for the audio output
+    Cuppa_AudioCues *mCues; // plays the sounds
+    Cuppa_AlarmSounds *mSounds; // sounds under test
+}
+@end
+
+@implementation Cuppa_AlarmSoundsTests
+;
+
+// *************************************************************************************************
+
+// Make an empty set of sounds in a fresh scratch folder, played through the recorder.
+- (void)setUp
+{
+    [super setUp];
+    mFolder = [[NSTemporaryDirectory() stringByAppendingPathComponent:
+                [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+    XCTAssertTrue([[NSFileManager defaultManager] createDirectoryAtPath:mFolder
+                                            withIntermediateDirectories:YES
+                                                             attributes:nil
+                                                                  error:NULL]);
+    mClock = [[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_VIRTUAL];
+    mRecorder = [[Cuppa_AudioRecorder alloc] initWithSampleRate:sSampleRate];
+    mCues = [[Cuppa_AudioCues alloc] initWithOutput:mRecorder clock:mClock];
+    mSounds = [[Cuppa_AlarmSounds alloc]
+               initWithAudio:mCues
+                      folder:[mFolder stringByAppendingPathComponent:@"Alarm Sounds"]];
+}
+
+// *************************************************************************************************
+
+// Release the sounds and everything behind them, and remove the scratch folder.
+- (void)tearDown
+{
+    [mSounds release];
+    [mCues stopAll];
+    [mCues release];
+    [mRecorder release];
+    [mClock release];
+    [[NSFileManager defaultManager] removeItemAtPath:mFolder error:NULL];
+    [mFolder release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Returns a mono 16-bit AIFF sound of a tone at pitch, seconds long.
+- (NSData *)soundOfPitch:(double)pitch seconds:(double)seconds
+{
+    NSMutableData *data = [NSMutableData data]; // the file
+    NSUInteger frameCount = (NSUInteger)(seconds * sFileRate); // frames in the sound
+    NSUInteger frame; // loop counter
+
+    [data appendBytes:"FORM" length:4];
+    CuppaTestAppendBig(data, 46 + (frameCount * 2), 4);
+    [data appendBytes:"AIFF" length:4];
+    [data appendBytes:"COMM" length:4];
+    CuppaTestAppendBig(data, 18, 4);
+    CuppaTestAppendBig(data, 1, 2);
+    CuppaTestAppendBig(data, frameCount, 4);
+    CuppaTestAppendBig(data, 16, 2);
+    CuppaTestAppendExtended(data, sFileRate);
+    [data appendBytes:"SSND" length:4];
+    CuppaTestAppendBig(data, 8 + (frameCount * 2), 4);
+    CuppaTestAppendBig(data, 0, 4);
+    CuppaTestAppendBig(data, 0, 4);
+    for (frame = 0; frame < frameCount; frame++)
+    {
+        CuppaTestAppendBig(data, (uint16_t)(int16_t)(16000.0 * sin(2.0 * M_PI * pitch * frame /
+                                                                  sFileRate)), 2);
+    }
+    return data;
+}
+
+// *************************************************************************************************
+
+// Writes data to name in the scratch folder, and returns its path.
+- (NSString *)writeData:(NSData *)data name:(NSString *)name
+{
+    NSString *path = [mFolder stringByAppendingPathComponent:name]; // where it goes
+
+    XCTAssertTrue([data writeToFile:path atomically:YES]);
+    return path;
+}
+
+// *************************************************************************************************
+
+// Imports the sound at path, waiting for it, and returns the name of its cue (or nil).
+- (NSString *)prepare:(NSString *)path
+{
+    XCTestExpectation *done = [self expectationWithDescription:path]; // import finished
+    __block NSString *result = nil; // cue handed back
+
+    [mSounds prepareSoundAtPath:path completion:^(NSString *cue) {
+        XCTAssertTrue([NSThread isMainThread]);
+        result = [cue copy];
+        [done fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:sTimeout handler:nil];
+    return [result autorelease];
+}
+
+// *************************************************************************************************
+
+// Copies the sound at path to our folder, waiting for it, and returns the copy's path (or nil).
+- (NSString *)keep:(NSString *)path
+{
+    XCTestExpectation *done = [self expectationWithDescription:path]; // copy finished
+    __block NSString *result = nil; // copy handed back
+
+    [mSounds keepSoundAtPath:path completion:^(NSString *copy) {
+        XCTAssertTrue([NSThread isMainThread]);
+        result = [copy copy];
+        [done fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:sTimeout handler:nil];
+    return [result autorelease];
+}
+
+// *************************************************************************************************
+
+// A short sound is converted to the output format, a long one is streamed as is, and one that is
+// too long or isn't a sound at all is turned away.
+- (void)testSoundWithData
+{
+    NSData *data; // file contents
+    id sound; // ready to be loaded as a cue
+
+    data = [self soundOfPitch:440.0 seconds:1.0];
+    sound = [Cuppa_AlarmSounds soundWithData:data sampleRate:sSampleRate channelCount:2];
+    XCTAssertTrue([sound isKindOfClass:[Cuppa_AudioBuffer class]]);
+    XCTAssertEqual([sound sampleRate], sSampleRate);
+    XCTAssertEqual([sound channelCount], 2u);
+    XCTAssertEqual([sound frameCount], 44100u);
+
+    data = [self soundOfPitch:440.0 seconds:(CUPPA_AUDIOCUES_PRELOAD_SECONDS + 1)];
+    sound = [Cuppa_AlarmSounds soundWithData:data sampleRate:sSampleRate channelCount:2];
+    XCTAssertTrue(sound == data);
+
+    data = [self soundOfPitch:440.0 seconds:(CUPPA_ALARMSOUNDS_MAX_SECONDS + 1)];
+    XCTAssertNil([Cuppa_AlarmSounds soundWithData:data sampleRate:sSampleRate channelCount:2]);
+    XCTAssertNil([Cuppa_AlarmSounds soundWithData:[self soundOfPitch:440.0 seconds:0.0]
+                                       sampleRate:sSampleRate
+                                     channelCount:2]);
+    data = [@"Not a sound" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertNil([Cuppa_AlarmSounds soundWithData:data sampleRate:sSampleRate channelCount:2]);
+}
+
+// *************************************************************************************************
+
+// A prepared sound is ready to play without reading its file again.
+- (void)testPrepare
+{
+    NSString *path; // the sound
+    NSString *cue; // its cue
+    __block NSString *again = nil; // its cue, prepared again
+
+    path = [self writeData:[self soundOfPitch:440.0 seconds:0.5] name:@"Tone.aiff"];
+    cue = [self prepare:path];
+    XCTAssertNotNil(cue);
+    XCTAssertEqualObjects([mSounds cueForPath:path], cue);
+    XCTAssertEqual([[mSounds hashForPath:path] length], 64u);
+    XCTAssertEqual([mSounds count], 1u);
+    XCTAssertEqual([mSounds pendingCount], 0u);
+    XCTAssertEqual([[mCues bufferForCue:cue] frameCount], 22050u);
+
+    // once ready the original isn't needed, and the handler is called straight away
+    XCTAssertTrue([[NSFileManager defaultManager] removeItemAtPath:path error:NULL]);
+    [mSounds prepareSoundAtPath:path completion:^(NSString *ready) {
+        again = ready;
+    }];
+    XCTAssertEqualObjects(again, cue);
+    XCTAssertTrue([mCues scheduleCue:cue atTime:1.0 tag:1]);
+}
+
+// *************************************************************************************************
+
+// A file is only read once, however many times it is asked for while it is being imported.
+- (void)testPendingCoalesced
+{
+    NSString *path; // the sound
+    XCTestExpectation *first; // first import finished
+    XCTestExpectation *second; // second import finished
+    __block NSString *firstCue = nil; // cue handed to the first handler
+    __block NSString *secondCue = nil; // cue handed to the second handler
+
+    path = [self writeData:[self soundOfPitch:440.0 seconds:0.5] name:@"Tone.aiff"];
+    first = [self expectationWithDescription:@"first"];
+    second = [self expectationWithDescription:@"second"];
+    [mSounds prepareSoundAtPath:path completion:^(NSString *cue) {
+        firstCue = [cue copy];
+        [first fulfill];
+    }];
+    [mSounds prepareSoundAtPath:path completion:^(NSString *cue) {
+        secondCue = [cue copy];
+        [second fulfill];
+    }];
+    XCTAssertEqual([mSounds pendingCount], 1u);
+    [self waitForExpectationsWithTimeout:sTimeout handler:nil];
+
+    XCTAssertNotNil(firstCue);
+    XCTAssertEqualObjects(firstCue, secondCue);
+    XCTAssertEqual([mSounds pendingCount], 0u);
+    XCTAssertEqual([mSounds count], 1u);
+    [firstCue release];
+    [secondCue release];
+}
+
+// *************************************************************************************************
+
+// The same sound from two places is kept once, as one cue.
+- (void)testSameSoundKeptOnce
+{
+    NSData *data = [self soundOfPitch:440.0 seconds:0.5]; // the sound
+    NSString *first; // one copy of it
+    NSString *second; // another
+
+    first = [self writeData:data name:@"Tone.aiff"];
+    second = [self writeData:data name:@"Same Tone.aiff"];
+    XCTAssertEqualObjects([self prepare:first], [self prepare:second]);
+    XCTAssertEqualObjects([mSounds hashForPath:first], [mSounds hashForPath:second]);
+    XCTAssertEqualObjects([mSounds hashForPath:first], [Cuppa_AlarmSounds hashForData:data]);
+    XCTAssertEqual([mSounds count], 1u);
+}
+
+// *************************************************************************************************
+
+// A file that isn't a sound, or isn't there, is turned away and leaves nothing behind.
+- (void)testBadSound
+{
+    NSString *path; // the file
+
+    path = [self writeData:[@"Not a sound" dataUsingEncoding:NSUTF8StringEncoding]
+                      name:@"Notes.aiff"];
+    XCTAssertNil([self prepare:path]);
+    XCTAssertNil([self prepare:[mFolder stringByAppendingPathComponent:@"Missing.aiff"]]);
+    XCTAssertNil([mSounds hashForPath:path]);
+    XCTAssertEqual([mSounds count], 0u);
+    XCTAssertEqual([mSounds pendingCount], 0u);
+}
+
+// *************************************************************************************************
+
+// Only so many sounds are kept, and the one played least recently is forgotten first.
+- (void)testLeastRecentForgotten
+{
+    NSMutableArray *paths = [NSMutableArray array]; // the sounds
+    NSMutableArray *cues = [NSMutableArray array]; // their cues
+    NSString *path; // current sound
+    NSUInteger i; // loop counter
+
+    for (i = 0; i <= CUPPA_ALARMSOUNDS_KEPT; i++)
+    {
+        path = [self writeData:[self soundOfPitch:(220.0 + (i * 110.0)) seconds:0.25]
+                          name:[NSString stringWithFormat:@"Tone %lu.aiff", (unsigned long)i]];
+        [paths addObject:path];
+        if (i < CUPPA_ALARMSOUNDS_KEPT)
+            [cues addObject:[self prepare:path]];
+    }
+    XCTAssertEqual([mSounds count], (NSUInteger)CUPPA_ALARMSOUNDS_KEPT);
+
+    // playing the first again makes the second the least recent
+    XCTAssertEqualObjects([self prepare:[paths objectAtIndex:0]], [cues objectAtIndex:0]);
+    XCTAssertNotNil([self prepare:[paths lastObject]]);
+    XCTAssertEqual([mSounds count], (NSUInteger)CUPPA_ALARMSOUNDS_KEPT);
+    XCTAssertNotNil([mSounds cueForPath:[paths objectAtIndex:0]]);
+    XCTAssertNil([mSounds cueForPath:[paths objectAtIndex:1]]);
+    XCTAssertNil([mCues bufferForCue:[cues objectAtIndex:1]]);
+
+    // a forgotten sound is simply imported again
+    XCTAssertEqualObjects([self prepare:[paths objectAtIndex:1]], [cues objectAtIndex:1]);
+    XCTAssertNil([mSounds cueForPath:[paths objectAtIndex:2]]);
+}
+
+// *************************************************************************************************
+
+// A long sound is streamed from its file rather than decoded, and still plays.
+- (void)testLongSoundStreamed
+{
+    NSString *path; // the sound
+    NSString *cue; // its cue
+    const float *samples; // everything recorded
+    BOOL sounding = NO; // whether anything was recorded
+    NSUInteger i; // loop counter
+
+    path = [self writeData:[self soundOfPitch:440.0 seconds:(CUPPA_AUDIOCUES_PRELOAD_SECONDS + 1)]
+                      name:@"Long Tone.aiff"];
+    cue = [self prepare:path];
+    XCTAssertNotNil(cue);
+    XCTAssertNil([mCues bufferForCue:cue]);
+
+    XCTAssertTrue([mCues scheduleCue:cue atTime:0.5 tag:1]);
+    [mCues runUntil:1.5];
+    samples = [[mRecorder samples] bytes];
+    for (i = 0; i < [mRecorder frameCount] * 2; i++)
+    {
+        sounding = sounding || (samples[i] != 0.0f);
+    }
+    XCTAssertTrue(sounding);
+}
+
+// *************************************************************************************************
+
+// A chosen sound is copied to our folder under its content hash, and plays from the copy once the
+// original has gone.
+- (void)testKeepCopies
+{
+    NSData *data = [self soundOfPitch:440.0 seconds:0.5]; // the sound
+    NSString *path; // the original
+    NSString *copy; // the copy in our folder
+    NSString *name; // the name the copy should have
+
+    path = [self writeData:data name:@"Tone.aiff"];
+    copy = [self keep:path];
+    name = [[Cuppa_AlarmSounds hashForData:data] stringByAppendingPathExtension:@"aiff"];
+    XCTAssertEqualObjects(copy, [[mSounds folder] stringByAppendingPathComponent:name]);
+    XCTAssertEqualObjects([NSData dataWithContentsOfFile:copy], data);
+    XCTAssertNotNil([mSounds cueForPath:copy]);
+    XCTAssertEqual([mSounds count], 1u);
+
+    // the same sound kept again finds the copy there already
+    XCTAssertTrue([[NSFileManager defaultManager] removeItemAtPath:path error:NULL]);
+    path = [self writeData:data name:@"Same Tone.aiff"];
+    XCTAssertEqualObjects([self keep:path], copy);
+    XCTAssertNil([self keep:[mFolder stringByAppendingPathComponent:@"Missing.aiff"]]);
+    XCTAssertEqual([mSounds count], 1u);
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AlarmSoundsTests
+
+// end Cuppa_AlarmSoundsTests.m
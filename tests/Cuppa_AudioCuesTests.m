@@ -0,0 +1,241 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_AudioCuesTests
+           - Checks scheduled cues land on the exact frame of their clock time, however far ahead
+             they were scheduled and whether decoded whole or streamed, by rendering a timeline
+             offline on a virtual clock.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AIFFDecoder.h"
+#import "Cuppa_AudioBuffer.h"
+#import "Cuppa_AudioCues.h"
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioRecorder.h"
+#import "Cuppa_Clock.h"
+
+// Internal Constants
+
+// Frames per second the timeline is rendered at
+static const double sSampleRate = 44100.0;
+
+// Frames in the click cue (shorter than the gap between any two cues)
+static const NSUInteger sClickFrames = 64;
+
+// Code!
+
+@interface Cuppa_AudioCuesTests : XCTestCase
+{
+    Cuppa_Clock *mClock; // virtual clock the cues are scheduled on
+    Cuppa_AudioRecorder *mRecorder; // records the timeline
+    Cuppa_AudioCues *mCues; // cue player under test
+}
+@end
+
+@implementation Cuppa_AudioCuesTests
+;
+
+// *************************************************************************************************
+
+// Make a cue player recording on a fresh virtual clock, with a click to play.
+- (void)setUp
+{
+    float samples[sClickFrames * 2]; // the click
+    Cuppa_AudioBuffer *click; // as a sound
+    NSUInteger i; // loop counter
+
+    [super setUp];
+    mClock = [[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_VIRTUAL];
+    mRecorder = [[Cuppa_AudioRecorder alloc] initWithSampleRate:sSampleRate];
+    mCues = [[Cuppa_AudioCues alloc] initWithOutput:mRecorder clock:mClock];
+    for (i = 0; i < sClickFrames * 2; i++)
+    {
+        samples[i] = 0.5f;
+    }
+    click = [[[Cuppa_AudioBuffer alloc] initWithSamples:samples
+                                             frameCount:sClickFrames
+                                           channelCount:2
+                                             sampleRate:sSampleRate] autorelease];
+    [mCues addCue:@"click" buffer:click];
+}
+
+// *************************************************************************************************
+
+// Release the cue player, recorder and clock.
+- (void)tearDown
+{
+    [mCues stopAll];
+    [mCues release];
+    [mRecorder release];
+    [mClock release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Returns the frames of the recording where a cue starts (silence, then sound).
+- (NSArray *)onsets
+{
+    const float *samples = [[mRecorder samples] bytes]; // everything recorded
+    NSMutableArray *onsets = [NSMutableArray array]; // frames found
+    float last = 0.0f; // left channel of the frame before
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < [mRecorder frameCount]; i++)
+    {
+        if (last == 0.0f && samples[i * 2] != 0.0f)
+            [onsets addObject:[NSNumber numberWithUnsignedInteger:i]];
+        last = samples[i * 2];
+    }
+    return onsets;
+}
+
+// *************************************************************************************************
+
+// Cues land on the frame of their clock time, whether handed to the mixer when scheduled or later
+// as their time nears, and however the frames fall into renders.
+- (void)testOnsetsOnExactFrame
+{
+    NSUInteger frames[] = { 22050, 44101, 100333, 150000, 300007 }; // frames to play the cue at
+    NSMutableArray *expected = [NSMutableArray array]; // onsets expected
+    NSUInteger recorded; // frames recorded
+    NSUInteger i; // loop counter
+
+    // the first cues are due within the hand-over time, so they start the output at time 0
+    for (i = 0; i < sizeof(frames) / sizeof(frames[0]); i++)
+    {
+        XCTAssertTrue([mCues scheduleCue:@"click" atTime:(frames[i] / sSampleRate) tag:1]);
+        [expected addObject:[NSNumber numberWithUnsignedInteger:frames[i]]];
+    }
+    XCTAssertEqual([mRecorder startCount], 1u);
+    XCTAssertEqual([[mCues mixer] activeVoiceCount], 2u);
+
+    recorded = [mCues runUntil:8.0];
+    XCTAssertEqual(recorded, [mRecorder frameCount]);
+    XCTAssertGreaterThanOrEqual(recorded, (NSUInteger)(8.0 * sSampleRate));
+    XCTAssertEqualObjects([self onsets], expected);
+    XCTAssertEqual([mRecorder startCount], 1u);
+}
+
+// *************************************************************************************************
+
+// Cancelled cues never play, whether or not they were already with the mixer.
+- (void)testCancelTag
+{
+    [mCues scheduleCue:@"click" atTime:1.0 tag:1];
+    [mCues scheduleCue:@"click" atTime:1.5 tag:2];
+    [mCues scheduleCue:@"click" atTime:4.0 tag:1];
+    XCTAssertEqual([mCues scheduledCount], 3u);
+    [mCues runUntil:0.5];
+    [mCues cancelTag:1];
+    XCTAssertEqual([mCues scheduledCount], 1u);
+
+    [mCues runUntil:6.0];
+    XCTAssertEqualObjects([self onsets], @[ [NSNumber numberWithUnsignedInteger:66150] ]);
+}
+
+// *************************************************************************************************
+
+// A cue is retired once its time is past, and reports whether it was played on time.
+- (void)testRetire
+{
+    XCTAssertFalse([mCues scheduleCue:@"missing" atTime:1.0 tag:3]);
+    XCTAssertTrue([mCues scheduleCue:@"click" atTime:3.0 tag:3]);
+    [mCues runUntil:3.5];
+    XCTAssertTrue([mCues retireCue:@"click" tag:3]);
+    XCTAssertFalse([mCues retireCue:@"click" tag:3]);
+    XCTAssertEqual([mCues scheduledCount], 0u);
+    XCTAssertEqual([[self onsets] count], 1u);
+}
+
+// *************************************************************************************************
+
+// A cue scheduled a little late plays straight away; one far too late is dropped.
+- (void)testLateCues
+{
+    [mClock setVirtualTime:10.0];
+    XCTAssertTrue([mCues scheduleCue:@"click" atTime:9.0 tag:4]);
+    XCTAssertEqual([mCues scheduledCount], 0u);
+    XCTAssertFalse([mCues retireCue:@"click" tag:4]);
+
+    XCTAssertTrue([mCues scheduleCue:@"click" atTime:9.8 tag:5]);
+    [mCues runUntil:10.5];
+    XCTAssertEqualObjects([self onsets], @[ [NSNumber numberWithUnsignedInteger:0] ]);
+    XCTAssertTrue([mCues retireCue:@"click" tag:5]);
+}
+
+// *************************************************************************************************
+
+// Removing a cue takes back its scheduled plays too.
+- (void)testRemoveCue
+{
+    [mCues scheduleCue:@"click" atTime:1.0 tag:6];
+    [mCues scheduleCue:@"click" atTime:5.0 tag:6];
+    [mCues removeCue:@"click"];
+    XCTAssertEqual([mCues scheduledCount], 0u);
+    XCTAssertNil([mCues bufferForCue:@"click"]);
+    [mCues runUntil:6.0];
+    XCTAssertEqual([[self onsets] count], 0u);
+}
+
+// *************************************************************************************************
+
+// A cue streamed through a ring plays on its frame, sample for sample as if it had been decoded
+// whole.
+- (void)testStreamedCuePlays
+{
+    NSString *path; // the pour sound
+    NSData *data; // the file, mapped
+    Cuppa_AudioBuffer *whole; // the sound, decoded whole
+    const float *samples; // everything recorded
+    NSUInteger onset; // frame the cue is scheduled at
+    NSUInteger i; // loop counter
+
+    path = [[NSBundle bundleForClass:[self class]] pathForResource:@"pour" ofType:@"aiff"];
+    data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:NULL];
+    XCTAssertNotNil(data);
+    whole = [[Cuppa_AIFFDecoder bufferWithData:data] bufferWithSampleRate:sSampleRate
+                                                              channelCount:2];
+    XCTAssertNotNil(whole);
+
+    [mCues addCue:@"pour" streamData:data];
+    XCTAssertNil([mCues bufferForCue:@"pour"]);
+    onset = 30000;
+    XCTAssertTrue([mCues scheduleCue:@"pour" atTime:(onset / sSampleRate) tag:7]);
+    [mCues runUntil:([whole duration] + 1.0)];
+    XCTAssertEqual([[mCues mixer] activeVoiceCount], 0u);
+    XCTAssertGreaterThan([mRecorder frameCount], onset + [whole frameCount]);
+
+    // silence up to the onset, then the sound, then silence again
+    samples = [[mRecorder samples] bytes];
+    for (i = 0; i < onset * 2; i++)
+    {
+        XCTAssertEqual(samples[i], 0.0f);
+    }
+    for (i = 0; i < [whole frameCount] * 2; i++)
+    {
+        XCTAssertEqualWithAccuracy(samples[(onset * 2) + i], [whole samples][i], 1e-6);
+    }
+    for (i = (onset + [whole frameCount]) * 2; i < [mRecorder frameCount] * 2; i++)
+    {
+        XCTAssertEqual(samples[i], 0.0f);
+    }
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioCuesTests
+
+// end Cuppa_AudioCuesTests.m
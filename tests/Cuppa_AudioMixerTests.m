@@ -0,0 +1,268 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_AudioMixerTests
+           - Checks the mixer sums overlapping sounds, clips the result, starts sounds on their
+             exact frame and hands voices back when they finish, are cancelled or are stopped,
+             by rendering through the audio recorder.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioBuffer.h"
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioRecorder.h"
+
+// Internal Constants
+
+// Frames per second everything is rendered at
+static const double sSampleRate = 44100.0;
+
+// Code!
+
+@interface Cuppa_AudioMixerTests : XCTestCase
+{
+    Cuppa_AudioMixer *mMixer; // mixer under test
+    Cuppa_AudioRecorder *mRecorder; // records what it renders
+}
+@end
+
+@implementation Cuppa_AudioMixerTests
+;
+
+// *************************************************************************************************
+
+// Make a stereo mixer and start recording it.
+- (void)setUp
+{
+    [super setUp];
+    mMixer = [[Cuppa_AudioMixer alloc] initWithSampleRate:sSampleRate channelCount:2];
+    mRecorder = [[Cuppa_AudioRecorder alloc] initWithSampleRate:sSampleRate];
+    XCTAssertTrue([mRecorder startWithMixer:mMixer]);
+}
+
+// *************************************************************************************************
+
+// Stop recording and release the mixer.
+- (void)tearDown
+{
+    [mRecorder stop];
+    [mRecorder release];
+    [mMixer release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Returns a stereo sound frameCount frames long, every sample value.
+- (Cuppa_AudioBuffer *)bufferOfValue:(float)value frameCount:(NSUInteger)frameCount
+{
+    Cuppa_AudioBuffer *buffer; // the sound
+    float *samples; // its samples
+    NSUInteger i; // loop counter
+
+    samples = malloc(frameCount * 2 * sizeof(float));
+    for (i = 0; i < frameCount * 2; i++)
+    {
+        samples[i] = value;
+    }
+    buffer = [[Cuppa_AudioBuffer alloc] initWithMallocedSamples:samples
+                                                     frameCount:frameCount
+                                                   channelCount:2
+                                                     sampleRate:sSampleRate];
+    return [buffer autorelease];
+}
+
+// *************************************************************************************************
+
+// Returns the left channel of frame of the recording.
+- (float)recordedFrame:(NSUInteger)frame
+{
+    XCTAssertLessThan(frame, [mRecorder frameCount]);
+    return ((const float *)[[mRecorder samples] bytes])[frame * 2];
+}
+
+// *************************************************************************************************
+
+// Returns the first frame of the recording that isn't silent, or NSNotFound.
+- (NSUInteger)firstSoundingFrame
+{
+    const float *samples = [[mRecorder samples] bytes]; // everything recorded
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < [mRecorder frameCount] * 2; i++)
+    {
+        if (samples[i] != 0.0f)
+            return i / 2;
+    }
+    return NSNotFound;
+}
+
+// *************************************************************************************************
+
+// Overlapping sounds add up, and each plays exactly once.
+- (void)testOverlapSums
+{
+    XCTAssertTrue([mMixer playBuffer:[self bufferOfValue:0.25f frameCount:100]]);
+    XCTAssertTrue([mMixer playBuffer:[self bufferOfValue:0.5f frameCount:100]
+                        atSampleTime:50
+                                 tag:1]);
+    XCTAssertEqual([mMixer activeVoiceCount], 2u);
+    XCTAssertEqual([mRecorder renderFrames:64], 64u);
+    XCTAssertEqual([mRecorder renderFrames:64], 64u);
+    XCTAssertEqual([mRecorder renderFrames:64], 64u);
+    XCTAssertEqual([mMixer sampleTime], 192u);
+
+    XCTAssertEqual([self recordedFrame:0], 0.25f);
+    XCTAssertEqual([self recordedFrame:49], 0.25f);
+    XCTAssertEqual([self recordedFrame:50], 0.75f);
+    XCTAssertEqual([self recordedFrame:99], 0.75f);
+    XCTAssertEqual([self recordedFrame:100], 0.5f);
+    XCTAssertEqual([self recordedFrame:149], 0.5f);
+    XCTAssertEqual([self recordedFrame:150], 0.0f);
+    XCTAssertEqual([self recordedFrame:191], 0.0f);
+    XCTAssertEqual([mMixer activeVoiceCount], 0u);
+}
+
+// *************************************************************************************************
+
+// Sounds that add up past full scale are clipped, either way.
+- (void)testClipping
+{
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < 3; i++)
+    {
+        [mMixer playBuffer:[self bufferOfValue:0.5f frameCount:10]];
+        [mMixer playBuffer:[self bufferOfValue:-0.75f frameCount:10] atSampleTime:10 tag:0];
+    }
+    [mRecorder renderFrames:20];
+    XCTAssertEqual([self recordedFrame:0], 1.0f);
+    XCTAssertEqual([self recordedFrame:9], 1.0f);
+    XCTAssertEqual([self recordedFrame:10], -1.0f);
+    XCTAssertEqual([self recordedFrame:19], -1.0f);
+}
+
+// *************************************************************************************************
+
+// A sound lands on the frame it was started at, wherever that falls in a render.
+- (void)testOnsetOnExactFrame
+{
+    uint64_t onsets[] = { 0, 1, 511, 512, 1234, 4095 }; // frames to start a sound at
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < sizeof(onsets) / sizeof(onsets[0]); i++)
+    {
+        [mRecorder stop];
+        [mRecorder release];
+        mRecorder = [[Cuppa_AudioRecorder alloc] initWithSampleRate:sSampleRate];
+        [mRecorder startWithMixer:mMixer];
+        XCTAssertTrue([mMixer playBuffer:[self bufferOfValue:0.5f frameCount:32]
+                            atSampleTime:([mMixer sampleTime] + onsets[i])
+                                     tag:0]);
+        while ([mRecorder frameCount] < onsets[i] + 512)
+        {
+            [mRecorder renderFrames:512];
+        }
+        XCTAssertEqual([self firstSoundingFrame], (NSUInteger)onsets[i]);
+        XCTAssertEqual([self recordedFrame:(NSUInteger)(onsets[i] + 31)], 0.5f);
+        XCTAssertEqual([self recordedFrame:(NSUInteger)(onsets[i] + 32)], 0.0f);
+    }
+}
+
+// *************************************************************************************************
+
+// Only so many sounds play at once, and voices come back once their sounds finish.
+- (void)testVoiceLimit
+{
+    Cuppa_AudioBuffer *buffer = [self bufferOfValue:0.01f frameCount:100]; // sound played
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < CUPPA_AUDIOMIXER_VOICES; i++)
+    {
+        XCTAssertTrue([mMixer playBuffer:buffer]);
+    }
+    XCTAssertFalse([mMixer playBuffer:buffer]);
+    XCTAssertEqual([mMixer activeVoiceCount], (NSUInteger)CUPPA_AUDIOMIXER_VOICES);
+
+    [mRecorder renderFrames:50];
+    XCTAssertFalse([mMixer playBuffer:buffer]);
+    [mRecorder renderFrames:50];
+    XCTAssertEqual([mMixer activeVoiceCount], 0u);
+    XCTAssertTrue([mMixer playBuffer:buffer]);
+}
+
+// *************************************************************************************************
+
+// Cancelling takes back the tagged sounds that haven't started, and leaves the rest alone.
+- (void)testCancelTag
+{
+    [mMixer playBuffer:[self bufferOfValue:0.25f frameCount:100] atSampleTime:1000 tag:1];
+    [mMixer playBuffer:[self bufferOfValue:0.25f frameCount:100] atSampleTime:2000 tag:1];
+    [mMixer playBuffer:[self bufferOfValue:0.5f frameCount:100] atSampleTime:1000 tag:2];
+    XCTAssertEqual([mMixer activeVoiceCount], 3u);
+    XCTAssertTrue([mMixer cancelVoiceTag:1]);
+    XCTAssertFalse([mMixer cancelVoiceTag:1]);
+    XCTAssertEqual([mMixer activeVoiceCount], 1u);
+
+    // once a sound has started it is too late
+    [mRecorder renderFrames:1050];
+    XCTAssertFalse([mMixer cancelVoiceTag:2]);
+    [mRecorder renderFrames:1050];
+    XCTAssertEqual([self firstSoundingFrame], 1000u);
+    XCTAssertEqual([self recordedFrame:1099], 0.5f);
+    XCTAssertEqual([self recordedFrame:1100], 0.0f);
+    XCTAssertEqual([self recordedFrame:2000], 0.0f);
+}
+
+// *************************************************************************************************
+
+// Stopping silences what is playing and drops what is waiting, on the next render.
+- (void)testStopAll
+{
+    [mMixer playBuffer:[self bufferOfValue:0.5f frameCount:44100]];
+    [mMixer playBuffer:[self bufferOfValue:0.5f frameCount:100] atSampleTime:5000 tag:0];
+    [mRecorder renderFrames:100];
+    [mMixer stopAll];
+    XCTAssertEqual([mMixer activeVoiceCount], 0u);
+    [mRecorder renderFrames:10000];
+    XCTAssertEqual([self recordedFrame:99], 0.5f);
+    XCTAssertEqual([self recordedFrame:100], 0.0f);
+    XCTAssertEqual([self recordedFrame:5000], 0.0f);
+
+    // the voices are all free again
+    [mMixer reap];
+    XCTAssertTrue([mMixer playBuffer:[self bufferOfValue:0.5f frameCount:100]]);
+}
+
+// *************************************************************************************************
+
+// The recorder only records while it is running.
+- (void)testRecorder
+{
+    XCTAssertTrue([mRecorder isRunning]);
+    XCTAssertTrue([mRecorder startWithMixer:mMixer]);
+    XCTAssertEqual([mRecorder startCount], 1u);
+    XCTAssertEqual([mRecorder renderFrames:256], 256u);
+    [mRecorder stop];
+    XCTAssertFalse([mRecorder isRunning]);
+    XCTAssertEqual([mRecorder renderFrames:256], 0u);
+    XCTAssertEqual([mRecorder frameCount], 256u);
+    XCTAssertEqual([[mRecorder samples] length], 256u * 2 * sizeof(float));
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_AudioMixerTests
+
+// end Cuppa_AudioMixerTests.m
@@ -0,0 +1,607 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_BevyBench
+           - Measures long beverage lists: loading them from the preferences (a property list of
+             dictionaries, made into beverage objects) against loading them from a catalog (read
+             lazily), and scrolling the beverage table through all of them, by CPU time and peak
+             resident memory; and sorting them, with English or localized names, with sort
+             descriptors against sorting them over typed columns, by CPU time; and how many
+             names the shared name arena keeps as they are made, renamed and freed; and decoding
+             cup shape labels through the shape table against the linear scan it replaced, by CPU
+             time; and how long the beverage store takes to record edits to a catalog, and how
+             many bytes it writes for them. Run through "make -C tests bench".
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <time.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_BevyColumns.h"
+#import "Cuppa_BevySortKeys.h"
+#import "Cuppa_BevyStore.h"
+#import "Cuppa_Catalog.h"
+#import "Cuppa_LazyBevys.h"
+#import "Cuppa_NameArena.h"
+#import "Cuppa_PrefsRecorder.h"
+#import "Cuppa_PrefsWriter.h"
+#import "Cuppa_ShapeTable.h"
+
+// Internal Constants
+
+// Rows shown in the beverage table at once
+static const NSUInteger sVisibleRows = 20;
+
+// Tea names as they might be localized, some accented (composed or not) and in mixed case
+static NSString * const sLocalizedNames[] = {
+    @"Th\u00E9 vert", @"THE\u0301 NOIR", @"Gr\u00FCner Tee", @"Schwarzer Tee", @"T\u00E9 rojo",
+    @"Cha\u0301 verde", @"\u00C7ay", @"Zielona herbata", @"Earl Grey", @"earl grey",
+    @"\u0417\u0435\u043B\u0451\u043D\u044B\u0439 \u0447\u0430\u0439",
+    @"\u039C\u03B1\u03CD\u03C1\u03BF \u03C4\u03C3\u03AC\u03B9", @"\u7DD1\u8336", @"\u7EA2\u8336"
+};
+
+// Code!
+
+// Returns the CPU time used by the process so far, in seconds.
+static double CuppaBenchCPUTime(void)
+{
+    struct rusage usage; // resources used
+
+    getrusage(RUSAGE_SELF, &usage);
+    return (double)usage.ru_utime.tv_sec + (usage.ru_utime.tv_usec / 1e6) +
+           (double)usage.ru_stime.tv_sec + (usage.ru_stime.tv_usec / 1e6);
+}
+
+// Returns the time on a clock that only goes forward, in seconds.
+static double CuppaBenchWallTime(void)
+{
+    struct timespec now; // current time
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (now.tv_nsec / 1e9);
+}
+
+// Returns the peak resident memory of the process so far, in KB.
+static double CuppaBenchPeakKB(void)
+{
+    struct rusage usage; // resources used
+
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024.0; // (bytes here, KB elsewhere)
+#else
+    return (double)usage.ru_maxrss;
+#endif
+}
+
+// Returns count beverage dictionaries, as the preferences hold them, with names and brew times
+// that repeat about as often as a real list's would.
+static NSMutableArray *CuppaBenchDictionaries(NSUInteger count)
+{
+    NSMutableArray *dicts; // the beverages
+    uint32_t seed = 1; // for names and brew times
+    NSUInteger i; // loop counter
+
+    dicts = [NSMutableArray arrayWithCapacity:count];
+    for (i = 0; i < count; i++)
+    {
+        seed = (seed * 1103515245u) + 12345u;
+        [dicts addObject:@{
+            @"name" : [NSString stringWithFormat:@"Tea %u", (seed >> 8) % 50000],
+            @"brewTime" : [NSNumber numberWithInt:(int)(30 + ((seed >> 4) % 600))],
+            @"cupShape" : @"default",
+            @"identifier" : [NSString stringWithFormat:@"%08lX-BENCH", (unsigned long)i]
+        }];
+    }
+    return dicts;
+}
+
+// Writes a list of count beverages into directory, as the preferences would hold it (a binary
+// property list) and as a catalog, and prints the size of each.
+static int PrepareBevys(NSString *directory, NSUInteger count)
+{
+    NSArray *dicts; // the beverages
+    NSData *plist, *catalog; // the list, written each way
+    NSString *name; // path of the files, without extension
+
+    dicts = CuppaBenchDictionaries(count);
+    plist = [NSPropertyListSerialization dataWithPropertyList:dicts
+                                                       format:NSPropertyListBinaryFormat_v1_0
+                                                      options:0
+                                                        error:NULL];
+    catalog = [Cuppa_Catalog fromDictionary:dicts];
+    if (!plist || !catalog)
+    {
+        printf("Cuppa_BevyBench: can't write %lu beverages\n", (unsigned long)count);
+        return 1;
+    }
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:NULL];
+    name = [directory stringByAppendingPathComponent:
+                          [NSString stringWithFormat:@"bevys-%lu", (unsigned long)count]];
+    [plist writeToFile:[name stringByAppendingPathExtension:@"plist"] atomically:NO];
+    [catalog writeToFile:[name stringByAppendingPathExtension:@"catalog"] atomically:NO];
+    printf("Cuppa_BevyBench: %8lu rows  plist %10lu bytes  catalog %10lu bytes\n",
+           (unsigned long)count, (unsigned long)[plist length], (unsigned long)[catalog length]);
+    return 0;
+}
+
+// Returns the list in a file written by PrepareBevys, loaded the way its extension says, or nil.
+static NSMutableArray *CuppaBenchOpen(NSString *path)
+{
+    NSMutableArray *bevys; // the list
+    NSData *data; // the file, mapped
+    Cuppa_Catalog *catalog; // the file as a catalog, if it is one
+
+    data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:NULL];
+    if ([[path pathExtension] isEqualToString:@"catalog"])
+    {
+        catalog = data ? [[[Cuppa_Catalog alloc] initWithData:data] autorelease] : nil;
+        bevys = catalog ? [[[Cuppa_LazyBevys alloc] initWithCatalog:catalog
+                                                        hotCapacity:CUPPA_LAZYBEVYS_HOT_ROWS]
+                           autorelease]
+                        : nil;
+    }
+    else
+    {
+        bevys = data ? [Cuppa_Bevy fromDictionary:
+                        [NSPropertyListSerialization propertyListWithData:data
+                                                                  options:0
+                                                                   format:NULL
+                                                                    error:NULL]]
+                     : nil;
+    }
+    return ([bevys count] > 0) ? bevys : nil;
+}
+
+// Loads a list from a file written by PrepareBevys, either way, and reads the first screenful of
+// rows as the beverage table would.
+static int LoadBevys(NSString *path)
+{
+    NSMutableArray *bevys; // the list
+    double startCPU, startKB; // CPU time and peak memory before loading
+    double openCPU; // CPU time once the list is open
+    NSUInteger total = 0; // sum of the fields read, so the reads aren't optimized away
+    NSUInteger i; // loop counter
+
+    startKB = CuppaBenchPeakKB();
+    startCPU = CuppaBenchCPUTime();
+    bevys = CuppaBenchOpen(path);
+    if (!bevys)
+    {
+        printf("Cuppa_BevyBench: can't read %s\n", [path UTF8String]);
+        return 1;
+    }
+    openCPU = CuppaBenchCPUTime();
+    for (i = 0; i < MIN(sVisibleRows, [bevys count]); i++)
+    {
+        total += [[bevys bevyNameAtIndex:i] length] + [bevys bevyBrewTimeAtIndex:i];
+    }
+
+    printf("Cuppa_BevyBench: load %-7s %8lu rows  open %9.2f ms CPU  first screen %7.3f ms CPU  "
+           "peak RSS +%8.0f KB  (%lu)\n",
+           [[path pathExtension] UTF8String], (unsigned long)[bevys count],
+           (openCPU - startCPU) * 1000.0, (CuppaBenchCPUTime() - openCPU) * 1000.0,
+           CuppaBenchPeakKB() - startKB, (unsigned long)total);
+    return 0;
+}
+
+// Loads a list from a file written by PrepareBevys, either way, then scrolls the beverage table
+// through every row and back, reading each cell, and reports how much memory that took and how
+// many rows became objects or stayed decoded.
+static int ScrollBevys(NSString *path)
+{
+    NSMutableArray *bevys; // the list
+    double startCPU, startKB; // CPU time and peak memory before scrolling
+    double openKB; // peak memory once the list is open
+    NSUInteger total = 0; // sum of the fields read, so the reads aren't optimized away
+    NSUInteger row, pass; // loop counters
+
+    startKB = CuppaBenchPeakKB();
+    bevys = CuppaBenchOpen(path);
+    if (!bevys)
+    {
+        printf("Cuppa_BevyBench: can't read %s\n", [path UTF8String]);
+        return 1;
+    }
+    openKB = CuppaBenchPeakKB();
+    startCPU = CuppaBenchCPUTime();
+    for (pass = 0; pass < 2; pass++)
+    {
+        for (row = 0; row < [bevys count]; row++)
+        {
+            @autoreleasepool
+            {
+                total += [bevys bevyCupShapeAtIndex:row];
+                total += [[bevys bevyNameAtIndex:row] length];
+                total += [bevys bevyBrewTimeAtIndex:row];
+            }
+        }
+    }
+
+    printf("Cuppa_BevyBench: scroll %-7s %8lu rows  %9.2f ms CPU  peak RSS open +%8.0f KB  "
+           "scrolled +%8.0f KB",
+           [[path pathExtension] UTF8String], (unsigned long)[bevys count],
+           (CuppaBenchCPUTime() - startCPU) * 1000.0, openKB - startKB,
+           CuppaBenchPeakKB() - openKB);
+    if ([bevys isKindOfClass:[Cuppa_LazyBevys class]])
+    {
+        printf("  objects %lu  decoded %lu",
+               (unsigned long)[(Cuppa_LazyBevys *)bevys materializedCount],
+               (unsigned long)[(Cuppa_LazyBevys *)bevys hotCount]);
+    }
+    printf("  (%lu)\n", (unsigned long)total);
+    return 0;
+}
+
+// Returns beverage dictionaries with their names replaced by localized ones.
+static NSMutableArray *CuppaBenchLocalize(NSArray *dicts)
+{
+    NSMutableArray *localized; // the beverages, renamed
+    NSMutableDictionary *dict; // current beverage
+    NSUInteger count = sizeof(sLocalizedNames) / sizeof(sLocalizedNames[0]); // names to draw on
+    NSUInteger i; // loop counter
+
+    localized = [NSMutableArray arrayWithCapacity:[dicts count]];
+    for (i = 0; i < [dicts count]; i++)
+    {
+        dict = [[[dicts objectAtIndex:i] mutableCopy] autorelease];
+        [dict setObject:[NSString stringWithFormat:@"%@ %lu", sLocalizedNames[(i * 7) % count],
+                                                   (unsigned long)((i * 2654435761u) % 5000)]
+                 forKey:@"name"];
+        [localized addObject:dict];
+    }
+    return localized;
+}
+
+// Sorts a list of count beverages (with localized names if asked) by each column the beverage
+// table sorts by, with the sort descriptors as the table did before and over typed columns as it
+// does now (with no sort keys known, then with all of them known, as for a second sort), and
+// checks both give the same order.
+static int SortBevys(NSUInteger count, BOOL localized)
+{
+    NSMutableArray *bevys; // the list, in its first order
+    NSMutableArray *byDescriptors, *byColumns; // the list sorted each way
+    Cuppa_BevySortKeys *keys; // sort keys kept between column sorts
+    NSArray *descriptors; // a descriptor for each column the table sorts by
+    NSSortDescriptor *descriptor; // current descriptor
+    double startCPU, descriptorCPU, columnCPU, knownCPU; // CPU time before and for each sort
+    NSUInteger row; // loop counter
+    int result = 0; // exit status
+
+    bevys = [Cuppa_Bevy fromDictionary:(localized
+                                           ? CuppaBenchLocalize(CuppaBenchDictionaries(count))
+                                           : CuppaBenchDictionaries(count))];
+    descriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"name"
+                                                   ascending:YES
+                                                    selector:@selector(caseInsensitiveCompare:)],
+                     [NSSortDescriptor sortDescriptorWithKey:@"brewTime"
+                                                   ascending:YES
+                                                    selector:@selector(compare:)] ];
+    for (descriptor in descriptors)
+    {
+        @autoreleasepool
+        {
+            byDescriptors = [[bevys mutableCopy] autorelease];
+            startCPU = CuppaBenchCPUTime();
+            [byDescriptors sortUsingDescriptors:@[ descriptor ]];
+            descriptorCPU = CuppaBenchCPUTime() - startCPU;
+
+            keys = [[[Cuppa_BevySortKeys alloc] init] autorelease];
+            byColumns = [[bevys mutableCopy] autorelease];
+            startCPU = CuppaBenchCPUTime();
+            [Cuppa_BevyColumns sortBevys:byColumns usingDescriptors:@[ descriptor ] sortKeys:keys];
+            columnCPU = CuppaBenchCPUTime() - startCPU;
+
+            byColumns = [[bevys mutableCopy] autorelease];
+            startCPU = CuppaBenchCPUTime();
+            [Cuppa_BevyColumns sortBevys:byColumns usingDescriptors:@[ descriptor ] sortKeys:keys];
+            knownCPU = CuppaBenchCPUTime() - startCPU;
+
+            // equal rows may be in either order after the descriptor sort, so compare keys
+            for (row = 0; row < count; row++)
+            {
+                if ([descriptor compareObject:[byColumns objectAtIndex:row]
+                                     toObject:[byDescriptors objectAtIndex:row]] != NSOrderedSame)
+                    break;
+            }
+            if (row < count)
+                result = 1;
+
+            printf("Cuppa_BevyBench: sort %-8s %8lu rows %-9s  descriptors %9.2f ms CPU  columns "
+                   "%9.2f ms CPU  keys known %9.2f ms CPU  %s\n",
+                   [[descriptor key] UTF8String], (unsigned long)count,
+                   localized ? "localized" : "", descriptorCPU * 1000.0,
+                   columnCPU * 1000.0, knownCPU * 1000.0,
+                   (row < count) ? "ORDER DIFFERS" : "same order");
+        }
+    }
+    return result;
+}
+
+// Makes a list of count beverages, renames every one of them, then frees them, and reports the
+// names (and characters) the shared name arena holds and the peak resident memory after each.
+static int ArenaBevys(NSUInteger count)
+{
+    Cuppa_NameArena *arena = [Cuppa_NameArena sharedArena]; // arena the beverages share
+    NSMutableArray *bevys; // the list
+    double startKB; // peak memory before making the list
+    NSUInteger row; // loop counter
+
+    startKB = CuppaBenchPeakKB();
+    @autoreleasepool
+    {
+        bevys = [[Cuppa_Bevy fromDictionary:CuppaBenchDictionaries(count)] retain];
+    }
+    printf("Cuppa_BevyBench: arena %8lu rows  made     names %8lu  characters %9lu  "
+           "peak RSS +%8.0f KB\n",
+           (unsigned long)count, (unsigned long)[arena count],
+           (unsigned long)[arena characterCount], CuppaBenchPeakKB() - startKB);
+
+    // every old name is dropped as its last beverage is renamed
+    for (row = 0; row < count; row++)
+    {
+        @autoreleasepool
+        {
+            [[bevys objectAtIndex:row]
+                setName:[NSString stringWithFormat:@"Renamed %lu", (unsigned long)row]];
+        }
+    }
+    printf("Cuppa_BevyBench: arena %8lu rows  renamed  names %8lu  characters %9lu  "
+           "peak RSS +%8.0f KB\n",
+           (unsigned long)count, (unsigned long)[arena count],
+           (unsigned long)[arena characterCount], CuppaBenchPeakKB() - startKB);
+
+    [bevys release];
+    printf("Cuppa_BevyBench: arena %8lu rows  freed    names %8lu  characters %9lu\n",
+           (unsigned long)count, (unsigned long)[arena count],
+           (unsigned long)[arena characterCount]);
+    return ([arena count] == 0) ? 0 : 1;
+}
+
+// Decodes count cup shape labels, as a catalog stores them (UTF-8 bytes), with the shapes from a
+// shape list: through the shape table, by a linear scan of the labels' bytes, and as before the
+// table, by making a string and scanning the labels for it. One label in each few is not known.
+static int DecodeLabels(NSString *path, NSUInteger count)
+{
+    Cuppa_ShapeTable *table; // shape table under test
+    NSMutableArray *labels; // labels to decode: every shape's, then one not known
+    const char **bytes; // UTF-8 bytes of each label
+    NSUInteger *lengths; // length of each
+    NSUInteger labelCount; // number of labels to decode
+    NSString *string; // label made into a string
+    double startCPU, tableCPU, bytesCPU, stringsCPU; // CPU time before and for each way
+    NSUInteger totals[3] = { 0, 0, 0 }; // sum of the shapes found each way, to check they agree
+    NSUInteger i, j, shape; // loop counters, and the shape found
+
+    table = [[[Cuppa_ShapeTable alloc] initWithContentsOfFile:path] autorelease];
+    labels = [NSMutableArray array];
+    for (i = 0; i < [table count]; i++)
+    {
+        [labels addObject:[table labelForShape:(int)i]];
+    }
+    [labels addObject:@"no-such-shape"];
+    labelCount = [labels count];
+    bytes = malloc(labelCount * sizeof(const char *));
+    lengths = malloc(labelCount * sizeof(NSUInteger));
+    for (i = 0; i < labelCount; i++)
+    {
+        bytes[i] = [[labels objectAtIndex:i] UTF8String];
+        lengths[i] = strlen(bytes[i]);
+    }
+
+    startCPU = CuppaBenchCPUTime();
+    for (i = 0; i < count; i++)
+    {
+        totals[0] += [table shapeForLabelBytes:bytes[i % labelCount]
+                                        length:lengths[i % labelCount]];
+    }
+    tableCPU = CuppaBenchCPUTime() - startCPU;
+
+    // (the last label is the one not known, so it is never matched)
+    startCPU = CuppaBenchCPUTime();
+    for (i = 0; i < count; i++)
+    {
+        shape = 0;
+        for (j = 0; j + 1 < labelCount; j++)
+        {
+            if (lengths[j] == lengths[i % labelCount] &&
+                memcmp(bytes[j], bytes[i % labelCount], lengths[j]) == 0)
+            {
+                shape = j;
+                break;
+            }
+        }
+        totals[1] += shape;
+    }
+    bytesCPU = CuppaBenchCPUTime() - startCPU;
+
+    startCPU = CuppaBenchCPUTime();
+    for (i = 0; i < count; i++)
+    {
+        string = [[NSString alloc] initWithBytes:bytes[i % labelCount]
+                                          length:lengths[i % labelCount]
+                                        encoding:NSUTF8StringEncoding];
+        shape = 0;
+        for (j = 0; j + 1 < labelCount; j++)
+        {
+            if ([string isEqualToString:[labels objectAtIndex:j]])
+            {
+                shape = j;
+                break;
+            }
+        }
+        totals[2] += shape;
+        [string release];
+    }
+    stringsCPU = CuppaBenchCPUTime() - startCPU;
+
+    printf("Cuppa_BevyBench: labels %9lu decodes of %lu labels  table %9.2f ms CPU  byte scan "
+           "%9.2f ms CPU  string scan %9.2f ms CPU  %s\n",
+           (unsigned long)count, (unsigned long)labelCount, tableCPU * 1000.0, bytesCPU * 1000.0,
+           stringsCPU * 1000.0,
+           (totals[0] == totals[1] && totals[1] == totals[2]) ? "same shapes" : "SHAPES DIFFER");
+    free(bytes);
+    free(lengths);
+    return (totals[0] == totals[1] && totals[1] == totals[2]) ? 0 : 1;
+}
+
+// Saves a list of count beverages through the beverage store, so it is kept as a catalog, and
+// reloads it lazily, as the app does; then makes edits to it (renames, moves, and removals with
+// insertions), reporting each to the store, and reports how long the reports take, how long until
+// everything is written, and the bytes written to the log and catalogs, against the bytes of
+// writing the whole list out again for every edit.
+static int StoreEdits(NSString *directory, NSUInteger count, NSUInteger edits)
+{
+    Cuppa_PrefsRecorder *recorder; // where the preferences are written
+    Cuppa_PrefsWriter *prefs; // preferences the store keeps its list in
+    Cuppa_BevyStore *store; // store under test
+    NSMutableArray *bevys; // its list
+    NSString *logPath; // path of its change log
+    NSUInteger wholeBytes; // bytes of the whole list as a catalog
+    Cuppa_Bevy *bevy, *inserted; // beverages edited
+    unsigned long long startBytes; // bytes written before the edits
+    NSInteger startGeneration; // generation of the list before the edits
+    double start, latency, worst = 0.0, total = 0.0; // time to report each edit, and in all
+    double settled; // time for the queue to catch up after the edits
+    NSUInteger i, from, to; // loop counter, and rows edited
+
+    [[NSFileManager defaultManager] removeItemAtPath:directory error:NULL];
+    logPath = [directory stringByAppendingPathComponent:@"Beverages.log"];
+    recorder = [[[Cuppa_PrefsRecorder alloc] init] autorelease];
+    prefs = [[[Cuppa_PrefsWriter alloc] initWithBackend:recorder delay:1.0] autorelease];
+    @autoreleasepool
+    {
+        store = [[Cuppa_BevyStore alloc] initWithPrefs:prefs logPath:logPath];
+        [store load];
+        [store replaceBevys:[Cuppa_Bevy fromDictionary:CuppaBenchDictionaries(count)]];
+        wholeBytes = [[Cuppa_Catalog fromBevys:[store bevys]] length];
+        [store release];
+    }
+
+    store = [[[Cuppa_BevyStore alloc] initWithPrefs:prefs logPath:logPath] autorelease];
+    bevys = [store load];
+    if ([bevys count] != count || ![bevys isKindOfClass:[Cuppa_LazyBevys class]])
+    {
+        printf("Cuppa_BevyBench: can't store %lu beverages as a catalog\n", (unsigned long)count);
+        return 1;
+    }
+    [prefs waitUntilWritten];
+    startBytes = [store bytesWritten];
+    startGeneration = [store generation];
+
+    for (i = 0; i < edits; i++)
+    {
+        @autoreleasepool
+        {
+            from = (i * 7919) % count;
+            to = (i * 104729) % count;
+            switch (i % 4)
+            {
+                case 2:
+                    bevy = [[bevys objectAtIndex:from] retain];
+                    [bevys removeObjectAtIndex:from];
+                    [bevys insertObject:bevy atIndex:to];
+                    start = CuppaBenchWallTime();
+                    [store bevyMoved:bevy toIndex:to];
+                    latency = CuppaBenchWallTime() - start;
+                    [bevy release];
+                    break;
+                case 3:
+                    bevy = [[bevys objectAtIndex:from] retain];
+                    [bevys removeObjectAtIndex:from];
+                    inserted = [[[Cuppa_Bevy alloc] init] autorelease];
+                    [inserted setName:[NSString stringWithFormat:@"Added %lu", (unsigned long)i]];
+                    [bevys insertObject:inserted atIndex:to];
+                    start = CuppaBenchWallTime();
+                    [store bevyRemoved:bevy];
+                    [store bevyInserted:inserted atIndex:to];
+                    latency = CuppaBenchWallTime() - start;
+                    [bevy release];
+                    break;
+                default:
+                    bevy = [bevys objectAtIndex:from];
+                    [bevy setName:[NSString stringWithFormat:@"Renamed %lu", (unsigned long)i]];
+                    start = CuppaBenchWallTime();
+                    [store bevyChanged:bevy];
+                    latency = CuppaBenchWallTime() - start;
+                    break;
+            }
+            total += latency;
+            worst = MAX(worst, latency);
+        }
+    }
+    start = CuppaBenchWallTime();
+    [prefs waitUntilWritten];
+    settled = CuppaBenchWallTime() - start;
+
+    printf("Cuppa_BevyBench: store %8lu rows %6lu edits  report %8.2f us mean %10.2f us max  "
+           "written %8.2f ms later  %3ld compactions  wrote %11llu bytes  whole list each edit "
+           "%13llu bytes\n",
+           (unsigned long)count, (unsigned long)edits, ((edits > 0) ? total / edits : 0.0) * 1e6,
+           worst * 1e6,
+           settled * 1000.0, (long)([store generation] - startGeneration),
+           [store bytesWritten] - startBytes, (unsigned long long)wholeBytes * edits);
+    return ([bevys count] == count) ? 0 : 1;
+}
+
+int main(int argc, const char *argv[])
+{
+    NSString *mode; // what to measure
+    int result; // exit status
+
+    @autoreleasepool
+    {
+        mode = (argc > 1) ? [NSString stringWithUTF8String:argv[1]] : @"";
+        if ([mode isEqualToString:@"prepare"] && argc == 4)
+            result = PrepareBevys([NSString stringWithUTF8String:argv[2]],
+                                  (NSUInteger)strtoul(argv[3], NULL, 10));
+        else if ([mode isEqualToString:@"load"] && argc == 3)
+            result = LoadBevys([NSString stringWithUTF8String:argv[2]]);
+        else if ([mode isEqualToString:@"scroll"] && argc == 3)
+            result = ScrollBevys([NSString stringWithUTF8String:argv[2]]);
+        else if ([mode isEqualToString:@"labels"] && argc == 4)
+            result = DecodeLabels([NSString stringWithUTF8String:argv[2]],
+                                  (NSUInteger)strtoul(argv[3], NULL, 10));
+        else if ([mode isEqualToString:@"store"] && argc == 5)
+            result = StoreEdits([NSString stringWithUTF8String:argv[2]],
+                                (NSUInteger)strtoul(argv[3], NULL, 10),
+                                (NSUInteger)strtoul(argv[4], NULL, 10));
+        else if ([mode isEqualToString:@"arena"] && argc == 3)
+            result = ArenaBevys((NSUInteger)strtoul(argv[2], NULL, 10));
+        else if ([mode isEqualToString:@"sort"] && argc == 3)
+            result = SortBevys((NSUInteger)strtoul(argv[2], NULL, 10), NO);
+        else if ([mode isEqualToString:@"sort"] && argc == 4 && strcmp(argv[3], "localized") == 0)
+            result = SortBevys((NSUInteger)strtoul(argv[2], NULL, 10), YES);
+        else
+            result = 2;
+
+        if (result == 2)
+        {
+            printf("usage: Cuppa_BevyBench prepare directory rows\n"
+                   "       Cuppa_BevyBench load|scroll bevys.plist|bevys.catalog\n"
+                   "       Cuppa_BevyBench sort rows [localized]\n"
+                   "       Cuppa_BevyBench arena rows\n"
+                   "       Cuppa_BevyBench store directory rows edits\n"
+                   "       Cuppa_BevyBench labels Shapes.plist decodes\n");
+        }
+    }
+    return result;
+}
+
+// end Cuppa_BevyBench.m
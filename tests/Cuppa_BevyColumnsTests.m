@@ -0,0 +1,236 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_BevyColumnsTests
+           - Checks the column sort puts beverages in exactly the order a stable sort by the same
+             descriptors does, keeps equal rows in their old order, and leaves the list alone for
+             descriptors it cannot stand in for.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_BevyColumns.h"
+#import "Cuppa_BevySortKeys.h"
+#import "Cuppa_LazyBevys.h"
+#import "Cuppa_Shape.h"
+
+// Internal Constants
+
+// Number of beverages in the test list
+static const NSUInteger sRows = 500;
+
+// Code!
+
+// Returns a copy of bevys sorted by descriptors with a sort that is stable by contract, to check
+// the column sort against.
+static NSMutableArray *CuppaTestStableSort(NSArray *bevys, NSArray *descriptors)
+{
+    NSMutableArray *sorted; // the sorted copy
+
+    sorted = [[bevys mutableCopy] autorelease];
+    [sorted sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(id a, id b) {
+        NSSortDescriptor *descriptor; // current descriptor
+        NSComparisonResult result; // result for the current descriptor
+
+        for (descriptor in descriptors)
+        {
+            result = [descriptor compareObject:a toObject:b];
+            if (result != NSOrderedSame)
+                return result;
+        }
+        return NSOrderedSame;
+    }];
+    return sorted;
+}
+
+@interface Cuppa_BevyColumnsTests : XCTestCase
+{
+    NSMutableArray *mBevys; // list under test, in its first order
+}
+@end
+
+@implementation Cuppa_BevyColumnsTests
+;
+
+// *************************************************************************************************
+
+// Make a list whose names differ only by case in places, and whose brew times and shapes repeat,
+// so every column has ties.
+- (void)setUp
+{
+    NSArray *names; // names to draw from
+    Cuppa_Bevy *bevy; // current beverage
+    NSUInteger i; // loop counter
+
+    [super setUp];
+    names = @[ @"Assam", @"assam", @"ASSAM", @"Darjeeling", @"Earl Grey", @"earl grey",
+               @"Oolong", @"Tea 10", @"Tea 9", @"tea 9", @"Pu-erh", @"" ];
+    mBevys = [[NSMutableArray alloc] initWithCapacity:sRows];
+    for (i = 0; i < sRows; i++)
+    {
+        bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+        [bevy setName:[names objectAtIndex:((i * 7) % [names count])]];
+        [bevy setBrewTime:(int)(60 + ((i * 13) % 5) * 30)];
+        [bevy setCupShape:(int)(i % [Cuppa_Shape shapeCount])];
+        [bevy setIdentifier:[NSString stringWithFormat:@"tea-%lu", (unsigned long)i]];
+        [mBevys addObject:bevy];
+    }
+}
+
+// *************************************************************************************************
+
+// Release the list.
+- (void)tearDown
+{
+    [mBevys release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Sort a copy of the list by descriptors both ways, and check the rows come out in the same order,
+// object for object, and in the same order of keys as sortUsingDescriptors: gives.
+- (void)checkDescriptors:(NSArray *)descriptors sortKeys:(Cuppa_BevySortKeys *)keys
+{
+    NSMutableArray *expected; // list sorted stably by the descriptors
+    NSMutableArray *sorted; // list sorted by the descriptors, as the table did before
+    NSMutableArray *columns; // list sorted by columns
+    NSSortDescriptor *descriptor; // current descriptor
+    NSUInteger i; // loop counter
+
+    expected = CuppaTestStableSort(mBevys, descriptors);
+    sorted = [[mBevys mutableCopy] autorelease];
+    [sorted sortUsingDescriptors:descriptors];
+    columns = [[mBevys mutableCopy] autorelease];
+    XCTAssertTrue([Cuppa_BevyColumns sortBevys:columns usingDescriptors:descriptors sortKeys:keys]);
+
+    XCTAssertEqual([columns count], [expected count]);
+    for (i = 0; i < [columns count]; i++)
+    {
+        XCTAssertEqual([columns objectAtIndex:i], [expected objectAtIndex:i],
+                       @"row %lu differs for %@", (unsigned long)i, descriptors);
+        for (descriptor in descriptors)
+        {
+            XCTAssertEqual([descriptor compareObject:[columns objectAtIndex:i]
+                                            toObject:[sorted objectAtIndex:i]],
+                           NSOrderedSame);
+        }
+    }
+}
+
+// *************************************************************************************************
+
+// Each column, each way, and two columns together, sort as the descriptors do.
+- (void)testMatchesDescriptors
+{
+    NSSortDescriptor *name, *brewTime, *cupShape; // a descriptor for each column, ascending
+
+    name = [NSSortDescriptor sortDescriptorWithKey:@"name"
+                                         ascending:YES
+                                          selector:@selector(caseInsensitiveCompare:)];
+    brewTime = [NSSortDescriptor sortDescriptorWithKey:@"brewTime"
+                                             ascending:YES
+                                              selector:@selector(compare:)];
+    cupShape = [NSSortDescriptor sortDescriptorWithKey:@"cupShape"
+                                             ascending:YES
+                                              selector:@selector(compare:)];
+
+    [self checkDescriptors:@[ name ] sortKeys:nil];
+    [self checkDescriptors:@[ [name reversedSortDescriptor] ] sortKeys:nil];
+    [self checkDescriptors:@[ brewTime ] sortKeys:nil];
+    [self checkDescriptors:@[ [brewTime reversedSortDescriptor] ] sortKeys:nil];
+    [self checkDescriptors:@[ cupShape ] sortKeys:nil];
+    [self checkDescriptors:@[ [cupShape reversedSortDescriptor] ] sortKeys:nil];
+    [self checkDescriptors:@[ brewTime, [name reversedSortDescriptor] ] sortKeys:nil];
+    [self checkDescriptors:@[] sortKeys:nil];
+}
+
+// *************************************************************************************************
+
+// Rows with the same key keep the order they had, whichever way the column is sorted.
+- (void)testStable
+{
+    NSMutableArray *sorted; // list sorted by brew time
+    NSNumber *ascending; // which way to sort
+    NSUInteger before, after; // first positions of two neighbouring rows
+    NSUInteger i; // loop counter
+
+    for (ascending in @[ @YES, @NO ])
+    {
+        sorted = [[mBevys mutableCopy] autorelease];
+        XCTAssertTrue([Cuppa_BevyColumns
+                    sortBevys:sorted
+             usingDescriptors:@[ [NSSortDescriptor sortDescriptorWithKey:@"brewTime"
+                                                               ascending:[ascending boolValue]] ]
+                     sortKeys:nil]);
+        for (i = 1; i < [sorted count]; i++)
+        {
+            if ([[sorted objectAtIndex:i - 1] brewTime] != [[sorted objectAtIndex:i] brewTime])
+                continue;
+            before = [mBevys indexOfObjectIdenticalTo:[sorted objectAtIndex:i - 1]];
+            after = [mBevys indexOfObjectIdenticalTo:[sorted objectAtIndex:i]];
+            XCTAssertLessThan(before, after);
+        }
+    }
+}
+
+// *************************************************************************************************
+
+// Known sort keys give the same order as folding every name, and are not folded again.
+- (void)testSortKeys
+{
+    Cuppa_BevySortKeys *keys; // sort keys kept between sorts
+    NSArray *descriptors; // sort by name
+    NSUInteger folded; // names folded by the first sort
+
+    keys = [[[Cuppa_BevySortKeys alloc] init] autorelease];
+    descriptors = @[ [NSSortDescriptor sortDescriptorWithKey:@"name"
+                                                   ascending:YES
+                                                    selector:@selector(caseInsensitiveCompare:)] ];
+    [self checkDescriptors:descriptors sortKeys:keys];
+    folded = [keys foldCount];
+    XCTAssertEqual(folded, sRows);
+    [self checkDescriptors:descriptors sortKeys:keys];
+    XCTAssertEqual([keys foldCount], folded);
+}
+
+// *************************************************************************************************
+
+// Descriptors with a key or selector the columns can't stand in for leave the list as it was.
+- (void)testUnsupportedDescriptors
+{
+    NSMutableArray *sorted; // copy of the list to sort
+    NSArray *unsupported; // descriptors to try
+    NSSortDescriptor *descriptor; // current descriptor
+
+    unsupported = @[ [NSSortDescriptor sortDescriptorWithKey:@"identifier" ascending:YES],
+                     [NSSortDescriptor sortDescriptorWithKey:@"name" ascending:YES],
+                     [NSSortDescriptor sortDescriptorWithKey:@"brewTime"
+                                                   ascending:YES
+                                                    selector:@selector(caseInsensitiveCompare:)] ];
+    for (descriptor in unsupported)
+    {
+        sorted = [[mBevys mutableCopy] autorelease];
+        XCTAssertFalse([Cuppa_BevyColumns sortBevys:sorted
+                                   usingDescriptors:@[ descriptor ]
+                                           sortKeys:nil]);
+        XCTAssertEqualObjects(sorted, mBevys);
+    }
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_BevyColumnsTests
+
+// end Cuppa_BevyColumnsTests.m
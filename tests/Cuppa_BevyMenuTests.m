@@ -0,0 +1,374 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_BevyMenuTests
+           - Drives the beverage menu update through 10k edits of the beverage list, and checks
+             the menu always matches the list while the live menu items and their retain counts
+             stay flat. Also times updating the menu in place against rebuilding its beverage
+             items, for lists of 10, 1k and 10k beverages.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <AppKit/AppKit.h>
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_BevyMenu.h"
+#import "Cuppa_LazyBevys.h"
+
+// Internal Constants
+
+// Number of beverages in the list, and of edits made to it
+static const NSUInteger sBevyCount = 100;
+static const NSUInteger sEdits = 10000;
+
+// Number of edits timed, each followed by an update of the menu
+static const NSUInteger sTimedEdits = 100;
+
+// Number of fixed items below the beverages (separator, quick timer, cancel)
+static const NSUInteger sFixedItems = 3;
+
+// Number of menu items alive
+static NSInteger sLiveItems = 0;
+
+// Code!
+
+// Menu item that counts how many of its kind are alive.
+@interface CuppaTestMenuItem : NSMenuItem
+@end
+
+@implementation CuppaTestMenuItem
+;
+
+// Initialize, counting one more item alive.
+- (id)initWithTitle:(NSString *)title action:(SEL)action keyEquivalent:(NSString *)key
+{
+    self = [super initWithTitle:title action:action keyEquivalent:key];
+    if (self)
+        sLiveItems++;
+    return self;
+}
+
+// Deallocate, counting one less item alive.
+- (void)dealloc
+{
+    sLiveItems--;
+    [super dealloc];
+}
+
+@end // @implementation CuppaTestMenuItem
+
+// Beverage menu that makes counted menu items.
+@interface CuppaTestBevyMenu : Cuppa_BevyMenu
+@end
+
+@implementation CuppaTestBevyMenu
+;
+
+// Returns the class of the menu items made.
++ (Class)menuItemClass
+{
+    return [CuppaTestMenuItem class];
+}
+
+@end // @implementation CuppaTestBevyMenu
+
+// Returns the identifiers of a beverage list, in order.
+static NSArray *CuppaTestIdentifiers(NSArray *bevys)
+{
+    NSMutableArray *identifiers; // the identifiers
+    NSUInteger i; // loop counter
+
+    identifiers = [NSMutableArray arrayWithCapacity:[bevys count]];
+    for (i = 0; i < [bevys count]; i++)
+    {
+        [identifiers addObject:[bevys bevyIdentifierAtIndex:i]];
+    }
+    return identifiers;
+}
+
+@interface Cuppa_BevyMenuTests : XCTestCase
+{
+    NSMutableArray *mBevys; // beverage list
+    NSMenu *mMenu; // menu under test, with the fixed items only
+    NSObject *mTarget; // target of the beverage items
+}
+@end
+
+@implementation Cuppa_BevyMenuTests
+;
+
+// *************************************************************************************************
+
+// Make a beverage list, and a menu with the fixed items the dock menu has below the beverages.
+- (void)setUp
+{
+    [super setUp];
+    mBevys = [[self bevysWithCount:sBevyCount] retain];
+    mMenu = [[NSMenu alloc] initWithTitle:@"Cuppa"];
+    [mMenu addItem:[NSMenuItem separatorItem]];
+    [mMenu addItemWithTitle:@"Quick Timer..." action:NULL keyEquivalent:@""];
+    [mMenu addItemWithTitle:@"Cancel" action:NULL keyEquivalent:@""];
+    mTarget = [[NSObject alloc] init];
+    sLiveItems = 0;
+}
+
+// *************************************************************************************************
+
+// Release the list, menu and target.
+- (void)tearDown
+{
+    [mMenu release];
+    [mBevys release];
+    [mTarget release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Returns a list of count beverages with distinct names and brew times.
+- (NSMutableArray *)bevysWithCount:(NSUInteger)count
+{
+    NSMutableArray *bevys; // the list
+    Cuppa_Bevy *bevy; // current beverage
+    NSUInteger i; // loop counter
+
+    bevys = [NSMutableArray arrayWithCapacity:count];
+    for (i = 0; i < count; i++)
+    {
+        bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+        [bevy setName:[NSString stringWithFormat:@"Tea %lu", (unsigned long)i]];
+        [bevy setBrewTime:(int)(60 + i)];
+        [bevys addObject:bevy];
+    }
+    return bevys;
+}
+
+// *************************************************************************************************
+
+// Make one edit to the list: a rename, a move, a delete and add, or none (a redisplay).
+- (void)editBevysAtStep:(NSUInteger)step
+{
+    Cuppa_Bevy *bevy; // beverage edited
+    NSUInteger from, to; // rows edited
+
+    from = (step * 7) % [mBevys count];
+    to = (step * 13) % [mBevys count];
+    switch (step % 4)
+    {
+        case 0:
+            [[mBevys objectAtIndex:from]
+                setName:[NSString stringWithFormat:@"Renamed %lu", (unsigned long)step]];
+            break;
+        case 1:
+            bevy = [[mBevys objectAtIndex:from] retain];
+            [mBevys removeObjectAtIndex:from];
+            [mBevys insertObject:bevy atIndex:to];
+            [bevy release];
+            break;
+        case 2:
+            [mBevys removeObjectAtIndex:from];
+            bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+            [bevy setName:[NSString stringWithFormat:@"Added %lu", (unsigned long)step]];
+            [mBevys insertObject:bevy atIndex:to];
+            break;
+        default:
+            break;
+    }
+}
+
+// *************************************************************************************************
+
+// Through 10k edits, with steep times switched on and off, the menu shows the list, and no menu
+// items or retains pile up.
+- (void)testManyEdits
+{
+    NSArray *shown = nil; // identifiers the menu shows
+    NSArray *identifiers; // identifiers of the list after an edit
+    NSUInteger itemRetains; // retain count of a beverage item after the first update
+    NSUInteger targetRetains; // retain count of the target at first
+    NSUInteger step, i; // loop counters
+    NSMenuItem *item; // current beverage item
+
+    targetRetains = [mTarget retainCount];
+    @autoreleasepool
+    {
+        shown = [CuppaTestIdentifiers(mBevys) retain];
+        [CuppaTestBevyMenu updateMenu:mMenu
+                                 from:nil
+                                   to:shown
+                                bevys:mBevys
+                            showSteep:NO
+                       keyEquivalents:YES
+                               target:mTarget];
+    }
+    itemRetains = [[mMenu itemAtIndex:0] retainCount];
+    XCTAssertEqual(sLiveItems, (NSInteger)sBevyCount);
+
+    for (step = 0; step < sEdits; step++)
+    {
+        @autoreleasepool
+        {
+            [self editBevysAtStep:step];
+            identifiers = [CuppaTestIdentifiers(mBevys) retain];
+            [CuppaTestBevyMenu updateMenu:mMenu
+                                     from:shown
+                                       to:identifiers
+                                    bevys:mBevys
+                                showSteep:((step / 500) % 2 == 0)
+                           keyEquivalents:YES
+                                   target:mTarget];
+            [shown release];
+            shown = identifiers;
+        }
+
+        // (checked once the pool is drained, so only items the menu holds are alive)
+        if ([mMenu numberOfItems] != (NSInteger)(sBevyCount + sFixedItems) ||
+            sLiveItems != (NSInteger)sBevyCount)
+        {
+            XCTFail(@"step %lu: %ld items in the menu, %ld alive", (unsigned long)step,
+                    (long)[mMenu numberOfItems], (long)sLiveItems);
+            break;
+        }
+    }
+
+    // every item shows its beverage, and is held only by the menu
+    @autoreleasepool
+    {
+        for (i = 0; i < sBevyCount; i++)
+        {
+            item = [mMenu itemAtIndex:i];
+            XCTAssertEqualObjects([item representedObject], [mBevys bevyIdentifierAtIndex:i]);
+            XCTAssertEqualObjects([item title], [mBevys bevyNameAtIndex:i]);
+            XCTAssertEqual([item target], mTarget);
+            XCTAssertEqual([item retainCount], itemRetains);
+        }
+        XCTAssertEqualObjects([[mMenu itemAtIndex:sBevyCount + 1] title], @"Quick Timer...");
+        XCTAssertEqual([mTarget retainCount], targetRetains);
+        [shown release];
+
+        // and the items go with the menu
+        [mMenu release];
+        mMenu = nil;
+    }
+    XCTAssertEqual(sLiveItems, 0);
+}
+
+// *************************************************************************************************
+
+// Time sTimedEdits edits of a list of count beverages, each followed by an update of the menu in
+// place, or by taking out its beverage items and filling it again as it was before updates were
+// made in place.
+- (void)measureEditsOfCount:(NSUInteger)count rebuild:(BOOL)rebuild
+{
+    __block NSArray *shown; // identifiers the menu shows
+
+    [mBevys release];
+    mBevys = [[self bevysWithCount:count] retain];
+    shown = [CuppaTestIdentifiers(mBevys) retain];
+    [Cuppa_BevyMenu updateMenu:mMenu
+                          from:nil
+                            to:shown
+                         bevys:mBevys
+                     showSteep:NO
+                keyEquivalents:YES
+                        target:mTarget];
+
+    [self measureBlock:^
+    {
+        NSArray *identifiers; // identifiers of the list after an edit
+        NSUInteger step, i; // loop counters
+
+        for (step = 0; step < sTimedEdits; step++)
+        {
+            @autoreleasepool
+            {
+                [self editBevysAtStep:step];
+                identifiers = [CuppaTestIdentifiers(mBevys) retain];
+                if (rebuild)
+                {
+                    for (i = [shown count]; i > 0; i--)
+                    {
+                        [mMenu removeItemAtIndex:i - 1];
+                    }
+                    [shown release];
+                    shown = nil;
+                }
+                [Cuppa_BevyMenu updateMenu:mMenu
+                                      from:shown
+                                        to:identifiers
+                                     bevys:mBevys
+                                 showSteep:NO
+                            keyEquivalents:YES
+                                    target:mTarget];
+                [shown release];
+                shown = identifiers;
+            }
+        }
+    }];
+    XCTAssertEqual([mMenu numberOfItems], (NSInteger)(count + sFixedItems));
+    [shown release];
+}
+
+// *************************************************************************************************
+
+// Updating 10 beverage items in place.
+- (void)testIncremental10Performance
+{
+    [self measureEditsOfCount:10 rebuild:NO];
+}
+
+// *************************************************************************************************
+
+// Rebuilding 10 beverage items.
+- (void)testRebuild10Performance
+{
+    [self measureEditsOfCount:10 rebuild:YES];
+}
+
+// *************************************************************************************************
+
+// Updating 1k beverage items in place.
+- (void)testIncremental1kPerformance
+{
+    [self measureEditsOfCount:1000 rebuild:NO];
+}
+
+// *************************************************************************************************
+
+// Rebuilding 1k beverage items.
+- (void)testRebuild1kPerformance
+{
+    [self measureEditsOfCount:1000 rebuild:YES];
+}
+
+// *************************************************************************************************
+
+// Updating 10k beverage items in place.
+- (void)testIncremental10kPerformance
+{
+    [self measureEditsOfCount:10000 rebuild:NO];
+}
+
+// *************************************************************************************************
+
+// Rebuilding 10k beverage items.
+- (void)testRebuild10kPerformance
+{
+    [self measureEditsOfCount:10000 rebuild:YES];
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_BevyMenuTests
+
+// end Cuppa_BevyMenuTests.m
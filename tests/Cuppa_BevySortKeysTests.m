@@ -0,0 +1,114 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_BevySortKeysTests
+           - Checks an ordinal comparison of sort keys orders accented, decomposed and mixed-case
+             names as caseInsensitiveCompare: does, and that a renamed beverage's key is dropped.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_BevySortKeys.h"
+
+// Code!
+
+// Returns the sign of a comparison, so results of different sizes can be checked against each
+// other.
+static int CuppaTestSign(NSComparisonResult result)
+{
+    return (result < 0) ? -1 : ((result > 0) ? 1 : 0);
+}
+
+@interface Cuppa_BevySortKeysTests : XCTestCase
+{
+    // no instance vars
+}
+@end
+
+@implementation Cuppa_BevySortKeysTests
+;
+
+// *************************************************************************************************
+
+// For every pair of names, comparing their keys a UTF-16 unit at a time agrees with comparing the
+// names with caseInsensitiveCompare:.
+- (void)testMatchesCaseInsensitiveCompare
+{
+    NSArray *names; // names to compare
+    NSString *a, *b; // current pair of names
+
+    names = @[ @"Assam", @"assam", @"ASSAM", @"Assam 2", @"tEA", @"Tea", @"Tea_Time",
+               @"Th\u00E9 vert", @"The\u0301 vert", @"TH\u00C9 VERT", @"The vert", @"Thf",
+               @"\u00C9clair", @"E\u0301clair", @"eclair", @"Ecru", @"f", @"Zo\u00EB", @"Zoe",
+               @"Zoey", @"\u00C5ngstr\u00F6m", @"A\u030Angstro\u0308m", @"Gr\u00FCner Tee",
+               @"GRU\u0308NER TEE", @"\u0427\u0430\u0439", @"\u0447\u0430\u0439",
+               @"\u7DD1\u8336", @"" ];
+    for (a in names)
+    {
+        for (b in names)
+        {
+            XCTAssertEqual(CuppaTestSign([[Cuppa_BevySortKeys keyForName:a]
+                                               compare:[Cuppa_BevySortKeys keyForName:b]
+                                               options:NSLiteralSearch]),
+                           CuppaTestSign([a caseInsensitiveCompare:b]), @"%@ against %@", a, b);
+        }
+    }
+
+    // the same name, composed or not, has the same key
+    XCTAssertEqualObjects([Cuppa_BevySortKeys keyForName:@"Th\u00E9 vert"],
+                          [Cuppa_BevySortKeys keyForName:@"THE\u0301 VERT"]);
+}
+
+// *************************************************************************************************
+
+// A key is kept by identifier until the beverage is renamed and its key forgotten, and a
+// beverage without an identifier is never kept.
+- (void)testForgetOnRename
+{
+    Cuppa_BevySortKeys *keys; // keys under test
+
+    keys = [[Cuppa_BevySortKeys alloc] init];
+    XCTAssertEqualObjects([keys keyForName:@"Assam" identifier:@"tea-1"], @"assam");
+    XCTAssertEqualObjects([keys keyForName:@"Oolong" identifier:@"tea-2"], @"oolong");
+    XCTAssertEqualObjects([keys keyForName:@"Sencha" identifier:nil], @"sencha");
+    XCTAssertEqual([keys count], 2u);
+    XCTAssertEqual([keys foldCount], 3u);
+
+    // a known key is not folded again
+    XCTAssertEqualObjects([keys keyForName:@"Assam" identifier:@"tea-1"], @"assam");
+    XCTAssertEqual([keys foldCount], 3u);
+
+    // renaming drops the old key, so the new name is folded
+    [keys forgetIdentifier:@"tea-1"];
+    XCTAssertNil([keys keyForIdentifier:@"tea-1"]);
+    XCTAssertEqual([keys count], 1u);
+    XCTAssertEqualObjects([keys keyForName:@"Darjeeling" identifier:@"tea-1"], @"darjeeling");
+    XCTAssertEqualObjects([keys keyForIdentifier:@"tea-1"], @"darjeeling");
+    XCTAssertEqual([keys foldCount], 4u);
+
+    // forgetting another or no identifier changes nothing else
+    [keys forgetIdentifier:@"tea-9"];
+    [keys forgetIdentifier:nil];
+    XCTAssertEqualObjects([keys keyForIdentifier:@"tea-2"], @"oolong");
+    XCTAssertEqual([keys count], 2u);
+
+    [keys forgetAll];
+    XCTAssertEqual([keys count], 0u);
+    [keys release];
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_BevySortKeysTests
+
+// end Cuppa_BevySortKeysTests.m
@@ -0,0 +1,428 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_BevyStoreTests
+           - Checks the beverage store replays its change log over the compacted list, ignores a
+             log from another generation, compacts into the preferences or a catalog once the
+             log is long enough, and compacts only once when it has no log to write to.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_BevyStore.h"
+#import "Cuppa_LazyBevys.h"
+#import "Cuppa_PrefsRecorder.h"
+#import "Cuppa_PrefsWriter.h"
+
+// Internal Constants
+
+// How long the writer collects changes for (long enough that no test waits it out by accident)
+static const NSTimeInterval sDelay = 60.0;
+
+// Preference keys the store keeps the compacted list, its catalog and its generation under
+static NSString *const sBevysKey = @"bevys";
+static NSString *const sCatalogKey = @"bevysCatalog";
+static NSString *const sGenerationKey = @"bevysGeneration";
+
+// A log path that can never be written, as no folder can be made inside a device
+static NSString *const sNoLogPath = @"/dev/null/Cuppa/Beverages.log";
+
+// Code!
+
+// Returns the names of a beverage list, in order.
+static NSArray *CuppaTestNames(NSArray *bevys)
+{
+    NSMutableArray *names; // the names
+    NSUInteger i; // loop counter
+
+    names = [NSMutableArray arrayWithCapacity:[bevys count]];
+    for (i = 0; i < [bevys count]; i++)
+    {
+        [names addObject:[bevys bevyNameAtIndex:i]];
+    }
+    return names;
+}
+
+// Returns the identifiers of a beverage list, in order.
+static NSArray *CuppaTestIdentifiers(NSArray *bevys)
+{
+    NSMutableArray *identifiers; // the identifiers
+    NSUInteger i; // loop counter
+
+    identifiers = [NSMutableArray arrayWithCapacity:[bevys count]];
+    for (i = 0; i < [bevys count]; i++)
+    {
+        [identifiers addObject:[bevys bevyIdentifierAtIndex:i]];
+    }
+    return identifiers;
+}
+
+// Returns a list of count beverages named "Tea 0" and up.
+static NSMutableArray *CuppaTestBevys(NSUInteger count)
+{
+    NSMutableArray *bevys; // the list
+    Cuppa_Bevy *bevy; // current beverage
+    NSUInteger i; // loop counter
+
+    bevys = [NSMutableArray arrayWithCapacity:count];
+    for (i = 0; i < count; i++)
+    {
+        bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+        [bevy setName:[NSString stringWithFormat:@"Tea %lu", (unsigned long)i]];
+        [bevy setBrewTime:(int)(60 + i)];
+        [bevys addObject:bevy];
+    }
+    return bevys;
+}
+
+@interface Cuppa_BevyStoreTests : XCTestCase
+{
+    NSString *mFolder; // scratch folder the log and catalogs are kept in
+    NSString *mLogPath; // path of the change log
+    Cuppa_PrefsRecorder *mRecorder; // backend the preferences are written to
+    Cuppa_PrefsWriter *mWriter; // preferences the compacted list is kept in
+}
+@end
+
+@implementation Cuppa_BevyStoreTests
+;
+
+// *************************************************************************************************
+
+// Make fresh preferences, and a fresh scratch folder for the log.
+- (void)setUp
+{
+    [super setUp];
+    mFolder = [[NSTemporaryDirectory() stringByAppendingPathComponent:
+                [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+    mLogPath = [[mFolder stringByAppendingPathComponent:@"Beverages.log"] retain];
+    mRecorder = [[Cuppa_PrefsRecorder alloc] init];
+    mWriter = [[Cuppa_PrefsWriter alloc] initWithBackend:mRecorder delay:sDelay];
+}
+
+// *************************************************************************************************
+
+// Release the preferences, and remove the scratch folder.
+- (void)tearDown
+{
+    [mWriter waitUntilWritten];
+    [mWriter release];
+    [mRecorder release];
+    [[NSFileManager defaultManager] removeItemAtPath:mFolder error:NULL];
+    [mLogPath release];
+    [mFolder release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Let the preferences queue catch up, and run anything it hands back to the main thread (and
+// anything that hands to the queue in turn).
+- (void)settle
+{
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < 2; i++)
+    {
+        [mWriter waitUntilWritten];
+        [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+    }
+    [mWriter waitUntilWritten];
+}
+
+// *************************************************************************************************
+
+// Returns the lines of the change log that hold something.
+- (NSArray *)logLines
+{
+    NSString *log; // the whole log
+
+    [mWriter waitUntilWritten];
+    log = [NSString stringWithContentsOfFile:mLogPath encoding:NSUTF8StringEncoding error:NULL];
+    return [[log componentsSeparatedByString:@"\n"]
+            filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"length > 0"]];
+}
+
+// *************************************************************************************************
+
+// Returns the generation the first line of the change log says it belongs to.
+- (NSInteger)logGeneration
+{
+    NSDictionary *header; // first line of the log
+
+    header = [NSJSONSerialization
+        JSONObjectWithData:[[[self logLines] firstObject] dataUsingEncoding:NSUTF8StringEncoding]
+                   options:0
+                     error:NULL];
+    return [[header objectForKey:@"generation"] integerValue];
+}
+
+// *************************************************************************************************
+
+// Returns a store over the preferences and log, loaded, with three beverages saved as its
+// compacted list.
+- (Cuppa_BevyStore *)storeWithThreeBevys
+{
+    Cuppa_BevyStore *store; // the store
+
+    store = [[[Cuppa_BevyStore alloc] initWithPrefs:mWriter logPath:mLogPath] autorelease];
+    [store load];
+    [store replaceBevys:CuppaTestBevys(3)];
+    XCTAssertEqual([store logCount], 0u);
+    return store;
+}
+
+// *************************************************************************************************
+
+// Make one of each edit to a store's list, reporting each to the store.
+- (void)editStore:(Cuppa_BevyStore *)store
+{
+    NSMutableArray *list; // the store's list
+    Cuppa_Bevy *bevy; // beverage edited
+
+    list = [store bevys];
+    [[list objectAtIndex:0] setName:@"Tea 0, renamed"];
+    [store bevyChanged:[list objectAtIndex:0]];
+
+    bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+    [bevy setName:@"Inserted"];
+    [list insertObject:bevy atIndex:1];
+    [store bevyInserted:bevy atIndex:1];
+
+    bevy = [[list lastObject] retain];
+    [list removeLastObject];
+    [list insertObject:bevy atIndex:0];
+    [store bevyMoved:bevy toIndex:0];
+    [bevy release];
+
+    bevy = [[list objectAtIndex:2] retain];
+    [list removeObjectAtIndex:2];
+    [store bevyRemoved:bevy];
+    [bevy release];
+
+    [list exchangeObjectAtIndex:0 withObjectAtIndex:1];
+    [store bevysReordered];
+}
+
+// *************************************************************************************************
+
+// Edits logged by one store are replayed by the next, giving the same list, names and identifiers
+// and order alike, without compacting again.
+- (void)testReplay
+{
+    Cuppa_BevyStore *store; // store the edits are made through, then one reloading them
+    NSArray *names, *identifiers; // the list after the edits
+    NSInteger generation; // generation the edits were logged against
+
+    @autoreleasepool
+    {
+        store = [self storeWithThreeBevys];
+        [self editStore:store];
+        names = [CuppaTestNames([store bevys]) retain];
+        identifiers = [CuppaTestIdentifiers([store bevys]) retain];
+        generation = [store generation];
+        XCTAssertEqual([store logCount], 5u);
+    }
+    XCTAssertEqual([[self logLines] count], 6u);
+
+    store = [[Cuppa_BevyStore alloc] initWithPrefs:mWriter logPath:mLogPath];
+    [store load];
+    XCTAssertEqualObjects(CuppaTestNames([store bevys]), names);
+    XCTAssertEqualObjects(CuppaTestIdentifiers([store bevys]), identifiers);
+    XCTAssertEqual([store logCount], 5u);
+    XCTAssertEqual([store generation], generation);
+    [store release];
+    [names release];
+    [identifiers release];
+}
+
+// *************************************************************************************************
+
+// A log from another generation of the list is ignored, and one that ends in a torn change is
+// replayed up to it; either way the list is compacted and the log started again.
+- (void)testGenerationMismatch
+{
+    Cuppa_BevyStore *store; // store the edits are made through, then one reloading them
+    NSArray *compacted, *edited; // names before and after the edits
+    NSFileHandle *log; // the log, to tear its end
+    NSInteger generation; // generation the edits were logged against
+
+    @autoreleasepool
+    {
+        store = [self storeWithThreeBevys];
+        compacted = [CuppaTestNames([store bevys]) retain];
+        [self editStore:store];
+        edited = [CuppaTestNames([store bevys]) retain];
+        generation = [store generation];
+    }
+
+    // a torn change at the end loses only that change
+    [mWriter waitUntilWritten];
+    log = [NSFileHandle fileHandleForWritingAtPath:mLogPath];
+    [log seekToEndOfFile];
+    [log writeData:[@"{\"change\":\"upd" dataUsingEncoding:NSUTF8StringEncoding]];
+    [log closeFile];
+    store = [[Cuppa_BevyStore alloc] initWithPrefs:mWriter logPath:mLogPath];
+    [store load];
+    XCTAssertEqualObjects(CuppaTestNames([store bevys]), edited);
+    XCTAssertEqual([store generation], generation + 1);
+    XCTAssertEqual([store logCount], 0u);
+    XCTAssertEqual([[self logLines] count], 1u);
+    XCTAssertEqual([self logGeneration], [store generation]);
+    [store release];
+
+    // a log whose generation the preferences don't have is not replayed at all
+    @autoreleasepool
+    {
+        store = [self storeWithThreeBevys];
+        [compacted release];
+        compacted = [CuppaTestNames([store bevys]) retain];
+        [self editStore:store];
+        generation = [store generation];
+    }
+    [mWriter setObject:[NSNumber numberWithInteger:generation + 10] forKey:sGenerationKey];
+    store = [[Cuppa_BevyStore alloc] initWithPrefs:mWriter logPath:mLogPath];
+    [store load];
+    XCTAssertEqualObjects(CuppaTestNames([store bevys]), compacted);
+    XCTAssertEqual([store generation], generation + 11);
+    XCTAssertEqual([store logCount], 0u);
+    XCTAssertEqual([[self logLines] count], 1u);
+    XCTAssertEqual([self logGeneration], [store generation]);
+    [store release];
+    [compacted release];
+    [edited release];
+}
+
+// *************************************************************************************************
+
+// Once the log is long enough the whole list is written into the preferences and the log started
+// again, and a reload finds the same list.
+- (void)testCompaction
+{
+    Cuppa_BevyStore *store; // store under test
+    Cuppa_Bevy *bevy; // beverage renamed over and over
+    NSInteger generation; // generation before the edits
+    NSUInteger i; // loop counter
+
+    store = [[self storeWithThreeBevys] retain];
+    generation = [store generation];
+    bevy = [[store bevys] objectAtIndex:1];
+    for (i = 1; i < CUPPA_BEVYSTORE_COMPACT_CHANGES; i++)
+    {
+        [bevy setName:[NSString stringWithFormat:@"Renamed %lu", (unsigned long)i]];
+        [store bevyChanged:bevy];
+    }
+    XCTAssertEqual([store logCount], (NSUInteger)CUPPA_BEVYSTORE_COMPACT_CHANGES - 1);
+    XCTAssertEqual([store generation], generation);
+
+    [bevy setName:@"Renamed last"];
+    [store bevyChanged:bevy];
+    XCTAssertEqual([store logCount], 0u);
+    XCTAssertEqual([store generation], generation + 1);
+    XCTAssertEqual([[self logLines] count], 1u);
+    XCTAssertEqualObjects([[mWriter objectForKey:sBevysKey] valueForKey:@"name"],
+                          (@[ @"Tea 0", @"Renamed last", @"Tea 2" ]));
+    XCTAssertNil([mWriter objectForKey:sCatalogKey]);
+    [store release];
+
+    store = [[Cuppa_BevyStore alloc] initWithPrefs:mWriter logPath:mLogPath];
+    [store load];
+    XCTAssertEqualObjects([[store bevys] bevyNameAtIndex:1], @"Renamed last");
+    XCTAssertEqual([store logCount], 0u);
+    XCTAssertEqual([store generation], generation + 1);
+    [store release];
+}
+
+// *************************************************************************************************
+
+// A long list is compacted into a catalog named in the preferences, which a reload reads lazily;
+// compacting again replaces the catalog.
+- (void)testCatalogCompaction
+{
+    Cuppa_BevyStore *store; // store under test
+    NSString *catalog; // name of the catalog saved
+    NSArray *names; // the list saved
+
+    store = [[Cuppa_BevyStore alloc] initWithPrefs:mWriter logPath:mLogPath];
+    [store load];
+    [store replaceBevys:CuppaTestBevys(CUPPA_BEVYSTORE_CATALOG_ROWS)];
+    names = CuppaTestNames([store bevys]);
+    catalog = [mWriter objectForKey:sCatalogKey];
+    XCTAssertEqualObjects(catalog, ([NSString stringWithFormat:@"Beverages-%ld.catalog",
+                                                               (long)[store generation]]));
+    XCTAssertNil([mWriter objectForKey:sBevysKey]);
+    [store release];
+    XCTAssertTrue([[NSFileManager defaultManager]
+        fileExistsAtPath:[mFolder stringByAppendingPathComponent:catalog]]);
+
+    store = [[Cuppa_BevyStore alloc] initWithPrefs:mWriter logPath:mLogPath];
+    [store load];
+    XCTAssertTrue([[store bevys] isKindOfClass:[Cuppa_LazyBevys class]]);
+    XCTAssertEqualObjects(CuppaTestNames([store bevys]), names);
+
+    // an edit and a compaction leave only the new catalog
+    [[[store bevys] objectAtIndex:0] setName:@"Renamed"];
+    [store bevyChanged:[[store bevys] objectAtIndex:0]];
+    [store compact];
+    [mWriter waitUntilWritten];
+    XCTAssertFalse([[NSFileManager defaultManager]
+        fileExistsAtPath:[mFolder stringByAppendingPathComponent:catalog]]);
+    catalog = [mWriter objectForKey:sCatalogKey];
+    XCTAssertTrue([[NSFileManager defaultManager]
+        fileExistsAtPath:[mFolder stringByAppendingPathComponent:catalog]]);
+    [store release];
+}
+
+// *************************************************************************************************
+
+// With no log to write to, the first change compacts the list, once, and the changes made until
+// then are saved by that compaction rather than each compacting again.
+- (void)testNoLog
+{
+    Cuppa_BevyStore *store; // store under test
+    Cuppa_Bevy *bevy; // beverage renamed over and over
+    NSInteger generation; // generation before the edits
+    NSUInteger i; // loop counter
+
+    store = [[Cuppa_BevyStore alloc] initWithPrefs:mWriter logPath:sNoLogPath];
+    [store load];
+    [store replaceBevys:CuppaTestBevys(3)];
+    [self settle];
+    generation = [store generation];
+
+    bevy = [[store bevys] objectAtIndex:0];
+    for (i = 0; i < 50; i++)
+    {
+        [bevy setName:[NSString stringWithFormat:@"Renamed %lu", (unsigned long)i]];
+        [store bevyChanged:bevy];
+    }
+    [self settle];
+    XCTAssertEqual([store generation], generation + 1);
+    XCTAssertEqualObjects([[mWriter objectForKey:sBevysKey] valueForKey:@"name"],
+                          (@[ @"Renamed 49", @"Tea 1", @"Tea 2" ]));
+
+    // the log still can't be started, so later changes wait for the next compaction
+    [bevy setName:@"Renamed again"];
+    [store bevyChanged:bevy];
+    [self settle];
+    XCTAssertEqual([store generation], generation + 1);
+    XCTAssertEqual([store logCount], 1u);
+    [store release];
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_BevyStoreTests
+
+// end Cuppa_BevyStoreTests.m
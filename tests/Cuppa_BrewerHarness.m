@@ -0,0 +1,426 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_BrewerHarness
+           - Simulates whole brews on a virtual clock, checking every completion, countdown beep
+             and wakeup, in no more wall time than it takes to compute them. Also checks the alarm
+             fires once, on time, across a wall-clock jump and a sleep, on awake and continuous
+             clocks.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#include <math.h>
+#include <stdio.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Brew.h"
+#import "Cuppa_Brewer.h"
+#import "Cuppa_Clock.h"
+#import "Cuppa_Schedule.h"
+#import "Cuppa_TimerQueue.h"
+#import "Cuppa_TimerWheel.h"
+
+// Internal Constants
+
+// Longest a completion may land after its deadline
+static const NSTimeInterval sSlackLimit = 0.02;
+
+// Number of brews in the long simulation
+static const NSUInteger sManyBrews = 10000;
+
+// Code!
+
+static int sFailures = 0; // number of checks failed
+
+// Records a failed check, naming where it is.
+#define CHECK(condition)                                                                           \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(condition))                                                                          \
+        {                                                                                          \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);                   \
+            sFailures++;                                                                           \
+        }                                                                                          \
+    } while (0)
+
+// Counts the events of a brewer, checking each one as it comes.
+@interface Cuppa_BrewerEvents : NSObject <Cuppa_BrewerDelegate>
+{
+    NSUInteger mShowCount; // number of countdowns shown
+    NSUInteger mBeepCount; // number of countdown beeps
+    NSUInteger mCompleteCount; // number of brews completed
+    NSUInteger mIdleCount; // number of times the last brew completed
+    NSUInteger mWakeCount; // number of wakeups asked for
+    NSTimeInterval mLastWakeup; // time of the last wakeup asked for
+    NSTimeInterval mLastDeadline; // deadline of the last brew completed
+    NSTimeInterval mSlack; // longest a completion may land after its deadline
+}
+
+// Sets the longest a completion may land after its deadline.
+- (void)setSlack:(NSTimeInterval)slack;
+
+// Returns the number of countdowns shown.
+- (NSUInteger)showCount;
+
+// Returns the number of countdown beeps.
+- (NSUInteger)beepCount;
+
+// Returns the number of brews completed.
+- (NSUInteger)completeCount;
+
+// Returns the number of times the last brew completed.
+- (NSUInteger)idleCount;
+
+// Returns the number of wakeups asked for.
+- (NSUInteger)wakeCount;
+
+// Returns the time of the last wakeup asked for.
+- (NSTimeInterval)lastWakeup;
+
+@end // @interface Cuppa_BrewerEvents
+
+@implementation Cuppa_BrewerEvents
+;
+
+- (id)init
+{
+    self = [super init];
+    mLastWakeup = INFINITY;
+    mLastDeadline = -INFINITY;
+    mSlack = sSlackLimit;
+    return self;
+}
+
+- (void)setSlack:(NSTimeInterval)slack
+{
+    mSlack = slack;
+}
+
+- (void)brewer:(Cuppa_Brewer *)brewer showBrew:(Cuppa_Brew *)brew secondsRemain:(int)secondsRemain
+{
+    // the countdown shows the next brew to complete, as it stands now (never more than its
+    // brew time)
+    CHECK(brew == [brewer nextBrew]);
+    CHECK(secondsRemain == MIN(CuppaScheduleSecondsRemain([brew deadline] - [[brewer clock] now]),
+                               [brew brewTime]));
+    mShowCount++;
+}
+
+- (void)brewerBeep:(Cuppa_Brewer *)brewer
+{
+    // beeps are only for the final seconds of the next brew to complete
+    CHECK([[brewer nextBrew] deadline] - [[brewer clock] now] <= CUPPA_SCHEDULE_BEEP_SECONDS);
+    mBeepCount++;
+}
+
+- (void)brewer:(Cuppa_Brewer *)brewer brewComplete:(Cuppa_Brew *)brew
+{
+    // brews complete just after their deadlines, in order
+    CHECK([[brewer clock] now] >= [brew deadline]);
+    CHECK([[brewer clock] now] < [brew deadline] + mSlack);
+    CHECK([brew deadline] >= mLastDeadline);
+    mLastDeadline = [brew deadline];
+    mCompleteCount++;
+}
+
+- (void)brewerIdle:(Cuppa_Brewer *)brewer
+{
+    CHECK([brewer count] == 0);
+    mIdleCount++;
+}
+
+- (void)brewer:(Cuppa_Brewer *)brewer wakeAt:(NSTimeInterval)time
+{
+    // a wakeup is never in the past, and only missing when there is nothing to wake up for
+    CHECK(time >= [[brewer clock] now]);
+    CHECK((isinf(time) != 0) == ([brewer count] == 0));
+    mLastWakeup = time;
+    mWakeCount++;
+}
+
+- (NSUInteger)showCount
+{
+    return mShowCount;
+}
+
+- (NSUInteger)beepCount
+{
+    return mBeepCount;
+}
+
+- (NSUInteger)completeCount
+{
+    return mCompleteCount;
+}
+
+- (NSUInteger)idleCount
+{
+    return mIdleCount;
+}
+
+- (NSUInteger)wakeCount
+{
+    return mWakeCount;
+}
+
+- (NSTimeInterval)lastWakeup
+{
+    return mLastWakeup;
+}
+
+@end // @implementation Cuppa_BrewerEvents
+
+// Returns a new brewer on a virtual clock, tracking brews in a backend of class backendClass and
+// reporting to events.
+static Cuppa_Brewer *NewBrewer(Class backendClass, Cuppa_BrewerEvents *events)
+{
+    Cuppa_Clock *clock; // virtual clock the brews run on
+    id<Cuppa_TimerBackend> backend; // where the brews are tracked
+    Cuppa_Brewer *brewer; // the new brewer
+
+    clock = [[[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_VIRTUAL] autorelease];
+    backend = [[[backendClass alloc] init] autorelease];
+    brewer = [[[Cuppa_Brewer alloc] initWithClock:clock backend:backend] autorelease];
+    [brewer setDelegate:events];
+    return brewer;
+}
+
+// Returns a beverage that brews for brewTime seconds.
+static Cuppa_Bevy *NewBevy(int brewTime)
+{
+    Cuppa_Bevy *bevy; // the new beverage
+
+    bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+    [bevy setName:@"Harness Tea"];
+    [bevy setBrewTime:brewTime];
+    return bevy;
+}
+
+// Runs a single brew through to completion, checking each wakeup is for something observable.
+static void TestSingleBrew(Class backendClass, BOOL showTimer, BOOL makeSound)
+{
+    Cuppa_BrewerEvents *events; // what the brewer reported
+    Cuppa_Brewer *brewer; // the brewer under test
+    NSUInteger ticks; // ticks the brew took
+
+    events = [[[Cuppa_BrewerEvents alloc] init] autorelease];
+    brewer = NewBrewer(backendClass, events);
+    [brewer setShowTimer:showTimer];
+    [brewer setMakeSound:makeSound];
+    [brewer startBrew:NewBevy(180)];
+    ticks = [brewer runUntil:200.0];
+
+    // the countdown ticks every second, beeps tick for the final seconds, or just the alarm does
+    if (showTimer)
+        CHECK(ticks == 180);
+    else if (makeSound)
+        CHECK(ticks == CUPPA_SCHEDULE_BEEP_SECONDS + 1);
+    else
+        CHECK(ticks == 1);
+
+    // the countdown is shown at the start and at every tick but the last
+    CHECK([events showCount] == ticks);
+    CHECK([events beepCount] == (makeSound ? CUPPA_SCHEDULE_BEEP_SECONDS : 0));
+    CHECK([events completeCount] == 1);
+    CHECK([events idleCount] == 1);
+    CHECK([events wakeCount] == ticks + 1);
+    CHECK(isinf([events lastWakeup]));
+    CHECK([brewer count] == 0);
+    CHECK([[brewer clock] now] == 200.0);
+}
+
+// Runs brews that end in the same second, which beep once per second between them.
+static void TestBeepWindow(Class backendClass)
+{
+    Cuppa_BrewerEvents *events; // what the brewer reported
+    Cuppa_Brewer *brewer; // the brewer under test
+
+    events = [[[Cuppa_BrewerEvents alloc] init] autorelease];
+    brewer = NewBrewer(backendClass, events);
+    [brewer setShowTimer:NO];
+    [brewer startBrew:NewBevy(60)];
+    [brewer startBrew:NewBevy(60)];
+    [brewer startBrew:NewBevy(60)];
+    CHECK([brewer runUntil:61.0] == CUPPA_SCHEDULE_BEEP_SECONDS + 1);
+    CHECK([events beepCount] == CUPPA_SCHEDULE_BEEP_SECONDS);
+    CHECK([events completeCount] == 3);
+    CHECK([events idleCount] == 1);
+}
+
+// Cancels brews part way through, after which nothing more happens.
+static void TestCancel(Class backendClass)
+{
+    Cuppa_BrewerEvents *events; // what the brewer reported
+    Cuppa_Brewer *brewer; // the brewer under test
+
+    events = [[[Cuppa_BrewerEvents alloc] init] autorelease];
+    brewer = NewBrewer(backendClass, events);
+    [brewer startBrew:NewBevy(30)];
+    [brewer startBrew:NewBevy(300)];
+    [brewer runUntil:10.0];
+    [brewer cancelAllBrews];
+    CHECK(isinf([brewer nextWakeup]));
+    CHECK(isinf([events lastWakeup]));
+    CHECK([brewer runUntil:1000.0] == 0);
+    CHECK([events completeCount] == 0);
+    CHECK([events beepCount] == 0);
+    CHECK([brewer count] == 0);
+}
+
+// Runs a brew across a wall-clock jump and a sleep, on a clock that counts sleep or not. The
+// alarm fires once, at its deadline on the clock either way.
+static void TestSleepAndJump(Class backendClass, BOOL countsSleep)
+{
+    Cuppa_BrewerEvents *events; // what the brewer reported
+    Cuppa_Brewer *brewer; // the brewer under test
+    Cuppa_Clock *clock; // virtual clock the brew runs on
+
+    events = [[[Cuppa_BrewerEvents alloc] init] autorelease];
+    brewer = NewBrewer(backendClass, events);
+    clock = [brewer clock];
+    [clock setCountsSleep:countsSleep];
+    [brewer setShowTimer:NO];
+    [brewer setMakeSound:NO];
+    CHECK([[brewer startBrew:NewBevy(180)] deadline] == 180.0);
+    CHECK([brewer runUntil:60.0] == 0);
+
+    // setting the system time back an hour moves the date, but not the clock or the alarm
+    [clock jumpWallClockBy:-3600.0];
+    CHECK([clock now] == 60.0);
+    CHECK([[clock date] timeIntervalSinceReferenceDate] == 60.0 - 3600.0);
+    CHECK([brewer nextWakeup] == 180.0);
+
+    // sleeping 50 seconds moves the clock on only if it counts sleep
+    CHECK([brewer runUntil:100.0] == 0);
+    [clock sleepFor:50.0];
+    CHECK([clock now] == (countsSleep ? 150.0 : 100.0));
+    CHECK([[clock date] timeIntervalSinceReferenceDate] == 150.0 - 3600.0);
+    CHECK([brewer runUntil:179.0] == 0);
+    CHECK([events completeCount] == 0);
+
+    // so the alarm fires at 180 on the clock, which by the date is 50 seconds later on an awake
+    // clock, and only fires once
+    CHECK([brewer runUntil:180.0] == 1);
+    CHECK([events completeCount] == 1);
+    CHECK([[clock date] timeIntervalSinceReferenceDate] ==
+          (countsSleep ? 180.0 : 230.0) - 3600.0);
+    CHECK([brewer runUntil:1000.0] == 0);
+    CHECK([events completeCount] == 1);
+    CHECK([events idleCount] == 1);
+}
+
+// Sleeps through a brew's deadline on a continuous clock. The alarm fires once, on waking, and
+// the countdown seconds slept through are not caught up on.
+static void TestSleepThrough(Class backendClass)
+{
+    Cuppa_BrewerEvents *events; // what the brewer reported
+    Cuppa_Brewer *brewer; // the brewer under test
+    Cuppa_Clock *clock; // virtual clock the brew runs on
+
+    events = [[[Cuppa_BrewerEvents alloc] init] autorelease];
+    brewer = NewBrewer(backendClass, events);
+    clock = [brewer clock];
+    [brewer setShowTimer:YES];
+    [brewer setMakeSound:YES];
+    [brewer startBrew:NewBevy(180)];
+    [brewer runUntil:100.0];
+    [clock sleepFor:200.0];
+    CHECK([clock now] == 300.0);
+
+    // the completion lands when the clock wakes, 120 seconds after its deadline
+    [events setSlack:121.0];
+    CHECK([brewer runUntil:300.0] == 1);
+    CHECK([events completeCount] == 1);
+    CHECK([events idleCount] == 1);
+    CHECK([brewer runUntil:1000.0] == 0);
+    CHECK([events completeCount] == 1);
+    CHECK([brewer count] == 0);
+}
+
+// Runs many overlapping brews, started at odd times, and reports how long the simulation took.
+static void TestManyBrews(Class backendClass)
+{
+    Cuppa_Clock *wallClock; // times the simulation
+    Cuppa_BrewerEvents *events; // what the brewer reported
+    Cuppa_Brewer *brewer; // the brewer under test
+    NSTimeInterval wallStart; // wall time the simulation started
+    NSTimeInterval lastDeadline; // deadline of the last brew to complete
+    NSUInteger ticks; // ticks the brews took
+    uint32_t seed; // for brew times, the same on every run
+    int brewTime; // brew time of the next brew
+    NSUInteger i; // loop counter
+
+    wallClock = [[[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_AWAKE] autorelease];
+    events = [[[Cuppa_BrewerEvents alloc] init] autorelease];
+    brewer = NewBrewer(backendClass, events);
+    wallStart = [wallClock now];
+
+    // start a brew every 0.37 seconds, each between the shortest brew time and an hour
+    seed = 1;
+    ticks = 0;
+    lastDeadline = 0.0;
+    for (i = 0; i < sManyBrews; i++)
+    {
+        @autoreleasepool
+        {
+            ticks += [brewer runUntil:(i * 0.37)];
+            seed = (seed * 1103515245) + 12345;
+            brewTime = CUPPA_BEVY_BREW_TIME_MIN + (int)((seed >> 16) % 3591);
+            lastDeadline = MAX(lastDeadline, [[brewer startBrew:NewBevy(brewTime)] deadline]);
+        }
+    }
+    CHECK(lastDeadline == [brewer lastDeadline]);
+    @autoreleasepool
+    {
+        ticks += [brewer runUntil:(lastDeadline + 1.0)];
+    }
+
+    // every brew completes, and the brewer goes idle only once (they all overlap)
+    CHECK([events completeCount] == sManyBrews);
+    CHECK([events idleCount] == 1);
+    CHECK([brewer count] == 0);
+    CHECK(isinf([brewer nextWakeup]));
+
+    printf("Cuppa_BrewerHarness: %lu brews over %.0f secs in %lu ticks, %.3f secs wall (%s)\n",
+           (unsigned long)sManyBrews, lastDeadline, (unsigned long)ticks,
+           [wallClock now] - wallStart, [NSStringFromClass(backendClass) UTF8String]);
+}
+
+int main(void)
+{
+    Class backends[2]; // timer backends to run the brews on
+    int i; // loop counter
+
+    backends[0] = [Cuppa_TimerQueue class];
+    backends[1] = [Cuppa_TimerWheel class];
+    for (i = 0; i < 2; i++)
+    {
+        @autoreleasepool
+        {
+            TestSingleBrew(backends[i], YES, YES);
+            TestSingleBrew(backends[i], YES, NO);
+            TestSingleBrew(backends[i], NO, YES);
+            TestSingleBrew(backends[i], NO, NO);
+            TestBeepWindow(backends[i]);
+            TestCancel(backends[i]);
+            TestSleepAndJump(backends[i], YES);
+            TestSleepAndJump(backends[i], NO);
+            TestSleepThrough(backends[i]);
+            TestManyBrews(backends[i]);
+        }
+    }
+
+    printf("Cuppa_BrewerHarness: %s\n", sFailures == 0 ? "passed" : "FAILED");
+    return sFailures == 0 ? 0 : 1;
+}
+
+// end Cuppa_BrewerHarness.m
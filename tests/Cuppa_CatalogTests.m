@@ -0,0 +1,280 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_CatalogTests
+           - Checks beverages survive a round trip through a catalog, that a damaged header is
+             refused, and that string fields out of bounds or not UTF-8 read as empty.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Catalog.h"
+
+// Internal Constants
+
+// Word numbers of the header fields (after the magic) and of the record fields, as stored
+enum
+{
+    sHeaderVersion = 1,
+    sHeaderRecordSize,
+    sHeaderCount,
+    sHeaderStringCount,
+    sHeaderOffsets,
+    sHeaderStrings,
+    sHeaderStringsLength
+};
+enum
+{
+    sRecordName = 0,
+    sRecordIdentifier,
+    sRecordCupShape,
+    sRecordAlarmSound,
+    sRecordBrewTime
+};
+
+// Code!
+
+// Returns the word at byte offset of catalog data.
+static uint32_t CuppaTestWord(NSData *data, NSUInteger offset)
+{
+    uint32_t word; // word as stored
+
+    [data getBytes:&word range:NSMakeRange(offset, sizeof(word))];
+    return NSSwapLittleIntToHost(word);
+}
+
+// Sets the word at byte offset of catalog data.
+static void CuppaTestSetWord(NSMutableData *data, NSUInteger offset, uint32_t value)
+{
+    uint32_t word = NSSwapHostIntToLittle(value); // word as stored
+
+    [data replaceBytesInRange:NSMakeRange(offset, sizeof(word)) withBytes:&word];
+}
+
+// Returns the byte offset of field of record index.
+static NSUInteger CuppaTestField(NSUInteger index, NSUInteger field)
+{
+    return CUPPA_CATALOG_HEADER_SIZE + (index * CUPPA_CATALOG_RECORD_SIZE) + (field * 4);
+}
+
+// Returns the byte offset of the offset of string number.
+static NSUInteger CuppaTestOffset(NSData *data, NSUInteger number)
+{
+    return CuppaTestWord(data, sHeaderOffsets * 4) + (number * 4);
+}
+
+@interface Cuppa_CatalogTests : XCTestCase
+{
+    NSArray *mDicts; // beverages, as stored in user defaults
+    NSData *mData; // the same beverages as a catalog
+}
+@end
+
+@implementation Cuppa_CatalogTests
+;
+
+// *************************************************************************************************
+
+// Write a few beverages, with and without the optional fields, to a catalog.
+- (void)setUp
+{
+    [super setUp];
+    mDicts = [@[ @{ @"name" : @"Assam", @"brewTime" : @240, @"cupShape" : @"no-such-shape",
+                    @"identifier" : @"assam", @"alarmSound" : @"/Library/Sounds/Gong.aiff" },
+                 @{ @"name" : @"Darjeeling", @"brewTime" : @180 },
+                 @{ @"name" : @"Pu-erh", @"brewTime" : @300, @"identifier" : @"pu-erh" } ]
+              retain];
+    mData = [[Cuppa_Catalog fromDictionary:mDicts] retain];
+}
+
+// *************************************************************************************************
+
+// Release the beverages and catalog.
+- (void)tearDown
+{
+    [mData release];
+    [mDicts release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Returns a catalog over a changed copy of the data, or nil if it is refused.
+- (Cuppa_Catalog *)catalogWithChange:(void (^)(NSMutableData *data))change
+{
+    NSMutableData *data; // changed copy
+
+    data = [[mData mutableCopy] autorelease];
+    change(data);
+    return [[[Cuppa_Catalog alloc] initWithData:data] autorelease];
+}
+
+// *************************************************************************************************
+
+// Every field reads back as written, missing ones filled in, and writing the result again gives
+// the same catalog.
+- (void)testRoundTrip
+{
+    Cuppa_Catalog *catalog; // catalog under test
+    NSArray *dicts; // beverages read back
+
+    catalog = [[[Cuppa_Catalog alloc] initWithData:mData] autorelease];
+    XCTAssertNotNil(catalog);
+    XCTAssertEqual([catalog count], 3u);
+    XCTAssertEqualObjects([catalog nameAtIndex:0], @"Assam");
+    XCTAssertEqualObjects([catalog identifierAtIndex:0], @"assam");
+    XCTAssertEqual([catalog brewTimeAtIndex:0], 240);
+    XCTAssertEqual([catalog cupShapeAtIndex:0], CUPPA_SHAPE_DEFAULT);
+    XCTAssertEqualObjects([catalog alarmSoundAtIndex:0], @"/Library/Sounds/Gong.aiff");
+
+    // a beverage from an older version is given an identifier and the usual sound
+    XCTAssertEqualObjects([catalog nameAtIndex:1], @"Darjeeling");
+    XCTAssertEqual([[catalog identifierAtIndex:1] length], 36u);
+    XCTAssertNil([catalog alarmSoundAtIndex:1]);
+
+    dicts = [catalog toDictionary];
+    XCTAssertEqualObjects([[dicts objectAtIndex:1] objectForKey:@"identifier"],
+                          [catalog identifierAtIndex:1]);
+    XCTAssertEqualObjects([Cuppa_Catalog fromDictionary:dicts], mData);
+    XCTAssertEqualObjects([Cuppa_Catalog fromBevys:[catalog bevys]], mData);
+
+    // brew times out of range are clamped
+    catalog = [self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, CuppaTestField(2, sRecordBrewTime), 99999);
+        CuppaTestSetWord(data, CuppaTestField(1, sRecordBrewTime), 0);
+    }];
+    XCTAssertEqual([catalog brewTimeAtIndex:2], CUPPA_BEVY_BREW_TIME_MAX);
+    XCTAssertEqual([catalog brewTimeAtIndex:1], CUPPA_BEVY_BREW_TIME_MIN);
+}
+
+// *************************************************************************************************
+
+// A catalog with a damaged header, or whose header points past the end of the data, is refused.
+- (void)testBadHeaders
+{
+    NSUInteger length = [mData length]; // length of the good catalog
+
+    XCTAssertNotNil([self catalogWithChange:^(NSMutableData *data) {}]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        [data setLength:0];
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        [data setLength:CUPPA_CATALOG_HEADER_SIZE - 1];
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        [data replaceBytesInRange:NSMakeRange(0, 4) withBytes:"CUPD"];
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, sHeaderVersion * 4, CUPPA_CATALOG_VERSION + 1);
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, sHeaderRecordSize * 4, CUPPA_CATALOG_RECORD_SIZE + 4);
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, sHeaderCount * 4, UINT32_MAX);
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, sHeaderStringCount * 4, UINT32_MAX);
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, sHeaderOffsets * 4, (uint32_t)length);
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, sHeaderStrings * 4, UINT32_MAX);
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, sHeaderStringsLength * 4,
+                         CuppaTestWord(data, sHeaderStringsLength * 4) + 1);
+    }]);
+    XCTAssertNil([self catalogWithChange:^(NSMutableData *data) {
+        [data setLength:length - 1];
+    }]);
+}
+
+// *************************************************************************************************
+
+// A string number or string offset out of bounds reads as empty, and the rest of the row still
+// reads.
+- (void)testStringsOutOfRange
+{
+    Cuppa_Catalog *catalog; // catalog under test
+
+    // a string number past the last string
+    catalog = [self catalogWithChange:^(NSMutableData *data) {
+        CuppaTestSetWord(data, CuppaTestField(0, sRecordName),
+                         CuppaTestWord(data, sHeaderStringCount * 4) + 5);
+    }];
+    XCTAssertNotNil(catalog);
+    XCTAssertEqualObjects([catalog nameAtIndex:0], @"");
+    XCTAssertEqualObjects([catalog identifierAtIndex:0], @"assam");
+    XCTAssertEqual([catalog brewTimeAtIndex:0], 240);
+
+    // a string that ends past the string bytes
+    catalog = [self catalogWithChange:^(NSMutableData *data) {
+        NSUInteger number = CuppaTestWord(data, CuppaTestField(0, sRecordIdentifier));
+        CuppaTestSetWord(data, CuppaTestOffset(data, number + 1),
+                         CuppaTestWord(data, sHeaderStringsLength * 4) + 100);
+    }];
+    XCTAssertEqualObjects([catalog identifierAtIndex:0], @"");
+    XCTAssertEqualObjects([catalog nameAtIndex:0], @"Assam");
+
+    // a string that ends before it starts
+    catalog = [self catalogWithChange:^(NSMutableData *data) {
+        NSUInteger number = CuppaTestWord(data, CuppaTestField(1, sRecordName));
+        CuppaTestSetWord(data, CuppaTestOffset(data, number),
+                         CuppaTestWord(data, CuppaTestOffset(data, number + 1)) + 1);
+    }];
+    XCTAssertEqualObjects([catalog nameAtIndex:1], @"");
+    XCTAssertEqualObjects([[catalog dictionaryAtIndex:1] objectForKey:@"name"], @"");
+    XCTAssertEqual([catalog brewTimeAtIndex:1], 180);
+}
+
+// *************************************************************************************************
+
+// Bytes that are not UTF-8 read as an empty string, or as the default shape for a shape label.
+- (void)testNonUTF8
+{
+    Cuppa_Catalog *catalog; // catalog under test
+
+    catalog = [self catalogWithChange:^(NSMutableData *data) {
+        NSUInteger strings = CuppaTestWord(data, sHeaderStrings * 4);
+        NSUInteger name = CuppaTestWord(data, CuppaTestField(0, sRecordName));
+        NSUInteger shape = CuppaTestWord(data, CuppaTestField(1, sRecordCupShape));
+        uint8_t bad = 0xFF;
+        [data replaceBytesInRange:NSMakeRange(strings + CuppaTestWord(data,
+                                                                      CuppaTestOffset(data, name)),
+                                              1)
+                        withBytes:&bad];
+        [data replaceBytesInRange:NSMakeRange(strings + CuppaTestWord(data,
+                                                                      CuppaTestOffset(data, shape)),
+                                              1)
+                        withBytes:&bad];
+    }];
+    XCTAssertNotNil(catalog);
+    XCTAssertEqualObjects([catalog nameAtIndex:0], @"");
+    XCTAssertEqualObjects([[catalog bevyAtIndex:0] name], @"");
+    XCTAssertEqual([catalog cupShapeAtIndex:1], CUPPA_SHAPE_DEFAULT);
+    XCTAssertEqualObjects([catalog nameAtIndex:1], @"Darjeeling");
+
+    // and writing it out again stores the empty name
+    catalog = [[[Cuppa_Catalog alloc] initWithData:
+                [Cuppa_Catalog fromDictionary:[catalog toDictionary]]] autorelease];
+    XCTAssertEqualObjects([catalog nameAtIndex:0], @"");
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_CatalogTests
+
+// end Cuppa_CatalogTests.m
@@ -0,0 +1,234 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_LazyBevysTests
+           - Checks a lazy beverage list reads single fields straight from its catalog, keeps only
+             so many rows decoded for reading and drops the least recent first, makes objects only
+             of rows fetched as objects, and snapshots its rows for saving.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Catalog.h"
+#import "Cuppa_LazyBevys.h"
+#import "Cuppa_Shape.h"
+
+// Internal Constants
+
+// Number of rows in the test catalog
+static const NSUInteger sRows = 200;
+
+// Decoded rows kept by the lists under test
+static const NSUInteger sHotRows = 4;
+
+// Code!
+
+@interface Cuppa_LazyBevysTests : XCTestCase
+{
+    NSMutableArray *mDicts; // the rows, as beverage dictionaries
+    Cuppa_Catalog *mCatalog; // the rows, as a catalog
+    Cuppa_LazyBevys *mBevys; // list under test
+}
+@end
+
+@implementation Cuppa_LazyBevysTests
+;
+
+// *************************************************************************************************
+
+// Make a catalog of rows with distinct names, brew times and identifiers, and a list over it.
+- (void)setUp
+{
+    NSUInteger i; // loop counter
+
+    [super setUp];
+    mDicts = [[NSMutableArray alloc] init];
+    for (i = 0; i < sRows; i++)
+    {
+        [mDicts addObject:@{
+            @"name" : [NSString stringWithFormat:@"Tea %lu", (unsigned long)i],
+            @"brewTime" : [NSNumber numberWithInt:(int)(60 + i)],
+            @"cupShape" : [Cuppa_Shape labelForShape:(int)(i % [Cuppa_Shape shapeCount])],
+            @"identifier" : [NSString stringWithFormat:@"tea-%lu", (unsigned long)i]
+        }];
+    }
+    mCatalog = [[Cuppa_Catalog alloc] initWithData:[Cuppa_Catalog fromDictionary:mDicts]];
+    mBevys = [[Cuppa_LazyBevys alloc] initWithCatalog:mCatalog hotCapacity:sHotRows];
+}
+
+// *************************************************************************************************
+
+// Release the list, catalog and rows.
+- (void)tearDown
+{
+    [mBevys release];
+    [mCatalog release];
+    [mDicts release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// The list can be made empty through NSMutableArray's initializer, and then filled.
+- (void)testInitWithCapacity
+{
+    Cuppa_LazyBevys *bevys; // empty list
+    Cuppa_Bevy *bevy; // beverage added to it
+
+    bevys = [[Cuppa_LazyBevys alloc] initWithCapacity:4];
+    XCTAssertNotNil(bevys);
+    XCTAssertEqual([bevys count], 0u);
+
+    bevy = [[[Cuppa_Bevy alloc] init] autorelease];
+    [bevy setName:@"Rooibos"];
+    [bevys addObject:bevy];
+    XCTAssertEqual([bevys count], 1u);
+    XCTAssertEqualObjects([bevys bevyNameAtIndex:0], @"Rooibos");
+    XCTAssertEqual([bevys objectAtIndex:0], bevy);
+    [bevys release];
+}
+
+// *************************************************************************************************
+
+// Single fields are read from the catalog, without making objects or decoding whole rows.
+- (void)testPrimitives
+{
+    NSDictionary *dict; // expected row
+    NSUInteger i; // loop counter
+
+    XCTAssertEqual([mBevys count], sRows);
+    for (i = 0; i < sRows; i++)
+    {
+        dict = [mDicts objectAtIndex:i];
+        XCTAssertEqualObjects([mBevys bevyNameAtIndex:i], [dict objectForKey:@"name"]);
+        XCTAssertEqual([mBevys bevyBrewTimeAtIndex:i], [[dict objectForKey:@"brewTime"] intValue]);
+        XCTAssertEqual([mBevys bevyCupShapeAtIndex:i],
+                       [Cuppa_Shape shapeForLabel:[dict objectForKey:@"cupShape"]]);
+        XCTAssertEqualObjects([mBevys bevyIdentifierAtIndex:i], [dict objectForKey:@"identifier"]);
+    }
+    XCTAssertEqual([mBevys materializedCount], 0u);
+    XCTAssertEqual([mBevys hotCount], 0u);
+}
+
+// *************************************************************************************************
+
+// Only so many rows are kept decoded for reading, and the one read least recently goes first.
+- (void)testEviction
+{
+    Cuppa_Bevy *first; // first row read
+    Cuppa_Bevy *second; // second row read
+    NSUInteger i; // loop counter
+
+    first = [[mBevys bevyForReadingAtIndex:0] retain];
+    second = [[mBevys bevyForReadingAtIndex:1] retain];
+    for (i = 2; i < sHotRows; i++)
+    {
+        [mBevys bevyForReadingAtIndex:i];
+    }
+    XCTAssertEqual([mBevys hotCount], sHotRows);
+
+    // reading the first again makes the second the least recent, so it goes for the next row
+    XCTAssertEqual([mBevys bevyForReadingAtIndex:0], first);
+    [mBevys bevyForReadingAtIndex:sHotRows];
+    XCTAssertEqual([mBevys hotCount], sHotRows);
+    XCTAssertEqual([mBevys bevyForReadingAtIndex:0], first);
+    XCTAssertNotEqual([mBevys bevyForReadingAtIndex:1], second);
+
+    // a dropped row is still fine to read by whoever kept it, and is never part of the list
+    XCTAssertEqualObjects([second name], @"Tea 1");
+    XCTAssertEqual([mBevys materializedCount], 0u);
+    [first release];
+    [second release];
+}
+
+// *************************************************************************************************
+
+// A row fetched as an object stays the same object, taking over its decoded copy if it has one.
+- (void)testMaterialize
+{
+    Cuppa_Bevy *read; // row read
+    Cuppa_Bevy *bevy; // row fetched as an object
+
+    read = [mBevys bevyForReadingAtIndex:7];
+    XCTAssertEqual([mBevys hotCount], 1u);
+    bevy = [mBevys objectAtIndex:7];
+    XCTAssertEqual(bevy, read);
+    XCTAssertEqual([mBevys hotCount], 0u);
+    XCTAssertEqual([mBevys objectAtIndex:7], bevy);
+    XCTAssertEqual([mBevys bevyForReadingAtIndex:7], bevy);
+    XCTAssertEqual([mBevys materializedCount], 1u);
+
+    // its fields are read from the object from then on
+    [bevy setBrewTime:600];
+    [bevy setName:@"Lapsang"];
+    XCTAssertEqual([mBevys bevyBrewTimeAtIndex:7], 600);
+    XCTAssertEqualObjects([mBevys bevyNameAtIndex:7], @"Lapsang");
+}
+
+// *************************************************************************************************
+
+// Reordering moves the rows as they are, without making objects of them.
+- (void)testReorder
+{
+    NSUInteger rows[sRows]; // new order: reversed
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < sRows; i++)
+    {
+        rows[i] = sRows - 1 - i;
+    }
+    [mBevys reorderBevysByRows:rows];
+    for (i = 0; i < sRows; i++)
+    {
+        XCTAssertEqualObjects([mBevys bevyIdentifierAtIndex:i],
+                              [[mDicts objectAtIndex:sRows - 1 - i] objectForKey:@"identifier"]);
+    }
+    XCTAssertEqual([mBevys materializedCount], 0u);
+}
+
+// *************************************************************************************************
+
+// The rows are snapshotted as catalog indexes, except edited ones, and save to the same list.
+- (void)testRows
+{
+    NSArray *rows; // snapshot
+    Cuppa_Catalog *saved; // snapshot saved as a catalog
+    NSUInteger i; // loop counter
+
+    [[mBevys objectAtIndex:1] setBrewTime:900];
+    rows = [mBevys bevyRows];
+    XCTAssertEqual([mBevys bevyCatalog], mCatalog);
+    XCTAssertEqual([rows count], sRows);
+    XCTAssertTrue([[rows objectAtIndex:0] isKindOfClass:[NSNumber class]]);
+    XCTAssertTrue([[rows objectAtIndex:1] isKindOfClass:[NSDictionary class]]);
+
+    saved = [[Cuppa_Catalog alloc] initWithData:[Cuppa_Catalog fromRows:rows ofCatalog:mCatalog]];
+    XCTAssertEqual([saved count], sRows);
+    for (i = 0; i < sRows; i++)
+    {
+        XCTAssertEqualObjects([saved identifierAtIndex:i], [mBevys bevyIdentifierAtIndex:i]);
+        XCTAssertEqual([saved brewTimeAtIndex:i], [mBevys bevyBrewTimeAtIndex:i]);
+    }
+    XCTAssertEqual([saved brewTimeAtIndex:1], 900);
+    [saved release];
+
+    // a plain list has no catalog, and snapshots as dictionaries
+    XCTAssertNil([mDicts bevyCatalog]);
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_LazyBevysTests
+
+// end Cuppa_LazyBevysTests.m
@@ -0,0 +1,265 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_ListDiffTests
+           - Checks list differences for repeated items, pure moves and empty lists, that applying
+             them turns the old list into the new one, and that they make the fewest changes.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_ListDiff.h"
+
+// Internal Constants
+
+// Number of random list pairs checked, their longest length, and the items they are drawn from
+static const NSUInteger sRandomPairs = 2000;
+static const NSUInteger sRandomLength = 12;
+static NSString *const sRandomItems = @"abcde";
+
+// Code!
+
+// Returns a list of single-letter items, one per character of letters.
+static NSArray *CuppaTestList(NSString *letters)
+{
+    NSMutableArray *list; // the list
+    NSUInteger i; // loop counter
+
+    list = [NSMutableArray arrayWithCapacity:[letters length]];
+    for (i = 0; i < [letters length]; i++)
+    {
+        [list addObject:[letters substringWithRange:NSMakeRange(i, 1)]];
+    }
+    return list;
+}
+
+// Returns a list of up to sRandomLength items drawn at random from sRandomItems.
+static NSArray *CuppaTestRandomList(void)
+{
+    NSMutableString *letters; // letters of the list
+    NSUInteger length; // number of items
+    NSUInteger i; // loop counter
+
+    letters = [NSMutableString string];
+    length = (NSUInteger)random() % (sRandomLength + 1);
+    for (i = 0; i < length; i++)
+    {
+        [letters appendFormat:@"%C", [sRandomItems characterAtIndex:((NSUInteger)random() %
+                                                                     [sRandomItems length])]];
+    }
+    return CuppaTestList(letters);
+}
+
+// Returns the length of a longest common subsequence of two lists, worked out the slow way.
+static NSUInteger CuppaTestCommonLength(NSArray *a, NSArray *b)
+{
+    NSUInteger *lengths; // common length of each pair of prefixes, a row per prefix of a
+    NSUInteger columns; // entries in a row
+    NSUInteger i, j; // loop counters
+    NSUInteger result; // common length of the whole lists
+
+    columns = [b count] + 1;
+    lengths = calloc(([a count] + 1) * columns, sizeof(NSUInteger));
+    for (i = 0; i < [a count]; i++)
+    {
+        for (j = 0; j < [b count]; j++)
+        {
+            if ([[a objectAtIndex:i] isEqual:[b objectAtIndex:j]])
+                lengths[(i + 1) * columns + j + 1] = lengths[i * columns + j] + 1;
+            else
+                lengths[(i + 1) * columns + j + 1] = MAX(lengths[i * columns + j + 1],
+                                                         lengths[(i + 1) * columns + j]);
+        }
+    }
+    result = lengths[[a count] * columns + [b count]];
+    free(lengths);
+    return result;
+}
+
+@interface Cuppa_ListDiffTests : XCTestCase
+{
+    // no instance vars
+}
+@end
+
+@implementation Cuppa_ListDiffTests
+;
+
+// *************************************************************************************************
+
+// Work out the differences between two lists, and check that applying them as a view would (the
+// removals bottom up, then the insertions top down, kept and moved items taken from the old list)
+// gives the new list, and that the two index maps agree. Returns the differences.
+- (Cuppa_ListDiff *)checkFrom:(NSArray *)oldList to:(NSArray *)newList
+{
+    Cuppa_ListDiff *diff; // differences under test
+    NSMutableArray *applied; // old list with the differences applied
+    NSUInteger i, j; // loop counters
+
+    diff = [[[Cuppa_ListDiff alloc] initFromList:oldList toList:newList] autorelease];
+    applied = [[oldList mutableCopy] autorelease];
+    for (i = [[diff removed] lastIndex]; i != NSNotFound; i = [[diff removed] indexLessThanIndex:i])
+    {
+        [applied removeObjectAtIndex:i];
+    }
+    for (j = [[diff inserted] firstIndex]; j != NSNotFound;
+         j = [[diff inserted] indexGreaterThanIndex:j])
+    {
+        i = [diff oldIndexForNewIndex:j];
+        if (i != NSNotFound)
+            XCTAssertTrue([[diff removed] containsIndex:i]);
+        [applied insertObject:((i != NSNotFound) ? [oldList objectAtIndex:i]
+                                                 : [newList objectAtIndex:j])
+                      atIndex:j];
+    }
+    XCTAssertEqualObjects(applied, newList, @"from %@", oldList);
+
+    for (j = 0; j < [newList count]; j++)
+    {
+        i = [diff oldIndexForNewIndex:j];
+        XCTAssertTrue(i != NSNotFound || [[diff inserted] containsIndex:j]);
+        if (i != NSNotFound)
+        {
+            XCTAssertEqualObjects([oldList objectAtIndex:i], [newList objectAtIndex:j]);
+            XCTAssertEqual([diff newIndexForOldIndex:i], j);
+        }
+    }
+    for (i = 0; i < [oldList count]; i++)
+    {
+        j = [diff newIndexForOldIndex:i];
+        XCTAssertTrue(j != NSNotFound || [[diff removed] containsIndex:i]);
+        if (j != NSNotFound)
+            XCTAssertEqual([diff oldIndexForNewIndex:j], i);
+    }
+    XCTAssertEqual([diff changeCount], [[diff removed] count] + [[diff inserted] count]);
+    return diff;
+}
+
+// *************************************************************************************************
+
+// A repeat of an item is inserted as a new item, and whichever copy keeps the most items in place
+// is kept.
+- (void)testDuplicatesInNewList
+{
+    Cuppa_ListDiff *diff; // differences under test
+
+    diff = [self checkFrom:CuppaTestList(@"ab") to:CuppaTestList(@"bab")];
+    XCTAssertEqual([diff changeCount], 1u);
+    XCTAssertEqualObjects([diff inserted], [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqual([diff oldIndexForNewIndex:0], NSNotFound);
+    XCTAssertEqual([diff oldIndexForNewIndex:1], 0u);
+    XCTAssertEqual([diff oldIndexForNewIndex:2], 1u);
+
+    diff = [self checkFrom:CuppaTestList(@"abc") to:CuppaTestList(@"aabbcc")];
+    XCTAssertEqual([diff changeCount], 3u);
+    XCTAssertEqual([[diff removed] count], 0u);
+
+    // and repeats in both lists are kept where they can be
+    diff = [self checkFrom:CuppaTestList(@"baa") to:CuppaTestList(@"aa")];
+    XCTAssertEqualObjects([diff removed], [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqual([diff changeCount], 1u);
+}
+
+// *************************************************************************************************
+
+// Reordering the same items only moves items: each removed item is inserted again, and the fewest
+// items move.
+- (void)testPureMoves
+{
+    Cuppa_ListDiff *diff; // differences under test
+    NSUInteger j; // loop counter
+
+    // one item from the end to the front
+    diff = [self checkFrom:CuppaTestList(@"abcde") to:CuppaTestList(@"eabcd")];
+    XCTAssertEqualObjects([diff removed], [NSIndexSet indexSetWithIndex:4]);
+    XCTAssertEqualObjects([diff inserted], [NSIndexSet indexSetWithIndex:0]);
+    XCTAssertEqual([diff oldIndexForNewIndex:0], 4u);
+
+    // two neighbours swapped
+    diff = [self checkFrom:CuppaTestList(@"abcde") to:CuppaTestList(@"abdce")];
+    XCTAssertEqual([diff changeCount], 2u);
+
+    // reversed, so all but one move
+    diff = [self checkFrom:CuppaTestList(@"abcde") to:CuppaTestList(@"edcba")];
+    XCTAssertEqual([[diff removed] count], 4u);
+    XCTAssertEqual([[diff inserted] count], 4u);
+    for (j = 0; j < 5; j++)
+    {
+        XCTAssertEqual([diff oldIndexForNewIndex:j], 4 - j);
+    }
+
+    // and the same list makes no changes
+    diff = [self checkFrom:CuppaTestList(@"abcde") to:CuppaTestList(@"abcde")];
+    XCTAssertEqual([diff changeCount], 0u);
+}
+
+// *************************************************************************************************
+
+// From an empty list everything is inserted as new, and to one everything is removed.
+- (void)testEmptyLists
+{
+    Cuppa_ListDiff *diff; // differences under test
+    NSIndexSet *all; // every index of a list of three
+    NSUInteger i; // loop counter
+
+    all = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 3)];
+    diff = [self checkFrom:@[] to:CuppaTestList(@"abc")];
+    XCTAssertEqual([[diff removed] count], 0u);
+    XCTAssertEqualObjects([diff inserted], all);
+    for (i = 0; i < 3; i++)
+    {
+        XCTAssertEqual([diff oldIndexForNewIndex:i], NSNotFound);
+    }
+
+    diff = [self checkFrom:CuppaTestList(@"abc") to:@[]];
+    XCTAssertEqualObjects([diff removed], all);
+    XCTAssertEqual([[diff inserted] count], 0u);
+    for (i = 0; i < 3; i++)
+    {
+        XCTAssertEqual([diff newIndexForOldIndex:i], NSNotFound);
+    }
+
+    diff = [self checkFrom:@[] to:@[]];
+    XCTAssertEqual([diff changeCount], 0u);
+}
+
+// *************************************************************************************************
+
+// For random lists with repeated items, the differences apply cleanly and make exactly as many
+// changes as the items outside a longest common subsequence.
+- (void)testFewestChanges
+{
+    NSArray *oldList, *newList; // current pair of lists
+    NSUInteger common; // length of a longest common subsequence of the pair
+    NSUInteger pair; // loop counter
+
+    srandom(1);
+    for (pair = 0; pair < sRandomPairs; pair++)
+    {
+        @autoreleasepool
+        {
+            oldList = CuppaTestRandomList();
+            newList = CuppaTestRandomList();
+            common = CuppaTestCommonLength(oldList, newList);
+            XCTAssertEqual([[self checkFrom:oldList to:newList] changeCount],
+                           [oldList count] + [newList count] - 2 * common,
+                           @"from %@ to %@", oldList, newList);
+        }
+    }
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_ListDiffTests
+
+// end Cuppa_ListDiffTests.m
@@ -0,0 +1,141 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_NameArenaTests
+           - Checks the name arena shares one string per name, drops a name once its last holder
+             lets go and reuses its handle, and that beverages and catalogs let go of theirs.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Catalog.h"
+#import "Cuppa_NameArena.h"
+
+// Internal Constants
+
+// Number of names added to grow the arena
+static const NSUInteger sManyNames = 1000;
+
+// Code!
+
+@interface Cuppa_NameArenaTests : XCTestCase
+{
+    // no instance vars
+}
+@end
+
+@implementation Cuppa_NameArenaTests
+;
+
+// *************************************************************************************************
+
+// Equal names share a handle and string, and a name lasts until its last hold is released.
+- (void)testHolds
+{
+    Cuppa_NameArena *arena; // arena under test
+    NSMutableString *name; // a name that changes after it is added
+    NSUInteger assam, again, oolong; // handles
+
+    arena = [[Cuppa_NameArena alloc] init];
+    name = [NSMutableString stringWithString:@"Assam"];
+    assam = [arena handleForName:name];
+    [name appendString:@" 2"];
+    again = [arena handleForName:@"Assam"];
+    oolong = [arena handleForName:@"Oolong"];
+    XCTAssertEqual(assam, again);
+    XCTAssertNotEqual(assam, oolong);
+    XCTAssertEqualObjects([arena nameForHandle:assam], @"Assam");
+    XCTAssertEqual([arena count], 2u);
+    XCTAssertEqual([arena characterCount], 11u);
+
+    // the name stays until both holds on it are released
+    [arena releaseHandle:assam];
+    XCTAssertEqualObjects([arena nameForHandle:assam], @"Assam");
+    [arena releaseHandle:again];
+    XCTAssertEqual([arena count], 1u);
+    XCTAssertEqual([arena characterCount], 6u);
+
+    // a new name gets the free handle, and the old name a new one
+    XCTAssertEqual([arena handleForName:@"Sencha"], assam);
+    XCTAssertEqualObjects([arena nameForHandle:assam], @"Sencha");
+    XCTAssertNotEqual([arena handleForName:@"Assam"], assam);
+    XCTAssertEqual([arena count], 3u);
+    [arena release];
+}
+
+// *************************************************************************************************
+
+// Growing past the first capacity keeps every name, and releasing them all empties the arena.
+- (void)testGrow
+{
+    Cuppa_NameArena *arena; // arena under test
+    NSUInteger *handles; // handle of each name
+    NSUInteger i; // loop counter
+
+    arena = [[Cuppa_NameArena alloc] init];
+    handles = malloc(sManyNames * sizeof(NSUInteger));
+    for (i = 0; i < sManyNames; i++)
+    {
+        handles[i] = [arena handleForName:[NSString stringWithFormat:@"Tea %lu", (unsigned long)i]];
+    }
+    XCTAssertEqual([arena count], sManyNames);
+    for (i = 0; i < sManyNames; i++)
+    {
+        XCTAssertEqualObjects([arena nameForHandle:handles[i]],
+                              ([NSString stringWithFormat:@"Tea %lu", (unsigned long)i]));
+        [arena releaseHandle:handles[i]];
+    }
+    XCTAssertEqual([arena count], 0u);
+    XCTAssertEqual([arena characterCount], 0u);
+    free(handles);
+    [arena release];
+}
+
+// *************************************************************************************************
+
+// A beverage lets go of its old name when renamed and of its name when deallocated, and a catalog
+// of the names it has read when it is deallocated.
+- (void)testOwners
+{
+    Cuppa_NameArena *arena = [Cuppa_NameArena sharedArena]; // arena the owners use
+    NSUInteger empty; // handle of the empty name, held so new beverages don't add it
+    NSUInteger count; // names in the arena at first
+    Cuppa_Bevy *bevy; // beverage under test
+    Cuppa_Catalog *catalog; // catalog under test
+
+    empty = [arena handleForName:@""];
+    count = [arena count];
+    bevy = [[Cuppa_Bevy alloc] init];
+    [bevy setName:@"Cuppa_NameArenaTests first name"];
+    XCTAssertEqual([arena count], count + 1);
+    [bevy setName:@"Cuppa_NameArenaTests second name"];
+    XCTAssertEqual([arena count], count + 1);
+    [bevy release];
+    XCTAssertEqual([arena count], count);
+
+    catalog = [[Cuppa_Catalog alloc] initWithData:[Cuppa_Catalog fromDictionary:@[
+        @{ @"name" : @"Cuppa_NameArenaTests catalog name", @"brewTime" : @180 },
+        @{ @"name" : @"Cuppa_NameArenaTests catalog name", @"brewTime" : @240 } ]]];
+    XCTAssertEqualObjects([catalog nameAtIndex:0], [catalog nameAtIndex:1]);
+    XCTAssertEqual([arena count], count + 1);
+    [catalog release];
+    XCTAssertEqual([arena count], count);
+    [arena releaseHandle:empty];
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_NameArenaTests
+
+// end Cuppa_NameArenaTests.m
@@ -0,0 +1,203 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_NotifyTests
+           - Checks brew notifications scheduled up front land on the brew deadlines, and are
+             withdrawn when brews are cancelled, by simulating brews against the notify recorder.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Bevy.h"
+#import "Cuppa_Brew.h"
+#import "Cuppa_Brewer.h"
+#import "Cuppa_Clock.h"
+#import "Cuppa_NotifyRecorder.h"
+#import "Cuppa_TimerQueue.h"
+
+// Internal Constants
+
+// Longest a completion may land after its notification
+static const NSTimeInterval sSlackLimit = 0.02;
+
+// Code!
+
+// The test case is also the brewer's delegate, so it sees each brew complete.
+@interface Cuppa_NotifyTests : XCTestCase <Cuppa_BrewerDelegate>
+{
+    Cuppa_Clock *mClock; // virtual clock the brews run on
+    Cuppa_Brewer *mBrewer; // runs the brews
+    Cuppa_NotifyRecorder *mNotifier; // records the notifications
+    NSUInteger mCompleteCount; // number of brews completed
+}
+@end
+
+@implementation Cuppa_NotifyTests
+;
+
+// *************************************************************************************************
+
+// Make a brewer and notify recorder on a fresh virtual clock.
+- (void)setUp
+{
+    [super setUp];
+    mClock = [[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_VIRTUAL];
+    mBrewer = [[Cuppa_Brewer alloc] initWithClock:mClock
+                                          backend:[[[Cuppa_TimerQueue alloc] init] autorelease]];
+    [mBrewer setDelegate:self];
+    mNotifier = [[Cuppa_NotifyRecorder alloc] initWithClock:mClock];
+    mCompleteCount = 0;
+}
+
+// *************************************************************************************************
+
+// Release the brewer and recorder.
+- (void)tearDown
+{
+    [mBrewer release];
+    [mNotifier release];
+    [mClock release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Start a brew and schedule its notification, as the controller does.
+- (Cuppa_Brew *)startBrew:(int)brewTime
+{
+    Cuppa_Bevy *bevy = [[[Cuppa_Bevy alloc] init] autorelease]; // beverage to brew
+    Cuppa_Brew *brew; // the new brew
+
+    [bevy setName:@"Notify Tea"];
+    [bevy setBrewTime:brewTime];
+    brew = [mBrewer startBrew:bevy];
+    [mNotifier scheduleNotification:[brew identifier]
+                              title:@"Brewing complete..."
+                               body:[brew name]
+                              after:([brew deadline] - [mClock now])];
+    [brew setNotifyScheduled:true];
+    return brew;
+}
+
+// *************************************************************************************************
+
+// Withdraw the notifications of the brews under way and cancel them, as the controller does.
+- (void)cancelBrews
+{
+    [mBrewer enumerateBrewsUsingBlock:^(Cuppa_Brew *brew)
+    {
+        if ([brew notifyScheduled])
+        {
+            [mNotifier withdrawNotification:[brew identifier]];
+            [brew setNotifyScheduled:false];
+        }
+    }];
+    [mBrewer cancelAllBrews];
+}
+
+// *************************************************************************************************
+
+// Each notification is delivered as its brew completes, not a tick later.
+- (void)brewer:(Cuppa_Brewer *)brewer brewComplete:(Cuppa_Brew *)brew
+{
+    NSTimeInterval delivery = [mNotifier deliveryTimeForNotification:[brew identifier]];
+
+    XCTAssertEqual(delivery, [brew deadline]);
+    XCTAssertGreaterThanOrEqual([mClock now], delivery);
+    XCTAssertLessThan([mClock now], delivery + sSlackLimit);
+    mCompleteCount++;
+}
+
+// The brewer's other events don't matter here.
+- (void)brewer:(Cuppa_Brewer *)brewer showBrew:(Cuppa_Brew *)brew secondsRemain:(int)secondsRemain
+{
+}
+
+- (void)brewerBeep:(Cuppa_Brewer *)brewer
+{
+}
+
+- (void)brewerIdle:(Cuppa_Brewer *)brewer
+{
+}
+
+- (void)brewer:(Cuppa_Brewer *)brewer wakeAt:(NSTimeInterval)time
+{
+}
+
+// *************************************************************************************************
+
+// Notifications are scheduled once, when brews start, for their deadlines.
+- (void)testScheduledUpFront
+{
+    Cuppa_Brew *brews[3]; // brews started
+
+    brews[0] = [self startBrew:240];
+    [mBrewer runUntil:30.5];
+    brews[1] = [self startBrew:60];
+    brews[2] = [self startBrew:600];
+    XCTAssertEqual([mNotifier scheduledCount], 3u);
+    XCTAssertEqual([mNotifier deliveryTimeForNotification:[brews[0] identifier]], 240.0);
+    XCTAssertEqual([mNotifier deliveryTimeForNotification:[brews[1] identifier]], 90.5);
+    XCTAssertEqual([mNotifier deliveryTimeForNotification:[brews[2] identifier]], 630.5);
+
+    // ticking through the brews schedules nothing more
+    [mBrewer runUntil:1000.0];
+    XCTAssertEqual(mCompleteCount, 3u);
+    XCTAssertEqual([mNotifier scheduledCount], 3u);
+    XCTAssertEqual([mNotifier withdrawnCount], 0u);
+}
+
+// *************************************************************************************************
+
+// Cancelling brews withdraws their notifications, which then never arrive.
+- (void)testCancelWithdraws
+{
+    Cuppa_Brew *brew; // brew cancelled
+
+    brew = [self startBrew:120];
+    [self startBrew:180];
+    [mBrewer runUntil:45.0];
+    [self cancelBrews];
+    XCTAssertEqual([mNotifier withdrawnCount], 2u);
+    XCTAssertEqual([mNotifier notificationCount], 0u);
+    XCTAssertEqual([mNotifier deliveryTimeForNotification:[brew identifier]], INFINITY);
+    XCTAssertFalse([brew notifyScheduled]);
+
+    [mBrewer runUntil:1000.0];
+    XCTAssertEqual(mCompleteCount, 0u);
+}
+
+// *************************************************************************************************
+
+// A notification already delivered can't be withdrawn.
+- (void)testDeliveredStays
+{
+    Cuppa_Brew *brew; // brew completed
+
+    brew = [self startBrew:30];
+    [self startBrew:300];
+    [mBrewer runUntil:31.0];
+    XCTAssertEqual(mCompleteCount, 1u);
+    [mNotifier withdrawNotification:[brew identifier]];
+    [self cancelBrews];
+    XCTAssertEqual([mNotifier withdrawnCount], 1u);
+    XCTAssertEqual([mNotifier notificationCount], 1u);
+    XCTAssertEqual([mNotifier deliveryTimeForNotification:[brew identifier]], 30.0);
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_NotifyTests
+
+// end Cuppa_NotifyTests.m
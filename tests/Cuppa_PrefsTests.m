@@ -0,0 +1,211 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_PrefsTests
+           - Checks preference changes are batched down to the last value of each key, written in
+             order off the main thread, and made durable at checkpoints, against the recorder.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_PrefsRecorder.h"
+#import "Cuppa_PrefsWriter.h"
+
+// Internal Constants
+
+// How long the writer collects changes for (long enough that no test waits it out by accident)
+static const NSTimeInterval sDelay = 60.0;
+
+// Code!
+
+@interface Cuppa_PrefsTests : XCTestCase
+{
+    Cuppa_PrefsRecorder *mRecorder; // backend the changes are written to
+    Cuppa_PrefsWriter *mWriter; // writer under test
+}
+@end
+
+@implementation Cuppa_PrefsTests
+;
+
+// *************************************************************************************************
+
+// Make a writer over a fresh recorder.
+- (void)setUp
+{
+    [super setUp];
+    mRecorder = [[Cuppa_PrefsRecorder alloc] init];
+    mWriter = [[Cuppa_PrefsWriter alloc] initWithBackend:mRecorder delay:sDelay];
+}
+
+// *************************************************************************************************
+
+// Release the writer and recorder.
+- (void)tearDown
+{
+    [mWriter release];
+    [mRecorder release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Many changes to a few keys are written as one batch, holding only the last value of each.
+- (void)testChangesBatched
+{
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < 100; i++)
+    {
+        [mWriter setObject:[NSNumber numberWithUnsignedInteger:i] forKey:@"lastBrew"];
+        [mWriter setBool:((i % 2) != 0) forKey:@"bounceIcon"];
+    }
+    XCTAssertEqual([mWriter pendingCount], 2u);
+    XCTAssertEqual([mWriter flushCount], 0u);
+
+    // nothing reaches the backend until the batch is flushed
+    [mWriter waitUntilWritten];
+    XCTAssertEqual([mRecorder writeCount], 0u);
+    XCTAssertEqualObjects([mWriter objectForKey:@"lastBrew"], [NSNumber numberWithInt:99]);
+
+    [mWriter flush];
+    [mWriter waitUntilWritten];
+    XCTAssertEqual([mWriter pendingCount], 0u);
+    XCTAssertEqual([mWriter flushCount], 1u);
+    XCTAssertEqual([mRecorder writeCount], 2u);
+    XCTAssertEqualObjects([mRecorder objectForKey:@"lastBrew"], [NSNumber numberWithInt:99]);
+    XCTAssertEqualObjects([mRecorder objectForKey:@"bounceIcon"], [NSNumber numberWithBool:YES]);
+
+    // an empty flush hands nothing over
+    [mWriter flush];
+    XCTAssertEqual([mWriter flushCount], 1u);
+}
+
+// *************************************************************************************************
+
+// A removal is a change like any other, and the last change to a key wins.
+- (void)testRemoval
+{
+    [mWriter setObject:@"Earl Grey" forKey:@"lastBevy"];
+    [mWriter flush];
+    [mWriter removeObjectForKey:@"lastBevy"];
+    XCTAssertNil([mWriter objectForKey:@"lastBevy"]);
+    [mWriter flush];
+    [mWriter waitUntilWritten];
+    XCTAssertNil([mRecorder objectForKey:@"lastBevy"]);
+
+    [mWriter removeObjectForKey:@"lastBevy"];
+    [mWriter setObject:@"Green" forKey:@"lastBevy"];
+    [mWriter flush];
+    XCTAssertEqualObjects([mWriter objectForKey:@"lastBevy"], @"Green");
+    XCTAssertEqual([mRecorder writeCount], 3u);
+}
+
+// *************************************************************************************************
+
+// Values are copied, so changing one after setting it changes nothing written.
+- (void)testValuesCopied
+{
+    NSMutableArray *bevys = [NSMutableArray arrayWithObject:@"Oolong"]; // value set
+
+    [mWriter setObject:bevys forKey:@"bevys"];
+    [bevys addObject:@"Rooibos"];
+    [mWriter flush];
+    XCTAssertEqualObjects([mWriter objectForKey:@"bevys"], @[ @"Oolong" ]);
+}
+
+// *************************************************************************************************
+
+// The scheduled flush happens by itself once the delay is up.
+- (void)testFlushedAfterDelay
+{
+    Cuppa_PrefsWriter *writer; // writer with a short delay
+
+    writer = [[[Cuppa_PrefsWriter alloc] initWithBackend:mRecorder delay:0.01] autorelease];
+    [writer setObject:@"Assam" forKey:@"lastBevy"];
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    XCTAssertEqual([writer flushCount], 1u);
+    XCTAssertEqual([writer pendingCount], 0u);
+    [writer waitUntilWritten];
+    XCTAssertEqualObjects([mRecorder objectForKey:@"lastBevy"], @"Assam");
+}
+
+// *************************************************************************************************
+
+// Only a checkpoint makes changes durable, and its block runs once they are.
+- (void)testCheckpointDurable
+{
+    __block id durable = nil; // value the checkpoint block saw as durable
+
+    [mWriter setObject:@"Darjeeling" forKey:@"lastBevy"];
+    [mWriter flush];
+    [mWriter waitUntilWritten];
+    XCTAssertEqualObjects([mRecorder objectForKey:@"lastBevy"], @"Darjeeling");
+    XCTAssertNil([mRecorder durableObjectForKey:@"lastBevy"]);
+    XCTAssertEqual([mRecorder synchronizeCount], 0u);
+
+    [mWriter setObject:@"Sencha" forKey:@"lastBevy"];
+    [mWriter checkpoint:^{
+        durable = [[mRecorder durableObjectForKey:@"lastBevy"] retain];
+    }];
+    [mWriter waitUntilWritten];
+    XCTAssertEqual([mRecorder synchronizeCount], 1u);
+    XCTAssertEqualObjects(durable, @"Sencha");
+    [durable release];
+
+    [mWriter checkpoint:nil];
+    [mWriter waitUntilWritten];
+    XCTAssertEqual([mRecorder synchronizeCount], 2u);
+}
+
+// *************************************************************************************************
+
+// Blocks run on the queue in step with the batches handed to it, off the main thread.
+- (void)testWritesInOrder
+{
+    NSMutableArray *seen = [NSMutableArray array]; // values seen by each block, in order
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < 10; i++)
+    {
+        [mWriter setObject:[NSNumber numberWithUnsignedInteger:i] forKey:@"count"];
+        [mWriter flush];
+        [mWriter performWrite:^{
+            XCTAssertFalse([NSThread isMainThread]);
+            [seen addObject:[mRecorder objectForKey:@"count"]];
+        }];
+    }
+    [mWriter waitUntilWritten];
+    XCTAssertEqual([seen count], 10u);
+    for (i = 0; i < 10; i++)
+    {
+        XCTAssertEqualObjects([seen objectAtIndex:i], [NSNumber numberWithUnsignedInteger:i]);
+    }
+}
+
+// *************************************************************************************************
+
+// Releasing the writer writes whatever is still pending.
+- (void)testNothingLostOnRelease
+{
+    [mWriter setObject:@"Chai" forKey:@"lastBevy"];
+    [mWriter release];
+    mWriter = nil;
+    XCTAssertEqualObjects([mRecorder objectForKey:@"lastBevy"], @"Chai");
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_PrefsTests
+
+// end Cuppa_PrefsTests.m
@@ -0,0 +1,250 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_RenderTests
+           - Checks dock tile renders are coalesced into one badge update per pass of the run loop,
+             and that an unchanged badge is never sent again, against a fake dock tile sink.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Render.h"
+#import "Cuppa_TimeFormat.h"
+
+// Code!
+
+// Stands in for the dock tile, recording every badge it is given (NSNull for no badge).
+@interface Cuppa_RenderTestSink : NSObject <Cuppa_RenderSink>
+{
+    NSMutableArray *mLabels; // badge labels received, in order
+}
+
+// Returns the badge labels received so far.
+- (NSArray *)labels;
+
+@end
+
+@implementation Cuppa_RenderTestSink
+;
+
+// *************************************************************************************************
+
+- (id)init
+{
+    if ((self = [super init]) != nil)
+        mLabels = [[NSMutableArray alloc] init];
+    return self;
+}
+
+// *************************************************************************************************
+
+- (void)dealloc
+{
+    [mLabels release];
+    [super dealloc];
+}
+
+// *************************************************************************************************
+
+- (void)setBadgeLabel:(NSString *)label
+{
+    [mLabels addObject:((label != nil) ? (id)label : (id)[NSNull null])];
+}
+
+// *************************************************************************************************
+
+- (NSArray *)labels
+{
+    return mLabels;
+}
+
+@end // @implementation Cuppa_RenderTestSink
+
+// *************************************************************************************************
+
+@interface Cuppa_RenderTests : XCTestCase
+{
+    Cuppa_Render *mRender; // renderer under test
+    Cuppa_RenderTestSink *mSink; // fake dock tile it renders to
+}
+@end
+
+@implementation Cuppa_RenderTests
+;
+
+// *************************************************************************************************
+
+// Make a renderer drawing to a fresh fake dock tile.
+- (void)setUp
+{
+    [super setUp];
+    mRender = [[Cuppa_Render alloc] init];
+    mSink = [[Cuppa_RenderTestSink alloc] init];
+    [mRender setSink:mSink];
+}
+
+// *************************************************************************************************
+
+// Release the renderer and sink.
+- (void)tearDown
+{
+    [mRender restore];
+    [mRender release];
+    [mSink release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Returns the badge label the dock tile should show for seconds remaining.
+- (NSString *)labelForSeconds:(int)seconds
+{
+    char label[CUPPA_RENDER_LABEL_MAX]; // formatted time
+
+    [Cuppa_TimeFormat formatSeconds:seconds buffer:label size:sizeof(label)];
+    return [NSString stringWithUTF8String:label];
+}
+
+// *************************************************************************************************
+
+// Runs the run loop for a moment, so any render requested gets committed.
+- (void)spinRunLoop
+{
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+}
+
+// *************************************************************************************************
+
+// Many changes and renders in one pass of the run loop make one badge update, with the last state.
+- (void)testRendersCoalesce
+{
+    int remain; // seconds remaining
+
+    for (remain = 240; remain > 230; remain--)
+    {
+        [mRender setBrewState:((240 - remain) / 240.0f)];
+        [mRender setBrewRemain:remain];
+        [mRender render];
+    }
+    XCTAssertEqual([mRender rendersRequested], 10u);
+    XCTAssertEqual([mRender rendersCommitted], 0u);
+    XCTAssertEqual([[mSink labels] count], 0u);
+
+    [self spinRunLoop];
+    XCTAssertEqual([mRender rendersCommitted], 1u);
+    XCTAssertEqual([[mSink labels] count], 1u);
+    XCTAssertEqualObjects([[mSink labels] lastObject], [self labelForSeconds:231]);
+
+    // nothing more turns up later
+    [self spinRunLoop];
+    XCTAssertEqual([[mSink labels] count], 1u);
+}
+
+// *************************************************************************************************
+
+// Flushing commits a requested render straight away, and only once.
+- (void)testFlush
+{
+    [mRender flush];
+    XCTAssertEqual([mRender rendersCommitted], 0u);
+
+    [mRender setBrewRemain:3725];
+    [mRender render];
+    [mRender flush];
+    XCTAssertEqual([mRender rendersCommitted], 1u);
+    XCTAssertEqualObjects([[mSink labels] lastObject], [self labelForSeconds:3725]);
+
+    [mRender flush];
+    [self spinRunLoop];
+    XCTAssertEqual([mRender rendersCommitted], 1u);
+    XCTAssertEqual([[mSink labels] count], 1u);
+}
+
+// *************************************************************************************************
+
+// A render that would leave the badge as it is sends nothing, though the brew state moved on.
+- (void)testUnchangedBadgeNotSent
+{
+    [mRender setBrewRemain:90];
+    [mRender render];
+    [mRender flush];
+
+    [mRender setBrewState:0.5f];
+    [mRender setBrewRemain:90];
+    [mRender render];
+    [mRender flush];
+    XCTAssertEqual([mRender rendersRequested], 2u);
+    XCTAssertEqual([mRender rendersCommitted], 1u);
+    XCTAssertEqual([[mSink labels] count], 1u);
+
+    [mRender setBrewRemain:89];
+    [mRender render];
+    [mRender flush];
+    XCTAssertEqual([mRender rendersCommitted], 2u);
+    XCTAssertEqualObjects([[mSink labels] lastObject], [self labelForSeconds:89]);
+}
+
+// *************************************************************************************************
+
+// The badge goes away when nothing is left to brew, and on restore.
+- (void)testBadgeRemoved
+{
+    // no badge to start with, so none to take away
+    [mRender setBrewRemain:0];
+    [mRender render];
+    [mRender flush];
+    XCTAssertEqual([[mSink labels] count], 0u);
+
+    [mRender setBrewRemain:5];
+    [mRender render];
+    [mRender flush];
+    [mRender setBrewRemain:0];
+    [mRender render];
+    [mRender flush];
+    XCTAssertEqual([[mSink labels] count], 2u);
+    XCTAssertEqualObjects([[mSink labels] lastObject], [NSNull null]);
+
+    // restoring drops a render still to come
+    [mRender setBrewRemain:60];
+    [mRender render];
+    [mRender restore];
+    [self spinRunLoop];
+    XCTAssertEqual([[mSink labels] count], 3u);
+    XCTAssertEqualObjects([[mSink labels] lastObject], [NSNull null]);
+    XCTAssertEqual([mRender rendersCommitted], 2u);
+}
+
+// *************************************************************************************************
+
+// A new sink hasn't been shown anything, so it gets the badge even if it hasn't changed.
+- (void)testNewSinkGetsBadge
+{
+    Cuppa_RenderTestSink *sink = [[[Cuppa_RenderTestSink alloc] init] autorelease]; // second tile
+
+    [mRender setBrewRemain:120];
+    [mRender render];
+    [mRender flush];
+    [mRender setSink:sink];
+    [mRender render];
+    [mRender flush];
+    XCTAssertEqual([[mSink labels] count], 1u);
+    XCTAssertEqual([[sink labels] count], 1u);
+    XCTAssertEqualObjects([[sink labels] lastObject], [self labelForSeconds:120]);
+    XCTAssertEqual([mRender rendersCommitted], 2u);
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_RenderTests
+
+// end Cuppa_RenderTests.m
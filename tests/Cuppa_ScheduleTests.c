@@ -0,0 +1,128 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_ScheduleTests
+           - Checks the brew timer wakes up exactly as often as the brew shows or plays something.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// C Includes
+
+#include <math.h>
+#include <stdio.h>
+
+// Cuppa Includes
+
+#include "Cuppa_Schedule.h"
+
+// Internal Constants
+
+// Longest a wakeup may land after the change it is for
+static const double sSlackLimit = 0.02;
+
+// Code!
+
+static int sFailures = 0; // number of checks failed
+
+// Records a failed check, naming where it is.
+#define CHECK(condition)                                                                           \
+    do                                                                                             \
+    {                                                                                              \
+        if (!(condition))                                                                          \
+        {                                                                                          \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);                   \
+            sFailures++;                                                                           \
+        }                                                                                          \
+    } while (0)
+
+// Runs a brew of brewTime seconds the way the brew timer does, waking only when told to, and
+// returns the number of wakeups. Each wakeup must land just after the change it is for.
+static int CountWakeups(int brewTime, bool showTimer, bool makeSound)
+{
+    double now = 0.0; // virtual time
+    double delay; // until the next wakeup
+    int wakeups = 0; // number of wakeups so far
+    int shown; // seconds shown at the last wakeup
+
+    shown = CuppaScheduleSecondsRemain(brewTime - now);
+    while ((delay = CuppaScheduleNextWakeup(brewTime - now, showTimer, makeSound)) > 0.0)
+    {
+        CHECK(delay > 0.0 && delay <= brewTime + sSlackLimit);
+        now += delay;
+        wakeups++;
+
+        // something changed, and only just (a second boundary has just gone by)
+        CHECK(CuppaScheduleSecondsRemain(brewTime - now) < shown);
+        CHECK(ceil(brewTime - now) - (brewTime - now) < sSlackLimit);
+        shown = CuppaScheduleSecondsRemain(brewTime - now);
+        if (wakeups > brewTime + 1)
+            break;
+    }
+
+    // the last wakeup is the alarm, just after the deadline
+    CHECK(now >= brewTime && now < brewTime + sSlackLimit);
+
+    return wakeups;
+}
+
+// Checks the seconds shown for a brew.
+static void TestSecondsRemain(void)
+{
+    CHECK(CuppaScheduleSecondsRemain(-1.0) == 0);
+    CHECK(CuppaScheduleSecondsRemain(0.0) == 0);
+    CHECK(CuppaScheduleSecondsRemain(0.001) == 1);
+    CHECK(CuppaScheduleSecondsRemain(1.0) == 1);
+    CHECK(CuppaScheduleSecondsRemain(1.001) == 2);
+    CHECK(CuppaScheduleSecondsRemain(179.5) == 180);
+}
+
+// Checks the number of wakeups over whole brews, which is what the schedule saves.
+static void TestWakeupCounts(void)
+{
+    int brewTime; // length of the brew
+
+    for (brewTime = 1; brewTime <= 600; brewTime++)
+    {
+        // the countdown changes every second
+        CHECK(CountWakeups(brewTime, true, true) == brewTime);
+        CHECK(CountWakeups(brewTime, true, false) == brewTime);
+
+        // beeps for the final seconds (after a single wakeup for the first one)
+        if (brewTime <= CUPPA_SCHEDULE_BEEP_SECONDS)
+            CHECK(CountWakeups(brewTime, false, true) == brewTime);
+        else
+            CHECK(CountWakeups(brewTime, false, true) == CUPPA_SCHEDULE_BEEP_SECONDS + 1);
+
+        // nothing but the alarm
+        CHECK(CountWakeups(brewTime, false, false) == 1);
+    }
+}
+
+// Checks a brew that is already over, or is woken part way through a second.
+static void TestPartSeconds(void)
+{
+    CHECK(CuppaScheduleNextWakeup(0.0, true, true) == 0.0);
+    CHECK(CuppaScheduleNextWakeup(-5.0, false, false) == 0.0);
+
+    // woken late (say after sleep), the next change is the next second boundary
+    CHECK(fabs(CuppaScheduleNextWakeup(100.25, true, false) - 0.26) < 1e-9);
+    CHECK(fabs(CuppaScheduleNextWakeup(100.25, false, true) - 95.26) < 1e-9);
+    CHECK(fabs(CuppaScheduleNextWakeup(100.25, false, false) - 100.26) < 1e-9);
+    CHECK(fabs(CuppaScheduleNextWakeup(3.5, false, true) - 0.51) < 1e-9);
+}
+
+int main(void)
+{
+    TestSecondsRemain();
+    TestWakeupCounts();
+    TestPartSeconds();
+
+    printf("Cuppa_ScheduleTests: %s\n", sFailures == 0 ? "passed" : "FAILED");
+    return sFailures == 0 ? 0 : 1;
+}
+
+// end Cuppa_ScheduleTests.c
@@ -0,0 +1,135 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_ShapeTableTests
+           - Checks the shape table keeps the first entry for each label, falls back to a default
+             shape, and finds each of many labels by string and by bytes, quickly.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_ShapeTable.h"
+
+// Internal Constants
+
+// Number of entries in the large table
+static const NSUInteger sManyEntries = 10000;
+
+// Code!
+
+// Returns a shape entry with a label and image.
+static NSDictionary *CuppaTestEntry(NSString *label, NSString *image)
+{
+    return [NSDictionary dictionaryWithObjectsAndKeys:label, @"label", image, @"image", nil];
+}
+
+@interface Cuppa_ShapeTableTests : XCTestCase
+{
+    // no instance vars
+}
+@end
+
+@implementation Cuppa_ShapeTableTests
+;
+
+// *************************************************************************************************
+
+// The first entry with a label wins, and unusable entries are skipped.
+- (void)testDuplicateLabels
+{
+    Cuppa_ShapeTable *table; // table under test
+    NSArray *entries; // its entries
+
+    entries = @[ CuppaTestEntry(@"mug", @"Mug"), @"not an entry", @{ @"image" : @"NoLabel" },
+                 @{ @"label" : @"", @"image" : @"Empty" }, CuppaTestEntry(@"glass", @"Glass"),
+                 CuppaTestEntry(@"mug", @"OtherMug") ];
+    table = [[Cuppa_ShapeTable alloc] initWithEntries:entries];
+    XCTAssertEqual([table count], 2u);
+    XCTAssertEqualObjects([table labelForShape:0], @"mug");
+    XCTAssertEqualObjects([table labelForShape:1], @"glass");
+    XCTAssertEqualObjects([[table entryForShape:0] objectForKey:@"image"], @"Mug");
+    XCTAssertEqual([table shapeForLabel:@"mug"], 0);
+    XCTAssertEqual([table shapeForLabel:@"glass"], 1);
+
+    // an unknown label, or none at all, is the default shape
+    XCTAssertEqual([table shapeForLabel:@"teapot"], 0);
+    XCTAssertEqual([table shapeForLabel:nil], 0);
+    XCTAssertEqual([table shapeForLabelBytes:"glas" length:4], 0);
+    XCTAssertEqual([table shapeForLabelBytes:NULL length:0], 0);
+    [table release];
+}
+
+// *************************************************************************************************
+
+// A table with no usable entries still has the default shape.
+- (void)testEmpty
+{
+    Cuppa_ShapeTable *table; // table under test
+
+    table = [[Cuppa_ShapeTable alloc] initWithEntries:@[]];
+    XCTAssertEqual([table count], 1u);
+    XCTAssertEqualObjects([table labelForShape:0], @"default");
+    XCTAssertEqual([table shapeForLabel:@"default"], 0);
+    XCTAssertEqual([table shapeForLabel:@"mug"], 0);
+    [table release];
+
+    table = [[Cuppa_ShapeTable alloc] initWithEntries:nil];
+    XCTAssertEqual([table count], 1u);
+    [table release];
+
+    table = [[Cuppa_ShapeTable alloc] initWithContentsOfFile:@"/nonexistent/Shapes.plist"];
+    XCTAssertEqual([table count], 1u);
+    [table release];
+}
+
+// *************************************************************************************************
+
+// Every label of a large table is found, by string and by bytes, and looking them all up is fast.
+- (void)testManyEntriesPerformance
+{
+    NSMutableArray *entries; // entries of the table
+    NSMutableArray *labels; // their labels
+    Cuppa_ShapeTable *table; // table under test
+    NSUInteger i; // loop counter
+
+    entries = [NSMutableArray arrayWithCapacity:sManyEntries];
+    labels = [NSMutableArray arrayWithCapacity:sManyEntries];
+    for (i = 0; i < sManyEntries; i++)
+    {
+        [labels addObject:[NSString stringWithFormat:@"shape-%lu", (unsigned long)i]];
+        [entries addObject:CuppaTestEntry([labels lastObject], @"Image")];
+    }
+    table = [[Cuppa_ShapeTable alloc] initWithEntries:entries];
+    XCTAssertEqual([table count], sManyEntries);
+
+    [self measureBlock:^
+    {
+        const char *bytes; // current label as UTF-8
+        NSUInteger j; // loop counter
+
+        for (j = 0; j < sManyEntries; j++)
+        {
+            bytes = [[labels objectAtIndex:j] UTF8String];
+            XCTAssertEqual([table shapeForLabel:[labels objectAtIndex:j]], (int)j);
+            XCTAssertEqual([table shapeForLabelBytes:bytes length:strlen(bytes)], (int)j);
+        }
+    }];
+    XCTAssertEqual([table shapeForLabel:@"shape-10000"], 0);
+    [table release];
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_ShapeTableTests
+
+// end Cuppa_ShapeTableTests.m
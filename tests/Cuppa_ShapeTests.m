@@ -0,0 +1,167 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_ShapeTests
+           - Checks shape image cache keys fold unknown shapes into the default and negative scales
+             into vectors, that the cache counts what it hands out and makes, and that the shared
+             image from imageNamed: is never changed. Needs no window.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <AppKit/AppKit.h>
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_Shape.h"
+#import "Cuppa_ShapeRegistry.h"
+
+// Internal Constants
+
+// Sizes no other test asks for, so their images are not cached yet
+static const NSSize sCacheSize = { 21.0, 21.0 };
+static const NSSize sVectorSize = { 22.0, 22.0 };
+static const NSSize sBitmapSize = { 23.0, 23.0 };
+
+// Code!
+
+@interface Cuppa_ShapeTests : XCTestCase
+{
+    NSImage *mSource; // shared image of the default shape, as imageNamed: gives it
+    BOOL mNamed; // whether we named mSource ourselves
+}
+@end
+
+@implementation Cuppa_ShapeTests
+;
+
+// *************************************************************************************************
+
+// Make sure imageNamed: has an image for the default shape, naming one if the bundle has none.
+- (void)setUp
+{
+    NSString *name; // image name of the default shape
+
+    [super setUp];
+    name = [[Cuppa_ShapeRegistry sharedRegistry] imageNameForShape:CUPPA_SHAPE_DEFAULT];
+    mSource = [[NSImage imageNamed:name] retain];
+    mNamed = NO;
+    if (!mSource)
+    {
+        mSource = [[NSImage alloc] initWithSize:NSMakeSize(32, 32)];
+        [mSource lockFocus];
+        [[NSColor blackColor] set];
+        NSRectFill(NSMakeRect(8, 8, 16, 16));
+        [mSource unlockFocus];
+        mNamed = [mSource setName:name];
+    }
+}
+
+// *************************************************************************************************
+
+// Take our name back off the default shape's image, if we gave it one.
+- (void)tearDown
+{
+    if (mNamed)
+        [mSource setName:nil];
+    [mSource release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// Unknown shapes share the default shape's key, and any negative scale means vectors.
+- (void)testImageKeys
+{
+    NSString *key; // key of the default shape, as vectors at menu size
+
+    key = [Cuppa_Shape imageKeyForShape:CUPPA_SHAPE_DEFAULT size:NSMakeSize(16, 16) scale:0.0];
+    XCTAssertEqualObjects([Cuppa_Shape imageKeyForShape:-1 size:NSMakeSize(16, 16) scale:0.0],
+                          key);
+    XCTAssertEqualObjects([Cuppa_Shape imageKeyForShape:[Cuppa_Shape shapeCount]
+                                                   size:NSMakeSize(16, 16)
+                                                  scale:0.0],
+                          key);
+    XCTAssertEqualObjects([Cuppa_Shape imageKeyForShape:CUPPA_SHAPE_DEFAULT
+                                                   size:NSMakeSize(16, 16)
+                                                  scale:-2.0],
+                          key);
+
+    // but size and scale each make a different key
+    XCTAssertNotEqualObjects([Cuppa_Shape imageKeyForShape:CUPPA_SHAPE_DEFAULT
+                                                      size:NSMakeSize(16, 16)
+                                                     scale:2.0],
+                             key);
+    XCTAssertNotEqualObjects([Cuppa_Shape imageKeyForShape:CUPPA_SHAPE_DEFAULT
+                                                      size:NSMakeSize(32, 16)
+                                                     scale:0.0],
+                             key);
+}
+
+// *************************************************************************************************
+
+// An image is made once per key and handed out from the cache after that, to unknown shapes and
+// negative scales too.
+- (void)testCacheCounters
+{
+    NSUInteger hits, decodes; // counters before
+    NSImage *image; // image made for the default shape
+
+    hits = [Cuppa_Shape imageCacheHits];
+    decodes = [Cuppa_Shape imageDecodes];
+    image = [Cuppa_Shape imageForShape:CUPPA_SHAPE_DEFAULT size:sCacheSize scale:0.0];
+    XCTAssertNotNil(image);
+    XCTAssertEqual([Cuppa_Shape imageDecodes], decodes + 1);
+    XCTAssertEqual([Cuppa_Shape imageCacheHits], hits);
+
+    XCTAssertEqual([Cuppa_Shape imageForShape:CUPPA_SHAPE_DEFAULT size:sCacheSize scale:0.0],
+                   image);
+    XCTAssertEqual([Cuppa_Shape imageForShape:-1 size:sCacheSize scale:0.0], image);
+    XCTAssertEqual([Cuppa_Shape imageForShape:CUPPA_SHAPE_DEFAULT size:sCacheSize scale:-1.0],
+                   image);
+    XCTAssertEqual([Cuppa_Shape imageDecodes], decodes + 1);
+    XCTAssertEqual([Cuppa_Shape imageCacheHits], hits + 3);
+    XCTAssertTrue([image isTemplate]);
+    XCTAssertTrue(NSEqualSizes([image size], sCacheSize));
+}
+
+// *************************************************************************************************
+
+// Making images of the default shape, as vectors and as a bitmap, leaves its shared image as it
+// was.
+- (void)testSharedImageUnchanged
+{
+    NSSize size; // size of the shared image before
+    BOOL wasTemplate; // whether it was a template before
+    NSArray *representations; // its representations before
+    NSImage *bitmap; // image drawn at a scale
+
+    XCTAssertNotNil(mSource);
+    size = [mSource size];
+    wasTemplate = [mSource isTemplate];
+    representations = [[[mSource representations] copy] autorelease];
+
+    XCTAssertNotEqual([Cuppa_Shape imageForShape:CUPPA_SHAPE_DEFAULT size:sVectorSize scale:0.0],
+                      mSource);
+    bitmap = [Cuppa_Shape imageForShape:CUPPA_SHAPE_DEFAULT size:sBitmapSize scale:2.0];
+    XCTAssertNotEqual(bitmap, mSource);
+    XCTAssertTrue(NSEqualSizes([bitmap size], sBitmapSize));
+    XCTAssertEqual([(NSImageRep *)[[bitmap representations] lastObject] pixelsWide], 46);
+
+    XCTAssertTrue(NSEqualSizes([mSource size], size));
+    XCTAssertEqual([mSource isTemplate], wasTemplate);
+    XCTAssertEqualObjects([mSource representations], representations);
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_ShapeTests
+
+// end Cuppa_ShapeTests.m
@@ -0,0 +1,516 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_SoundBench
+           - Compares the cue sounds as shipped before (16-bit PCM AIFF, decoded whole) with how
+             they ship now (IMA4 AIFF-C, streamed through a ring): bundle size, decode CPU and
+             peak resident memory. Also times each cue from -playCue: to its first sound in the
+             recorder's output. Run through "make -C tests bench".
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AIFFDecoder.h"
+#import "Cuppa_AudioBuffer.h"
+#import "Cuppa_AudioCues.h"
+#import "Cuppa_AudioRecorder.h"
+#import "Cuppa_AudioRing.h"
+#import "Cuppa_AudioStream.h"
+#import "Cuppa_Clock.h"
+
+// Internal Constants
+
+// Output format the cues are converted to, as the audio output plays them
+static const double sSampleRate = 44100.0;
+static const NSUInteger sChannelCount = 2;
+
+// Frames mixed from each stream at a time, about a render of the audio device
+enum
+{
+    sMixFrames = 512
+};
+
+// Number of times each cue is played when timing latency
+static const NSUInteger sLatencyPlays = 200;
+
+// IMA4 packets, as afconvert writes them
+enum
+{
+    sIMAPacketFrames = 64, // frames in a packet
+    sIMAPacketSize = 34, // bytes in one channel of a packet (2 header bytes, 64 nibbles)
+    sIMAStepCount = 89 // entries in the step table
+};
+
+// IMA ADPCM step sizes
+static const int sIMASteps[sIMAStepCount] = {
+    7,     8,     9,     10,    11,    12,    13,    14,    16,    17,    19,    21,    23,
+    25,    28,    31,    34,    37,    41,    45,    50,    55,    60,    66,    73,    80,
+    88,    97,    107,   118,   130,   143,   157,   173,   190,   209,   230,   253,   279,
+    307,   337,   371,   408,   449,   494,   544,   598,   658,   724,   796,   876,   963,
+    1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,  2272,  2499,  2749,  3024,  3327,
+    3660,  4026,  4428,  4871,  5358,  5894,  6484,  7132,  7845,  8630,  9493,  10442, 11487,
+    12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767};
+
+// IMA ADPCM step index changes, by nibble
+static const int sIMAIndexChanges[16] = {-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8};
+
+// Code!
+
+// Returns the CPU time used by the process so far, in seconds.
+static double CuppaBenchCPUTime(void)
+{
+    struct rusage usage; // resources used
+
+    getrusage(RUSAGE_SELF, &usage);
+    return (double)usage.ru_utime.tv_sec + (usage.ru_utime.tv_usec / 1e6) +
+           (double)usage.ru_stime.tv_sec + (usage.ru_stime.tv_usec / 1e6);
+}
+
+// Returns the peak resident memory of the process so far, in KB.
+static double CuppaBenchPeakKB(void)
+{
+    struct rusage usage; // resources used
+
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024.0; // (bytes here, KB elsewhere)
+#else
+    return (double)usage.ru_maxrss;
+#endif
+}
+
+// Appends the low count bytes of value to data, big-endian.
+static void CuppaBenchAppendBig(NSMutableData *data, uint64_t value, NSUInteger count)
+{
+    uint8_t byte; // current byte
+    NSUInteger i; // loop counter
+
+    for (i = count; i > 0; i--)
+    {
+        byte = (uint8_t)(value >> ((i - 1) * 8));
+        [data appendBytes:&byte length:1];
+    }
+}
+
+// Appends value to data as an 80-bit IEEE extended float, as the AIFF sample rate is stored.
+static void CuppaBenchAppendExtended(NSMutableData *data, double value)
+{
+    double fraction; // value is fraction * 2^exponent, with fraction in [0.5, 1)
+    int exponent; // power of two
+
+    fraction = frexp(value, &exponent);
+    CuppaBenchAppendBig(data, (uint64_t)(exponent - 1 + 16383), 2);
+    CuppaBenchAppendBig(data, (uint64_t)ldexp(fraction, 64), 8);
+}
+
+// Returns sample of buffer (looped) as a 16-bit integer.
+static int CuppaBenchSample(Cuppa_AudioBuffer *buffer, NSUInteger frame, NSUInteger channel)
+{
+    float sample; // the sample, -1.0 to 1.0
+
+    sample = [buffer samples][((frame % [buffer frameCount]) * [buffer channelCount]) + channel];
+    return (int)lrintf(MAX(-1.0f, MIN(sample, 1.0f)) * 32767.0f);
+}
+
+// Returns frameCount frames of buffer (looped) as a 16-bit PCM AIFF file.
+static NSData *CuppaBenchPCM(Cuppa_AudioBuffer *buffer, NSUInteger frameCount)
+{
+    NSMutableData *data = [NSMutableData data]; // the file
+    NSUInteger soundLength; // bytes of samples
+    NSUInteger frame, channel; // loop counters
+
+    soundLength = frameCount * [buffer channelCount] * 2;
+    [data appendBytes:"FORM" length:4];
+    CuppaBenchAppendBig(data, 46 + soundLength, 4);
+    [data appendBytes:"AIFF" length:4];
+    [data appendBytes:"COMM" length:4];
+    CuppaBenchAppendBig(data, 18, 4);
+    CuppaBenchAppendBig(data, [buffer channelCount], 2);
+    CuppaBenchAppendBig(data, frameCount, 4);
+    CuppaBenchAppendBig(data, 16, 2);
+    CuppaBenchAppendExtended(data, [buffer sampleRate]);
+    [data appendBytes:"SSND" length:4];
+    CuppaBenchAppendBig(data, 8 + soundLength, 4);
+    CuppaBenchAppendBig(data, 0, 4);
+    CuppaBenchAppendBig(data, 0, 4);
+    for (frame = 0; frame < frameCount; frame++)
+    {
+        for (channel = 0; channel < [buffer channelCount]; channel++)
+        {
+            CuppaBenchAppendBig(data, (uint16_t)CuppaBenchSample(buffer, frame, channel), 2);
+        }
+    }
+    return data;
+}
+
+// Encodes one channel of a packet of buffer (looped, and silent past frameCount) into packet,
+// carrying the predictor and step index from packet to packet as the decoder will see them.
+static void CuppaBenchEncodeIMA4(Cuppa_AudioBuffer *buffer, NSUInteger frameCount,
+                                 NSUInteger first, NSUInteger channel, int *predictor, int *index,
+                                 uint8_t *packet)
+{
+    int sample; // next sample to encode
+    int nibble; // its code
+    int step; // current step size
+    int diff; // distance to the sample, then the change the code makes
+    NSUInteger i; // loop counter
+
+    // the header holds the top 9 bits of the predictor, which is all the decoder starts with
+    *predictor = (int16_t)(*predictor & 0xFF80);
+    packet[0] = (uint8_t)((*predictor >> 8) & 0xFF);
+    packet[1] = (uint8_t)((*predictor & 0x80) | *index);
+    memset(packet + 2, 0, sIMAPacketSize - 2);
+    for (i = 0; i < sIMAPacketFrames; i++)
+    {
+        sample = (first + i < frameCount) ? CuppaBenchSample(buffer, first + i, channel) : 0;
+        step = sIMASteps[*index];
+        diff = sample - *predictor;
+        nibble = (diff < 0) ? 8 : 0;
+        diff = abs(diff);
+        if (diff >= step)
+        {
+            nibble |= 4;
+            diff -= step;
+        }
+        if (diff >= step >> 1)
+        {
+            nibble |= 2;
+            diff -= step >> 1;
+        }
+        if (diff >= step >> 2)
+            nibble |= 1;
+
+        // step on exactly as the decoder will
+        diff = step >> 3;
+        if (nibble & 1)
+            diff += step >> 2;
+        if (nibble & 2)
+            diff += step >> 1;
+        if (nibble & 4)
+            diff += step;
+        *predictor += (nibble & 8) ? -diff : diff;
+        *predictor = MAX(-32768, MIN(*predictor, 32767));
+        *index = MAX(0, MIN(*index + sIMAIndexChanges[nibble], sIMAStepCount - 1));
+
+        // low nibble first
+        packet[2 + (i / 2)] |= (uint8_t)(nibble << ((i & 1) * 4));
+    }
+}
+
+// Returns frameCount frames of buffer (looped) as an IMA4 AIFF-C file, laid out as afconvert
+// writes the cue sounds in the "Compress Sounds" build phase.
+static NSData *CuppaBenchIMA4(Cuppa_AudioBuffer *buffer, NSUInteger frameCount)
+{
+    NSMutableData *data = [NSMutableData data]; // the file
+    NSUInteger packetCount; // packets per channel
+    NSUInteger soundLength; // bytes of packets
+    int predictors[8] = {0}, indexes[8] = {0}; // encoder state of each channel
+    uint8_t packet[sIMAPacketSize]; // current packet of one channel
+    NSUInteger i, channel; // loop counters
+
+    packetCount = (frameCount + sIMAPacketFrames - 1) / sIMAPacketFrames;
+    soundLength = packetCount * [buffer channelCount] * sIMAPacketSize;
+    [data appendBytes:"FORM" length:4];
+    CuppaBenchAppendBig(data, 4 + 12 + 38 + 16 + soundLength, 4);
+    [data appendBytes:"AIFC" length:4];
+    [data appendBytes:"FVER" length:4];
+    CuppaBenchAppendBig(data, 4, 4);
+    CuppaBenchAppendBig(data, 0xA2805140, 4);
+    [data appendBytes:"COMM" length:4];
+    CuppaBenchAppendBig(data, 30, 4);
+    CuppaBenchAppendBig(data, [buffer channelCount], 2);
+    CuppaBenchAppendBig(data, packetCount, 4);
+    CuppaBenchAppendBig(data, 16, 2);
+    CuppaBenchAppendExtended(data, [buffer sampleRate]);
+    [data appendBytes:"ima4\x07IMA 4:1" length:12];
+    [data appendBytes:"SSND" length:4];
+    CuppaBenchAppendBig(data, 8 + soundLength, 4);
+    CuppaBenchAppendBig(data, 0, 4);
+    CuppaBenchAppendBig(data, 0, 4);
+    for (i = 0; i < packetCount; i++)
+    {
+        for (channel = 0; channel < MIN([buffer channelCount], (NSUInteger)8); channel++)
+        {
+            CuppaBenchEncodeIMA4(buffer, frameCount, i * sIMAPacketFrames, channel,
+                                 &predictors[channel], &indexes[channel], packet);
+            [data appendBytes:packet length:sIMAPacketSize];
+        }
+    }
+    return data;
+}
+
+// Writes each sound, looped to at least seconds long, into directory as 16-bit PCM AIFF and as
+// IMA4 AIFF-C, and prints the size of each, as the bundle would hold it.
+static int PrepareSounds(NSString *directory, double seconds, NSArray *paths)
+{
+    Cuppa_AudioBuffer *buffer; // a sound
+    NSString *name; // its name, without extension
+    NSData *pcm, *ima4; // the sound, written each way
+    NSUInteger frameCount; // frames written
+    NSUInteger pcmTotal = 0, ima4Total = 0; // bytes written each way
+
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory
+                              withIntermediateDirectories:YES
+                                               attributes:nil
+                                                    error:NULL];
+    for (NSString *path in paths)
+    {
+        buffer = [Cuppa_AIFFDecoder bufferWithContentsOfFile:path];
+        if (!buffer || [buffer frameCount] == 0 || [buffer channelCount] > 8)
+        {
+            printf("Cuppa_SoundBench: can't read %s\n", [path UTF8String]);
+            return 1;
+        }
+        frameCount = MAX([buffer frameCount],
+                         (NSUInteger)ceil(seconds * [buffer sampleRate]));
+        pcm = CuppaBenchPCM(buffer, frameCount);
+        ima4 = CuppaBenchIMA4(buffer, frameCount);
+        name = [directory stringByAppendingPathComponent:
+                              [[path lastPathComponent] stringByDeletingPathExtension]];
+        [pcm writeToFile:[name stringByAppendingPathExtension:@"aiff"] atomically:NO];
+        [ima4 writeToFile:[name stringByAppendingPathExtension:@"aifc"] atomically:NO];
+        pcmTotal += [pcm length];
+        ima4Total += [ima4 length];
+        printf("Cuppa_SoundBench: %-12s %6.2f secs  aiff %8lu bytes  aifc %8lu bytes\n",
+               [[path lastPathComponent] UTF8String], frameCount / [buffer sampleRate],
+               (unsigned long)[pcm length], (unsigned long)[ima4 length]);
+    }
+    printf("Cuppa_SoundBench: bundle       aiff %lu bytes, aifc %lu bytes (%.0f%%)\n",
+           (unsigned long)pcmTotal, (unsigned long)ima4Total, 100.0 * ima4Total / pcmTotal);
+    return 0;
+}
+
+// Decodes each sound whole and converts it to the output format, keeping them all, as every cue
+// was loaded before (and short cues still are).
+static int DecodeWhole(NSArray *paths)
+{
+    NSMutableArray *buffers = [NSMutableArray array]; // decoded sounds, as the cues hold them
+    Cuppa_AudioBuffer *buffer; // a sound
+    double startCPU, startKB; // CPU time and peak memory before decoding
+    double seconds = 0.0; // length of all the sounds
+
+    startKB = CuppaBenchPeakKB();
+    startCPU = CuppaBenchCPUTime();
+    for (NSString *path in paths)
+    {
+        buffer = [Cuppa_AIFFDecoder bufferWithContentsOfFile:path];
+        buffer = [buffer bufferWithSampleRate:sSampleRate channelCount:sChannelCount];
+        if (!buffer)
+        {
+            printf("Cuppa_SoundBench: can't read %s\n", [path UTF8String]);
+            return 1;
+        }
+        [buffers addObject:buffer];
+        seconds += [buffer duration];
+    }
+    printf("Cuppa_SoundBench: whole  %2lu sounds %7.2f secs  decode %8.2f ms CPU  "
+           "peak RSS +%8.0f KB\n",
+           (unsigned long)[buffers count], seconds, (CuppaBenchCPUTime() - startCPU) * 1000.0,
+           CuppaBenchPeakKB() - startKB);
+    return 0;
+}
+
+// Plays every sound at once through its own ring, as long cues are played now, mixing a render's
+// worth from each ring in turn until they have all drained.
+static int DecodeStreamed(NSArray *paths)
+{
+    NSMutableArray *streams = [NSMutableArray array]; // streams of the sounds
+    Cuppa_AudioStream *stream; // a stream
+    NSData *data; // a sound file, mapped
+    float *mix; // output being mixed
+    double startCPU, startKB; // CPU time and peak memory before decoding
+    double seconds = 0.0; // length of all the sounds
+    BOOL playing; // flag: some stream has not drained?
+
+    startKB = CuppaBenchPeakKB();
+    startCPU = CuppaBenchCPUTime();
+    for (NSString *path in paths)
+    {
+        data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:NULL];
+        stream = data ? [[[Cuppa_AudioStream alloc] initWithData:data
+                                                      sampleRate:sSampleRate
+                                                    channelCount:sChannelCount] autorelease]
+                      : nil;
+        if (!stream)
+        {
+            printf("Cuppa_SoundBench: can't read %s\n", [path UTF8String]);
+            return 1;
+        }
+        [streams addObject:stream];
+        seconds += [stream duration];
+    }
+
+    // the streams are never started, so filling them here is the only writing there is
+    mix = malloc(sMixFrames * sChannelCount * sizeof(float));
+    do
+    {
+        playing = NO;
+        memset(mix, 0, sMixFrames * sChannelCount * sizeof(float));
+        for (stream in streams)
+        {
+            [stream fill];
+            [[stream ring] mixFrames:sMixFrames into:mix];
+            playing = playing || ![[stream ring] isDrained];
+        }
+    } while (playing);
+    free(mix);
+
+    printf("Cuppa_SoundBench: stream %2lu sounds %7.2f secs  decode %8.2f ms CPU  "
+           "peak RSS +%8.0f KB\n",
+           (unsigned long)[streams count], seconds, (CuppaBenchCPUTime() - startCPU) * 1000.0,
+           CuppaBenchPeakKB() - startKB);
+    return 0;
+}
+
+// Returns the number of silent frames at the start of a sound, once converted to the output
+// format, or NSNotFound if it is silent throughout.
+static NSUInteger CuppaBenchLeadIn(Cuppa_AudioBuffer *buffer)
+{
+    const float *samples = [buffer samples]; // the sound
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < [buffer frameCount] * [buffer channelCount]; i++)
+    {
+        if (samples[i] != 0.0f)
+            return i / [buffer channelCount];
+    }
+    return NSNotFound;
+}
+
+// Plays each sound as a cue into a recorder, timing from -playCue: to the first non-zero sample
+// the recorder records, rendering a device's worth at a time. The frames before that sample, less
+// any silence the sound starts with, are the cue's latency in samples.
+static int TimeLatency(NSArray *paths)
+{
+    Cuppa_Clock *wallClock; // times each play
+    Cuppa_AudioRecorder *recorder; // records the cues
+    Cuppa_AudioCues *cues; // plays the cues
+    Cuppa_AudioBuffer *buffer; // a sound, converted to the output format
+    const float *samples; // samples recorded
+    NSUInteger leadIn; // silent frames the sound starts with
+    NSUInteger first; // first frame recorded for the current play
+    NSUInteger frame; // frame being checked
+    NSUInteger latency; // frames before the first sound of a play
+    NSUInteger play; // loop counter
+    NSTimeInterval start; // wall time of the current play
+    NSTimeInterval elapsed, total, longest; // wall time to the first sound
+    BOOL heard; // flag: the current play has made a sound?
+
+    wallClock = [[[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_AWAKE] autorelease];
+    recorder = [[[Cuppa_AudioRecorder alloc] initWithSampleRate:sSampleRate] autorelease];
+    cues = [[[Cuppa_AudioCues alloc]
+        initWithOutput:recorder
+                 clock:[[[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_VIRTUAL] autorelease]]
+        autorelease];
+    for (NSString *path in paths)
+    {
+        buffer = [Cuppa_AIFFDecoder bufferWithContentsOfFile:path];
+        buffer = [buffer bufferWithSampleRate:sSampleRate channelCount:sChannelCount];
+        if (!buffer || ![cues loadCue:path fromFile:path])
+        {
+            printf("Cuppa_SoundBench: can't read %s\n", [path UTF8String]);
+            return 1;
+        }
+        leadIn = CuppaBenchLeadIn(buffer);
+        if (leadIn == NSNotFound)
+        {
+            printf("Cuppa_SoundBench: %s is silent\n", [path UTF8String]);
+            return 1;
+        }
+
+        total = 0.0;
+        longest = 0.0;
+        latency = 0;
+        for (play = 0; play < sLatencyPlays; play++)
+        {
+            @autoreleasepool
+            {
+                first = [recorder frameCount];
+                heard = NO;
+                start = [wallClock now];
+                [cues playCue:path];
+                for (frame = first; !heard && frame < first + leadIn + (NSUInteger)sSampleRate;)
+                {
+                    [[cues mixer] topUpStreams];
+                    [recorder renderFrames:sMixFrames];
+                    samples = [[recorder samples] bytes];
+                    for (; !heard && frame < [recorder frameCount]; frame++)
+                    {
+                        heard = (samples[frame * sChannelCount] != 0.0f) ||
+                                (samples[(frame * sChannelCount) + 1] != 0.0f);
+                    }
+                }
+                elapsed = [wallClock now] - start;
+                [cues stopAll];
+            }
+            if (!heard)
+            {
+                printf("Cuppa_SoundBench: %s made no sound\n", [path UTF8String]);
+                return 1;
+            }
+            total += elapsed;
+            longest = MAX(longest, elapsed);
+            latency = MAX(latency, frame - 1 - first - leadIn);
+        }
+        printf("Cuppa_SoundBench: latency %-28s %s  mean %8.1f us  max %8.1f us  "
+               "%lu frames late\n",
+               [[path lastPathComponent] UTF8String],
+               ([cues bufferForCue:path] != nil) ? "whole " : "stream",
+               total / sLatencyPlays * 1e6, longest * 1e6, (unsigned long)latency);
+    }
+    return 0;
+}
+
+int main(int argc, const char *argv[])
+{
+    NSMutableArray *paths; // sounds named on the command line
+    NSString *mode; // what to do with them
+    int first; // first sound argument
+    int i; // loop counter
+    int result; // exit status
+
+    @autoreleasepool
+    {
+        mode = (argc > 1) ? [NSString stringWithUTF8String:argv[1]] : @"";
+        first = [mode isEqualToString:@"prepare"] ? 4 : 2;
+        if (argc <= first)
+        {
+            printf("usage: Cuppa_SoundBench prepare directory seconds sound.aiff...\n"
+                   "       Cuppa_SoundBench whole|stream|latency sound...\n");
+            return 2;
+        }
+        paths = [NSMutableArray array];
+        for (i = first; i < argc; i++)
+        {
+            [paths addObject:[NSString stringWithUTF8String:argv[i]]];
+        }
+
+        if ([mode isEqualToString:@"prepare"])
+            result = PrepareSounds([NSString stringWithUTF8String:argv[2]], atof(argv[3]), paths);
+        else if ([mode isEqualToString:@"whole"])
+            result = DecodeWhole(paths);
+        else if ([mode isEqualToString:@"stream"])
+            result = DecodeStreamed(paths);
+        else if ([mode isEqualToString:@"latency"])
+            result = TimeLatency(paths);
+        else
+            result = 2;
+    }
+    return result;
+}
+
+// end Cuppa_SoundBench.m
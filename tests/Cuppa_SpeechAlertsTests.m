@@ -0,0 +1,187 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_SpeechAlertsTests
+           - Checks spoken alerts are synthesized once when prepared, play straight away once
+             ready, are kept by voice as well as text, and are forgotten least recent first,
+             against the speech recorder.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_AudioCues.h"
+#import "Cuppa_AudioMixer.h"
+#import "Cuppa_AudioRecorder.h"
+#import "Cuppa_Clock.h"
+#import "Cuppa_SpeechAlerts.h"
+#import "Cuppa_SpeechRecorder.h"
+
+// Internal Constants
+
+// Frames per second alerts are synthesized and played at
+static const double sSampleRate = 44100.0;
+
+// Code!
+
+@interface Cuppa_SpeechAlertsTests : XCTestCase
+{
+    NSString *mFolder; // scratch folder alerts are synthesized into
+    Cuppa_Clock *mClock; // virtual clock the alerts are played on
+    Cuppa_AudioRecorder *mRecorder; // stands in for the audio output
+    Cuppa_AudioCues *mCues; // plays the alerts
+    Cuppa_SpeechRecorder *mSpeech; // stands in for the speech synthesizer
+    Cuppa_SpeechAlerts *mAlerts; // alerts under test
+}
+@end
+
+@implementation Cuppa_SpeechAlertsTests
+;
+
+// *************************************************************************************************
+
+// Make an empty set of alerts, synthesized by the recorder into a fresh scratch folder.
+- (void)setUp
+{
+    [super setUp];
+    mFolder = [[NSTemporaryDirectory() stringByAppendingPathComponent:
+                [[NSProcessInfo processInfo] globallyUniqueString]] retain];
+    mClock = [[Cuppa_Clock alloc] initWithPolicy:CUPPA_CLOCK_VIRTUAL];
+    mRecorder = [[Cuppa_AudioRecorder alloc] initWithSampleRate:sSampleRate];
+    mCues = [[Cuppa_AudioCues alloc] initWithOutput:mRecorder clock:mClock];
+    mSpeech = [[Cuppa_SpeechRecorder alloc] initWithVoice:@"com.example.voice.tea"
+                                               sampleRate:sSampleRate];
+    mAlerts = [[Cuppa_SpeechAlerts alloc] initWithBackend:mSpeech audio:mCues folder:mFolder];
+}
+
+// *************************************************************************************************
+
+// Release the alerts and everything behind them, and remove the scratch folder.
+- (void)tearDown
+{
+    [mAlerts release];
+    [mSpeech release];
+    [mCues stopAll];
+    [mCues release];
+    [mRecorder release];
+    [mClock release];
+    [[NSFileManager defaultManager] removeItemAtPath:mFolder error:NULL];
+    [mFolder release];
+    [super tearDown];
+}
+
+// *************************************************************************************************
+
+// A prepared alert is ready to play, and its file is gone once it is loaded.
+- (void)testPrepare
+{
+    XCTAssertFalse([mAlerts isReadyForString:@"Earl Grey is ready"]);
+    [mAlerts prepareString:@"Earl Grey is ready"];
+    XCTAssertTrue([mAlerts isReadyForString:@"Earl Grey is ready"]);
+    XCTAssertEqual([mAlerts readyCount], 1u);
+    XCTAssertEqual([mAlerts pendingCount], 0u);
+    XCTAssertEqualObjects([mSpeech requests], @[ @"Earl Grey is ready" ]);
+    XCTAssertEqual([[[NSFileManager defaultManager] contentsOfDirectoryAtPath:mFolder
+                                                                        error:NULL] count], 0u);
+}
+
+// *************************************************************************************************
+
+// An alert is only synthesized once, however often it is prepared and spoken.
+- (void)testSynthesizedOnce
+{
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < 5; i++)
+    {
+        [mAlerts prepareString:@"Sencha is ready"];
+        XCTAssertTrue([mAlerts speakString:@"Sencha is ready"]);
+    }
+    XCTAssertEqual([mSpeech requestCount], 1u);
+    XCTAssertEqual([mAlerts readyCount], 1u);
+}
+
+// *************************************************************************************************
+
+// Speaking a ready alert plays it straight away; one that isn't ready is left to be spoken live.
+- (void)testSpeak
+{
+    XCTAssertFalse([mAlerts speakString:@"Chai is ready"]);
+    XCTAssertEqual([mSpeech requestCount], 0u);
+
+    [mAlerts prepareString:@"Chai is ready"];
+    XCTAssertTrue([mAlerts speakString:@"Chai is ready"]);
+    XCTAssertTrue([mRecorder isRunning]);
+    XCTAssertEqual([[mCues mixer] activeVoiceCount], 1u);
+}
+
+// *************************************************************************************************
+
+// Only so many alerts are kept, and the one spoken least recently is forgotten first.
+- (void)testLeastRecentForgotten
+{
+    NSMutableArray *texts = [NSMutableArray array]; // the alerts
+    NSUInteger i; // loop counter
+
+    for (i = 0; i <= CUPPA_SPEECHALERTS_KEPT; i++)
+    {
+        [texts addObject:[NSString stringWithFormat:@"Brew %lu is ready", (unsigned long)i]];
+    }
+    for (i = 0; i < CUPPA_SPEECHALERTS_KEPT; i++)
+    {
+        [mAlerts prepareString:[texts objectAtIndex:i]];
+    }
+    XCTAssertEqual([mAlerts readyCount], (NSUInteger)CUPPA_SPEECHALERTS_KEPT);
+
+    // speaking the first again makes the second the least recent
+    XCTAssertTrue([mAlerts speakString:[texts objectAtIndex:0]]);
+    [mAlerts prepareString:[texts lastObject]];
+    XCTAssertEqual([mAlerts readyCount], (NSUInteger)CUPPA_SPEECHALERTS_KEPT);
+    XCTAssertTrue([mAlerts isReadyForString:[texts objectAtIndex:0]]);
+    XCTAssertFalse([mAlerts isReadyForString:[texts objectAtIndex:1]]);
+    XCTAssertFalse([mAlerts speakString:[texts objectAtIndex:1]]);
+
+    // a forgotten alert is simply synthesized again
+    [mAlerts prepareString:[texts objectAtIndex:1]];
+    XCTAssertTrue([mAlerts isReadyForString:[texts objectAtIndex:1]]);
+    XCTAssertEqual([mSpeech requestCount], (NSUInteger)CUPPA_SPEECHALERTS_KEPT + 2);
+}
+
+// *************************************************************************************************
+
+// An alert made in one voice isn't spoken in another, and changing back finds it again.
+- (void)testVoiceChange
+{
+    NSString *key; // key of the alert in the first voice
+
+    [mAlerts prepareString:@"Oolong is ready"];
+    key = [mAlerts keyForString:@"Oolong is ready"];
+    XCTAssertNotEqual([key rangeOfString:@"com.example.voice.tea"].location, NSNotFound);
+
+    [mSpeech setVoice:@"com.example.voice.coffee"];
+    XCTAssertNotEqualObjects([mAlerts keyForString:@"Oolong is ready"], key);
+    XCTAssertFalse([mAlerts isReadyForString:@"Oolong is ready"]);
+    XCTAssertFalse([mAlerts speakString:@"Oolong is ready"]);
+    [mAlerts prepareString:@"Oolong is ready"];
+    XCTAssertEqual([mAlerts readyCount], 2u);
+
+    [mSpeech setVoice:@"com.example.voice.tea"];
+    XCTAssertEqualObjects([mAlerts keyForString:@"Oolong is ready"], key);
+    XCTAssertTrue([mAlerts speakString:@"Oolong is ready"]);
+    XCTAssertEqual([mSpeech requestCount], 2u);
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_SpeechAlertsTests
+
+// end Cuppa_SpeechAlertsTests.m
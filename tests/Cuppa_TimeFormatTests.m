@@ -0,0 +1,177 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_TimeFormatTests
+           - Checks steep times are formatted as snprintf would format them, at the hour boundary,
+             for negative and the largest times, and when truncated; and times formatting them
+             against snprintf.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+#include <limits.h>
+#include <stdio.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimeFormat.h"
+
+// Internal Constants
+
+// Number of times formatted, checked against snprintf and timed each way
+static const int sTimes = 1000000;
+
+// Code!
+
+// Format seconds into buffer with snprintf, the way steep times were formatted before. Returns
+// the length snprintf would have written.
+static int CuppaTestSprintf(int seconds, char separator, char *buffer, size_t size)
+{
+    if (seconds < 0)
+        seconds = 0;
+    if (seconds >= 3600)
+        return snprintf(buffer, size, "%d%c%02d%c%02d", seconds / 3600, separator,
+                        (seconds / 60) % 60, separator, seconds % 60);
+    return snprintf(buffer, size, "%d%c%02d", seconds / 60, separator, seconds % 60);
+}
+
+@interface Cuppa_TimeFormatTests : XCTestCase
+{
+    // no instance vars
+}
+@end
+
+@implementation Cuppa_TimeFormatTests
+;
+
+// *************************************************************************************************
+
+// Format seconds with ':' into a buffer of size, and check the result and its length.
+- (void)checkSeconds:(int)seconds size:(size_t)size expected:(const char *)expected
+{
+    char buffer[CUPPA_TIME_STRING_MAX]; // formatted time
+    size_t length; // length returned
+
+    memset(buffer, 'x', sizeof(buffer));
+    length = [Cuppa_TimeFormat formatSeconds:seconds separator:':' buffer:buffer size:size];
+    XCTAssertEqual(strcmp(buffer, expected), 0, @"%d seconds gave %s", seconds, buffer);
+    XCTAssertEqual(length, strlen(expected));
+
+    // nothing is written past the buffer
+    if (size < sizeof(buffer))
+        XCTAssertEqual(buffer[size], (char)'x');
+}
+
+// *************************************************************************************************
+
+// Either side of an hour, hours appear and minutes are padded.
+- (void)testHourBoundary
+{
+    [self checkSeconds:0 size:CUPPA_TIME_STRING_MAX expected:"0:00"];
+    [self checkSeconds:59 size:CUPPA_TIME_STRING_MAX expected:"0:59"];
+    [self checkSeconds:3599 size:CUPPA_TIME_STRING_MAX expected:"59:59"];
+    [self checkSeconds:3600 size:CUPPA_TIME_STRING_MAX expected:"1:00:00"];
+    [self checkSeconds:3661 size:CUPPA_TIME_STRING_MAX expected:"1:01:01"];
+    [self checkSeconds:36000 size:CUPPA_TIME_STRING_MAX expected:"10:00:00"];
+}
+
+// *************************************************************************************************
+
+// Negative times are written as zero, and the largest time fits.
+- (void)testLimits
+{
+    [self checkSeconds:-1 size:CUPPA_TIME_STRING_MAX expected:"0:00"];
+    [self checkSeconds:INT_MIN size:CUPPA_TIME_STRING_MAX expected:"0:00"];
+    [self checkSeconds:INT_MAX size:CUPPA_TIME_STRING_MAX expected:"596523:14:07"];
+}
+
+// *************************************************************************************************
+
+// A buffer too small for the time gets as much of it as fits, and is still terminated.
+- (void)testTruncation
+{
+    [self checkSeconds:3600 size:1 expected:""];
+    [self checkSeconds:3600 size:4 expected:"1:0"];
+    [self checkSeconds:3599 size:4 expected:"59:"];
+    [self checkSeconds:59 size:4 expected:"0:5"];
+    [self checkSeconds:59 size:5 expected:"0:59"];
+    [self checkSeconds:INT_MAX size:4 expected:"596"];
+}
+
+// *************************************************************************************************
+
+// Every time up to a million seconds, with either separator, comes out as snprintf writes it.
+- (void)testMatchesSprintf
+{
+    char buffer[CUPPA_TIME_STRING_MAX]; // time formatted by Cuppa_TimeFormat
+    char expected[CUPPA_TIME_STRING_MAX]; // time formatted by snprintf
+    int seconds; // loop counter
+
+    for (seconds = -1; seconds < sTimes; seconds++)
+    {
+        CuppaTestSprintf(seconds, (seconds & 1) ? '.' : ':', expected, sizeof(expected));
+        [Cuppa_TimeFormat formatSeconds:seconds
+                              separator:((seconds & 1) ? '.' : ':')
+                                 buffer:buffer
+                                   size:sizeof(buffer)];
+        if (strcmp(buffer, expected) != 0)
+        {
+            XCTFail(@"%d seconds gave %s, not %s", seconds, buffer, expected);
+            break;
+        }
+    }
+}
+
+// *************************************************************************************************
+
+// Formatting a million times.
+- (void)testFormatPerformance
+{
+    [self measureBlock:^
+    {
+        char buffer[CUPPA_TIME_STRING_MAX]; // formatted time
+        size_t total = 0; // sum of the lengths, so the formatting isn't optimized away
+        int seconds; // loop counter
+
+        for (seconds = 0; seconds < sTimes; seconds++)
+        {
+            total += [Cuppa_TimeFormat formatSeconds:seconds
+                                           separator:':'
+                                              buffer:buffer
+                                                size:sizeof(buffer)];
+        }
+        XCTAssertGreaterThan(total, 0u);
+    }];
+}
+
+// *************************************************************************************************
+
+// Formatting a million times with snprintf, to compare with the above.
+- (void)testSprintfPerformance
+{
+    [self measureBlock:^
+    {
+        char buffer[CUPPA_TIME_STRING_MAX]; // formatted time
+        size_t total = 0; // sum of the lengths, so the formatting isn't optimized away
+        int seconds; // loop counter
+
+        for (seconds = 0; seconds < sTimes; seconds++)
+        {
+            total += (size_t)CuppaTestSprintf(seconds, ':', buffer, sizeof(buffer));
+        }
+        XCTAssertGreaterThan(total, 0u);
+    }];
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_TimeFormatTests
+
+// end Cuppa_TimeFormatTests.m
@@ -0,0 +1,175 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_TimerBench
+           - Compares the timer heap with the timing wheel as brew timer backends: the CPU time to
+             start, cancel and expire a number of brew-length timers on a clock that has been
+             running for days, and peak resident memory. Run through "make -C tests bench".
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimerBackend.h"
+#import "Cuppa_TimerQueue.h"
+#import "Cuppa_TimerWheel.h"
+
+// Internal Constants
+
+// Time on the clock when the timers start, as after a few days of uptime
+static const NSTimeInterval sStartTime = 300000.25;
+
+// Shortest and longest brew timers, in seconds (an hour covers nearly every real brew)
+static const int sShortestBrew = 10;
+static const int sLongestBrew = 3600;
+
+// Every this many timers started, one is cancelled
+static const NSUInteger sCancelEvery = 3;
+
+// Code!
+
+// Returns the CPU time used by the process so far, in seconds.
+static double CuppaBenchCPUTime(void)
+{
+    struct rusage usage; // resources used
+
+    getrusage(RUSAGE_SELF, &usage);
+    return (double)usage.ru_utime.tv_sec + (usage.ru_utime.tv_usec / 1e6) +
+           (double)usage.ru_stime.tv_sec + (usage.ru_stime.tv_usec / 1e6);
+}
+
+// Returns the peak resident memory of the process so far, in KB.
+static double CuppaBenchPeakKB(void)
+{
+    struct rusage usage; // resources used
+
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return usage.ru_maxrss / 1024.0; // (bytes here, KB elsewhere)
+#else
+    return (double)usage.ru_maxrss;
+#endif
+}
+
+// Starts count brew timers on backend, cancels every sCancelEvery-th, then ticks the clock a
+// second at a time, as the brewer does with the countdown shown, expiring the rest in order.
+static int RunTimers(NSString *name, id<Cuppa_TimerBackend> backend, NSUInteger count)
+{
+    NSMutableArray *objects; // deadlines of the timers, made before timing starts
+    NSUInteger *timerIDs; // identifiers of the timers started
+    NSTimeInterval now; // current time on the clock
+    NSTimeInterval deadline; // deadline of a timer
+    NSTimeInterval last; // deadline of the last timer expired
+    NSUInteger expired, cancelled; // timers expired and cancelled
+    double startCPU, startKB; // CPU time and peak memory before starting the timers
+    double addCPU, cancelCPU, expireCPU; // CPU time of each phase
+    uint32_t seed; // for brew times, the same on every run
+    NSNumber *object; // deadline of a timer expired
+    NSUInteger i; // loop counter
+
+    objects = [NSMutableArray arrayWithCapacity:count];
+    seed = 1;
+    for (i = 0; i < count; i++)
+    {
+        seed = (seed * 1103515245) + 12345;
+        deadline = sStartTime + sShortestBrew +
+                   ((seed >> 8) % ((sLongestBrew - sShortestBrew) * 1000)) / 1000.0;
+        [objects addObject:[NSNumber numberWithDouble:deadline]];
+    }
+    timerIDs = malloc(count * sizeof(NSUInteger));
+
+    startKB = CuppaBenchPeakKB();
+    startCPU = CuppaBenchCPUTime();
+    for (i = 0; i < count; i++)
+    {
+        object = [objects objectAtIndex:i];
+        timerIDs[i] = [backend addTimerWithDeadline:[object doubleValue] object:object];
+    }
+    addCPU = CuppaBenchCPUTime();
+
+    cancelled = 0;
+    for (i = 0; i < count; i += sCancelEvery)
+    {
+        if ([backend cancelTimer:timerIDs[i]])
+            cancelled++;
+    }
+    cancelCPU = CuppaBenchCPUTime();
+
+    expired = 0;
+    last = -INFINITY;
+    for (now = sStartTime; [backend count] > 0; now += 1.0)
+    {
+        @autoreleasepool
+        {
+            while ((object = [backend popTimerDueBy:now]) != nil)
+            {
+                if ([object doubleValue] < last || [object doubleValue] > now)
+                {
+                    printf("Cuppa_TimerBench: %s expired a timer out of order\n",
+                           [name UTF8String]);
+                    free(timerIDs);
+                    return 1;
+                }
+                last = [object doubleValue];
+                expired++;
+            }
+        }
+    }
+    expireCPU = CuppaBenchCPUTime();
+    free(timerIDs);
+
+    if (expired + cancelled != count)
+    {
+        printf("Cuppa_TimerBench: %s lost %lu timers\n", [name UTF8String],
+               (unsigned long)(count - expired - cancelled));
+        return 1;
+    }
+    printf("Cuppa_TimerBench: %-5s %8lu timers  add %9.2f ms  cancel %8.2f ms  "
+           "expire %9.2f ms CPU  peak RSS +%8.0f KB\n",
+           [name UTF8String], (unsigned long)count, (addCPU - startCPU) * 1000.0,
+           (cancelCPU - addCPU) * 1000.0, (expireCPU - cancelCPU) * 1000.0,
+           CuppaBenchPeakKB() - startKB);
+    return 0;
+}
+
+int main(int argc, const char *argv[])
+{
+    NSString *name; // backend to run
+    id<Cuppa_TimerBackend> backend; // the backend
+    long count; // number of timers
+    int result; // exit status
+
+    @autoreleasepool
+    {
+        name = (argc > 2) ? [NSString stringWithUTF8String:argv[1]] : @"";
+        count = (argc > 2) ? atol(argv[2]) : 0;
+        if ([name isEqualToString:@"queue"])
+            backend = [[[Cuppa_TimerQueue alloc] init] autorelease];
+        else if ([name isEqualToString:@"wheel"])
+            backend = [[[Cuppa_TimerWheel alloc] init] autorelease];
+        else
+            backend = nil;
+        if (!backend || count <= 0)
+        {
+            printf("usage: Cuppa_TimerBench queue|wheel count\n");
+            return 2;
+        }
+
+        result = RunTimers(name, backend, (NSUInteger)count);
+    }
+    return result;
+}
+
+// end Cuppa_TimerBench.m
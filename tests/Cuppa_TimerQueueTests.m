@@ -0,0 +1,197 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_TimerQueueTests
+           - Checks the timer heap hands timers back in deadline order through any mix of adds,
+             cancels and pops, and times it with many timers.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimerQueue.h"
+
+// Internal Constants
+
+// Number of timers in the benchmark
+static const NSUInteger sManyTimers = 100000;
+
+// Code!
+
+// Returns the next of a repeatable series of deadlines, up to a day away.
+static NSTimeInterval CuppaTestDeadline(uint32_t *seed)
+{
+    *seed = (*seed * 1103515245) + 12345;
+    return (NSTimeInterval)(*seed >> 8) / (NSTimeInterval)(1 << 24) * 86400.0;
+}
+
+@interface Cuppa_TimerQueueTests : XCTestCase
+@end
+
+@implementation Cuppa_TimerQueueTests
+;
+
+// *************************************************************************************************
+
+// An empty queue has nothing due, and nothing to pop.
+- (void)testEmpty
+{
+    Cuppa_TimerQueue *queue = [[[Cuppa_TimerQueue alloc] init] autorelease]; // queue under test
+
+    XCTAssertEqual([queue count], 0u);
+    XCTAssertEqual([queue nextDeadline], INFINITY);
+    XCTAssertNil([queue nextObject]);
+    XCTAssertNil([queue popTimerDueBy:INFINITY]);
+    XCTAssertFalse([queue cancelTimer:CUPPA_TIMER_NONE]);
+}
+
+// *************************************************************************************************
+
+// Timers come back earliest first, and only once they are due.
+- (void)testPopsInDeadlineOrder
+{
+    Cuppa_TimerQueue *queue = [[[Cuppa_TimerQueue alloc] init] autorelease]; // queue under test
+    NSMutableArray *deadlines = [NSMutableArray array]; // deadlines added, to sort
+    NSNumber *deadline; // deadline popped
+    uint32_t seed = 1; // for deadlines
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < 1000; i++)
+    {
+        deadline = [NSNumber numberWithDouble:CuppaTestDeadline(&seed)];
+        XCTAssertNotEqual([queue addTimerWithDeadline:[deadline doubleValue] object:deadline],
+                          (NSUInteger)CUPPA_TIMER_NONE);
+        [deadlines addObject:deadline];
+    }
+    [deadlines sortUsingSelector:@selector(compare:)];
+    XCTAssertEqual([queue count], 1000u);
+    XCTAssertEqual([queue nextDeadline], [[deadlines objectAtIndex:0] doubleValue]);
+
+    // nothing is due before the first deadline
+    XCTAssertNil([queue popTimerDueBy:([[deadlines objectAtIndex:0] doubleValue] - 0.001)]);
+    for (i = 0; i < 1000; i++)
+    {
+        deadline = [queue popTimerDueBy:INFINITY];
+        XCTAssertEqualObjects(deadline, [deadlines objectAtIndex:i]);
+    }
+    XCTAssertEqual([queue count], 0u);
+    XCTAssertEqual([queue nextDeadline], INFINITY);
+}
+
+// *************************************************************************************************
+
+// Cancelled timers never come back, and a timer can only be cancelled while it is active.
+- (void)testCancel
+{
+    Cuppa_TimerQueue *queue = [[[Cuppa_TimerQueue alloc] init] autorelease]; // queue under test
+    NSUInteger timerIDs[100]; // timers added
+    NSNumber *index; // timer popped
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < 100; i++)
+    {
+        timerIDs[i] = [queue addTimerWithDeadline:(NSTimeInterval)(100 - i)
+                                           object:[NSNumber numberWithUnsignedInteger:i]];
+    }
+
+    // cancel every odd timer, the second time to no effect
+    for (i = 1; i < 100; i += 2)
+    {
+        XCTAssertTrue([queue cancelTimer:timerIDs[i]]);
+        XCTAssertFalse([queue cancelTimer:timerIDs[i]]);
+    }
+    XCTAssertEqual([queue count], 50u);
+    while ((index = [queue popTimerDueBy:INFINITY]) != nil)
+    {
+        XCTAssertEqual([index unsignedIntegerValue] % 2, 0u);
+
+        // a popped timer can't be cancelled
+        XCTAssertFalse([queue cancelTimer:timerIDs[[index unsignedIntegerValue]]]);
+    }
+
+    // slots are reused, but the old identifiers stay dead
+    i = [queue addTimerWithDeadline:1.0 object:[NSNull null]];
+    XCTAssertFalse([queue cancelTimer:timerIDs[0]]);
+    XCTAssertFalse([queue cancelTimer:timerIDs[99]]);
+    XCTAssertTrue([queue cancelTimer:i]);
+}
+
+// *************************************************************************************************
+
+// Enumerating visits exactly the timers due before the time given.
+- (void)testEnumerateDueBefore
+{
+    Cuppa_TimerQueue *queue = [[[Cuppa_TimerQueue alloc] init] autorelease]; // queue under test
+    __block NSUInteger visited = 0; // timers visited
+    NSUInteger expected = 0; // timers due
+    NSTimeInterval deadline; // deadline added
+    uint32_t seed = 7; // for deadlines
+    NSUInteger i; // loop counter
+
+    for (i = 0; i < 1000; i++)
+    {
+        deadline = CuppaTestDeadline(&seed);
+        [queue addTimerWithDeadline:deadline object:[NSNumber numberWithDouble:deadline]];
+        if (deadline < 3600.0)
+            expected++;
+    }
+    [queue enumerateTimersDueBefore:3600.0 usingBlock:^(id object, NSTimeInterval due)
+    {
+        XCTAssertLessThan(due, 3600.0);
+        XCTAssertEqual([object doubleValue], due);
+        visited++;
+    }];
+    XCTAssertEqual(visited, expected);
+    XCTAssertEqual([queue count], 1000u);
+
+    [queue removeAllTimers];
+    XCTAssertEqual([queue count], 0u);
+    XCTAssertNil([queue nextObject]);
+}
+
+// *************************************************************************************************
+
+// Starts and expires many timers at once, as a brew timer never would but a heap has to cope with.
+- (void)testManyTimersPerformance
+{
+    [self measureBlock:^
+    {
+        Cuppa_TimerQueue *queue = [[Cuppa_TimerQueue alloc] init]; // queue under test
+        NSTimeInterval last = -INFINITY; // deadline last popped
+        NSUInteger popped = 0; // timers popped
+        uint32_t seed = 3; // for deadlines
+        NSUInteger i; // loop counter
+
+        @autoreleasepool
+        {
+            for (i = 0; i < sManyTimers; i++)
+            {
+                [queue addTimerWithDeadline:CuppaTestDeadline(&seed) object:[NSNull null]];
+            }
+            while ([queue count] > 0)
+            {
+                XCTAssertGreaterThanOrEqual([queue nextDeadline], last);
+                last = [queue nextDeadline];
+                [queue popTimerDueBy:INFINITY];
+                popped++;
+            }
+        }
+        XCTAssertEqual(popped, sManyTimers);
+        [queue release];
+    }];
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_TimerQueueTests
+
+// end Cuppa_TimerQueueTests.m
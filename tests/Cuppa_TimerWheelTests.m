@@ -0,0 +1,228 @@
+/*
+ **************************************************************************************************
+ Package:  Cuppa
+ Test:     Cuppa_TimerWheelTests
+           - Checks the timing wheel against the timer heap, which must agree on every timer
+             through any mix of adds, cancels, pops and long jumps in time, and when the wheel is
+             first used days from zero.
+ ----------------------------------------------------------------------------------------------------
+ Copyright (c) 2005-2026 Nathan Cosgray. All rights reserved.
+ 
+ This source code is licensed under the BSD-style license found in LICENSE.txt.
+ **************************************************************************************************
+ */
+
+// OSX Includes
+
+#import <Foundation/Foundation.h>
+#import <XCTest/XCTest.h>
+
+// Cuppa Includes
+
+#import "Cuppa_TimerQueue.h"
+#import "Cuppa_TimerWheel.h"
+
+// Internal Constants
+
+// Number of steps in the random walk
+static const NSUInteger sSteps = 20000;
+
+// Code!
+
+// Returns the next of a repeatable series of numbers, from 0 to 0xffffff.
+static uint32_t CuppaTestRandom(uint32_t *seed)
+{
+    *seed = (*seed * 1103515245) + 12345;
+    return *seed >> 8;
+}
+
+@interface Cuppa_TimerWheelTests : XCTestCase
+@end
+
+@implementation Cuppa_TimerWheelTests
+;
+
+// *************************************************************************************************
+
+// Checks the wheel and the heap hold the same timers, due at the same times.
+- (void)checkWheel:(Cuppa_TimerWheel *)wheel matchesQueue:(Cuppa_TimerQueue *)queue
+            before:(NSTimeInterval)time
+{
+    __block NSTimeInterval wheelSum = 0.0, queueSum = 0.0; // deadlines of timers due
+    __block NSUInteger wheelDue = 0, queueDue = 0; // number of timers due
+
+    XCTAssertEqual([wheel count], [queue count]);
+    XCTAssertEqual([wheel nextDeadline], [queue nextDeadline]);
+    [wheel enumerateTimersDueBefore:time usingBlock:^(id object, NSTimeInterval deadline)
+    {
+        XCTAssertLessThan(deadline, time);
+        wheelSum += deadline;
+        wheelDue++;
+    }];
+    [queue enumerateTimersDueBefore:time usingBlock:^(id object, NSTimeInterval deadline)
+    {
+        queueSum += deadline;
+        queueDue++;
+    }];
+    XCTAssertEqual(wheelDue, queueDue);
+    XCTAssertEqualWithAccuracy(wheelSum, queueSum, 1e-6);
+}
+
+// *************************************************************************************************
+
+// Pops everything due by time from both, which must come out the same.
+- (void)popWheel:(Cuppa_TimerWheel *)wheel
+           queue:(Cuppa_TimerQueue *)queue
+           dueBy:(NSTimeInterval)time
+{
+    NSNumber *fromWheel, *fromQueue; // deadlines popped
+
+    do
+    {
+        fromWheel = [wheel popTimerDueBy:time];
+        fromQueue = [queue popTimerDueBy:time];
+        XCTAssertEqualObjects(fromWheel, fromQueue);
+    } while (fromWheel != nil && fromQueue != nil);
+}
+
+// *************************************************************************************************
+
+// Walks forward through time adding, cancelling and popping timers at random, from a second to
+// well past a turn of the outer wheel away.
+- (void)testRandomWalkMatchesHeap
+{
+    Cuppa_TimerWheel *wheel = [[[Cuppa_TimerWheel alloc] init] autorelease]; // wheel under test
+    Cuppa_TimerQueue *queue = [[[Cuppa_TimerQueue alloc] init] autorelease]; // reference
+    NSMutableArray *wheelIDs = [NSMutableArray array]; // identifiers of timers on the wheel
+    NSMutableArray *queueIDs = [NSMutableArray array]; // and of the same timers on the heap
+    NSTimeInterval now = 1000.25; // current time
+    NSTimeInterval deadline; // deadline of the next timer
+    NSNumber *object; // object of the next timer
+    NSUInteger pick; // timer to cancel
+    uint32_t seed = 11; // for the walk
+    NSUInteger step; // loop counter
+
+    for (step = 0; step < sSteps; step++)
+    {
+        @autoreleasepool
+        {
+            switch (CuppaTestRandom(&seed) % 8)
+            {
+                case 0:
+                case 1:
+                case 2:
+                    // a brew-length timer, or (rarely) one further away than the wheel reaches
+                    deadline = now + (CuppaTestRandom(&seed) % 36000) +
+                               (CuppaTestRandom(&seed) % 1000) / 1000.0;
+                    if (CuppaTestRandom(&seed) % 50 == 0)
+                        deadline += 200000.0;
+                    object = [NSNumber numberWithDouble:deadline];
+                    [wheelIDs addObject:[NSNumber numberWithUnsignedInteger:
+                                         [wheel addTimerWithDeadline:deadline object:object]]];
+                    [queueIDs addObject:[NSNumber numberWithUnsignedInteger:
+                                         [queue addTimerWithDeadline:deadline object:object]]];
+                    break;
+                case 3:
+                    // cancel a timer, which may have expired already
+                    if ([wheelIDs count] == 0)
+                        break;
+                    pick = CuppaTestRandom(&seed) % [wheelIDs count];
+                    XCTAssertEqual(
+                        [wheel cancelTimer:[[wheelIDs objectAtIndex:pick] unsignedIntegerValue]],
+                        [queue cancelTimer:[[queueIDs objectAtIndex:pick] unsignedIntegerValue]]);
+                    [wheelIDs removeObjectAtIndex:pick];
+                    [queueIDs removeObjectAtIndex:pick];
+                    break;
+                case 4:
+                    // sleep for a while
+                    now += CuppaTestRandom(&seed) % 20000;
+                    [self popWheel:wheel queue:queue dueBy:now];
+                    break;
+                default:
+                    // tick along a second or so
+                    now += (CuppaTestRandom(&seed) % 1500) / 1000.0;
+                    [self popWheel:wheel queue:queue dueBy:now];
+                    break;
+            }
+            if (step % 100 == 0)
+                [self checkWheel:wheel matchesQueue:queue before:(now + 10.0)];
+        }
+    }
+
+    // everything left comes out in the same order
+    [self checkWheel:wheel matchesQueue:queue before:INFINITY];
+    [self popWheel:wheel queue:queue dueBy:INFINITY];
+    XCTAssertEqual([wheel count], 0u);
+    XCTAssertEqual([wheel nextDeadline], INFINITY);
+}
+
+// *************************************************************************************************
+
+// Timers added after their deadline are due straight away, and a long sleep loses nothing.
+- (void)testPastDeadlinesAndLongSleep
+{
+    Cuppa_TimerWheel *wheel = [[[Cuppa_TimerWheel alloc] init] autorelease]; // wheel under test
+    NSUInteger i; // loop counter
+
+    // turn the wheel on, then add timers behind it and ahead of it
+    [wheel addTimerWithDeadline:5000.0 object:@"turn"];
+    XCTAssertEqualObjects([wheel popTimerDueBy:5000.0], @"turn");
+    [wheel addTimerWithDeadline:4000.5 object:@"late"];
+    for (i = 0; i < 10; i++)
+    {
+        [wheel addTimerWithDeadline:(5000.0 + (i * 7000.0))
+                             object:[NSNumber numberWithUnsignedInteger:i]];
+    }
+    XCTAssertEqual([wheel nextDeadline], 4000.5);
+    XCTAssertEqualObjects([wheel popTimerDueBy:5000.0], @"late");
+    XCTAssertEqualObjects([wheel popTimerDueBy:5000.0], [NSNumber numberWithUnsignedInteger:0]);
+    XCTAssertNil([wheel popTimerDueBy:5000.0]);
+
+    // a day later, the rest are all due, in order
+    for (i = 1; i < 10; i++)
+    {
+        XCTAssertEqualObjects([wheel popTimerDueBy:(5000.0 + 86400.0)],
+                              [NSNumber numberWithUnsignedInteger:i]);
+    }
+    XCTAssertEqual([wheel count], 0u);
+}
+
+// *************************************************************************************************
+
+// A wheel first used days from zero starts at its first deadline, moves back for earlier ones
+// added before it turns, and still hands every timer out in order, from the heap's.
+- (void)testFirstDeadlineFarFromZero
+{
+    Cuppa_TimerWheel *wheel = [[[Cuppa_TimerWheel alloc] init] autorelease]; // wheel under test
+    Cuppa_TimerQueue *queue = [[[Cuppa_TimerQueue alloc] init] autorelease]; // reference
+    NSTimeInterval now = 300000.25; // current time, days of uptime in
+    NSTimeInterval deadline; // deadline of the next timer
+    NSNumber *object; // object of the next timer
+    NSUInteger i; // loop counter
+
+    // falling deadlines, then a few later ones, then one already due
+    for (i = 0; i < 600; i++)
+    {
+        deadline = now + ((i < 500) ? (3600.5 - (i * 7)) : (i * 11));
+        object = [NSNumber numberWithDouble:deadline];
+        [wheel addTimerWithDeadline:deadline object:object];
+        [queue addTimerWithDeadline:deadline object:object];
+    }
+    object = [NSNumber numberWithDouble:(now - 5.0)];
+    [wheel addTimerWithDeadline:(now - 5.0) object:object];
+    [queue addTimerWithDeadline:(now - 5.0) object:object];
+    [self checkWheel:wheel matchesQueue:queue before:(now + 1000.0)];
+
+    // tick along a second at a time until the heap is empty
+    for (; [queue count] > 0; now += 1.0)
+    {
+        [self popWheel:wheel queue:queue dueBy:now];
+    }
+    XCTAssertEqual([wheel count], 0u);
+}
+
+// *************************************************************************************************
+
+@end // @implementation Cuppa_TimerWheelTests
+
+// end Cuppa_TimerWheelTests.m